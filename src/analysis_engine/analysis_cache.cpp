@@ -0,0 +1,51 @@
+#include "analysis_cache.h"
+
+AnalysisCache::AnalysisCache(size_t capacity)
+    : capacity_(capacity)
+    , version_(0)
+{}
+
+bool AnalysisCache::store(const PositionKey& key, const EngineAnalysis& analysis) {
+    if (!analysis.hasResult || analysis.lines.empty())
+        return false;
+    
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto existing = entries_.find(key);
+        if (existing != entries_.end()) {
+            if (existing->second.depth > analysis.depth)
+                return false;
+            existing->second = analysis;
+        } else {
+            // Analysis is cheap to recompute; dropping everything keeps this simple
+            if (entries_.size() >= capacity_)
+                entries_.clear();
+            entries_.emplace(key, analysis);
+        }
+    }
+    version_.fetch_add(1, std::memory_order_release);
+    return true;
+}
+
+bool AnalysisCache::lookup(const PositionKey& key, EngineAnalysis& analysis) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto entry = entries_.find(key);
+    if (entry == entries_.end())
+        return false;
+    analysis = entry->second;
+    return true;
+}
+
+int AnalysisCache::getDepth(const PositionKey& key) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto entry = entries_.find(key);
+    return (entry == entries_.end()) ? 0 : entry->second.depth;
+}
+
+void AnalysisCache::clear() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        entries_.clear();
+    }
+    version_.fetch_add(1, std::memory_order_release);
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include "analysis_engine.h"
+
+/**
+ * Thread-safe store of engine analysis keyed by position line
+ * 
+ * Key features:
+ * - Filled by live analysis and by speculative (pre-analysis) searches
+ * - Keeps only the deepest analysis per position
+ * - Version counter lets the GUI notice new entries without polling them
+ * - Bounded: the whole cache is dropped when it reaches capacity
+ */
+class AnalysisCache {
+public:
+    explicit AnalysisCache(size_t capacity);
+    
+    // Store if deeper than (or as deep as) the existing entry; returns true if stored
+    bool store(const PositionKey& key, const EngineAnalysis& analysis);
+    
+    // Copy the cached analysis for a position; returns false if there is none
+    bool lookup(const PositionKey& key, EngineAnalysis& analysis) const;
+    
+    // Depth of the cached analysis (0 if none)
+    int getDepth(const PositionKey& key) const;
+    
+    // Bumped whenever an entry is stored
+    uint64_t getVersion() const { return version_.load(std::memory_order_acquire); }
+    
+    void clear();
+    
+private:
+    struct KeyHash {
+        size_t operator()(const PositionKey& key) const { 
+            return static_cast<size_t>(key.lineHash ^ (static_cast<uint64_t>(key.length) * 0x9E3779B97F4A7C15ULL)); 
+        }
+    };
+    
+    mutable std::mutex mutex_;
+    std::unordered_map<PositionKey, EngineAnalysis, KeyHash> entries_;
+    size_t capacity_;
+    std::atomic<uint64_t> version_;
+};
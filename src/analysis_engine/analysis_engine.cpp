@@ -0,0 +1,41 @@
+#include "analysis_engine.h"
+#include "../config/config.h"
+#include <algorithm>
+#include <thread>
+
+EngineSettings EngineSettings::fromConfig() {
+    EngineSettings settings;
+    
+    // Leave one hardware thread for the GUI
+    const int hardwareThreads = static_cast<int>(std::thread::hardware_concurrency());
+    settings.threads = 
+        (Config::Engine::THREADS > 0) ?
+        Config::Engine::THREADS :
+        std::max(1, hardwareThreads - 1);
+    settings.hashMb = Config::Engine::HASH_MB;
+    settings.multiPV = Config::Engine::MULTI_PV;
+    settings.evalFile = Config::Engine::EVAL_FILE;
+    return settings;
+}
+
+std::string SearchLimits::toGoCommand() const {
+    std::string command = "go";
+    if (depth > 0)
+        command += " depth " + std::to_string(depth);
+    if (nodes > 0)
+        command += " nodes " + std::to_string(nodes);
+    if (movetimeMs > 0)
+        command += " movetime " + std::to_string(movetimeMs);
+    if (mate > 0)
+        command += " mate " + std::to_string(mate);
+    if (!isBounded())
+        command += " infinite";
+    
+    // searchmoves must come last: every following token is a move
+    if (!searchMoves.empty()) {
+        command += " searchmoves";
+        for (const auto& move : searchMoves)
+            command += " " + move;
+    }
+    return command;
+}
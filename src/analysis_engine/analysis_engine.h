@@ -0,0 +1,185 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <string>
+#include <vector>
+#include "uci_analysis_parser.h"
+
+enum class EngineState {
+    Disconnected,   // Not connected to engine
+    Connecting,     // Establishing connection to engine
+    Ready,          // Connected and ready for commands (not analyzing)
+    Stopping,       // Stopping current analysis (transition state)
+    Analyzing,      // Currently analyzing a position
+    Error           // Error occurred
+};
+
+// Identity of a requested position (start position + move sequence) without comparing move lists
+struct PositionKey {
+    uint64_t lineHash = 0;  // Hash of the start FEN and every move played from it
+    uint32_t length = 0;    // Plies from the start FEN
+
+    bool operator==(const PositionKey& other) const { return lineHash == other.lineHash && length == other.length; }
+    bool operator!=(const PositionKey& other) const { return !(*this == other); }
+};
+
+struct EngineAnalysis {
+    EngineState state;              // Current engine state
+    uint64_t version = 0;           // Snapshot version (changes whenever state or results change)
+    PositionKey key;                // Position the results belong to
+    int depth = 0;                  // Depth of the principal line
+
+    // Validity flag - indicates if analysis data is valid/available
+    bool hasResult = false;
+
+    // Analysis data - only valid when hasResult is true
+    std::string fen;                // Position relevant to the analysis
+    std::string rawInfo;            // data for printing to the screen
+
+    std::vector<AnalysisLine> lines; // Up to 4 analysis lines
+};
+
+// Budget for a bounded search; unset (zero/empty) limits are left out of the go command
+struct SearchLimits {
+    int depth = 0;
+    uint64_t nodes = 0;
+    int movetimeMs = 0;
+    int mate = 0;                          // Search for a mate in this many moves
+    std::vector<std::string> searchMoves;  // Restrict the search to these root moves
+
+    bool isBounded() const { return depth > 0 || nodes > 0 || movetimeMs > 0 || mate > 0; }
+    std::string toGoCommand() const;       // "go infinite" when unbounded
+};
+
+// Engine options applied on connect and on reconfigure
+struct EngineSettings {
+    int threads = 1;
+    int hashMb = 16;
+    int multiPV = 1;
+    std::string evalFile;           // Empty keeps the engine's built-in network
+
+    static EngineSettings fromConfig(); // Config::Engine values (threads resolved to a count)
+};
+
+// Final answer of a bounded search
+struct SearchResult {
+    PositionKey key;                // Position the search was requested for
+    std::string bestMove;           // Empty if the search was cancelled
+    std::string ponderMove;
+    EngineAnalysis analysis;        // Last info lines before bestmove
+};
+
+// Invoked on the engine thread when a bounded search completes (or is cancelled)
+using SearchCallback = std::function<void(const SearchResult&)>;
+
+/**
+ * Polling interface shared by the analysis backends
+ *
+ * Key features:
+ * - UCIEngine drives an external engine process, NativeEngine searches in
+ *   process; the controller, EngineComp, game review and batch mode only see
+ *   this interface, so either backend can be plugged in
+ * - Every call returns immediately: live results are polled, bounded
+ *   searches answer through a future (and an optional callback)
+ * - Moves and positions are exchanged as UCI strings and FENs
+ */
+class AnalysisEngine {
+public:
+    virtual ~AnalysisEngine() = default;
+
+    /**
+     * Set the position to analyze
+     * This is non-blocking and returns immediately.
+     * Internal state machine will handle stopping current analysis if needed.
+     * Call pollAnalysis() to get updates.
+     *
+     * @param startFen The FEN the move sequence starts from (ideally the last irreversible position)
+     * @param moves The list of moves from startFen to the current position
+     * @param key Identity of the whole line; positions are only resent when it changes
+     */
+    virtual void setPosition(const std::string& startFen, const std::vector<std::string>& moves, const PositionKey& key) = 0;
+
+    /**
+     * Check if a position is already requested (or being analyzed)
+     * Lets callers skip building the move list when nothing changed.
+     */
+    virtual bool isPositionRequested(const PositionKey& key) const = 0;
+
+    /**
+     * Drop queued (not yet started) bounded searches; their results are empty
+     */
+    virtual void clearPendingSearches() = 0;
+
+    /**
+     * Queue a bounded search
+     * Non-blocking. Queued searches take priority over interactive analysis and
+     * start as soon as the previous one has answered, so a batch of positions
+     * runs back to back without manual stop/start.
+     *
+     * @param startFen The FEN the move sequence starts from
+     * @param moves The list of moves from startFen to the position to search
+     * @param key Identity of the position, echoed in the result
+     * @param limits Search budget (unbounded limits fall back to a 1 second movetime)
+     * @param onComplete Optional callback, invoked on the engine thread
+     * @return Future fulfilled with the result; bestMove is empty if the engine was disabled first
+     */
+    virtual std::future<SearchResult> requestSearch(
+        const std::string& startFen,
+        const std::vector<std::string>& moves,
+        const PositionKey& key,
+        const SearchLimits& limits,
+        SearchCallback onComplete = nullptr) = 0;
+
+    /**
+     * Poll for current analysis state
+     * This updates internal state and returns latest analysis.
+     * Should be called regularly (e.g., every frame in raylib).
+     * Returns immediately, never blocks.
+     *
+     * Gracefully handles situations where engine has no result yet:
+     * - The hasResult field indicates if analysis data is valid
+     * - When hasResult==false, do not access other analysis data fields
+     * - Never throws exceptions
+     * - State field indicates what engine is currently doing
+     */
+    virtual EngineAnalysis pollAnalysis() = 0;
+
+    /**
+     * Current snapshot version
+     * Bumped on every state transition and every analysis update, so callers
+     * can cheaply detect new results without copying the analysis.
+     */
+    virtual uint64_t getAnalysisVersion() const = 0;
+
+    /**
+     * Enable the engine (start it if it is not running)
+     */
+    virtual void enable() = 0;
+
+    /**
+     * Disable the engine
+     * Stops all analysis; outstanding bounded searches are answered empty.
+     */
+    virtual void disable() = 0;
+
+    /**
+     * Check if the engine is currently enabled
+     */
+    virtual bool isEnabled() const = 0;
+
+    /**
+     * Change Threads/Hash/MultiPV/EvalFile
+     * Non-blocking. Applied between searches; interactive analysis restarts
+     * with the new settings. If the engine is disabled they are applied on enable().
+     */
+    virtual void configure(const EngineSettings& settings) = 0;
+    virtual EngineSettings getSettings() const = 0;
+
+    /**
+     * Clear current analysis output
+     * Stops current analysis and clears all displayed results
+     */
+    virtual void clearAnalysis() = 0;
+};
@@ -0,0 +1,143 @@
+#include "evaluation.h"
+#include <algorithm>
+#include <initializer_list>
+
+using namespace Bitboards;
+
+namespace {
+    constexpr int PIECE_VALUES[7] = { 0, 100, 320, 330, 500, 900, 0 };
+    constexpr int BISHOP_PAIR_BONUS = 30;
+    constexpr int TEMPO_BONUS = 10;
+
+    // Game phase: knights and bishops count 1, rooks 2, queens 4 (24 at the start)
+    constexpr int PHASE_WEIGHTS[7] = { 0, 0, 1, 1, 2, 4, 0 };
+    constexpr int MAX_PHASE = 24;
+
+    // Piece-square tables from White's point of view, rank 8 first (as printed)
+    using Table = int[SQUARE_COUNT];
+
+    constexpr Table PAWN_TABLE = {
+         0,  0,  0,  0,  0,  0,  0,  0,
+        50, 50, 50, 50, 50, 50, 50, 50,
+        10, 10, 20, 30, 30, 20, 10, 10,
+         5,  5, 10, 25, 25, 10,  5,  5,
+         0,  0,  0, 20, 20,  0,  0,  0,
+         5, -5,-10,  0,  0,-10, -5,  5,
+         5, 10, 10,-20,-20, 10, 10,  5,
+         0,  0,  0,  0,  0,  0,  0,  0
+    };
+
+    constexpr Table KNIGHT_TABLE = {
+        -50,-40,-30,-30,-30,-30,-40,-50,
+        -40,-20,  0,  0,  0,  0,-20,-40,
+        -30,  0, 10, 15, 15, 10,  0,-30,
+        -30,  5, 15, 20, 20, 15,  5,-30,
+        -30,  0, 15, 20, 20, 15,  0,-30,
+        -30,  5, 10, 15, 15, 10,  5,-30,
+        -40,-20,  0,  5,  5,  0,-20,-40,
+        -50,-40,-30,-30,-30,-30,-40,-50
+    };
+
+    constexpr Table BISHOP_TABLE = {
+        -20,-10,-10,-10,-10,-10,-10,-20,
+        -10,  0,  0,  0,  0,  0,  0,-10,
+        -10,  0,  5, 10, 10,  5,  0,-10,
+        -10,  5,  5, 10, 10,  5,  5,-10,
+        -10,  0, 10, 10, 10, 10,  0,-10,
+        -10, 10, 10, 10, 10, 10, 10,-10,
+        -10,  5,  0,  0,  0,  0,  5,-10,
+        -20,-10,-10,-10,-10,-10,-10,-20
+    };
+
+    constexpr Table ROOK_TABLE = {
+         0,  0,  0,  0,  0,  0,  0,  0,
+         5, 10, 10, 10, 10, 10, 10,  5,
+        -5,  0,  0,  0,  0,  0,  0, -5,
+        -5,  0,  0,  0,  0,  0,  0, -5,
+        -5,  0,  0,  0,  0,  0,  0, -5,
+        -5,  0,  0,  0,  0,  0,  0, -5,
+        -5,  0,  0,  0,  0,  0,  0, -5,
+         0,  0,  0,  5,  5,  0,  0,  0
+    };
+
+    constexpr Table QUEEN_TABLE = {
+        -20,-10,-10, -5, -5,-10,-10,-20,
+        -10,  0,  0,  0,  0,  0,  0,-10,
+        -10,  0,  5,  5,  5,  5,  0,-10,
+         -5,  0,  5,  5,  5,  5,  0, -5,
+          0,  0,  5,  5,  5,  5,  0, -5,
+        -10,  5,  5,  5,  5,  5,  0,-10,
+        -10,  0,  5,  0,  0,  0,  0,-10,
+        -20,-10,-10, -5, -5,-10,-10,-20
+    };
+
+    constexpr Table KING_MIDDLEGAME_TABLE = {
+        -30,-40,-40,-50,-50,-40,-40,-30,
+        -30,-40,-40,-50,-50,-40,-40,-30,
+        -30,-40,-40,-50,-50,-40,-40,-30,
+        -30,-40,-40,-50,-50,-40,-40,-30,
+        -20,-30,-30,-40,-40,-30,-30,-20,
+        -10,-20,-20,-20,-20,-20,-20,-10,
+         20, 20,  0,  0,  0,  0, 20, 20,
+         20, 30, 10,  0,  0, 10, 30, 20
+    };
+
+    constexpr Table KING_ENDGAME_TABLE = {
+        -50,-40,-30,-20,-20,-30,-40,-50,
+        -30,-20,-10,  0,  0,-10,-20,-30,
+        -30,-10, 20, 30, 30, 20,-10,-30,
+        -30,-10, 30, 40, 40, 30,-10,-30,
+        -30,-10, 30, 40, 40, 30,-10,-30,
+        -30,-10, 20, 30, 30, 20,-10,-30,
+        -30,-30,  0,  0,  0,  0,-30,-30,
+        -50,-30,-30,-30,-30,-30,-30,-50
+    };
+
+    constexpr const int* PIECE_TABLES[7] = {
+        nullptr, PAWN_TABLE, KNIGHT_TABLE, BISHOP_TABLE, ROOK_TABLE, QUEEN_TABLE, nullptr
+    };
+
+    // Table index of a square for the given color (tables are printed rank 8 first)
+    int tableIndex(const PieceColor color, const Square square) {
+        const int rank =
+            (color == PieceColor::White) ?
+            7 - rankOf(square) :
+            rankOf(square);
+        return rank * 8 + fileOf(square);
+    }
+}
+
+int Evaluation::getPieceValue(const PieceType type) {
+    return PIECE_VALUES[static_cast<uint8_t>(type)];
+}
+
+int Evaluation::evaluate(const Position& position) {
+    int score[2] = { 0, 0 };
+    int phase = 0;
+
+    for (const PieceColor color : { PieceColor::White, PieceColor::Black }) {
+        int& sideScore = score[static_cast<uint8_t>(color)];
+        for (PieceType type = PieceType::Pawn; type <= PieceType::Queen; type = static_cast<PieceType>(static_cast<uint8_t>(type) + 1)) {
+            const int typeIndex = static_cast<uint8_t>(type);
+            Bitboard pieces = position.getPieces(color, type);
+            while (pieces) {
+                const Square square = popLsb(pieces);
+                sideScore += PIECE_VALUES[typeIndex] + PIECE_TABLES[typeIndex][tableIndex(color, square)];
+                phase += PHASE_WEIGHTS[typeIndex];
+            }
+        }
+        if (popCount(position.getPieces(color, PieceType::Bishop)) >= 2)
+            sideScore += BISHOP_PAIR_BONUS;
+    }
+
+    // King placement blends towards the endgame table as material comes off
+    phase = std::min(phase, MAX_PHASE);
+    for (const PieceColor color : { PieceColor::White, PieceColor::Black }) {
+        const int index = tableIndex(color, position.getKingSquare(color));
+        score[static_cast<uint8_t>(color)] +=
+            (KING_MIDDLEGAME_TABLE[index] * phase + KING_ENDGAME_TABLE[index] * (MAX_PHASE - phase)) / MAX_PHASE;
+    }
+
+    const int us = static_cast<uint8_t>(position.getSideToMove());
+    return score[us] - score[us ^ 1] + TEMPO_BONUS;
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+#include "../core/position.h"
+
+/**
+ * Static evaluation of the native search
+ *
+ * Key features:
+ * - Material plus piece-square tables; the king table is blended from a
+ *   middlegame to an endgame table by the remaining non-pawn material
+ * - Small bishop pair bonus and tempo for the side to move
+ * - Scores in centipawns from the side to move's point of view
+ */
+class Evaluation {
+public:
+    static int evaluate(const Position& position);
+
+    // Material value in centipawns (king 0), also used for capture ordering
+    static int getPieceValue(const PieceType type);
+};
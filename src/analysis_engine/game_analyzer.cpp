@@ -0,0 +1,176 @@
+#include "game_analyzer.h"
+#include "../config/config.h"
+#include "../core/threat_scanner.h"
+#include <algorithm>
+
+namespace ReviewCfg = Config::Review;
+
+GameAnalyzer::GameAnalyzer()
+    : version_(0)
+{}
+
+void GameAnalyzer::start(AnalysisEngine& engine, const std::string& rootFen, const std::vector<std::string>& moves, const std::vector<PositionKey>& keys) {
+    if (keys.size() != moves.size() + 1)
+        return;
+
+    // Side to move of the first position; it alternates from there
+    const size_t sidePos = rootFen.find(' ');
+    const char rootSide =
+        (sidePos != std::string::npos && sidePos + 1 < rootFen.size()) ?
+        rootFen[sidePos + 1] :
+        'w';
+
+    // Engine-free pre-filter: only tactical positions get the full budget
+    const std::vector<bool> isTactical = scanTactics(rootFen, moves);
+
+    uint64_t generation;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        generation = ++generation_;
+        evaluations_.assign(keys.size(), PlyEvaluation{});
+        for (size_t ply = 0; ply < keys.size(); ply++) {
+            PlyEvaluation& evaluation = evaluations_[ply];
+            evaluation.key = keys[ply];
+            evaluation.sideToMove =
+                (ply % 2 == 0) ?
+                rootSide :
+                (rootSide == 'w' ? 'b' : 'w');
+            if (ply < moves.size())
+                evaluation.playedMove = moves[ply];
+            evaluation.isTactical = isTactical[ply];
+        }
+        remaining_ = static_cast<int>(keys.size());
+    }
+    version_.fetch_add(1, std::memory_order_release);
+
+    // Last position first: each search reuses the hash entries of the one before
+    for (size_t ply = keys.size(); ply-- > 0;) {
+        SearchLimits limits;
+        limits.movetimeMs =
+            isTactical[ply] ?
+            ReviewCfg::SEARCH_MOVETIME_MS :
+            ReviewCfg::QUIET_SEARCH_MOVETIME_MS;
+        const std::vector<std::string> prefix(moves.begin(), moves.begin() + ply);
+        engine.requestSearch(rootFen, prefix, keys[ply], limits,
+            [this, generation, ply](const SearchResult& result) {
+                onSearchComplete(generation, ply, result);
+            });
+    }
+}
+
+std::vector<bool> GameAnalyzer::scanTactics(const std::string& rootFen, const std::vector<std::string>& moves) {
+    // Positions that cannot be replayed keep the full budget
+    std::vector<bool> isTactical(moves.size() + 1, true);
+    Position position;
+    if (!position.setFromFEN(rootFen))
+        return isTactical;
+
+    ThreatReport report;
+    for (size_t ply = 0; ply < isTactical.size(); ply++) {
+        ThreatScanner::scan(position, report);
+        isTactical[ply] = report.isTactical();
+        if (ply == moves.size())
+            break;
+
+        const ChessMove move = position.findLegalMove(ChessMove::fromUCI(moves[ply]));
+        if (move.isNull())
+            break;
+        PositionUndo undo;
+        position.makeMove(move, undo);
+    }
+    return isTactical;
+}
+
+void GameAnalyzer::clear() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ++generation_;
+        evaluations_.clear();
+        remaining_ = 0;
+    }
+    version_.fetch_add(1, std::memory_order_release);
+}
+
+bool GameAnalyzer::isRunning() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return remaining_ > 0;
+}
+
+int GameAnalyzer::getCompletedCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return static_cast<int>(evaluations_.size()) - remaining_;
+}
+
+std::vector<PlyEvaluation> GameAnalyzer::getEvaluations() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return evaluations_;
+}
+
+int GameAnalyzer::getCappedScore(const PlyEvaluation& evaluation) {
+    return std::clamp(evaluation.scoreCp, -ReviewCfg::EVAL_CAP_CP, ReviewCfg::EVAL_CAP_CP);
+}
+
+void GameAnalyzer::onSearchComplete(uint64_t generation, size_t ply, const SearchResult& result) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (generation != generation_ || ply >= evaluations_.size())
+            return; // Review was replaced or cleared
+        remaining_--;
+
+        // Cancelled searches (engine disabled) have no best move
+        auto line = std::find_if(result.analysis.lines.begin(), result.analysis.lines.end(),
+            [](const AnalysisLine& candidate) { return candidate.multipv == 1; });
+        if (result.bestMove.empty() || line == result.analysis.lines.end() || !line->hasScore)
+            return;
+
+        // Engine scores are from the side to move's point of view
+        PlyEvaluation& evaluation = evaluations_[ply];
+        int score = line->scoreCp;
+        if (line->isMate)
+            score =
+                (line->mateIn > 0) ?
+                ReviewCfg::MATE_SCORE_CP - line->mateIn :
+                -ReviewCfg::MATE_SCORE_CP - line->mateIn; // mate 0: side to move is mated
+        const int sign =
+            (evaluation.sideToMove == 'w') ?
+            1 :
+            -1;
+        evaluation.scoreCp = sign * score;
+        evaluation.isMate = line->isMate;
+        evaluation.mateIn = sign * line->mateIn;
+        evaluation.bestMove = result.bestMove;
+        evaluation.isAnalyzed = true;
+
+        // The move into this position and the move out of it can now be judged
+        if (ply > 0)
+            classify(ply - 1);
+        classify(ply);
+    }
+    version_.fetch_add(1, std::memory_order_release);
+}
+
+void GameAnalyzer::classify(size_t ply) {
+    if (ply + 1 >= evaluations_.size())
+        return;
+    PlyEvaluation& before = evaluations_[ply];
+    const PlyEvaluation& after = evaluations_[ply + 1];
+    if (!before.isAnalyzed || !after.isAnalyzed)
+        return;
+
+    // Loss from the mover's point of view; capped scores ignore swings in already decided positions
+    const int sign =
+        (before.sideToMove == 'w') ?
+        1 :
+        -1;
+    before.scoreLoss = std::max(0, sign * (getCappedScore(before) - getCappedScore(after)));
+
+    // Playing the engine's choice is never a mistake, whatever a short search thinks
+    if (before.playedMove == before.bestMove || before.scoreLoss < ReviewCfg::INACCURACY_CP)
+        before.classification = MoveClassification::Good;
+    else if (before.scoreLoss < ReviewCfg::MISTAKE_CP)
+        before.classification = MoveClassification::Inaccuracy;
+    else if (before.scoreLoss < ReviewCfg::BLUNDER_CP)
+        before.classification = MoveClassification::Mistake;
+    else
+        before.classification = MoveClassification::Blunder;
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "analysis_engine.h"
+
+enum class MoveClassification {
+    None,           // Not classified (yet)
+    Good,
+    Inaccuracy,
+    Mistake,
+    Blunder
+};
+
+// Review result for one position of the line (index = plies from the first position)
+struct PlyEvaluation {
+    PositionKey key;                // Position the evaluation belongs to
+    bool isAnalyzed = false;
+    char sideToMove = 'w';
+    int scoreCp = 0;                // White's point of view; mates map to +/-(MATE_SCORE_CP - moves)
+    bool isMate = false;
+    int mateIn = 0;                 // White's point of view (negative: Black mates)
+    std::string bestMove;           // Engine choice in this position (UCI notation)
+    std::string playedMove;         // Move played from this position (empty for the last one)
+    int scoreLoss = 0;              // Centipawns playedMove lost, from the mover's point of view
+    bool isTactical = true;         // Check, material en prise or a winning capture (ThreatScanner)
+    MoveClassification classification = MoveClassification::None; // Of playedMove
+};
+
+/**
+ * Whole-game review on an analysis engine (UCI or native)
+ *
+ * Key features:
+ * - Every position of a line gets a fixed-budget bounded search; positions
+ *   the threat scanner finds quiet get a smaller budget than tactical ones
+ * - Positions are queued last to first: the engine never sends ucinewgame
+ *   between them, so each search starts from a hash table already holding
+ *   the continuation it just analyzed
+ * - Results arrive on the engine thread; classification runs as soon as
+ *   both neighbours of a move are known
+ * - Version counter lets the GUI notice new results without copying them
+ */
+class GameAnalyzer {
+public:
+    GameAnalyzer();
+
+    /**
+     * Queue the review of a line (replaces any previous review)
+     *
+     * @param engine Engine to search on (must outlive this analyzer's pending searches)
+     * @param rootFen FEN of the first position
+     * @param moves Moves of the line (UCI notation)
+     * @param keys Identity of every position (moves.size() + 1 entries)
+     */
+    void start(AnalysisEngine& engine, const std::string& rootFen, const std::vector<std::string>& moves, const std::vector<PositionKey>& keys);
+
+    // Forget the review; results of searches still in flight are ignored
+    void clear();
+
+    bool isRunning() const;
+    int getCompletedCount() const;
+    std::vector<PlyEvaluation> getEvaluations() const;
+
+    // Bumped whenever a result arrives or the review is replaced
+    uint64_t getVersion() const { return version_.load(std::memory_order_acquire); }
+
+    // Score from White's point of view, clamped to the eval cap (for graphs and losses)
+    static int getCappedScore(const PlyEvaluation& evaluation);
+
+private:
+    mutable std::mutex mutex_;
+    std::vector<PlyEvaluation> evaluations_;    // Protected by mutex_
+    int remaining_ = 0;                         // Searches not answered yet (protected by mutex_)
+    uint64_t generation_ = 0;                   // Identifies the current review (protected by mutex_)
+    std::atomic<uint64_t> version_;
+
+    void onSearchComplete(uint64_t generation, size_t ply, const SearchResult& result);
+    static std::vector<bool> scanTactics(const std::string& rootFen, const std::vector<std::string>& moves);
+    void classify(size_t ply); // Caller holds mutex_
+};
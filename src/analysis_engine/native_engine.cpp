@@ -0,0 +1,421 @@
+#include "native_engine.h"
+#include "../profiling/profiler.h"
+#include <algorithm>
+
+// Budget used when a bounded search is requested without any limit
+static constexpr int DEFAULT_SEARCH_MOVETIME_MS = 1000;
+
+// Lines kept per snapshot (as many as EngineComp shows)
+static constexpr size_t MAX_ANALYSIS_LINES = 4;
+
+NativeEngine::NativeEngine()
+    : state_(EngineState::Disconnected)
+    , enabled_(false)
+    , analysisVersion_(0)
+    , stopRequested_(false)
+    , search_(table_)
+    , settings_(EngineSettings::fromConfig())
+{}
+
+NativeEngine::~NativeEngine() {
+    if (enabled_)
+        disable();
+}
+
+void NativeEngine::enable() {
+    if (enabled_)
+        return; // Already enabled
+
+    // A fresh start has no position yet; the hash is allocated by the search thread
+    {
+        std::lock_guard<std::mutex> lock(analysisMutex_);
+        hasRequestedPosition_ = false;
+        hasCurrentPosition_ = false;
+        isInteractiveRunning_ = false;
+        currentAnalysis_ = EngineAnalysis();
+    }
+    stopRequested_ = false;
+    enabled_ = true;
+    setState(EngineState::Ready);
+
+    searchThread_ = std::make_unique<std::thread>(&NativeEngine::searchThreadFunction, this);
+}
+
+void NativeEngine::disable() {
+    if (!enabled_)
+        return; // Already disabled
+
+    {
+        std::lock_guard<std::mutex> lock(analysisMutex_);
+        enabled_ = false;
+        stopRequested_ = true;
+    }
+    wakeUp_.notify_all();
+
+    // The running search notices the stop flag within NODE_CHECK_INTERVAL nodes
+    if (searchThread_ && searchThread_->joinable())
+        searchThread_->join();
+    searchThread_ = nullptr;
+
+    // Nobody will answer outstanding searches now
+    clearPendingSearches();
+    setState(EngineState::Disconnected);
+}
+
+bool NativeEngine::isEnabled() const {
+    return enabled_;
+}
+
+void NativeEngine::configure(const EngineSettings& settings) {
+    {
+        std::lock_guard<std::mutex> lock(analysisMutex_);
+        settings_ = settings;
+        hasCurrentPosition_ = false; // Restart analysis with the new settings
+        interruptInteractiveSearch();
+    }
+    wakeUp_.notify_all();
+}
+
+EngineSettings NativeEngine::getSettings() const {
+    std::lock_guard<std::mutex> lock(analysisMutex_);
+    return settings_;
+}
+
+uint64_t NativeEngine::getAnalysisVersion() const {
+    return analysisVersion_.load(std::memory_order_acquire);
+}
+
+void NativeEngine::setState(EngineState state) {
+    state_ = state;
+    analysisVersion_.fetch_add(1, std::memory_order_release);
+}
+
+void NativeEngine::clearAnalysis() {
+    if (!enabled_)
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(analysisMutex_);
+        interruptInteractiveSearch();
+        currentAnalysis_ = EngineAnalysis();
+        currentAnalysis_.state = state_.load();
+        hasCurrentPosition_ = false; // Restart analysis of the requested position
+    }
+    analysisVersion_.fetch_add(1, std::memory_order_release);
+    wakeUp_.notify_all();
+}
+
+void NativeEngine::setPosition(const std::string& startFen, const std::vector<std::string>& moves, const PositionKey& key) {
+    if (!enabled_)
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(analysisMutex_);
+        if (hasRequestedPosition_ && requestedKey_ == key)
+            return;
+        requestedStartFen_ = startFen;
+        requestedMoves_ = moves;
+        requestedKey_ = key;
+        hasRequestedPosition_ = true;
+        interruptInteractiveSearch();
+    }
+    wakeUp_.notify_all();
+}
+
+bool NativeEngine::isPositionRequested(const PositionKey& key) const {
+    std::lock_guard<std::mutex> lock(analysisMutex_);
+    return hasRequestedPosition_ && requestedKey_ == key;
+}
+
+std::future<SearchResult> NativeEngine::requestSearch(
+    const std::string& startFen,
+    const std::vector<std::string>& moves,
+    const PositionKey& key,
+    const SearchLimits& limits,
+    SearchCallback onComplete) {
+
+    PendingSearch search;
+    search.startFen = startFen;
+    search.moves = moves;
+    search.key = key;
+    search.limits = limits;
+    search.onComplete = std::move(onComplete);
+    if (!search.limits.isBounded())
+        search.limits.movetimeMs = DEFAULT_SEARCH_MOVETIME_MS;
+
+    std::future<SearchResult> future = search.promise.get_future();
+
+    // Queued searches take priority over interactive analysis; enabled_ is
+    // checked under the lock disable() clears it with, so none is left unanswered
+    {
+        std::lock_guard<std::mutex> lock(analysisMutex_);
+        if (enabled_) {
+            pendingSearches_.push_back(std::move(search));
+            interruptInteractiveSearch();
+            wakeUp_.notify_all();
+            return future;
+        }
+    }
+
+    // Without a running engine the search is answered (empty) immediately
+    answerEmpty(search);
+    return future;
+}
+
+void NativeEngine::clearPendingSearches() {
+    std::deque<PendingSearch> cancelled;
+    {
+        std::lock_guard<std::mutex> lock(analysisMutex_);
+        cancelled.swap(pendingSearches_);
+    }
+
+    // Answer with an empty best move so waiting callers never hang
+    for (auto& search : cancelled)
+        answerEmpty(search);
+}
+
+EngineAnalysis NativeEngine::pollAnalysis() {
+    PROFILE_SCOPE("NativeEngine::pollAnalysis");
+    EngineAnalysis result;
+    result.state = state_;
+    result.version = getAnalysisVersion();
+
+    {
+        std::lock_guard<std::mutex> lock(analysisMutex_);
+        result.fen = currentAnalysis_.fen;
+        result.rawInfo = currentAnalysis_.rawInfo;
+        result.hasResult = currentAnalysis_.hasResult;
+        result.lines = currentAnalysis_.lines;
+        result.key = currentKey_;
+        result.depth = currentAnalysis_.depth;
+    }
+    return result;
+}
+
+bool NativeEngine::hasWork() const {
+    return
+        !enabled_ ||
+        !pendingSearches_.empty() ||
+        (hasRequestedPosition_ && !(hasCurrentPosition_ && requestedKey_ == currentKey_));
+}
+
+void NativeEngine::interruptInteractiveSearch() {
+    // Bounded searches always run to their limits
+    if (isInteractiveRunning_)
+        stopRequested_ = true;
+}
+
+void NativeEngine::searchThreadFunction() {
+    PROFILE_THREAD("Native Search");
+
+    while (true) {
+        std::unique_ptr<PendingSearch> boundedSearch;
+        std::string startFen;
+        std::vector<std::string> moves;
+        int multiPV = 1;
+        int hashMb = 0;
+        int threads = 1;
+        {
+            std::unique_lock<std::mutex> lock(analysisMutex_);
+            wakeUp_.wait(lock, [this]() { return hasWork(); });
+            if (!enabled_)
+                break;
+
+            // Requests arriving from here on interrupt the search picked below
+            stopRequested_ = false;
+            multiPV = settings_.multiPV;
+            hashMb = settings_.hashMb;
+            threads = settings_.threads;
+            if (!pendingSearches_.empty()) {
+                boundedSearch = std::make_unique<PendingSearch>(std::move(pendingSearches_.front()));
+                pendingSearches_.pop_front();
+                startFen = boundedSearch->startFen;
+                currentKey_ = boundedSearch->key;
+                hasCurrentPosition_ = false; // Interactive analysis resumes once the queue drains
+                isInteractiveRunning_ = false;
+            } else {
+                startFen = requestedStartFen_;
+                moves = requestedMoves_;
+                currentKey_ = requestedKey_;
+                hasCurrentPosition_ = true;
+                isInteractiveRunning_ = true;
+            }
+            currentAnalysis_ = EngineAnalysis();
+            currentAnalysis_.fen = startFen;
+        }
+
+        if (hashMb != allocatedHashMb_) {
+            table_.resize(hashMb);
+            allocatedHashMb_ = hashMb;
+        }
+        search_.setThreadCount(threads);
+
+        setState(EngineState::Analyzing);
+        if (boundedSearch)
+            runBoundedSearch(*boundedSearch, multiPV);
+        else
+            runInteractiveSearch(startFen, moves, multiPV);
+
+        {
+            std::lock_guard<std::mutex> lock(analysisMutex_);
+            isInteractiveRunning_ = false;
+        }
+        if (enabled_)
+            setState(EngineState::Ready);
+    }
+}
+
+void NativeEngine::runInteractiveSearch(const std::string& startFen, const std::vector<std::string>& moves, const int multiPV) {
+    PROFILE_SCOPE("NativeEngine::runInteractiveSearch");
+
+    Position position;
+    std::vector<uint64_t> history;
+    if (!setupPosition(startFen, moves, position, history)) {
+        std::lock_guard<std::mutex> lock(analysisMutex_);
+        currentAnalysis_.rawInfo = "Invalid position";
+        analysisVersion_.fetch_add(1, std::memory_order_release);
+        return;
+    }
+
+    // Unbounded: runs to MAX_DEPTH (or a proven mate) unless interrupted
+    const NativeSearchIteration iteration = search_.run(position, history, SearchLimits{}, multiPV, stopRequested_,
+        [this](const NativeSearchIteration& update) { publishIteration(update); });
+    if (iteration.lines.empty() && !stopRequested_)
+        publishNoLegalMoves(position);
+}
+
+void NativeEngine::runBoundedSearch(PendingSearch& search, const int multiPV) {
+    PROFILE_SCOPE("NativeEngine::runBoundedSearch");
+
+    SearchResult result;
+    result.key = search.key;
+
+    Position position;
+    std::vector<uint64_t> history;
+    if (setupPosition(search.startFen, search.moves, position, history)) {
+        const NativeSearchIteration iteration = search_.run(position, history, search.limits, multiPV, stopRequested_,
+            [this](const NativeSearchIteration& update) { publishIteration(update); });
+
+        // Disabled while searching: answered empty like every other outstanding search
+        if (!enabled_) {
+            answerEmpty(search);
+            return;
+        }
+
+        if (!iteration.lines.empty()) {
+            const std::vector<ChessMove>& pv = iteration.lines.front().pv;
+            result.bestMove = pv.front().toAlgebraicNotation();
+            if (pv.size() > 1)
+                result.ponderMove = pv[1].toAlgebraicNotation();
+        } else {
+            // Mated or stalemated ("(none)" as UCI engines report it), unless a limit hit before depth 1
+            MoveList legalMoves;
+            position.generateLegalMoves(legalMoves);
+            if (legalMoves.isEmpty())
+                publishNoLegalMoves(position);
+            result.bestMove =
+                legalMoves.isEmpty() ?
+                "(none)" :
+                legalMoves[0].toAlgebraicNotation();
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(analysisMutex_);
+        currentAnalysis_.rawInfo = "bestmove " + result.bestMove;
+        if (!result.ponderMove.empty())
+            currentAnalysis_.rawInfo += " ponder " + result.ponderMove;
+        result.analysis = currentAnalysis_;
+        result.analysis.key = result.key;
+    }
+    result.analysis.state = EngineState::Ready;
+    result.analysis.version = getAnalysisVersion();
+
+    if (search.onComplete)
+        search.onComplete(result);
+    search.promise.set_value(std::move(result));
+}
+
+bool NativeEngine::setupPosition(
+    const std::string& startFen, const std::vector<std::string>& moves,
+    Position& position, std::vector<uint64_t>& history) {
+
+    // An empty FEN means the standard starting position (as for UCIEngine)
+    if (startFen.empty())
+        position.setStartingPosition();
+    else if (!position.setFromFEN(startFen))
+        return false;
+
+    // UCI moves carry no castling/en passant flag; matching legal moves supplies it
+    history.clear();
+    history.reserve(moves.size());
+    for (const std::string& text : moves) {
+        const ChessMove move = position.findLegalMove(ChessMove::fromUCI(text));
+        if (move.isNull())
+            return false;
+        history.push_back(position.getKey());
+        PositionUndo undo;
+        position.makeMove(move, undo);
+    }
+    return true;
+}
+
+void NativeEngine::publishIteration(const NativeSearchIteration& iteration) {
+    // Parse outside the lock
+    std::vector<AnalysisLine> lines;
+    std::string rawInfo;
+    for (size_t i = 0; i < iteration.lines.size() && i < MAX_ANALYSIS_LINES; i++) {
+        rawInfo = formatInfoLine(iteration, iteration.lines[i], static_cast<int>(i) + 1);
+        lines.push_back(UCIAnalysisParser::parseAnalysisLine(rawInfo));
+    }
+
+    std::lock_guard<std::mutex> lock(analysisMutex_);
+    currentAnalysis_.lines = std::move(lines);
+    currentAnalysis_.rawInfo = std::move(rawInfo);
+    currentAnalysis_.hasResult = true;
+    currentAnalysis_.depth = iteration.depth;
+    analysisVersion_.fetch_add(1, std::memory_order_release);
+}
+
+void NativeEngine::publishNoLegalMoves(const Position& position) {
+    // Checkmate scores "mate 0", stalemate a draw
+    const std::string rawInfo =
+        position.isInCheck() ?
+        "info depth 0 score mate 0" :
+        "info depth 0 score cp 0";
+
+    std::lock_guard<std::mutex> lock(analysisMutex_);
+    currentAnalysis_.lines = { UCIAnalysisParser::parseAnalysisLine(rawInfo) };
+    currentAnalysis_.rawInfo = rawInfo;
+    currentAnalysis_.hasResult = true;
+    currentAnalysis_.depth = 0;
+    analysisVersion_.fetch_add(1, std::memory_order_release);
+}
+
+std::string NativeEngine::formatInfoLine(const NativeSearchIteration& iteration, const NativeSearchLine& line, const int multipv) {
+    // "info depth 12 seldepth 18 multipv 1 score cp 35 nodes ... nps ... hashfull ... time ... pv e2e4 ..."
+    const uint64_t nps = iteration.nodes * 1000 / static_cast<uint64_t>(std::max<int64_t>(iteration.elapsedMs, 1));
+    std::string info = "info depth " + std::to_string(iteration.depth);
+    info += " seldepth " + std::to_string(iteration.selectiveDepth);
+    info += " multipv " + std::to_string(multipv);
+    info +=
+        NativeSearch::isMateScore(line.score) ?
+        " score mate " + std::to_string(NativeSearch::toMateMoves(line.score)) :
+        " score cp " + std::to_string(line.score);
+    info += " nodes " + std::to_string(iteration.nodes);
+    info += " nps " + std::to_string(nps);
+    info += " hashfull " + std::to_string(iteration.hashfull);
+    info += " time " + std::to_string(iteration.elapsedMs);
+    info += " pv";
+    for (const ChessMove& move : line.pv)
+        info += " " + move.toAlgebraicNotation();
+    return info;
+}
+
+void NativeEngine::answerEmpty(PendingSearch& search) {
+    SearchResult result;
+    result.key = search.key;
+    if (search.onComplete)
+        search.onComplete(result);
+    search.promise.set_value(std::move(result));
+}
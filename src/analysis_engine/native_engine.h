@@ -0,0 +1,115 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "analysis_engine.h"
+#include "native_search_group.h"
+#include "transposition_table.h"
+
+/**
+ * In-process analysis engine (AnalysisEngine backed by NativeSearch)
+ *
+ * Key features:
+ * - Same polling interface and semantics as UCIEngine: interactive analysis
+ *   of the requested position, bounded searches queued ahead of it
+ * - One controlling search thread (the Lazy-SMP main thread, helpers per
+ *   the Threads setting); it sleeps on a condition variable while idle and a
+ *   stop flag interrupts the running search within a few microseconds
+ * - Each completed iteration is published as UCI-style info lines and parsed
+ *   with UCIAnalysisParser, so EngineComp shows both backends identically
+ * - Starts instantly and needs no engine executable or process rights
+ * - The transposition table is kept between positions (cleared on resize)
+ */
+class NativeEngine : public AnalysisEngine {
+public:
+    NativeEngine();
+    ~NativeEngine() override;
+
+    // Non-copyable
+    NativeEngine(const NativeEngine&) = delete;
+    NativeEngine& operator=(const NativeEngine&) = delete;
+
+    // AnalysisEngine
+    void setPosition(const std::string& startFen, const std::vector<std::string>& moves, const PositionKey& key) override;
+    bool isPositionRequested(const PositionKey& key) const override;
+    void clearPendingSearches() override;
+    std::future<SearchResult> requestSearch(
+        const std::string& startFen,
+        const std::vector<std::string>& moves,
+        const PositionKey& key,
+        const SearchLimits& limits,
+        SearchCallback onComplete = nullptr) override;
+    EngineAnalysis pollAnalysis() override;
+    uint64_t getAnalysisVersion() const override;
+    void enable() override;                 // Allocates the hash and starts the search thread
+    void disable() override;                // Stops the search and joins the thread
+    bool isEnabled() const override;
+    void configure(const EngineSettings& settings) override; // EvalFile is ignored
+    EngineSettings getSettings() const override;
+    void clearAnalysis() override;
+
+private:
+    struct PendingSearch {
+        std::string startFen;
+        std::vector<std::string> moves;
+        PositionKey key;
+        SearchLimits limits;
+        SearchCallback onComplete;
+        std::promise<SearchResult> promise;
+    };
+
+    // Engine state
+    std::atomic<EngineState> state_;
+    std::atomic<bool> enabled_;
+    std::atomic<uint64_t> analysisVersion_;
+    std::atomic<bool> stopRequested_;       // Interrupts the running search
+
+    // Search thread
+    std::unique_ptr<std::thread> searchThread_;
+    mutable std::mutex analysisMutex_;
+    std::condition_variable wakeUp_;        // Signalled on any new request
+    EngineAnalysis currentAnalysis_;
+    TranspositionTable table_;              // Search thread only (and enable())
+    NativeSearchGroup search_;              // Search thread only
+
+    // Position tracking - protected by analysisMutex_
+    std::string requestedStartFen_;
+    std::vector<std::string> requestedMoves_;
+    PositionKey requestedKey_;
+    PositionKey currentKey_;                // Position of the running (or last) search
+    bool hasRequestedPosition_ = false;
+    bool hasCurrentPosition_ = false;       // Interactive analysis of currentKey_ started
+    bool isInteractiveRunning_ = false;     // The running search may be interrupted for new work
+
+    // Settings and bounded searches - protected by analysisMutex_
+    EngineSettings settings_;
+    int allocatedHashMb_ = 0;               // Search thread only
+    std::deque<PendingSearch> pendingSearches_;
+
+    // State transitions (bumps the snapshot version)
+    void setState(EngineState state);
+
+    // Search thread
+    void searchThreadFunction();
+    bool hasWork() const;                   // Caller holds analysisMutex_
+    void runInteractiveSearch(const std::string& startFen, const std::vector<std::string>& moves, int multiPV);
+    void runBoundedSearch(PendingSearch& search, int multiPV);
+    void interruptInteractiveSearch();      // Caller holds analysisMutex_
+
+    // Position setup and output
+    static bool setupPosition(
+        const std::string& startFen, const std::vector<std::string>& moves,
+        Position& position, std::vector<uint64_t>& history);
+    void publishIteration(const NativeSearchIteration& iteration);
+    void publishNoLegalMoves(const Position& position);
+    static std::string formatInfoLine(const NativeSearchIteration& iteration, const NativeSearchLine& line, int multipv);
+    static void answerEmpty(PendingSearch& search);
+};
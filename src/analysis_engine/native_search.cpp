@@ -0,0 +1,496 @@
+#include "native_search.h"
+#include "evaluation.h"
+#include "../core/static_exchange.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+namespace NativeCfg = Config::NativeEngine;
+
+namespace {
+    // Move ordering tiers (history scores stay below KILLER_SCORE)
+    constexpr int TT_MOVE_SCORE = 1 << 30;
+    constexpr int CAPTURE_SCORE = 1 << 24;
+    constexpr int QUEEN_PROMOTION_SCORE = 1 << 23;
+    constexpr int KILLER_SCORE = 1 << 22;
+    constexpr int HISTORY_LIMIT = 1 << 20;
+    constexpr int LOSING_CAPTURE_SCORE = -(1 << 21);    // Below every quiet move
+
+    // Helper threads skip blocks of depths, each with its own size and phase,
+    // so the group spreads over neighbouring depths instead of duplicating work
+    constexpr int SKIP_PATTERNS = 20;
+    constexpr int SKIP_SIZE[SKIP_PATTERNS] = { 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 3, 3, 4, 4, 4, 4, 4, 4, 4, 4 };
+    constexpr int SKIP_PHASE[SKIP_PATTERNS] = { 0, 1, 0, 1, 2, 3, 0, 1, 2, 3, 4, 5, 0, 1, 2, 3, 4, 5, 6, 7 };
+}
+
+NativeSearch::NativeSearch(TranspositionTable& table, const int threadIndex) :
+    table_(table),
+    threadIndex_(threadIndex),
+    pvTable_(NativeCfg::MAX_PLY, std::vector<ChessMove>(NativeCfg::MAX_PLY)),
+    pvLength_(NativeCfg::MAX_PLY, 0),
+    killers_(NativeCfg::MAX_PLY) {
+
+    std::memset(history_, 0, sizeof(history_));
+}
+
+NativeSearchIteration NativeSearch::run(
+    const Position& root,
+    const std::vector<uint64_t>& history,
+    const SearchLimits& limits,
+    const int multiPV,
+    const std::atomic<bool>& stop,
+    std::atomic<uint64_t>& sharedNodes,
+    const IterationCallback& onIteration) {
+
+    const bool isMainThread = (threadIndex_ == 0);
+    position_ = root;
+    keyStack_ = history;
+    keyStack_.push_back(root.getKey());
+    stop_ = &stop;
+    sharedNodes_ = &sharedNodes;
+    startTime_ = std::chrono::steady_clock::now();
+    movetimeMs_ = limits.movetimeMs;
+    nodeLimit_ = limits.nodes;
+    limitsActive_ = false;
+    stopped_ = false;
+    nodes_ = 0;
+    flushedNodes_ = 0;
+
+    std::memset(history_, 0, sizeof(history_));
+    std::fill(killers_.begin(), killers_.end(), std::array<ChessMove, 2>{});
+
+    // searchmoves arrive as UCI strings; unknown or illegal ones are ignored
+    allowedRootMoves_.clear();
+    for (const std::string& text : limits.searchMoves) {
+        const ChessMove move = root.findLegalMove(ChessMove::fromUCI(text));
+        if (!move.isNull())
+            allowedRootMoves_.push_back(move);
+    }
+
+    MoveList legalMoves;
+    root.generateLegalMoves(legalMoves);
+    const int rootMoveCount =
+        allowedRootMoves_.empty() ?
+        legalMoves.size() :
+        static_cast<int>(allowedRootMoves_.size());
+    const int lineCount = std::min(std::max(multiPV, 1), rootMoveCount);
+
+    NativeSearchIteration result;
+    const int maxDepth =
+        (isMainThread && limits.depth > 0) ?
+        std::min(limits.depth, NativeCfg::MAX_DEPTH) :
+        NativeCfg::MAX_DEPTH;
+
+    for (int depth = 1; depth <= maxDepth && lineCount > 0; depth++) {
+        if (isSkippedDepth(depth))
+            continue;
+        NativeSearchIteration iteration;
+        selectiveDepth_ = 0;
+        excludedRootMoves_.clear();
+
+        // Each further line searches the root without the first moves already found
+        for (int line = 0; line < lineCount; line++) {
+            const int score = negamax(depth, 0, -INFINITE_SCORE, INFINITE_SCORE, false);
+            if (stopped_ || pvLength_[0] == 0)
+                break;
+            NativeSearchLine searchLine;
+            searchLine.score = score;
+            searchLine.pv.assign(pvTable_[0].begin(), pvTable_[0].begin() + pvLength_[0]);
+            excludedRootMoves_.push_back(searchLine.pv.front());
+            iteration.lines.push_back(std::move(searchLine));
+        }
+        if (stopped_)
+            break; // Partial iterations are dropped
+
+        std::stable_sort(iteration.lines.begin(), iteration.lines.end(),
+            [](const NativeSearchLine& a, const NativeSearchLine& b) { return a.score > b.score; });
+        iteration.depth = depth;
+        iteration.selectiveDepth = std::max(selectiveDepth_, depth);
+        flushNodes();
+        iteration.nodes = sharedNodes.load(std::memory_order_relaxed);
+        iteration.elapsedMs = getElapsedMs();
+        iteration.hashfull = table_.getHashfull();
+        result = std::move(iteration);
+        if (onIteration)
+            onIteration(result);
+        limitsActive_ = isMainThread; // Helpers run until the main thread stops them
+
+        // A requested mate was found
+        const int bestScore = result.lines.front().score;
+        if (isMainThread && limits.mate > 0 && bestScore >= MATE_BOUND && toMateMoves(bestScore) <= limits.mate)
+            break;
+
+        // Every line is a mate the search has had room to confirm
+        const bool isSolved = std::all_of(result.lines.begin(), result.lines.end(),
+            [depth](const NativeSearchLine& line) {
+                return isMateScore(line.score) && depth >= 2 * (MATE_SCORE - std::abs(line.score)) + 2;
+            });
+        if (isSolved)
+            break;
+
+        // Out of budget before the next iteration could start
+        if (shouldStop())
+            break;
+    }
+
+    flushNodes();
+    result.nodes = sharedNodes.load(std::memory_order_relaxed);
+    result.elapsedMs = getElapsedMs();
+    return result;
+}
+
+int NativeSearch::toMateMoves(const int score) {
+    return
+        (score > 0) ?
+        (MATE_SCORE - score + 1) / 2 :
+        -(MATE_SCORE + score) / 2;
+}
+
+int NativeSearch::negamax(int depth, const int ply, int alpha, int beta, const bool allowNullMove) {
+    pvLength_[ply] = 0;
+    const bool isRoot = (ply == 0);
+
+    if (!isRoot) {
+        if ((nodes_ & (NativeCfg::NODE_CHECK_INTERVAL - 1)) == 0 && shouldStop())
+            stopped_ = true;
+        if (stopped_)
+            return 0;
+        if (isDraw())
+            return 0;
+
+        // Mate distance pruning: no line from here beats a mate already found closer to the root
+        alpha = std::max(alpha, -MATE_SCORE + ply);
+        beta = std::min(beta, MATE_SCORE - ply - 1);
+        if (alpha >= beta)
+            return alpha;
+    }
+    if (ply >= NativeCfg::MAX_PLY - 1)
+        return Evaluation::evaluate(position_);
+
+    const bool inCheck = position_.isInCheck();
+    if (inCheck)
+        depth++;
+    if (depth <= 0)
+        return quiescence(ply, alpha, beta);
+
+    nodes_++;
+    const bool isPvNode = (beta - alpha > 1);
+    const PieceColor us = position_.getSideToMove();
+
+    // Transposition table: cutoff in non-PV nodes, best move for ordering everywhere
+    TTEntry entry;
+    ChessMove ttMove;
+    if (table_.probe(position_.getKey(), entry)) {
+        ttMove = entry.move;
+        const int ttScore = scoreFromTable(entry.score, ply);
+        if (!isRoot && !isPvNode && entry.depth >= depth &&
+                (entry.bound == ScoreBound::Exact ||
+                (entry.bound == ScoreBound::Lower && ttScore >= beta) ||
+                (entry.bound == ScoreBound::Upper && ttScore <= alpha)))
+            return ttScore;
+    }
+
+    // Null move: if passing still fails high, a real move will too (not with only pawns: zugzwang)
+    const Bitboard nonPawnMaterial =
+        position_.getPieces(us) & ~position_.getPieces(us, PieceType::Pawn) & ~position_.getPieces(us, PieceType::King);
+    if (!isPvNode && !inCheck && allowNullMove && depth >= NativeCfg::NULL_MOVE_MIN_DEPTH &&
+            nonPawnMaterial && Evaluation::evaluate(position_) >= beta) {
+        const int reduction = 2 + depth / 4;
+        PositionUndo undo;
+        position_.makeNullMove(undo);
+        keyStack_.push_back(position_.getKey());
+        const int score = -negamax(depth - 1 - reduction, ply + 1, -beta, -beta + 1, false);
+        keyStack_.pop_back();
+        position_.undoNullMove(undo);
+        if (stopped_)
+            return 0;
+        if (score >= beta)
+            return isMateScore(score) ? beta : score;
+    }
+
+    MoveList moves;
+    position_.generateMoves(moves);
+    ScoredMove scored[MAX_MOVES];
+    scoreMoves(moves, scored, ttMove, ply);
+
+    const int originalAlpha = alpha;
+    int bestScore = -INFINITE_SCORE;
+    ChessMove bestMove;
+    int legalMoveCount = 0;
+
+    for (int index = 0; index < moves.size(); index++) {
+        const ChessMove move = pickNext(scored, moves.size(), index);
+        if (isRoot && !isRootMoveSearched(move))
+            continue;
+        if (!position_.isLegal(move))
+            continue;
+
+        const bool isQuiet = !position_.isCapture(move) && move.getFlag() != MoveFlag::Promotion;
+        PositionUndo undo;
+        position_.makeMove(move, undo);
+        keyStack_.push_back(position_.getKey());
+        legalMoveCount++;
+
+        // Principal variation search: the first move gets the full window, the rest
+        // must prove they are better with a null window (late quiet moves reduced)
+        int score;
+        if (legalMoveCount == 1)
+            score = -negamax(depth - 1, ply + 1, -beta, -alpha, true);
+        else {
+            int reduction = 0;
+            if (depth >= NativeCfg::LMR_MIN_DEPTH && legalMoveCount > NativeCfg::LMR_MIN_MOVES &&
+                    isQuiet && !inCheck && !position_.isInCheck())
+                reduction = std::min(1 + (legalMoveCount > 12 ? 1 : 0), depth - 2);
+            score = -negamax(depth - 1 - reduction, ply + 1, -alpha - 1, -alpha, true);
+            if (score > alpha && reduction > 0)
+                score = -negamax(depth - 1, ply + 1, -alpha - 1, -alpha, true);
+            if (score > alpha && score < beta)
+                score = -negamax(depth - 1, ply + 1, -beta, -alpha, true);
+        }
+
+        keyStack_.pop_back();
+        position_.undoMove(move, undo);
+        if (stopped_)
+            return 0;
+
+        if (score > bestScore) {
+            bestScore = score;
+            bestMove = move;
+            if (score > alpha) {
+                alpha = score;
+                updatePv(ply, move);
+                if (score >= beta) {
+                    if (isQuiet)
+                        updateQuietStats(ply, depth, move);
+                    break;
+                }
+            }
+        }
+    }
+
+    // No legal move: checkmate or stalemate
+    if (legalMoveCount == 0)
+        return inCheck ? -MATE_SCORE + ply : 0;
+
+    // A restricted root (MultiPV, searchmoves) is not the position's real score
+    if (!isRoot || (excludedRootMoves_.empty() && allowedRootMoves_.empty())) {
+        const ScoreBound bound =
+            (bestScore >= beta) ?
+            ScoreBound::Lower :
+            (bestScore > originalAlpha) ?
+            ScoreBound::Exact :
+            ScoreBound::Upper;
+        table_.store(
+            position_.getKey(),
+            (bound == ScoreBound::Upper) ? ChessMove() : bestMove,
+            scoreToTable(bestScore, ply), depth, bound);
+    }
+    return bestScore;
+}
+
+int NativeSearch::quiescence(const int ply, int alpha, const int beta) {
+    pvLength_[ply] = 0;
+    if ((++nodes_ & (NativeCfg::NODE_CHECK_INTERVAL - 1)) == 0 && shouldStop())
+        stopped_ = true;
+    if (stopped_)
+        return 0;
+    selectiveDepth_ = std::max(selectiveDepth_, ply);
+    if (ply >= NativeCfg::MAX_PLY - 1)
+        return Evaluation::evaluate(position_);
+
+    // In check every evasion is searched (no stand pat), so mates at the horizon are seen
+    const bool inCheck = position_.isInCheck();
+    int bestScore = -MATE_SCORE + ply;
+    MoveList moves;
+    if (inCheck)
+        position_.generateMoves(moves);
+    else {
+        bestScore = Evaluation::evaluate(position_);
+        if (bestScore >= beta)
+            return bestScore;
+        alpha = std::max(alpha, bestScore);
+        position_.generateCaptures(moves);
+    }
+
+    ScoredMove scored[MAX_MOVES];
+    scoreMoves(moves, scored, ChessMove(), ply);
+    for (int index = 0; index < moves.size(); index++) {
+        const ChessMove move = pickNext(scored, moves.size(), index);
+
+        // Captures losing the exchange come last and are not worth resolving
+        if (!inCheck && scored[index].score < 0)
+            break;
+        if (!position_.isLegal(move))
+            continue;
+
+        PositionUndo undo;
+        position_.makeMove(move, undo);
+        const int score = -quiescence(ply + 1, -beta, -alpha);
+        position_.undoMove(move, undo);
+        if (stopped_)
+            return 0;
+
+        if (score > bestScore) {
+            bestScore = score;
+            if (score > alpha) {
+                alpha = score;
+                if (score >= beta)
+                    break;
+            }
+        }
+    }
+    return bestScore;
+}
+
+bool NativeSearch::shouldStop() {
+    flushNodes();
+    if (stop_->load(std::memory_order_relaxed))
+        return true;
+    if (!limitsActive_)
+        return false;
+    if (nodeLimit_ > 0 && sharedNodes_->load(std::memory_order_relaxed) >= nodeLimit_)
+        return true;
+    return movetimeMs_ > 0 && getElapsedMs() >= movetimeMs_;
+}
+
+// Threads publish their nodes in batches, so the shared counter is touched once per check interval
+void NativeSearch::flushNodes() {
+    if (nodes_ != flushedNodes_) {
+        sharedNodes_->fetch_add(nodes_ - flushedNodes_, std::memory_order_relaxed);
+        flushedNodes_ = nodes_;
+    }
+}
+
+bool NativeSearch::isSkippedDepth(const int depth) const {
+    if (threadIndex_ == 0)
+        return false;
+    const int pattern = (threadIndex_ - 1) % SKIP_PATTERNS;
+    return ((depth + SKIP_PHASE[pattern]) / SKIP_SIZE[pattern]) % 2 != 0;
+}
+
+bool NativeSearch::isDraw() const {
+    if (position_.getHalfmoveClock() >= 100 || position_.hasInsufficientMaterial())
+        return true;
+
+    // Repetition: same key an even number of plies back, no further than the last irreversible move
+    const int count = static_cast<int>(keyStack_.size());
+    const int reach = std::min(position_.getHalfmoveClock(), count - 1);
+    const uint64_t key = keyStack_.back();
+    for (int back = 4; back <= reach; back += 2) {
+        if (keyStack_[count - 1 - back] == key)
+            return true;
+    }
+    return false;
+}
+
+void NativeSearch::scoreMoves(const MoveList& moves, ScoredMove* scored, const ChessMove& ttMove, const int ply) const {
+    const std::array<ChessMove, 2>& killers = killers_[ply];
+    const int side = static_cast<uint8_t>(position_.getSideToMove());
+
+    for (int index = 0; index < moves.size(); index++) {
+        const ChessMove move = moves[index];
+        int score;
+        if (move == ttMove)
+            score = TT_MOVE_SCORE;
+        else if (position_.isCapture(move)) {
+            // Most valuable victim first, least valuable attacker breaking ties
+            const PieceType victim =
+                (move.getFlag() == MoveFlag::EnPassant) ?
+                PieceType::Pawn :
+                typeOf(position_.getPiece(move.getTo()));
+            const PieceType attacker = typeOf(position_.getPiece(move.getFrom()));
+            const int mvvLva = Evaluation::getPieceValue(victim) * 8 - static_cast<int>(attacker);
+
+            // A cheaper victim may be defended: captures losing the exchange go last
+            const bool isLosing =
+                StaticExchange::getPieceValue(victim) < StaticExchange::getPieceValue(attacker) &&
+                StaticExchange::evaluate(position_, move) < 0;
+            score =
+                isLosing ?
+                LOSING_CAPTURE_SCORE + mvvLva :
+                CAPTURE_SCORE + mvvLva;
+            if (move.getPromotion() == PieceType::Queen)
+                score += Evaluation::getPieceValue(PieceType::Queen);
+        } else if (move.getPromotion() == PieceType::Queen)
+            score = QUEEN_PROMOTION_SCORE;
+        else if (move.getFlag() == MoveFlag::Promotion)
+            score = -1; // Underpromotions last
+        else if (move == killers[0])
+            score = KILLER_SCORE;
+        else if (move == killers[1])
+            score = KILLER_SCORE - 1;
+        else
+            score = history_[side][indexOf(move.getFrom())][indexOf(move.getTo())];
+        scored[index] = ScoredMove{move, score};
+    }
+}
+
+ChessMove NativeSearch::pickNext(ScoredMove* scored, const int count, const int index) {
+    int best = index;
+    for (int candidate = index + 1; candidate < count; candidate++) {
+        if (scored[candidate].score > scored[best].score)
+            best = candidate;
+    }
+    std::swap(scored[index], scored[best]);
+    return scored[index].move;
+}
+
+void NativeSearch::updatePv(const int ply, const ChessMove& move) {
+    std::vector<ChessMove>& line = pvTable_[ply];
+    const int childLength =
+        (ply + 1 < NativeCfg::MAX_PLY) ?
+        std::min(pvLength_[ply + 1], NativeCfg::MAX_PLY - 1) :
+        0;
+    line[0] = move;
+    if (childLength > 0)
+        std::copy(pvTable_[ply + 1].begin(), pvTable_[ply + 1].begin() + childLength, line.begin() + 1);
+    pvLength_[ply] = childLength + 1;
+}
+
+void NativeSearch::updateQuietStats(const int ply, const int depth, const ChessMove& move) {
+    std::array<ChessMove, 2>& killers = killers_[ply];
+    if (killers[0] != move) {
+        killers[1] = killers[0];
+        killers[0] = move;
+    }
+
+    // Halve every score when one gets too large, keeping the ordering below the killers
+    int& score = history_[static_cast<uint8_t>(position_.getSideToMove())][indexOf(move.getFrom())][indexOf(move.getTo())];
+    score += depth * depth;
+    if (score >= HISTORY_LIMIT) {
+        for (auto& side : history_) {
+            for (auto& from : side) {
+                for (int& value : from)
+                    value /= 2;
+            }
+        }
+    }
+}
+
+bool NativeSearch::isRootMoveSearched(const ChessMove& move) const {
+    if (std::find(excludedRootMoves_.begin(), excludedRootMoves_.end(), move) != excludedRootMoves_.end())
+        return false;
+    return allowedRootMoves_.empty() ||
+        std::find(allowedRootMoves_.begin(), allowedRootMoves_.end(), move) != allowedRootMoves_.end();
+}
+
+// Mate scores are stored as distance from the node, not from the root
+int NativeSearch::scoreToTable(const int score, const int ply) {
+    if (score >= MATE_BOUND)
+        return score + ply;
+    if (score <= -MATE_BOUND)
+        return score - ply;
+    return score;
+}
+
+int NativeSearch::scoreFromTable(const int score, const int ply) {
+    if (score >= MATE_BOUND)
+        return score - ply;
+    if (score <= -MATE_BOUND)
+        return score + ply;
+    return score;
+}
+
+int64_t NativeSearch::getElapsedMs() const {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTime_).count();
+}
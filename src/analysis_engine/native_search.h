@@ -0,0 +1,130 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include "analysis_engine.h"
+#include "transposition_table.h"
+#include "../core/position.h"
+#include "../config/config.h"
+
+// One principal variation of a finished iteration
+struct NativeSearchLine {
+    int score = 0;                      // Side to move's point of view; see NativeSearch::isMateScore
+    std::vector<ChessMove> pv;
+};
+
+// Snapshot after each completed iteration (and the final answer)
+struct NativeSearchIteration {
+    int depth = 0;
+    int selectiveDepth = 0;
+    uint64_t nodes = 0;
+    int64_t elapsedMs = 0;
+    int hashfull = 0;                   // Permille
+    std::vector<NativeSearchLine> lines; // Best first (MultiPV)
+};
+
+/**
+ * Alpha-beta search on Position; one instance per search thread (see NativeSearchGroup)
+ *
+ * Key features:
+ * - Iterative deepening with principal variation search; MultiPV searches
+ *   the root again without the moves of the lines already found
+ * - Transposition table cutoffs and move, null-move pruning and late move
+ *   reductions; check extension
+ * - Move ordering: TT move, captures by MVV-LVA, killers, history heuristic
+ *   (killers and history are per thread), captures losing the exchange (SEE) last
+ * - Quiescence search on captures that do not lose the exchange (all evasions
+ *   when in check), so tactics at the horizon are resolved
+ * - Mate scores are distance to mate, so the shortest mate is preferred
+ * - The main thread (index 0) applies the limits and reports iterations;
+ *   helpers skip depths in staggered patterns and run until stopped, filling
+ *   the shared table for the main thread
+ * - Stops on the stop flag, the depth/node/time/mate limits, or when every
+ *   line is a proven mate; time and node limits only apply after depth 1
+ */
+class NativeSearch {
+public:
+    static constexpr int MATE_SCORE = 32000;
+    static constexpr int INFINITE_SCORE = MATE_SCORE + 1;
+    static constexpr int MATE_BOUND = MATE_SCORE - Config::NativeEngine::MAX_PLY; // Scores beyond are mates
+
+    using IterationCallback = std::function<void(const NativeSearchIteration&)>;
+
+    NativeSearch(TranspositionTable& table, int threadIndex);
+
+    /**
+     * Search a position until a limit is reached
+     *
+     * @param root Position to search
+     * @param history Keys of the positions played before root, oldest first (repetitions)
+     * @param limits Depth/nodes/movetime/mate limits and searchmoves; unbounded runs to MAX_DEPTH
+     * @param multiPV Lines to search (capped at the number of legal moves)
+     * @param stop Aborts the search when set (the last completed iteration is returned)
+     * @param sharedNodes Node counter of the whole thread group (the node limit applies to it)
+     * @param onIteration Called after each completed iteration (may be empty; main thread only)
+     * @return The last completed iteration; no lines if root has no legal move
+     */
+    NativeSearchIteration run(
+        const Position& root,
+        const std::vector<uint64_t>& history,
+        const SearchLimits& limits,
+        int multiPV,
+        const std::atomic<bool>& stop,
+        std::atomic<uint64_t>& sharedNodes,
+        const IterationCallback& onIteration);
+
+    static bool isMateScore(const int score) { return score >= MATE_BOUND || score <= -MATE_BOUND; }
+    static int toMateMoves(const int score); // UCI "mate N" (negative: side to move is mated)
+
+private:
+    struct ScoredMove {
+        ChessMove move;
+        int score;
+    };
+
+    TranspositionTable& table_;
+    const int threadIndex_;                     // 0 = main thread
+    Position position_;
+    std::vector<uint64_t> keyStack_;            // Every position from the game start to the current node
+    std::vector<ChessMove> excludedRootMoves_;  // First moves of the lines found this iteration
+    std::vector<ChessMove> allowedRootMoves_;   // searchmoves (empty: all)
+
+    // PV table: pvTable_[ply] holds the line from ply onwards
+    std::vector<std::vector<ChessMove>> pvTable_;
+    std::vector<int> pvLength_;
+    std::vector<std::array<ChessMove, 2>> killers_;
+    int history_[2][SQUARE_COUNT][SQUARE_COUNT];
+
+    // Limits of the running search
+    const std::atomic<bool>* stop_ = nullptr;
+    std::atomic<uint64_t>* sharedNodes_ = nullptr;
+    std::chrono::steady_clock::time_point startTime_;
+    int64_t movetimeMs_ = 0;
+    uint64_t nodeLimit_ = 0;
+    bool limitsActive_ = false;                 // Time and node limits (off until depth 1 is done)
+    bool stopped_ = false;
+    uint64_t nodes_ = 0;                        // This thread
+    uint64_t flushedNodes_ = 0;                 // Part of nodes_ already added to sharedNodes_
+    int selectiveDepth_ = 0;
+
+    int negamax(int depth, int ply, int alpha, int beta, bool allowNullMove);
+    int quiescence(int ply, int alpha, int beta);
+
+    bool shouldStop();                          // Polled every NODE_CHECK_INTERVAL nodes
+    void flushNodes();
+    bool isSkippedDepth(int depth) const;       // Helper thread depth staggering
+    bool isDraw() const;                        // Fifty moves, insufficient material or repetition
+    void scoreMoves(const MoveList& moves, ScoredMove* scored, const ChessMove& ttMove, int ply) const;
+    static ChessMove pickNext(ScoredMove* scored, int count, int index); // Selection sort step
+    void updatePv(int ply, const ChessMove& move);
+    void updateQuietStats(int ply, int depth, const ChessMove& move);
+    bool isRootMoveSearched(const ChessMove& move) const;
+
+    static int scoreToTable(int score, int ply);
+    static int scoreFromTable(int score, int ply);
+    int64_t getElapsedMs() const;
+};
@@ -0,0 +1,95 @@
+#include "native_search_group.h"
+#include "../profiling/profiler.h"
+#include <algorithm>
+
+namespace NativeCfg = Config::NativeEngine;
+
+NativeSearchGroup::NativeSearchGroup(TranspositionTable& table) :
+    table_(table), helpersStop_(false), sharedNodes_(0) {
+
+    workers_.push_back(std::make_unique<NativeSearch>(table_, 0));
+}
+
+NativeSearchGroup::~NativeSearchGroup() {
+    stopHelperThreads();
+}
+
+void NativeSearchGroup::setThreadCount(const int threads) {
+    const int count = std::clamp(threads, 1, NativeCfg::MAX_THREADS);
+    if (count == getThreadCount())
+        return;
+
+    stopHelperThreads();
+    workers_.resize(1);
+    for (int index = 1; index < count; index++)
+        workers_.push_back(std::make_unique<NativeSearch>(table_, index));
+
+    quit_ = false;
+    for (int index = 1; index < count; index++)
+        helperThreads_.emplace_back(&NativeSearchGroup::helperThreadFunction, this, index, jobId_);
+}
+
+NativeSearchIteration NativeSearchGroup::run(
+    const Position& root,
+    const std::vector<uint64_t>& history,
+    const SearchLimits& limits,
+    const int multiPV,
+    const std::atomic<bool>& stop,
+    const NativeSearch::IterationCallback& onIteration) {
+
+    table_.newSearch();
+    helpersStop_ = false;
+    sharedNodes_ = 0;
+
+    if (!helperThreads_.empty()) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        job_ = Job{&root, &history, &limits, multiPV};
+        jobId_++;
+        runningHelpers_ = static_cast<int>(helperThreads_.size());
+    }
+    wakeUp_.notify_all();
+
+    NativeSearchIteration result = workers_[0]->run(root, history, limits, multiPV, stop, sharedNodes_, onIteration);
+
+    // Helpers reference root and history: wait until all of them are out
+    helpersStop_ = true;
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        finished_.wait(lock, [this]() { return runningHelpers_ == 0; });
+    }
+    result.nodes = sharedNodes_.load(std::memory_order_relaxed);
+    return result;
+}
+
+void NativeSearchGroup::helperThreadFunction(const int index, uint64_t lastJobId) {
+    PROFILE_THREAD("Native Search Helper");
+
+    while (true) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            wakeUp_.wait(lock, [this, lastJobId]() { return quit_ || jobId_ != lastJobId; });
+            if (quit_)
+                return;
+            lastJobId = jobId_;
+            job = job_;
+        }
+
+        workers_[index]->run(*job.root, *job.history, *job.limits, job.multiPV, helpersStop_, sharedNodes_, nullptr);
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (--runningHelpers_ == 0)
+            finished_.notify_all();
+    }
+}
+
+void NativeSearchGroup::stopHelperThreads() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        quit_ = true;
+    }
+    wakeUp_.notify_all();
+    for (std::thread& thread : helperThreads_)
+        thread.join();
+    helperThreads_.clear();
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "native_search.h"
+
+/**
+ * Lazy-SMP thread group of the native search
+ *
+ * Key features:
+ * - Every thread searches the same root; they cooperate only through the
+ *   shared lockless transposition table (no split points, no locks while searching)
+ * - The calling thread is the main thread: it applies the limits, reports
+ *   iterations and returns the result; helpers stop when it finishes
+ * - Helper threads are created once and sleep on a condition variable
+ *   between searches, so starting a search costs no thread creation
+ * - Each thread owns its NativeSearch (killers, history, PV), nodes are
+ *   summed in one shared counter
+ */
+class NativeSearchGroup {
+public:
+    explicit NativeSearchGroup(TranspositionTable& table);
+    ~NativeSearchGroup();
+
+    // Non-copyable
+    NativeSearchGroup(const NativeSearchGroup&) = delete;
+    NativeSearchGroup& operator=(const NativeSearchGroup&) = delete;
+
+    void setThreadCount(int threads);   // Only while no search runs; clamped to 1..MAX_THREADS
+    int getThreadCount() const { return static_cast<int>(workers_.size()); }
+
+    // Same contract as NativeSearch::run; nodes of the result are those of all threads
+    NativeSearchIteration run(
+        const Position& root,
+        const std::vector<uint64_t>& history,
+        const SearchLimits& limits,
+        int multiPV,
+        const std::atomic<bool>& stop,
+        const NativeSearch::IterationCallback& onIteration);
+
+private:
+    // The search handed to the helpers (valid until every helper has finished)
+    struct Job {
+        const Position* root = nullptr;
+        const std::vector<uint64_t>* history = nullptr;
+        const SearchLimits* limits = nullptr;
+        int multiPV = 1;
+    };
+
+    TranspositionTable& table_;
+    std::vector<std::unique_ptr<NativeSearch>> workers_;   // [0] runs on the calling thread
+    std::vector<std::thread> helperThreads_;                // One per worker but the first
+
+    std::mutex mutex_;
+    std::condition_variable wakeUp_;        // New job or shutdown
+    std::condition_variable finished_;      // Last helper done
+    Job job_;                               // Protected by mutex_
+    uint64_t jobId_ = 0;                    // Protected by mutex_
+    int runningHelpers_ = 0;                // Protected by mutex_
+    bool quit_ = false;                     // Protected by mutex_
+
+    std::atomic<bool> helpersStop_;
+    std::atomic<uint64_t> sharedNodes_;
+
+    void helperThreadFunction(int index, uint64_t lastJobId); // Waits for a job newer than lastJobId
+    void stopHelperThreads();
+};
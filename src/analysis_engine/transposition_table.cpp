@@ -0,0 +1,127 @@
+#include "transposition_table.h"
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+namespace {
+    constexpr size_t BYTES_PER_MEGABYTE = 1024 * 1024;
+    constexpr size_t HASHFULL_SAMPLE = 1000;
+    constexpr size_t SLOTS_PER_CLEAR_THREAD = size_t{1} << 22; // 64 MB
+
+    // Packed entry layout: move 0-15, score 16-31, depth 32-39, bound 40-47, generation 48-55
+    constexpr int SCORE_SHIFT = 16;
+    constexpr int DEPTH_SHIFT = 32;
+    constexpr int BOUND_SHIFT = 40;
+    constexpr int GENERATION_SHIFT = 48;
+}
+
+TranspositionTable::TranspositionTable() :
+    slots_(new Slot[1]), count_(1), mask_(0), generation_(0) {
+    clear();
+}
+
+void TranspositionTable::resize(const int megabytes) {
+    // Largest power of two that fits the budget (at least one slot)
+    const size_t budget = static_cast<size_t>(megabytes > 0 ? megabytes : 1) * BYTES_PER_MEGABYTE / sizeof(Slot);
+    size_t count = 1;
+    while (count * 2 <= budget)
+        count *= 2;
+
+    slots_.reset();
+    slots_.reset(new Slot[count]);
+    count_ = count;
+    mask_ = count - 1;
+    clear();
+}
+
+void TranspositionTable::clear() {
+    // Gigabyte tables are cleared (and first touched) by several threads
+    const size_t hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+    const size_t threadCount = std::clamp(count_ / SLOTS_PER_CLEAR_THREAD, size_t{1}, hardwareThreads);
+
+    auto clearRange = [this](const size_t begin, const size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            slots_[i].check.store(0, std::memory_order_relaxed);
+            slots_[i].data.store(0, std::memory_order_relaxed);
+        }
+    };
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < threadCount; i++)
+        threads.emplace_back(clearRange, count_ * i / threadCount, count_ * (i + 1) / threadCount);
+    clearRange(0, count_ / threadCount);
+    for (std::thread& thread : threads)
+        thread.join();
+    generation_ = 0;
+}
+
+void TranspositionTable::newSearch() {
+    generation_++;
+}
+
+bool TranspositionTable::probe(const uint64_t key, TTEntry& entry) const {
+    const Slot& slot = slots_[key & mask_];
+    const uint64_t data = slot.data.load(std::memory_order_relaxed);
+    if ((slot.check.load(std::memory_order_relaxed) ^ data) != key)
+        return false;
+    entry = unpack(data);
+    return entry.bound != ScoreBound::None;
+}
+
+void TranspositionTable::store(
+    const uint64_t key, const ChessMove& move,
+    const int score, const int depth, const ScoreBound bound) {
+
+    Slot& slot = slots_[key & mask_];
+    const uint64_t oldData = slot.data.load(std::memory_order_relaxed);
+    const bool isSamePosition = ((slot.check.load(std::memory_order_relaxed) ^ oldData) == key);
+    const TTEntry old = unpack(oldData);
+
+    // Keep deeper results of this search for other positions
+    if (!isSamePosition && old.generation == generation_ && old.depth > depth && bound != ScoreBound::Exact)
+        return;
+
+    // A search without a best move keeps the move already known for the position
+    TTEntry entry;
+    entry.move =
+        (move.isNull() && isSamePosition) ?
+        old.move :
+        move;
+    entry.score = static_cast<int16_t>(score);
+    entry.depth = static_cast<int8_t>(depth);
+    entry.bound = bound;
+    entry.generation = generation_;
+
+    const uint64_t data = pack(entry);
+    slot.data.store(data, std::memory_order_relaxed);
+    slot.check.store(key ^ data, std::memory_order_relaxed);
+}
+
+int TranspositionTable::getHashfull() const {
+    const size_t sample = std::min(HASHFULL_SAMPLE, count_);
+    size_t used = 0;
+    for (size_t i = 0; i < sample; i++) {
+        const TTEntry entry = unpack(slots_[i].data.load(std::memory_order_relaxed));
+        if (entry.bound != ScoreBound::None && entry.generation == generation_)
+            used++;
+    }
+    return static_cast<int>(used * 1000 / sample);
+}
+
+uint64_t TranspositionTable::pack(const TTEntry& entry) {
+    return
+        static_cast<uint64_t>(entry.move.getRaw()) |
+        static_cast<uint64_t>(static_cast<uint16_t>(entry.score)) << SCORE_SHIFT |
+        static_cast<uint64_t>(static_cast<uint8_t>(entry.depth)) << DEPTH_SHIFT |
+        static_cast<uint64_t>(entry.bound) << BOUND_SHIFT |
+        static_cast<uint64_t>(entry.generation) << GENERATION_SHIFT;
+}
+
+TTEntry TranspositionTable::unpack(const uint64_t data) {
+    TTEntry entry;
+    entry.move = ChessMove::fromRaw(static_cast<uint16_t>(data));
+    entry.score = static_cast<int16_t>(static_cast<uint16_t>(data >> SCORE_SHIFT));
+    entry.depth = static_cast<int8_t>(static_cast<uint8_t>(data >> DEPTH_SHIFT));
+    entry.bound = static_cast<ScoreBound>(static_cast<uint8_t>(data >> BOUND_SHIFT));
+    entry.generation = static_cast<uint8_t>(data >> GENERATION_SHIFT);
+    return entry;
+}
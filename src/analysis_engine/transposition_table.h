@@ -0,0 +1,67 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include "../core/chess_move.h"
+
+// How a stored score relates to the true score
+enum class ScoreBound : uint8_t {
+    None,
+    Upper,          // Failed low: true score <= score
+    Lower,          // Failed high: true score >= score
+    Exact
+};
+
+// Decoded table entry (the table itself stores packed slots)
+struct TTEntry {
+    ChessMove move;
+    int16_t score = 0;          // Mate scores are stored relative to the node (see NativeSearch)
+    int8_t depth = 0;
+    ScoreBound bound = ScoreBound::None;
+    uint8_t generation = 0;
+};
+
+/**
+ * Transposition table of the native search, shared by all search threads
+ *
+ * Key features:
+ * - Power-of-two slot count sized from megabytes, indexed by the low key bits
+ * - Lockless: a slot is two relaxed 64-bit atomics, the packed entry and the
+ *   key XOR the entry; a torn write from another thread fails the XOR check
+ *   and reads as a miss, so no lock is taken on the search path
+ * - Full keys are verified, so index collisions are never trusted
+ * - Replacement prefers deeper results of the current search; entries of
+ *   earlier searches (older generation) are always replaced
+ * - Survives between searches, so analysis of the next position starts warm
+ */
+class TranspositionTable {
+public:
+    TranspositionTable();
+
+    // Not thread safe: only while no search runs
+    void resize(int megabytes);     // Clears the table
+    void clear();
+    void newSearch();               // Ages existing entries
+
+    // Safe from any number of search threads
+    bool probe(uint64_t key, TTEntry& entry) const;
+    void store(uint64_t key, const ChessMove& move, int score, int depth, ScoreBound bound);
+
+    int getHashfull() const;        // Permille of sampled entries written by the current search
+
+private:
+    struct Slot {
+        std::atomic<uint64_t> check;    // key ^ data
+        std::atomic<uint64_t> data;     // Packed TTEntry
+    };
+
+    std::unique_ptr<Slot[]> slots_;
+    size_t count_;
+    size_t mask_;
+    uint8_t generation_;
+
+    static uint64_t pack(const TTEntry& entry);
+    static TTEntry unpack(uint64_t data);
+};
@@ -15,6 +15,9 @@ AnalysisLine UCIAnalysisParser::parseAnalysisLine(const std::string& line) {
     else
         analysisLine.multipv = 1;
 
+    analysisLine.depth = parseDepth(line);
+    analysisLine.firstMove = parseFirstMove(line);
+    parseScore(line, analysisLine);
     analysisLine.text = parseCpOrMate(line);
     
     analysisLine.text += parsePv(line);
@@ -30,6 +33,22 @@ bool UCIAnalysisParser::shouldIgnoreLine(const std::string& line) {
     return line.find("currmove") != std::string::npos;
 }
 
+bool UCIAnalysisParser::isBestMoveLine(const std::string& line) {
+    return line.rfind("bestmove", 0) == 0;
+}
+
+void UCIAnalysisParser::parseBestMove(const std::string& line, std::string& bestMove, std::string& ponderMove) {
+    std::istringstream stream(line);
+    std::string token;
+    bestMove.clear();
+    ponderMove.clear();
+    
+    stream >> token; // "bestmove"
+    stream >> bestMove;
+    if (stream >> token && token == "ponder")
+        stream >> ponderMove;
+}
+
 bool UCIAnalysisParser::isValidFEN(const std::string& fen) {
     if (fen.empty())
         return false;
@@ -87,6 +106,46 @@ std::string UCIAnalysisParser::parseCpOrMate(const std::string& line) {
     return startLine;
 }
 
+int UCIAnalysisParser::parseDepth(const std::string& line) {
+    // " depth " (not " seldepth ")
+    size_t depthPos = line.find(" depth ");
+    if (depthPos == std::string::npos)
+        return 0;
+    return std::atoi(line.c_str() + depthPos + 7);
+}
+
+void UCIAnalysisParser::parseScore(const std::string& line, AnalysisLine& analysisLine) {
+    // "score cp <x>" or "score mate <y>" (optionally followed by lowerbound/upperbound)
+    size_t scorePos = line.find(" score ");
+    if (scorePos == std::string::npos)
+        return;
+    
+    std::istringstream stream(line.substr(scorePos + 7));
+    std::string unit;
+    int value = 0;
+    if (!(stream >> unit >> value))
+        return;
+    
+    if (unit == "cp") {
+        analysisLine.scoreCp = value;
+        analysisLine.hasScore = true;
+    } else if (unit == "mate") {
+        analysisLine.mateIn = value;
+        analysisLine.isMate = true;
+        analysisLine.hasScore = true;
+    }
+}
+
+ChessMove UCIAnalysisParser::parseFirstMove(const std::string& line) {
+    size_t pvPos = line.find(" pv ");
+    if (pvPos == std::string::npos)
+        return ChessMove();
+    size_t moveStart = pvPos + 4;
+    size_t moveEnd = line.find(" ", moveStart);
+    const std::string_view lineView = line;
+    return ChessMove::fromUCI(lineView.substr(moveStart, moveEnd == std::string::npos ? std::string::npos : moveEnd - moveStart));
+}
+
 std::string UCIAnalysisParser::parsePv(const std::string& line) {
     
     std::string pvString = "";
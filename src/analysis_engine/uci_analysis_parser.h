@@ -3,12 +3,19 @@
 #include <string>
 #include <vector>
 #include <regex>
+#include "../core/chess_move.h"
 
 /**
  * Structure representing a parsed analysis line from the UCI engine
  */
 struct AnalysisLine {
     int multipv = 1;            // Principal variation number (1-4)
+    int depth = 0;              // Search depth of this PV
+    ChessMove firstMove;        // First move of the PV (null move if none)
+    bool hasScore = false;      // A cp or mate score was reported
+    bool isMate = false;        // Score is a mate distance (mateIn) rather than centipawns
+    int scoreCp = 0;            // Centipawns from the side to move's point of view
+    int mateIn = 0;             // Moves to mate (negative: side to move is mated, 0: already mated)
     std::string text;           // Raw info line (trimmed) for this PV
 };
 
@@ -41,6 +48,21 @@ public:
      */
     static bool shouldIgnoreLine(const std::string& line);
     
+    /**
+     * Check if a line is the final answer of a search (starts with "bestmove")
+     * @param line The line to check
+     * @return true if it's a bestmove line, false otherwise
+     */
+    static bool isBestMoveLine(const std::string& line);
+    
+    /**
+     * Parse "bestmove <move> [ponder <move>]"
+     * @param line The bestmove line
+     * @param bestMove Receives the best move ("(none)" when there is no legal move)
+     * @param ponderMove Receives the ponder move (empty if absent)
+     */
+    static void parseBestMove(const std::string& line, std::string& bestMove, std::string& ponderMove);
+    
     /**
      * Validate if a FEN string has the correct number of parts
      * @param fen The FEN string to validate
@@ -60,4 +82,7 @@ private:
 
     static std::string parseCpOrMate(const std::string& line);
     static std::string parsePv(const std::string& line);
+    static int parseDepth(const std::string& line);
+    static void parseScore(const std::string& line, AnalysisLine& analysisLine);
+    static ChessMove parseFirstMove(const std::string& line);
 };
\ No newline at end of file
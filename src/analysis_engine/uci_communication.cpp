@@ -1,6 +1,7 @@
 #include "uci_communication.h"
 #include <windows.h>
 #include <iostream>
+#include <thread>
 
 UCICommunication::UCICommunication()
     : inputHandle_(nullptr)
@@ -66,46 +67,88 @@ bool UCICommunication::hasDataAvailable() const {
     return false;
 }
 
-bool UCICommunication::initializeProtocol() {
+bool UCICommunication::waitForData(std::chrono::steady_clock::time_point deadline) const {
+    while (!hasDataAvailable()) {
+        if (std::chrono::steady_clock::now() >= deadline)
+            return false;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+bool UCICommunication::initializeProtocol(int timeoutMs) {
     // Send UCI command
     if (!sendCommand("uci")) {
         std::cerr << "Failed to send UCI command" << std::endl;
         return false;
     }
     
-    // Wait for uciok
-    if (!waitForResponse("uciok")) {
+    // Record advertised options until uciok
+    options_.clear();
+    bool receivedUciOk = false;
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+    while (!receivedUciOk && waitForData(deadline)) {
+        std::string line = readResponseLine();
+        if (line.empty())
+            break; // No more data available
+        
+        if (line.rfind("option", 0) == 0)
+            options_.parseOptionLine(line);
+        else if (line.find("uciok") != std::string::npos)
+            receivedUciOk = true;
+    }
+    if (!receivedUciOk) {
         std::cerr << "Did not receive uciok response" << std::endl;
         return false;
     }
     
-    // Send isready
-    if (!sendCommand("isready")) {
-        std::cerr << "Failed to send isready command" << std::endl;
+    return synchronize(timeoutMs);
+}
+
+bool UCICommunication::setOption(const std::string& name, const std::string& value) {
+    std::string normalized;
+    if (!options_.normalizeValue(name, value, normalized)) {
+        std::cerr << "Engine does not support option: " << name << " = " << value << std::endl;
         return false;
     }
     
-    // Wait for readyok
-    if (!waitForResponse("readyok")) {
-        std::cerr << "Did not receive readyok response" << std::endl;
+    const UCIOption* option = options_.find(name);
+    std::string command = "setoption name " + option->name;
+    if (option->type != UCIOptionType::Button)
+        command += " value " + normalized;
+    
+    if (!sendCommand(command)) {
+        std::cerr << "Failed to set option: " << name << std::endl;
         return false;
     }
     
+    options_.setValue(name, normalized);
     return true;
 }
 
-bool UCICommunication::configureEngine() {
-    // Set MultiPV to 4 for multiple principal variations
-    if (!sendCommand("setoption name MultiPV value 4")) {
-        std::cerr << "Failed to set MultiPV option" << std::endl;
+bool UCICommunication::synchronize(int timeoutMs) {
+    // Send isready
+    if (!sendCommand("isready")) {
+        std::cerr << "Failed to send isready command" << std::endl;
+        return false;
+    }
+    
+    // Wait for readyok
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+    if (!waitForResponse("readyok", deadline)) {
+        std::cerr << "Did not receive readyok response" << std::endl;
         return false;
     }
     
     return true;
 }
 
-bool UCICommunication::waitForResponse(const std::string& expectedResponse) {
+bool UCICommunication::waitForResponse(const std::string& expectedResponse, std::chrono::steady_clock::time_point deadline) {
     while (true) {
+        // A hung engine never answers; give up at the deadline instead of blocking
+        if (!waitForData(deadline))
+            return false;
+        
         std::string line = readResponseLine();
         if (line.empty())
             return false; // No more data available
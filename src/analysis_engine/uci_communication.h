@@ -2,6 +2,8 @@
 
 #include <string>
 #include <memory>
+#include <chrono>
+#include "uci_options.h"
 
 /**
  * Handles low-level communication with UCI engines
@@ -42,22 +44,44 @@ public:
      */
     bool hasDataAvailable() const;
     
+    /**
+     * Wait (polling) until data is available or the deadline passes
+     * @return true if data is available, false on timeout
+     */
+    bool waitForData(std::chrono::steady_clock::time_point deadline) const;
+    
     /**
      * Initialize the UCI protocol with the engine
-     * Sends uci command and waits for uciok, then sends isready and waits for readyok
-     * @return true if successful, false otherwise
+     * Sends uci command, records every advertised option until uciok,
+     * then sends isready and waits for readyok
+     * @param timeoutMs Deadline for each of uciok and readyok
+     * @return true if successful, false otherwise (including a missed deadline)
      */
-    bool initializeProtocol();
+    bool initializeProtocol(int timeoutMs);
     
     /**
-     * Configure engine options (like MultiPV)
-     * @return true if successful, false otherwise
+     * Send "setoption" for a supported option (spins are clamped to the advertised range)
+     * Call synchronize() afterwards before the next search.
+     * @return false if the engine does not support the option/value or sending failed
+     */
+    bool setOption(const std::string& name, const std::string& value);
+    
+    /**
+     * Send isready and wait for readyok (required after setoption)
+     * @param timeoutMs Deadline for readyok
+     * @return true if the engine answered in time
+     */
+    bool synchronize(int timeoutMs);
+    
+    /**
+     * Options advertised by the engine (valid after initializeProtocol)
      */
-    bool configureEngine();
+    const UCIOptionTable& getOptions() const { return options_; }
     
 private:
     void* inputHandle_;
     void* outputHandle_;
+    UCIOptionTable options_;
     
-    bool waitForResponse(const std::string& expectedResponse);
+    bool waitForResponse(const std::string& expectedResponse, std::chrono::steady_clock::time_point deadline);
 };
\ No newline at end of file
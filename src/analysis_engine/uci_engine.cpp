@@ -1,13 +1,22 @@
 #include "uci_engine.h"
+#include "../profiling/profiler.h"
+#include "../config/config.h"
+#include <algorithm>
 #include <iostream>
 #include <chrono>
 
+// Budget used when a bounded search is requested without any limit
+static constexpr int DEFAULT_SEARCH_MOVETIME_MS = 1000;
+
 UCIEngine::UCIEngine(const std::string& enginePath)
     : enginePath_(enginePath)
     , process_(std::make_unique<UCIProcess>())
     , communication_(std::make_unique<UCICommunication>())
     , state_(EngineState::Disconnected)
     , enabled_(false)
+    , analysisVersion_(0)
+    , settings_(EngineSettings::fromConfig())
+    , restartRequested_(false)
 {}
 
 UCIEngine::~UCIEngine() {
@@ -19,16 +28,29 @@ void UCIEngine::enable() {
     if (enabled_)
         return; // Already enabled
     
-    state_ = EngineState::Connecting;
+    setState(EngineState::Connecting);
+    
+    // A fresh engine process has no position yet and needs every setting
+    {
+        std::lock_guard<std::mutex> lock(analysisMutex_);
+        hasRequestedPosition_ = false;
+        hasCurrentPosition_ = false;
+        clearRequested_ = false;
+        pendingOptions_.clear();
+        appliedOptions_.clear();
+        queueSettings(settings_);
+    }
+    restartRequested_ = false;
+    restartAttempts_ = 0;
     
     if (!initializeEngine()) {
-        state_ = EngineState::Error;
+        setState(EngineState::Error);
         return;
     }
     
     // Only set enabled to true AFTER initialization succeeds
     enabled_ = true;
-    state_ = EngineState::Ready;
+    setState(EngineState::Ready);
     
     // Start analysis thread
     analysisThread_ = std::make_unique<std::thread>(&UCIEngine::analysisThreadFunction, this);
@@ -38,13 +60,19 @@ void UCIEngine::disable() {
     if (!enabled_)
         return; // Already disabled
     
-    enabled_ = false;
-    state_ = EngineState::Disconnected;
+    {
+        std::lock_guard<std::mutex> lock(analysisMutex_);
+        enabled_ = false;
+    }
+    setState(EngineState::Disconnected);
     
     // Wait for thread to finish
     if (analysisThread_ && analysisThread_->joinable())
         analysisThread_->join();
     
+    // Nobody will answer outstanding searches now
+    cancelSearches();
+    
     // Stop the engine process
     process_->stopEngine();
     
@@ -56,23 +84,112 @@ bool UCIEngine::isEnabled() const {
     return enabled_;
 }
 
-void UCIEngine::clearAnalysis() {
-    if (!enabled_)
-        return;
+void UCIEngine::configure(const EngineSettings& settings) {
+    std::lock_guard<std::mutex> lock(analysisMutex_);
+    settings_ = settings;
+    queueSettings(settings);
+}
+
+EngineSettings UCIEngine::getSettings() const {
+    std::lock_guard<std::mutex> lock(analysisMutex_);
+    return settings_;
+}
+
+void UCIEngine::setOption(const std::string& name, const std::string& value) {
+    std::lock_guard<std::mutex> lock(analysisMutex_);
+    pendingOptions_.emplace_back(name, value);
+}
+
+std::vector<UCIOption> UCIEngine::getOptions() const {
+    std::lock_guard<std::mutex> lock(analysisMutex_);
+    return options_;
+}
+
+void UCIEngine::queueSettings(const EngineSettings& settings) {
+    // Hash before Threads: some engines reallocate per thread on resize
+    pendingOptions_.emplace_back("Hash", std::to_string(settings.hashMb));
+    pendingOptions_.emplace_back("Threads", std::to_string(settings.threads));
+    pendingOptions_.emplace_back("MultiPV", std::to_string(settings.multiPV));
+    if (!settings.evalFile.empty())
+        pendingOptions_.emplace_back("EvalFile", settings.evalFile);
+}
+
+bool UCIEngine::applyPendingOptions() {
+    std::vector<std::pair<std::string, std::string>> options;
+    {
+        std::lock_guard<std::mutex> lock(analysisMutex_);
+        if (pendingOptions_.empty())
+            return false;
+        options.swap(pendingOptions_);
+    }
     
-    // Stop current analysis if running
-    if (state_ == EngineState::Analyzing)
-        stopCurrentAnalysis();
+    PROFILE_SCOPE("UCIEngine::applyPendingOptions");
+    
+    // A hung engine is restarted; the batch is put back so the restart replays it
+    auto requeueForRestart = [&]() {
+        {
+            std::lock_guard<std::mutex> lock(analysisMutex_);
+            pendingOptions_.insert(pendingOptions_.begin(), options.begin(), options.end());
+        }
+        restartRequested_ = true;
+    };
+    
+    // Options may only change while the engine is not searching
+    const bool wasAnalyzing = (state_ == EngineState::Analyzing);
+    if (wasAnalyzing && !stopCurrentAnalysis()) {
+        requeueForRestart();
+        return true;
+    }
+    
+    std::vector<std::pair<std::string, std::string>> accepted;
+    for (const auto& [name, value] : options) {
+        if (communication_->setOption(name, value)) // Unsupported options are skipped
+            accepted.emplace_back(name, value);
+    }
+    
+    // Wait until the engine has applied them (hash allocation can take a while)
+    if (!communication_->synchronize(Config::Engine::READY_TIMEOUT_MS)) {
+        requeueForRestart();
+        return true;
+    }
     
-    // Clear analysis results
     {
         std::lock_guard<std::mutex> lock(analysisMutex_);
-        currentAnalysis_ = EngineAnalysis();
-        currentAnalysis_.state = state_.load();
+        for (const auto& option : accepted) {
+            auto applied = std::find_if(appliedOptions_.begin(), appliedOptions_.end(),
+                [&](const auto& entry) { return entry.first == option.first; });
+            if (applied != appliedOptions_.end())
+                applied->second = option.second;
+            else
+                appliedOptions_.push_back(option);
+        }
+        options_ = communication_->getOptions().getOptions();
+        hasCurrentPosition_ = false; // Restart analysis with the new settings
     }
+    if (wasAnalyzing)
+        setState(EngineState::Ready);
+    return true;
+}
+
+uint64_t UCIEngine::getAnalysisVersion() const {
+    return analysisVersion_.load(std::memory_order_acquire);
+}
+
+void UCIEngine::setState(EngineState state) {
+    state_ = state;
+    analysisVersion_.fetch_add(1, std::memory_order_release);
 }
 
-void UCIEngine::setPosition(const std::string& startFen, const std::vector<std::string>& moves) {
+void UCIEngine::clearAnalysis() {
+    if (!enabled_)
+        return;
+    
+    // The analysis thread owns the engine pipe: it stops the search and clears the results
+    std::lock_guard<std::mutex> lock(analysisMutex_);
+    clearRequested_ = true;
+}
+
+void UCIEngine::setPosition(const std::string& startFen, const std::vector<std::string>& moves, const PositionKey& key) {
     // Check if engine is enabled
     if (!enabled_)
         return;
@@ -89,21 +206,84 @@ void UCIEngine::setPosition(const std::string& startFen, const std::vector<std::
         return;
     }
     
-    // Set the requested starting FEN and moves - the analysis thread will detect the change
+    // Set the requested starting FEN and moves - the analysis thread will detect the key change
+    {
+        std::lock_guard<std::mutex> lock(analysisMutex_);
+        if (hasRequestedPosition_ && requestedKey_ == key)
+            return;
+        requestedStartFen_ = fenToUse;
+        requestedMoves_ = moves;
+        requestedKey_ = key;
+        hasRequestedPosition_ = true;
+    }
+}
+
+bool UCIEngine::isPositionRequested(const PositionKey& key) const {
+    std::lock_guard<std::mutex> lock(analysisMutex_);
+    return hasRequestedPosition_ && requestedKey_ == key;
+}
+
+std::future<SearchResult> UCIEngine::requestSearch(
+    const std::string& startFen, 
+    const std::vector<std::string>& moves, 
+    const PositionKey& key,
+    const SearchLimits& limits,
+    SearchCallback onComplete) {
+    
+    PendingSearch search;
+    search.startFen = startFen;
+    search.moves = moves;
+    search.key = key;
+    search.limits = limits;
+    search.onComplete = std::move(onComplete);
+    if (!search.limits.isBounded())
+        search.limits.movetimeMs = DEFAULT_SEARCH_MOVETIME_MS;
+    
+    std::future<SearchResult> future = search.promise.get_future();
+    
+    // Checked under the queue lock: disable() clears enabled_ under it too, so
+    // nothing is queued after cancelSearches() has answered the queue
     {
         std::lock_guard<std::mutex> lock(analysisMutex_);
-        requestedStartFen_ = startFen;
-        if (!moves.empty()) {
-            requestedMoves_ = moves;
+        if (enabled_) {
+            pendingSearches_.push_back(std::move(search));
+            return future;
         }
     }
+    
+    // Without a running engine the search is answered (empty) immediately
+    SearchResult result;
+    result.key = key;
+    if (search.onComplete)
+        search.onComplete(result);
+    search.promise.set_value(std::move(result));
+    return future;
+}
+
+void UCIEngine::clearPendingSearches() {
+    std::deque<PendingSearch> cancelled;
+    {
+        std::lock_guard<std::mutex> lock(analysisMutex_);
+        cancelled.swap(pendingSearches_);
+    }
+    
+    // Answer with an empty best move so waiting callers never hang
+    for (auto& search : cancelled) {
+        SearchResult result;
+        result.key = search.key;
+        if (search.onComplete)
+            search.onComplete(result);
+        search.promise.set_value(std::move(result));
+    }
 }
 
 EngineAnalysis UCIEngine::pollAnalysis() {
+    PROFILE_SCOPE("UCIEngine::pollAnalysis");
     EngineAnalysis result;
     
     // Get current state
     result.state = state_;
+    result.version = getAnalysisVersion();
     
     // Get latest analysis data
     {
@@ -113,6 +293,8 @@ EngineAnalysis UCIEngine::pollAnalysis() {
         result.rawInfo = currentAnalysis_.rawInfo;
         result.hasResult = currentAnalysis_.hasResult;
         result.lines = currentAnalysis_.lines;
+        result.key = currentKey_;
+        result.depth = currentAnalysis_.depth;
     }
     
     return result;
@@ -129,13 +311,14 @@ bool UCIEngine::initializeEngine() {
     communication_->initialize(process_->getInputHandle(), process_->getOutputHandle());
     
     // Initialize UCI protocol
-    if (!communication_->initializeProtocol()) {
+    if (!communication_->initializeProtocol(Config::Engine::READY_TIMEOUT_MS)) {
         std::cerr << "Failed to initialize UCI protocol" << std::endl;
         return false;
     }
     
-    // Configure engine options
-    if (!communication_->configureEngine()) {
+    // Configure engine options (queued by enable())
+    applyPendingOptions();
+    if (restartRequested_) {
         std::cerr << "Failed to configure engine" << std::endl;
         return false;
     }
@@ -144,6 +327,8 @@ bool UCIEngine::initializeEngine() {
 }
 
 void UCIEngine::analysisThreadFunction() {
+    PROFILE_THREAD("UCI Reader");
+
     while (true) {
         // Exit if disabled
         if (!enabled_)
@@ -154,18 +339,33 @@ void UCIEngine::analysisThreadFunction() {
         // Exit if disconnected or error
         if (currentState == EngineState::Disconnected || currentState == EngineState::Error)
             break;
-
         
-        // Check for and handle any position change requests
-        handlePositionTransition();
+        // Crashed or hung engine: restart it, giving up after repeated failures
+        if (restartRequested_ || !isEngineHealthy()) {
+            if (!restartEngine() && restartAttempts_ >= Config::Engine::MAX_RESTART_ATTEMPTS) {
+                std::cerr << "Engine restart failed " << restartAttempts_ << " times, giving up" << std::endl;
+                cancelSearches();
+                setState(EngineState::Error);
+                break;
+            }
+            continue;
+        }
         
-        // Read engine output while analyzing
-        if (currentState == EngineState::Analyzing) {
-            // Only attempt to read if data is available to avoid blocking
-            if (communication_->hasDataAvailable())
-                readEngineOutput();
+        handleClearRequest();
+        
+        // Options change only between searches; queued bounded searches run
+        // before interactive analysis resumes
+        if (!activeSearch_) {
+            applyPendingOptions();
+            if (!startNextSearch())
+                handlePositionTransition();
         }
         
+        // Read engine output while analyzing
+        currentState = state_;
+        if (currentState == EngineState::Analyzing)
+            readEngineOutput();
+        
         // Sleep based on current state (stale state is acceptable, will refresh next iteration)
         std::this_thread::sleep_for(
             currentState == EngineState::Analyzing ? 
@@ -174,52 +374,249 @@ void UCIEngine::analysisThreadFunction() {
     }
 }
 
+void UCIEngine::handleClearRequest() {
+    {
+        std::lock_guard<std::mutex> lock(analysisMutex_);
+        if (!clearRequested_)
+            return;
+        clearRequested_ = false;
+    }
+    
+    // Stop whatever runs; a bounded search is answered (empty) since its bestmove is consumed here
+    const bool isStopped = state_ != EngineState::Analyzing || stopCurrentAnalysis();
+    cancelActiveSearch();
+    
+    // Clear analysis results; the requested position is analyzed again from scratch
+    {
+        std::lock_guard<std::mutex> lock(analysisMutex_);
+        currentKey_ = requestedKey_;
+        currentAnalysis_ = EngineAnalysis();
+        hasCurrentPosition_ = false;
+    }
+    
+    // An engine that ignores stop is restarted (the restart publishes the new state)
+    if (isStopped)
+        setState(EngineState::Ready);
+    else
+        restartRequested_ = true;
+}
+
 void UCIEngine::handlePositionTransition() {
-    // Check if there's a position change to handle
+    PROFILE_SCOPE("UCIEngine::handlePositionTransition");
+
+    // Check if there's a position change to handle (key comparison only; copy on change)
     std::string requestedStartFen;
     std::vector<std::string> requestedMoves;
-    std::string currentStartFen;
-    std::vector<std::string> currentMoves;
+    PositionKey requestedKey;
     {
         std::lock_guard<std::mutex> lock(analysisMutex_);
+        
+        // If no change requested or already analyzing this position, nothing to do
+        if (!hasRequestedPosition_ || 
+                (hasCurrentPosition_ && requestedKey_ == currentKey_))
+            return;
+        
         requestedStartFen = requestedStartFen_;
         requestedMoves = requestedMoves_;
-        currentStartFen = currentStartFen_;
-        currentMoves = currentMoves_;
+        requestedKey = requestedKey_;
     }
     
-    // If no change requested or already analyzing this position, nothing to do
-    if (requestedStartFen.empty() || 
-            (requestedStartFen == currentStartFen && requestedMoves == currentMoves))
-        return;
-    
     // Need to transition to new position - stop current analysis if running
-    if (state_ == EngineState::Analyzing)
-        stopCurrentAnalysis();
+    if (state_ == EngineState::Analyzing && !stopCurrentAnalysis()) {
+        restartRequested_ = true; // The restart picks up the requested position
+        return;
+    }
     
     // Update current position and clear results
     {
         std::lock_guard<std::mutex> lock(analysisMutex_);
         currentStartFen_ = requestedStartFen;
-        currentMoves_ = requestedMoves;
+        currentKey_ = requestedKey;
+        hasCurrentPosition_ = true;
         currentAnalysis_ = EngineAnalysis();
     }
+    analysisVersion_.fetch_add(1, std::memory_order_release);
+    
     // Start analysis on new position
     startAnalysisForPosition(requestedStartFen, requestedMoves);
 }
 
-void UCIEngine::stopCurrentAnalysis() {
-    state_ = EngineState::Stopping;
+bool UCIEngine::stopCurrentAnalysis() {
+    PROFILE_SCOPE("UCIEngine::stopCurrentAnalysis");
+
+    setState(EngineState::Stopping);
     communication_->sendCommand("stop");
     
     // Wait for stop to complete by reading output until we see "bestmove"
-    std::string line;
-    do
-        line = communication_->readResponseLine();
-    while (!line.empty() && line.find("bestmove") == std::string::npos);
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(Config::Engine::STOP_TIMEOUT_MS);
+    while (communication_->waitForData(deadline)) {
+        const std::string line = communication_->readResponseLine();
+        if (line.empty())
+            break; // Pipe closed
+        if (line.find("bestmove") != std::string::npos) {
+            awaitingReadyOk_ = false; // A pending probe answer may be consumed above
+            return true;
+        }
+    }
+    return false;
 }
 
 void UCIEngine::startAnalysisForPosition(const std::string& startFen, const std::vector<std::string>& moves) {
+    sendPosition(startFen, moves);
+    communication_->sendCommand(SearchLimits{}.toGoCommand());
+    lastOutputTime_ = std::chrono::steady_clock::now();
+    setState(EngineState::Analyzing);
+}
+
+bool UCIEngine::isEngineHealthy() {
+    if (!process_->isRunning()) {
+        std::cerr << "Engine process exited" << std::endl;
+        return false;
+    }
+    
+    // A bounded search only waits while Analyzing; stuck anywhere else (Stopping), nothing would answer it
+    if (activeSearch_ && state_ != EngineState::Analyzing) {
+        std::cerr << "Engine left a bounded search unanswered" << std::endl;
+        return false;
+    }
+    if (state_ != EngineState::Analyzing)
+        return true;
+    
+    // Searches print info lines regularly; after a silence, ask whether the engine still answers
+    const auto now = std::chrono::steady_clock::now();
+    if (awaitingReadyOk_) {
+        if (now - probeSentTime_ < std::chrono::milliseconds(Config::Engine::READY_TIMEOUT_MS))
+            return true;
+        std::cerr << "Engine did not answer isready" << std::endl;
+        return false;
+    }
+    if (now - lastOutputTime_ >= std::chrono::milliseconds(Config::Engine::STALL_PROBE_MS)) {
+        communication_->sendCommand("isready");
+        probeSentTime_ = now;
+        awaitingReadyOk_ = true;
+    }
+    return true;
+}
+
+bool UCIEngine::restartEngine() {
+    PROFILE_SCOPE("UCIEngine::restartEngine");
+
+    restartRequested_ = false;
+    awaitingReadyOk_ = false;
+    ++restartAttempts_;
+    
+    // A bounded search lost to the crash is retried first (once), otherwise answered empty
+    if (activeSearch_) {
+        if (activeSearch_->retries < Config::Engine::MAX_SEARCH_RETRIES) {
+            ++activeSearch_->retries;
+            std::lock_guard<std::mutex> lock(analysisMutex_);
+            pendingSearches_.push_front(std::move(*activeSearch_));
+            activeSearch_ = nullptr;
+        } else
+            completeActiveSearch("");
+    }
+    
+    // Warm state: replay every applied option (plus any still queued); the thread
+    // loop resubmits the requested position once the engine is back
+    {
+        std::lock_guard<std::mutex> lock(analysisMutex_);
+        std::vector<std::pair<std::string, std::string>> options = appliedOptions_;
+        options.insert(options.end(), pendingOptions_.begin(), pendingOptions_.end());
+        pendingOptions_.swap(options);
+        hasCurrentPosition_ = false;
+        currentAnalysis_ = EngineAnalysis();
+    }
+    
+    process_->stopEngine();
+    setState(EngineState::Connecting);
+    std::this_thread::sleep_for(std::chrono::milliseconds(Config::Engine::RESTART_BACKOFF_MS * restartAttempts_));
+    if (!enabled_)
+        return false;
+    
+    if (!initializeEngine()) {
+        process_->stopEngine();
+        restartRequested_ = true; // Try again on the next iteration
+        return false;
+    }
+    
+    setState(EngineState::Ready);
+    return true;
+}
+
+bool UCIEngine::startNextSearch() {
+    PROFILE_SCOPE("UCIEngine::startNextSearch");
+
+    {
+        std::lock_guard<std::mutex> lock(analysisMutex_);
+        if (pendingSearches_.empty())
+            return false;
+        activeSearch_ = std::make_unique<PendingSearch>(std::move(pendingSearches_.front()));
+        pendingSearches_.pop_front();
+    }
+    
+    // Interrupt interactive analysis; it restarts once the queue is empty
+    if (state_ == EngineState::Analyzing && !stopCurrentAnalysis()) {
+        restartRequested_ = true; // The restart requeues the search
+        return true;
+    }
+    {
+        std::lock_guard<std::mutex> lock(analysisMutex_);
+        currentKey_ = activeSearch_->key; // Info lines belong to the searched position, not the board
+        currentAnalysis_ = EngineAnalysis();
+        hasCurrentPosition_ = false; // Interactive analysis resumes once the queue drains
+    }
+    
+    sendPosition(activeSearch_->startFen, activeSearch_->moves);
+    communication_->sendCommand(activeSearch_->limits.toGoCommand());
+    lastOutputTime_ = std::chrono::steady_clock::now();
+    setState(EngineState::Analyzing);
+    return true;
+}
+
+void UCIEngine::completeActiveSearch(const std::string& bestMoveLine) {
+    SearchResult result;
+    result.key = activeSearch_->key;
+    UCIAnalysisParser::parseBestMove(bestMoveLine, result.bestMove, result.ponderMove);
+    {
+        std::lock_guard<std::mutex> lock(analysisMutex_);
+        currentAnalysis_.rawInfo = bestMoveLine;
+        result.analysis = currentAnalysis_;
+        result.analysis.key = result.key;
+
+        // Back to the board's position until its analysis restarts
+        currentKey_ = requestedKey_;
+        currentAnalysis_ = EngineAnalysis();
+    }
+    
+    // The engine is idle again after bestmove
+    setState(EngineState::Ready);
+    result.analysis.state = EngineState::Ready;
+    result.analysis.version = getAnalysisVersion();
+    
+    std::unique_ptr<PendingSearch> search = std::move(activeSearch_);
+    if (search->onComplete)
+        search->onComplete(result);
+    search->promise.set_value(std::move(result));
+}
+
+void UCIEngine::cancelActiveSearch() {
+    // Answer with an empty best move so waiting callers never hang
+    if (!activeSearch_)
+        return;
+    std::unique_ptr<PendingSearch> search = std::move(activeSearch_);
+    SearchResult result;
+    result.key = search->key;
+    if (search->onComplete)
+        search->onComplete(result);
+    search->promise.set_value(std::move(result));
+}
+
+void UCIEngine::cancelSearches() {
+    cancelActiveSearch();
+    clearPendingSearches();
+}
+
+void UCIEngine::sendPosition(const std::string& startFen, const std::vector<std::string>& moves) {
     const std::string standardStartpos = "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";
     
     // Send ucinewgame if this is the start of a new game (no moves and at standard starting position)
@@ -242,19 +639,27 @@ void UCIEngine::startAnalysisForPosition(const std::string& startFen, const std:
     }
     
     communication_->sendCommand(positionCommand);
-    communication_->sendCommand("go infinite");
-    state_ = EngineState::Analyzing;
 }
 
 void UCIEngine::readEngineOutput() {
-    // Peek first to avoid blocking if no data available
-    if (!communication_->hasDataAvailable())
-        return;
-    
-    // Read one line and process it
-    std::string output = communication_->readResponseLine();
-    if (!output.empty())
+    PROFILE_SCOPE("UCIEngine::readEngineOutput");
+
+    // Drain everything available (peek first to avoid blocking), so bounded
+    // searches reach bestmove without waiting a sleep interval per line
+    while (communication_->hasDataAvailable()) {
+        std::string output = communication_->readResponseLine();
+        if (output.empty())
+            break;
+        
+        // Any output proves the engine alive
+        lastOutputTime_ = std::chrono::steady_clock::now();
+        restartAttempts_ = 0;
         parseEngineOutput(output);
+        
+        // Stop after bestmove; the next queued search is started by the thread loop
+        if (state_ != EngineState::Analyzing)
+            break;
+    }
 }
 
 void UCIEngine::parseEngineOutput(const std::string& output) {
@@ -265,6 +670,12 @@ void UCIEngine::parseEngineOutput(const std::string& output) {
     if (line.empty())
         return;
     
+    // Answer to a stall probe
+    if (line == "readyok") {
+        awaitingReadyOk_ = false;
+        return;
+    }
+    
     // Ignore lines containing "currmove"
     if (UCIAnalysisParser::shouldIgnoreLine(line))
         return;
@@ -272,10 +683,17 @@ void UCIEngine::parseEngineOutput(const std::string& output) {
     // Check if it's an info line first (no lock needed for this check)
     bool isInfoLine = UCIAnalysisParser::isInfoLine(line);
     
+    // Final answer of a bounded search
+    if (activeSearch_ && UCIAnalysisParser::isBestMoveLine(line)) {
+        completeActiveSearch(line);
+        return;
+    }
+    
     if (!isInfoLine) {
         // Not an info line - just update rawInfo
         std::lock_guard<std::mutex> lock(analysisMutex_);
         currentAnalysis_.rawInfo = line;
+        analysisVersion_.fetch_add(1, std::memory_order_release);
         return;
     }
     
@@ -288,8 +706,10 @@ void UCIEngine::parseEngineOutput(const std::string& output) {
     currentAnalysis_.hasResult = true;
     
     // If we see multipv 1, clear all existing lines (new batch/depth)
-    if (analysisLine.multipv == 1)
+    if (analysisLine.multipv == 1) {
         currentAnalysis_.lines.clear();
+        currentAnalysis_.depth = analysisLine.depth;
+    }
     
     // Merge into currentAnalysis_.lines by multipv (up to 4)
     bool found = false;
@@ -302,4 +722,5 @@ void UCIEngine::parseEngineOutput(const std::string& output) {
     }
     if (!found && currentAnalysis_.lines.size() < 4)
         currentAnalysis_.lines.push_back(analysisLine);
+    analysisVersion_.fetch_add(1, std::memory_order_release);
 }
\ No newline at end of file
@@ -4,103 +4,71 @@
 #include <memory>
 #include <thread>
 #include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
 #include <mutex>
 #include <vector>
 #include <utility>
 #include "uci_process.h"
 #include "uci_communication.h"
 #include "uci_analysis_parser.h"
+#include "analysis_engine.h"
 
 /**
- * Simple non-blocking UCI engine wrapper
+ * Simple non-blocking UCI engine wrapper (AnalysisEngine backed by an engine process)
  * 
  * Key features:
  * - Completely non-blocking API for polling
  * - Internal state machine handles stopping/resetting analysis
+ * - Bounded searches (depth/nodes/movetime/mate) are queued and run back to
+ *   back; interactive infinite analysis resumes once the queue drains
+ * - Watchdog: a crashed process, a missed readyok/bestmove deadline or a
+ *   silent search restarts the engine with the options it had and the
+ *   position (or bounded search) it was working on
  * - Clean separation: you poll for updates, we manage the engine
  */
 
-enum class EngineState {
-    Disconnected,   // Not connected to engine
-    Connecting,     // Establishing connection to engine
-    Ready,          // Connected and ready for commands (not analyzing)
-    Stopping,       // Stopping current analysis (transition state)
-    Analyzing,      // Currently analyzing a position
-    Error           // Error occurred
-};
-
-struct EngineAnalysis {
-    EngineState state;              // Current engine state
-    
-    // Validity flag - indicates if analysis data is valid/available
-    bool hasResult = false;
-    
-    // Analysis data - only valid when hasResult is true
-    std::string fen;                // Position relevant to the analysis
-    std::string rawInfo;            // data for printing to the screen
-    
-    std::vector<AnalysisLine> lines; // Up to 4 analysis lines
-};
-
-class UCIEngine {
+class UCIEngine : public AnalysisEngine {
 public:
     UCIEngine(const std::string& enginePath);
-    ~UCIEngine();
+    ~UCIEngine() override;
     
     // Non-copyable
     UCIEngine(const UCIEngine&) = delete;
     UCIEngine& operator=(const UCIEngine&) = delete;
-    
-
 
-
-    /**
-     * Set the position to analyze
-     * This is non-blocking and returns immediately.
-     * Internal state machine will handle stopping current analysis if needed.
-     * Call pollAnalysis() to get updates.
-     * 
-     * @param startFen The starting position FEN (where the game aka the move sequence began)
-     * @param moves The list of moves from startFen to the current position
-     */
-    void setPosition(const std::string& startFen, const std::vector<std::string>& moves);
-    
-    /**
-     * Poll for current analysis state
-     * This updates internal state and returns latest analysis.
-     * Should be called regularly (e.g., every frame in raylib).
-     * Returns immediately, never blocks.
-     * 
-     * Gracefully handles situations where engine has no result yet:
-     * - The hasResult field indicates if analysis data is valid
-     * - When hasResult==false, do not access other analysis data fields
-     * - Never throws exceptions
-     * - State field indicates what engine is currently doing
-     */
-    EngineAnalysis pollAnalysis();
+    // AnalysisEngine
+    void setPosition(const std::string& startFen, const std::vector<std::string>& moves, const PositionKey& key) override;
+    bool isPositionRequested(const PositionKey& key) const override;
+    void clearPendingSearches() override;
+    std::future<SearchResult> requestSearch(
+        const std::string& startFen, 
+        const std::vector<std::string>& moves, 
+        const PositionKey& key,
+        const SearchLimits& limits,
+        SearchCallback onComplete = nullptr) override;
+    EngineAnalysis pollAnalysis() override;
+    uint64_t getAnalysisVersion() const override;
+    void enable() override;                 // Connects to and initializes the engine process
+    void disable() override;                // Stops analysis and the engine process
+    bool isEnabled() const override;
+    void configure(const EngineSettings& settings) override; // Sent between searches (after isready/readyok)
+    EngineSettings getSettings() const override;
+    void clearAnalysis() override;          // Asynchronous: the analysis thread stops and clears
     
     /**
-     * Enable the engine
-     * Connects to and initializes the engine if not already connected.
+     * Set any advertised option by name (same timing rules as configure())
      */
-    void enable();
+    void setOption(const std::string& name, const std::string& value);
     
     /**
-     * Disable the engine
-     * Stops all analysis and disconnects from the engine.
+     * Options advertised by the engine, with the values last sent
+     * Empty until the engine has been enabled once.
      */
-    void disable();
-    
-    /**
-     * Check if the engine is currently enabled
-     */
-    bool isEnabled() const;
-    
-    /**
-     * Clear current analysis output
-     * Stops current analysis and clears all displayed results
-     */
-    void clearAnalysis();
+    std::vector<UCIOption> getOptions() const;
     
 private:
     // Engine components
@@ -111,28 +79,74 @@ private:
     // Engine state
     std::atomic<EngineState> state_;
     std::atomic<bool> enabled_;
+    std::atomic<uint64_t> analysisVersion_;
     
     // Analysis thread
     std::unique_ptr<std::thread> analysisThread_;
-    std::mutex analysisMutex_;
+    mutable std::mutex analysisMutex_;
     EngineAnalysis currentAnalysis_;
     
     // Position tracking - protected by analysisMutex_
     std::string requestedStartFen_;      // Starting FEN requested by setPosition()
     std::vector<std::string> requestedMoves_; // Moves requested by setPosition()
+    PositionKey requestedKey_;           // Identity of the requested line
     std::string currentStartFen_;        // Starting FEN currently being analyzed
-    std::vector<std::string> currentMoves_;  // Moves currently being analyzed
+    PositionKey currentKey_;             // Identity of the line currently being analyzed
+    bool hasRequestedPosition_ = false;
+    bool hasCurrentPosition_ = false;
+    bool clearRequested_ = false;        // Set by clearAnalysis(); the analysis thread stops and resets
+    
+    // Engine options - protected by analysisMutex_
+    EngineSettings settings_;
+    std::vector<std::pair<std::string, std::string>> pendingOptions_; // Name/value, applied in order
+    std::vector<UCIOption> options_;     // Snapshot of the communication option table
+    std::vector<std::pair<std::string, std::string>> appliedOptions_; // Latest value per name, replayed on restart
+    
+    // Watchdog - analysis thread only (restartRequested_ may be set from any thread)
+    std::atomic<bool> restartRequested_;
+    std::chrono::steady_clock::time_point lastOutputTime_; // Last line read while analyzing
+    std::chrono::steady_clock::time_point probeSentTime_;  // When the stall probe (isready) was sent
+    bool awaitingReadyOk_ = false;
+    int restartAttempts_ = 0;            // Consecutive restarts without engine output
+    
+    // Bounded searches
+    struct PendingSearch {
+        std::string startFen;
+        std::vector<std::string> moves;
+        PositionKey key;
+        SearchLimits limits;
+        SearchCallback onComplete;
+        std::promise<SearchResult> promise;
+        int retries = 0;                 // Restarts this search has already survived
+    };
+    std::deque<PendingSearch> pendingSearches_;     // Protected by analysisMutex_
+    std::unique_ptr<PendingSearch> activeSearch_;   // Analysis thread only (and disable() after join)
+    
+    // State transitions (bumps the snapshot version)
+    void setState(EngineState state);
     
     // Engine initialization
     bool initializeEngine();
+    void queueSettings(const EngineSettings& settings); // Caller holds analysisMutex_
+    bool applyPendingOptions();
+    
+    // Watchdog
+    bool isEngineHealthy();              // Process alive and answering (sends stall probes)
+    bool restartEngine();                // Restart with the applied options; requeues the active search
     
     // Analysis thread function
     void analysisThreadFunction();
     
     // Analysis thread helpers
+    void handleClearRequest();
     void handlePositionTransition();
     void startAnalysisForPosition(const std::string& startFen, const std::vector<std::string>& moves);
-    void stopCurrentAnalysis();
+    void sendPosition(const std::string& startFen, const std::vector<std::string>& moves);
+    bool startNextSearch();
+    void completeActiveSearch(const std::string& bestMoveLine);
+    void cancelActiveSearch();           // Answers the active search (empty)
+    void cancelSearches();
+    bool stopCurrentAnalysis();          // False if bestmove missed its deadline
     void readEngineOutput();
     
     // Output parsing
@@ -0,0 +1,134 @@
+#include "uci_options.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <sstream>
+
+bool UCIOptionTable::parseOptionLine(const std::string& line) {
+    std::istringstream stream(line);
+    std::string token;
+    if (!(stream >> token) || token != "option")
+        return false;
+    
+    // Split into keyword sections; names and values may contain spaces
+    UCIOption option;
+    std::string section;
+    std::string text;
+    auto flushSection = [&]() {
+        if (section == "name")
+            option.name = text;
+        else if (section == "type") {
+            if (text == "check")
+                option.type = UCIOptionType::Check;
+            else if (text == "spin")
+                option.type = UCIOptionType::Spin;
+            else if (text == "combo")
+                option.type = UCIOptionType::Combo;
+            else if (text == "button")
+                option.type = UCIOptionType::Button;
+            else
+                option.type = UCIOptionType::String;
+        } else if (section == "default")
+            option.defaultValue = (text == "<empty>") ? "" : text;
+        else if (section == "min")
+            option.min = std::strtoll(text.c_str(), nullptr, 10);
+        else if (section == "max")
+            option.max = std::strtoll(text.c_str(), nullptr, 10);
+        else if (section == "var")
+            option.vars.push_back(text);
+        text.clear();
+    };
+    
+    while (stream >> token) {
+        const bool isKeyword = 
+            token == "name" || token == "type" || token == "default" || 
+            token == "min" || token == "max" || token == "var";
+        // "name" content may itself contain keywords only before "type"
+        if (isKeyword && !(section == "name" && token != "type")) {
+            flushSection();
+            section = token;
+        } else {
+            if (!text.empty())
+                text += " ";
+            text += token;
+        }
+    }
+    flushSection();
+    
+    if (option.name.empty())
+        return false;
+    
+    option.value = option.defaultValue;
+    
+    // Engines should not repeat options, but keep the latest definition if they do
+    if (UCIOption* existing = findMutable(option.name))
+        *existing = option;
+    else
+        options_.push_back(option);
+    return true;
+}
+
+const UCIOption* UCIOptionTable::find(const std::string& name) const {
+    for (const auto& option : options_) {
+        if (equalsIgnoreCase(option.name, name))
+            return &option;
+    }
+    return nullptr;
+}
+
+bool UCIOptionTable::normalizeValue(const std::string& name, const std::string& value, std::string& normalized) const {
+    const UCIOption* option = find(name);
+    if (!option)
+        return false;
+    
+    switch (option->type) {
+        case UCIOptionType::Spin: {
+            char* end = nullptr;
+            long long number = std::strtoll(value.c_str(), &end, 10);
+            if (end == value.c_str())
+                return false;
+            number = std::clamp<long long>(number, option->min, option->max);
+            normalized = std::to_string(number);
+            return true;
+        }
+        case UCIOptionType::Check:
+            if (value != "true" && value != "false")
+                return false;
+            normalized = value;
+            return true;
+        case UCIOptionType::Combo:
+            for (const auto& var : option->vars) {
+                if (equalsIgnoreCase(var, value)) {
+                    normalized = var;
+                    return true;
+                }
+            }
+            return false;
+        case UCIOptionType::Button:
+            normalized.clear();
+            return true;
+        default:
+            normalized = value;
+            return true;
+    }
+}
+
+void UCIOptionTable::setValue(const std::string& name, const std::string& value) {
+    if (UCIOption* option = findMutable(name))
+        option->value = value;
+}
+
+UCIOption* UCIOptionTable::findMutable(const std::string& name) {
+    for (auto& option : options_) {
+        if (equalsIgnoreCase(option.name, name))
+            return &option;
+    }
+    return nullptr;
+}
+
+bool UCIOptionTable::equalsIgnoreCase(const std::string& a, const std::string& b) {
+    return a.size() == b.size() &&
+        std::equal(a.begin(), a.end(), b.begin(), [](char x, char y) {
+            return std::tolower(static_cast<unsigned char>(x)) == std::tolower(static_cast<unsigned char>(y));
+        });
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * Option types advertised by a UCI engine in its "option" lines
+ */
+enum class UCIOptionType {
+    Check,      // true/false
+    Spin,       // Integer within [min, max]
+    Combo,      // One of a fixed list of strings
+    Button,     // Action without a value
+    String      // Free text (file paths etc.)
+};
+
+/**
+ * One engine option as advertised after the "uci" command
+ */
+struct UCIOption {
+    std::string name;
+    UCIOptionType type = UCIOptionType::String;
+    std::string defaultValue;
+    std::string value;              // Last value sent (defaultValue until changed)
+    int64_t min = 0;                // Spin only
+    int64_t max = 0;                // Spin only
+    std::vector<std::string> vars;  // Combo only
+};
+
+/**
+ * Typed table of the options an engine supports
+ * Filled from "option name <id> type <t> [default <x>] [min <x>] [max <x>] [var <x>]*" lines
+ */
+class UCIOptionTable {
+public:
+    /**
+     * Parse a single "option ..." line and add it to the table
+     * @param line The raw line from the engine
+     * @return true if the line was an option line and was added
+     */
+    bool parseOptionLine(const std::string& line);
+    
+    /**
+     * Find an option by name (UCI option names are case-insensitive)
+     * @return Pointer into the table, or nullptr if the engine does not support it
+     */
+    const UCIOption* find(const std::string& name) const;
+    
+    /**
+     * Validate a value for an option, clamping spins to their range
+     * @param name Option name
+     * @param value Requested value
+     * @param normalized Receives the value to send
+     * @return false if the option is unknown or the value is not allowed
+     */
+    bool normalizeValue(const std::string& name, const std::string& value, std::string& normalized) const;
+    
+    // Record a value that was sent to the engine
+    void setValue(const std::string& name, const std::string& value);
+    
+    const std::vector<UCIOption>& getOptions() const { return options_; }
+    void clear() { options_.clear(); }
+    
+private:
+    std::vector<UCIOption> options_;
+    
+    UCIOption* findMutable(const std::string& name);
+    static bool equalsIgnoreCase(const std::string& a, const std::string& b);
+};
@@ -0,0 +1,451 @@
+#include "batch_analyzer.h"
+#include "../config/config.h"
+#include "../core/fen_loader.h"
+#include "../core/san_formatter.h"
+#include "../analysis_engine/native_engine.h"
+#include "../analysis_engine/uci_engine.h"
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+#include <thread>
+
+namespace BatchCfg = Config::Batch;
+using MoveResult = ChessMoveValidator::MoveResult;
+
+bool BatchOptions::parseArguments(int argc, char* argv[], BatchOptions& options) {
+    options = BatchOptions{};
+    options.outputPrefix = BatchCfg::OUTPUT_PREFIX;
+
+    for (int i = 1; i < argc; i++) {
+        const std::string argument = argv[i];
+        const bool hasValue = (i + 1 < argc);
+        try {
+            if (argument == "--batch" && hasValue)
+                options.inputPath = argv[++i];
+            else if (argument == "--output" && hasValue)
+                options.outputPrefix = argv[++i];
+            else if (argument == "--engines" && hasValue)
+                options.engines = std::stoi(argv[++i]);
+            else if (argument == "--depth" && hasValue)
+                options.depth = std::stoi(argv[++i]);
+            else if (argument == "--movetime" && hasValue)
+                options.movetimeMs = std::stoi(argv[++i]);
+            else if (argument == "--resume")
+                options.resume = true;
+            else if (argument == "--native")
+                options.native = true;
+            else
+                return false;
+        } catch (const std::exception&) {
+            return false; // Non-numeric value
+        }
+    }
+    return !options.inputPath.empty() && !options.outputPrefix.empty() &&
+        options.engines >= 0 && options.depth >= 0 && options.movetimeMs >= 0;
+}
+
+const char* BatchOptions::getUsage() {
+    return "Usage: --batch <file.epd> [--output <prefix>] [--engines N] [--depth D] [--movetime MS] [--resume] [--native]";
+}
+
+BatchAnalyzer::BatchAnalyzer(const BatchOptions& options) :
+    options(options) {
+
+    limits.depth = options.depth;
+    limits.movetimeMs = options.movetimeMs;
+    if (!limits.isBounded())
+        limits.movetimeMs = BatchCfg::MOVETIME_MS;
+}
+
+BatchAnalyzer::~BatchAnalyzer() {
+    // Engines answer (empty) whatever is still queued while shutting down
+    for (auto& engine : engines)
+        engine->disable();
+}
+
+int BatchAnalyzer::run() {
+    EPDReader reader(options.inputPath);
+    if (!reader.isOpen()) {
+        std::cerr << "Cannot open " << options.inputPath << std::endl;
+        return 1;
+    }
+
+    // Resuming fixes the shard count (and so the engine count)
+    if (options.resume && !loadCheckpoint())
+        return 1;
+    const int hardwareThreads = static_cast<int>(std::thread::hardware_concurrency());
+    const int requestedEngines =
+        (options.engines > 0) ?
+        options.engines :
+        (BatchCfg::ENGINES > 0) ?
+        BatchCfg::ENGINES :
+        std::max(1, hardwareThreads / BatchCfg::THREADS_PER_ENGINE);
+    const int engineCount =
+        options.resume ?
+        static_cast<int>(shards.size()) :
+        requestedEngines;
+    if (!options.resume)
+        shards = std::vector<Shard>(engineCount);
+
+    if (!openShards(options.resume) || !startEngines(engineCount))
+        return 1;
+    if (reader.skip(nextIndex) != nextIndex) {
+        std::cerr << "Input has fewer positions than the checkpoint" << std::endl;
+        return 1;
+    }
+
+    const auto startTime = std::chrono::steady_clock::now();
+    const uint64_t startIndex = nextIndex;
+    uint64_t lastCheckpointIndex = nextIndex;
+    EPDRecord record;
+    bool hasRecord = false;                 // Read but not yet dispatched (engines busy)
+    bool isEndOfInput = false;
+    bool failed = false;
+    ChessBoard board;
+    ChessGameState gameState{board};
+
+    while (true) {
+        // Keep every engine's queue full
+        bool progressed = false;
+        while (!isEndOfInput) {
+            if (!hasRecord) {
+                if (!reader.next(record)) {
+                    isEndOfInput = true;
+                    break;
+                }
+                hasRecord = true;
+
+                // Invalid positions are reported and skipped; engines may crash on them
+                if (!FENLoader::loadPosition(record.fen, board, gameState)) {
+                    std::cerr << "Line " << record.lineNumber << ": invalid position skipped" << std::endl;
+                    pendingInvalid.push_back(record.index);
+                    nextIndex = record.index + 1;
+                    hasRecord = false;
+                    continue;
+                }
+            }
+            if (!dispatch(record))
+                break;
+            nextIndex = record.index + 1;
+            hasRecord = false;
+            progressed = true;
+        }
+
+        progressed |= (collectResults(failed) > 0);
+        if (failed)
+            break;
+
+        const bool isDone = isEndOfInput &&
+            std::all_of(inFlight.begin(), inFlight.end(), [](const auto& queue) { return queue.empty(); });
+        if (isDone)
+            break;
+
+        // Periodic checkpoint and progress
+        if (getWatermark() - lastCheckpointIndex >= static_cast<uint64_t>(BatchCfg::CHECKPOINT_INTERVAL)) {
+            if (!writeCheckpoint())
+                return 1;
+            lastCheckpointIndex = getWatermark();
+            const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+            std::cout << completed << " positions ("
+                      << static_cast<uint64_t>((lastCheckpointIndex - startIndex) / std::max(seconds, 0.001))
+                      << "/s)" << std::endl;
+        }
+
+        if (!progressed)
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    // A failed search stays in flight, so the watermark stops right before it
+    if (!writeCheckpoint())
+        return 1;
+    if (failed) {
+        std::cerr << "Engine failure; rerun with --resume to continue from position " << getWatermark() << std::endl;
+        return 1;
+    }
+
+    std::cout << completed << " positions analyzed, " << invalid << " invalid";
+    if (scored > 0)
+        std::cout << ", solved " << solved << "/" << scored;
+    std::cout << std::endl;
+    return 0;
+}
+
+bool BatchAnalyzer::startEngines(int engineCount) {
+    EngineSettings settings = EngineSettings::fromConfig();
+    settings.threads = BatchCfg::THREADS_PER_ENGINE;
+    settings.hashMb = BatchCfg::HASH_MB;
+    settings.multiPV = 1;
+
+    for (int i = 0; i < engineCount; i++) {
+        std::unique_ptr<AnalysisEngine> engine;
+        if (options.native)
+            engine = std::make_unique<NativeEngine>();
+        else
+            engine = std::make_unique<UCIEngine>(Config::Engine::PATH);
+        engine->configure(settings);
+        engine->enable();
+        if (!engine->isEnabled()) {
+            std::cerr << "Failed to start engine " << i << " (" <<
+                (options.native ? "native" : Config::Engine::PATH) << ")" << std::endl;
+            return false;
+        }
+        engines.push_back(std::move(engine));
+    }
+    inFlight.resize(engines.size());
+    return true;
+}
+
+bool BatchAnalyzer::openShards(bool resume) {
+    for (size_t i = 0; i < shards.size(); i++) {
+        const std::string path = getShardPath(i);
+        Shard& shard = shards[i];
+
+        // Drop results written after the last checkpoint; they are recomputed
+        if (resume) {
+            std::error_code error;
+            std::filesystem::resize_file(path, shard.committedSize, error);
+            if (error) {
+                std::cerr << "Cannot truncate " << path << ": " << error.message() << std::endl;
+                return false;
+            }
+        }
+
+        // Binary: sizes in the checkpoint are byte offsets
+        shard.file.open(path, std::ios::binary | (resume ? std::ios::app : std::ios::trunc));
+        if (!shard.file.is_open()) {
+            std::cerr << "Cannot open " << path << std::endl;
+            return false;
+        }
+        shard.size = shard.committedSize;
+    }
+    return true;
+}
+
+bool BatchAnalyzer::loadCheckpoint() {
+    std::ifstream file(getCheckpointPath());
+    if (!file.is_open()) {
+        std::cerr << "No checkpoint at " << getCheckpointPath() << std::endl;
+        return false;
+    }
+
+    // "<key> <value>" lines; shard lines are "shard <index> <size>"
+    std::string key;
+    std::string inputPath;
+    while (file >> key) {
+        if (key == "input") {
+            file >> std::ws;
+            std::getline(file, inputPath);
+        } else if (key == "shards") {
+            size_t count = 0;
+            file >> count;
+            shards = std::vector<Shard>(count);
+        } else if (key == "next")
+            file >> nextIndex;
+        else if (key == "completed")
+            file >> completed;
+        else if (key == "invalid")
+            file >> invalid;
+        else if (key == "scored")
+            file >> scored;
+        else if (key == "solved")
+            file >> solved;
+        else if (key == "shard") {
+            size_t index = 0;
+            uint64_t size = 0;
+            file >> index >> size;
+            if (index < shards.size())
+                shards[index].committedSize = size;
+        }
+    }
+
+    if (inputPath != options.inputPath || shards.empty()) {
+        std::cerr << "Checkpoint does not belong to " << options.inputPath << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool BatchAnalyzer::dispatch(EPDRecord& record) {
+    // Least busy engine with room in its queue
+    size_t best = inFlight.size();
+    for (size_t i = 0; i < inFlight.size(); i++) {
+        if (inFlight[i].size() < static_cast<size_t>(BatchCfg::SEARCHES_PER_ENGINE) &&
+                (best == inFlight.size() || inFlight[i].size() < inFlight[best].size()))
+            best = i;
+    }
+    if (best == inFlight.size())
+        return false;
+
+    InFlight search;
+    search.result = engines[best]->requestSearch(record.fen, {}, PositionKey{record.index, 0}, limits);
+    search.record = std::move(record);
+    inFlight[best].push_back(std::move(search));
+    return true;
+}
+
+int BatchAnalyzer::collectResults(bool& failed) {
+    int collected = 0;
+    for (size_t i = 0; i < inFlight.size(); i++) {
+        // Each engine answers in order; stop at the first unfinished search
+        auto& queue = inFlight[i];
+        while (!queue.empty() &&
+                queue.front().result.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+            SearchResult result = queue.front().result.get();
+            if (result.bestMove.empty()) {
+                failed = true; // Engine gave up (watchdog); keep the position unfinished
+                return collected;
+            }
+            writeResult(i, queue.front().record, result);
+            queue.pop_front();
+            collected++;
+        }
+    }
+    return collected;
+}
+
+void BatchAnalyzer::writeResult(size_t shardIndex, const EPDRecord& record, const SearchResult& result) {
+    // Principal line score, from the side to move's point of view
+    std::string score = "-";
+    auto line = std::find_if(result.analysis.lines.begin(), result.analysis.lines.end(),
+        [](const AnalysisLine& candidate) { return candidate.multipv == 1; });
+    if (line != result.analysis.lines.end() && line->hasScore)
+        score =
+            line->isMate ?
+            "mate " + std::to_string(line->mateIn) :
+            "cp " + std::to_string(line->scoreCp);
+
+    const bool isScored = !record.bestMoves.empty() || !record.avoidMoves.empty();
+    const bool isSolvedRecord = isScored && isSolved(record, result.bestMove);
+    const std::string verdict =
+        !isScored ?
+        "-" :
+        isSolvedRecord ?
+        "solved" :
+        "failed";
+
+    // index, id, fen, best move, score, depth, bm/am verdict
+    const std::string text =
+        std::to_string(record.index) + "\t" +
+        (record.id.empty() ? "-" : record.id) + "\t" +
+        record.fen + "\t" +
+        result.bestMove + "\t" +
+        score + "\t" +
+        std::to_string(result.analysis.depth) + "\t" +
+        verdict + "\n";
+
+    Shard& shard = shards[shardIndex];
+    shard.file << text;
+    shard.size += text.size();
+    shard.written.push_back({record.index, shard.size, isScored, isSolvedRecord});
+}
+
+bool BatchAnalyzer::isSolved(const EPDRecord& record, const std::string& bestMove) const {
+    // EPD moves are usually SAN, but some suites use UCI
+    const std::string san = stripAnnotations(toSAN(record.fen, bestMove));
+    auto matches = [&](const std::vector<std::string>& moves) {
+        return std::any_of(moves.begin(), moves.end(), [&](const std::string& move) {
+            const std::string expected = stripAnnotations(move);
+            return expected == bestMove || (!san.empty() && expected == san);
+        });
+    };
+
+    if (!record.bestMoves.empty() && !matches(record.bestMoves))
+        return false;
+    return !matches(record.avoidMoves);
+}
+
+uint64_t BatchAnalyzer::getWatermark() const {
+    // Queues are in input order, so their fronts are the oldest unfinished positions
+    uint64_t watermark = nextIndex;
+    for (const auto& queue : inFlight) {
+        if (!queue.empty())
+            watermark = std::min(watermark, queue.front().record.index);
+    }
+    return watermark;
+}
+
+bool BatchAnalyzer::writeCheckpoint() {
+    // Commit everything below the watermark; later results are redone on resume
+    const uint64_t watermark = getWatermark();
+    for (Shard& shard : shards) {
+        while (!shard.written.empty() && shard.written.front().index < watermark) {
+            const WrittenResult& written = shard.written.front();
+            shard.committedSize = written.sizeAfter;
+            completed++;
+            scored += written.isScored ? 1 : 0;
+            solved += written.isSolved ? 1 : 0;
+            shard.written.pop_front();
+        }
+        shard.file.flush();
+        if (!shard.file.good()) {
+            std::cerr << "Write failed: " << options.outputPrefix << std::endl;
+            return false;
+        }
+    }
+    while (!pendingInvalid.empty() && pendingInvalid.front() < watermark) {
+        invalid++;
+        pendingInvalid.pop_front();
+    }
+
+    // Write then rename, so an interrupted write never leaves a torn checkpoint
+    const std::string path = getCheckpointPath();
+    const std::string temporaryPath = path + ".tmp";
+    {
+        std::ofstream file(temporaryPath, std::ios::trunc);
+        file << "input " << options.inputPath << "\n"
+             << "shards " << shards.size() << "\n"
+             << "next " << watermark << "\n"
+             << "completed " << completed << "\n"
+             << "invalid " << invalid << "\n"
+             << "scored " << scored << "\n"
+             << "solved " << solved << "\n";
+        for (size_t i = 0; i < shards.size(); i++)
+            file << "shard " << i << " " << shards[i].committedSize << "\n";
+        if (!file.good()) {
+            std::cerr << "Cannot write " << temporaryPath << std::endl;
+            return false;
+        }
+    }
+
+    std::error_code error;
+    std::filesystem::rename(temporaryPath, path, error);
+    if (error) {
+        std::cerr << "Cannot replace " << path << ": " << error.message() << std::endl;
+        return false;
+    }
+    return true;
+}
+
+std::string BatchAnalyzer::getShardPath(size_t shardIndex) const {
+    return options.outputPrefix + "." + std::to_string(shardIndex) + ".tsv";
+}
+
+std::string BatchAnalyzer::getCheckpointPath() const {
+    return options.outputPrefix + ".checkpoint";
+}
+
+std::string BatchAnalyzer::toSAN(const std::string& fen, const std::string& uciMove) {
+    const ChessMove move = ChessMove::fromUCI(uciMove);
+    if (move.isNull())
+        return "";
+    ChessBoard board;
+    ChessGameState gameState{board};
+    if (!FENLoader::loadPosition(fen, board, gameState))
+        return "";
+
+    const ChessMoveValidator validator;
+    const MoveResult result = validator.validateMove(board, gameState, move);
+    if (!validator.isValidMoveResult(result))
+        return "";
+
+    // Promotions keep the engine's piece
+    return SANFormatter::formatMove(board, gameState, validator, validator.getFlaggedMove(move, result), result);
+}
+
+std::string BatchAnalyzer::stripAnnotations(const std::string& move) {
+    std::string stripped = move;
+    while (!stripped.empty() && std::string("+#!?").find(stripped.back()) != std::string::npos)
+        stripped.pop_back();
+    return stripped;
+}
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+#include "../analysis_engine/analysis_engine.h"
+#include "../core/epd_reader.h"
+
+// Command line options of the headless batch mode
+struct BatchOptions {
+    std::string inputPath;
+    std::string outputPrefix;
+    int engines = 0;                // 0 = Config::Batch::ENGINES (auto)
+    int depth = 0;                  // 0 = use movetime
+    int movetimeMs = 0;             // 0 = Config::Batch::MOVETIME_MS (when depth is unset too)
+    bool resume = false;            // Continue from <prefix>.checkpoint
+    bool native = false;            // Built-in search instead of Config::Engine::PATH
+
+    // "--batch <file> [--output <prefix>] [--engines N] [--depth D] [--movetime MS] [--resume] [--native]"
+    static bool parseArguments(int argc, char* argv[], BatchOptions& options);
+    static const char* getUsage();
+};
+
+/**
+ * Headless analysis of EPD/FEN position sets (test suites, dataset labeling)
+ *
+ * Key features:
+ * - Input is streamed (EPDReader); only the positions in flight are in memory
+ * - Positions are validated with FENLoader before reaching an engine
+ * - A pool of engine processes; each engine has its own output shard, written
+ *   in input order, so shards can be merged by index
+ * - Checkpoints record the first position not yet finished plus every shard's
+ *   size at that point; --resume truncates the shards to those sizes and
+ *   continues, so no position is lost or written twice
+ * - bm/am opcodes are scored against the engine move (SAN or UCI)
+ */
+class BatchAnalyzer {
+public:
+    explicit BatchAnalyzer(const BatchOptions& options);
+    ~BatchAnalyzer();
+
+    // Run to completion; returns the process exit code
+    int run();
+
+private:
+    struct InFlight {
+        EPDRecord record;
+        std::future<SearchResult> result;
+    };
+
+    struct WrittenResult {
+        uint64_t index;
+        uint64_t sizeAfter;                              // Shard size including this result
+        bool isScored;
+        bool isSolved;
+    };
+
+    struct Shard {
+        std::ofstream file;
+        uint64_t size = 0;                               // Bytes written so far
+        uint64_t committedSize = 0;                      // Size at the last checkpoint
+        std::deque<WrittenResult> written;               // Since the last checkpoint
+    };
+
+    BatchOptions options;
+    SearchLimits limits;
+    std::vector<std::unique_ptr<AnalysisEngine>> engines;
+    std::vector<std::deque<InFlight>> inFlight;          // Per engine, in input order
+    std::vector<Shard> shards;                           // One per engine
+
+    std::deque<uint64_t> pendingInvalid;                 // Invalid positions since the last checkpoint
+
+    // Totals up to the last checkpoint (persisted in it)
+    uint64_t nextIndex = 0;                              // Next position to read
+    uint64_t completed = 0;
+    uint64_t invalid = 0;
+    uint64_t scored = 0;                                 // Positions with bm/am
+    uint64_t solved = 0;
+
+    // Setup
+    bool startEngines(int engineCount);
+    bool openShards(bool resume);
+    bool loadCheckpoint();
+
+    // Main loop helpers
+    bool dispatch(EPDRecord& record);                    // Queue on the least busy engine
+    int collectResults(bool& failed);                    // Write finished searches; returns how many
+    void writeResult(size_t shardIndex, const EPDRecord& record, const SearchResult& result);
+    bool isSolved(const EPDRecord& record, const std::string& bestMove) const;
+    uint64_t getWatermark() const;                       // Every position below it is finished
+    bool writeCheckpoint();
+
+    // Paths
+    std::string getShardPath(size_t shardIndex) const;
+    std::string getCheckpointPath() const;
+
+    // Move matching
+    static std::string toSAN(const std::string& fen, const std::string& uciMove);
+    static std::string stripAnnotations(const std::string& move); // Drop +, #, ! and ?
+};
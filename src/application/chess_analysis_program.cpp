@@ -1,13 +1,22 @@
 #include "chess_analysis_program.h"
 #include "../core/fen_loader.h"
-#include <sstream>
+#include "../core/san_formatter.h"
+#include "../analysis_engine/native_engine.h"
+#include "../analysis_engine/uci_engine.h"
+#include "../profiling/profiler.h"
+#include <filesystem>
+#include <fstream>
 #include <vector>
 namespace GOCfg = Config::GameOver;
+namespace EngineCfg = Config::Engine;
+namespace DatabaseCfg = Config::Database;
 
 ChessAnalysisProgram::ChessAnalysisProgram() : 
     board{}, gameState{board}, fenStateHistory{}, moveValidator{},
     inputHandler{*this}, gameStateAnalyzer{}, 
-    uciEngine{std::make_unique<UCIEngine>("src/analysis_engine/stockfish.exe")},
+    uciEngine{createAnalysisEngine()},
+    analysisCache{static_cast<size_t>(EngineCfg::ANALYSIS_CACHE_SIZE)},
+    speculativeEngine{createAnalysisEngine()},
     gui{std::make_unique<ChessGUI>(*this)}, currentGameState{GameState::IN_PROGRESS}
     {
     // Initialize board to starting position first
@@ -42,26 +51,99 @@ ChessAnalysisProgram::ChessAnalysisProgram() :
         std::string loadedFEN = tempTracker.getCurrentPosition();
         fenStateHistory.setStartingPosition(loadedFEN);
     }
+
+    // The game database is optional; without its files the database panels say so
+    gameDatabase.open(DatabaseCfg::INDEX_PATH);
+    openingExplorer.open(DatabaseCfg::EXPLORER_PATH);
 }
 
 ChessAnalysisProgram::~ChessAnalysisProgram() 
 {}
 
 void ChessAnalysisProgram::run() {
+    PROFILE_THREAD("Main");
+
     // Main loop
     while (!WindowShouldClose()) { // Detect window close button or ESC key
+        PROFILE_FRAME();
         inputHandler.handleInput(*gui); // Input handler processes input through controller
-        gui->draw(); // GUI only renders
+        collectExternalChanges();
+
+        // A new position gets its legal moves before it is drawn or a piece is dragged on it
+        if (dirtyFlags & DirtyFlags::BOARD) {
+            refreshLegalMoves();
+            refreshDatabaseLookups();
+        }
+
+        // Nothing changed: sleep and poll events instead of presenting an identical frame
+        if (dirtyFlags == DirtyFlags::NONE) {
+            WaitTime(Config::Window::IDLE_WAIT_SECONDS);
+            PollInputEvents();
+            continue;
+        }
+
+        gui->draw(dirtyFlags); // GUI only renders
+        dirtyFlags = DirtyFlags::NONE;
+    }
+}
+
+void ChessAnalysisProgram::collectExternalChanges() {
+    // New engine snapshot (results or state transition) or new cached analysis
+    uint64_t engineVersion = getUCIEngineAnalysisVersion();
+    if (engineVersion != lastEngineVersion) {
+        lastEngineVersion = engineVersion;
+        markDirty(DirtyFlags::ENGINE);
+
+        // Keep live results so revisiting a position is instant, and pre-analyze likely replies
+        if (isUCIEngineEnabled()) {
+            EngineAnalysis liveAnalysis = uciEngine->pollAnalysis();
+            analysisCache.store(liveAnalysis.key, liveAnalysis);
+            scheduleReplySpeculation(liveAnalysis);
+        }
+    }
+
+    // New review results (eval graph)
+    uint64_t reviewVersion = gameReview.getVersion();
+    if (reviewVersion != lastReviewVersion) {
+        lastReviewVersion = reviewVersion;
+        markDirty(DirtyFlags::ENGINE);
     }
+
+    // Window events
+    bool isWindowFocused = IsWindowFocused();
+    if (IsWindowResized() || isWindowFocused != wasWindowFocused)
+        markDirty(DirtyFlags::WINDOW);
+    wasWindowFocused = isWindowFocused;
+
+    // The profiler overlay shows live timings, so keep presenting while it is visible
+    if (isProfilerOverlayVisible)
+        markDirty(DirtyFlags::OVERLAY);
 }
 
 // Move validation and execution methods (Controller coordination)
 bool ChessAnalysisProgram::attemptMove(const ChessMove& move) {
-    // 1. Validate the move using the validator
-    MoveResult validationResult = moveValidator.validateMove(board, gameState, move);
+    PROFILE_SCOPE("ChessAnalysisProgram::attemptMove");
+
+    // 1. Look the move up in the cached legal moves (no-op refresh unless the position changed unseen)
+    refreshLegalMoves();
+    MoveResult validationResult = MoveResult::INVALID_ILLEGAL_MOVE;
+    ChessMove playedMove;
+    if (legalMoves.isValid()) {
+        // Generated moves carry their special move type (promotions always promote to a queen)
+        playedMove = legalMoves.findMove(move);
+        if (!playedMove.isNull())
+            validationResult = moveValidator.getMoveResult(playedMove);
+    } else {
+        // Boards without a legal position (not one king per side) go through the full validator
+        validationResult = moveValidator.validateMove(board, gameState, move);
+        playedMove = moveValidator.getFlaggedMove(move, validationResult);
+    }
 
     // 2. If valid move, execute the move and switch turns
     if (isValidMoveResult(validationResult)) {
+        // SAN depends on the position before the move (disambiguation, captures)
+        std::string sanMove = SANFormatter::formatMove(board, gameState, moveValidator, playedMove, validationResult);
+
         // Update ChessGameState
         gameState.makeMove(move);
 
@@ -70,24 +152,21 @@ bool ChessAnalysisProgram::attemptMove(const ChessMove& move) {
             board.executeCastling(move);
         else if (validationResult == MoveResult::VALID_EN_PASSANT)
             board.executeEnPassant(move);
-        else if (validationResult == MoveResult::VALID_PROMOTION) {
-            // Set the piece to promote to
-            char promoteTo =
-                (getCurrentPlayer() == 'w') ?
-                'q' :
-                'Q';
-            board.executePromotion(move, promoteTo);
-        } else
+        else if (validationResult == MoveResult::VALID_PROMOTION)
+            board.executePromotion(playedMove);
+        else
             board.executeBasicMove(move);
         
         // Record position AFTER making the move
-        fenStateHistory.record(board, gameState, move.toAlgebraicNotation());
+        sanMove += SANFormatter::getCheckSuffix(board, gameState, moveValidator);
+        fenStateHistory.record(board, gameState, playedMove, sanMove);
 
         // Update UCI engine position
         setUCIEnginePosition();
 
         // After successful move, analyze the new game state
         currentGameState = gameStateAnalyzer.analyzeGameState(board, gameState, fenStateHistory);
+        markDirty(DirtyFlags::BOARD | DirtyFlags::HISTORY);
         return true;
     }
 
@@ -95,6 +174,63 @@ bool ChessAnalysisProgram::attemptMove(const ChessMove& move) {
     return false;
 }
 
+Bitboard ChessAnalysisProgram::getLegalDestinations(const int rank, const int file) const {
+    if (!board.isValidSquare(rank, file))
+        return Bitboards::EMPTY;
+    return legalMoves.getDestinations(makeSquare(rank, file));
+}
+
+void ChessAnalysisProgram::refreshLegalMoves() {
+    // Keyed by the position hash, so an unchanged position costs one comparison
+    const Position* position = moveValidator.getPosition(board, gameState);
+    if (position)
+        legalMoves.update(*position);
+    else
+        legalMoves.clear();
+}
+
+void ChessAnalysisProgram::refreshDatabaseLookups() {
+    if (!gameDatabase.isOpen() && !openingExplorer.isOpen())
+        return;
+
+    // Keyed by the Zobrist key, so moving pieces around without changing the position costs nothing
+    const uint64_t positionKey = fenStateHistory.getCurrentZobristKey();
+    if (gameDatabase.isOpen() && (positionKey != referenceGames.positionKey || referenceGames.version == 0))
+        refreshReferenceGames(positionKey);
+    if (openingExplorer.isOpen() && (positionKey != explorerStats.positionKey || explorerStats.version == 0))
+        refreshExplorerStats(positionKey);
+}
+
+void ChessAnalysisProgram::refreshReferenceGames(const uint64_t positionKey) {
+    std::vector<PositionHit> hits;
+    referenceGames.positionKey = positionKey;
+    referenceGames.totalGames = gameDatabase.lookup(positionKey, hits, DatabaseCfg::MAX_REFERENCE_GAMES);
+    referenceGames.games.clear();
+    for (const PositionHit& hit : hits)
+        referenceGames.games.push_back({gameDatabase.getGame(hit.gameId), hit.ply});
+    referenceGames.version++;
+    markDirty(DirtyFlags::HISTORY);
+}
+
+void ChessAnalysisProgram::refreshExplorerStats(const uint64_t positionKey) {
+    std::vector<ExplorerMove> moves;
+    openingExplorer.lookup(positionKey, moves);
+    explorerStats.positionKey = positionKey;
+    explorerStats.moves.clear();
+
+    // Stored moves are matched against the legal move cache (refreshed first), so a
+    // key collision can never show an illegal move
+    for (const ExplorerMove& move : moves) {
+        const ChessMove legalMove = legalMoves.findMove(move.move);
+        if (legalMove.isNull())
+            continue;
+        const std::string san = SANFormatter::formatMove(board, gameState, moveValidator, legalMove, moveValidator.getMoveResult(legalMove));
+        explorerStats.moves.push_back({san, move});
+    }
+    explorerStats.version++;
+    markDirty(DirtyFlags::HISTORY);
+}
+
 // All valid moves from MoveResult
 bool ChessAnalysisProgram::isValidMoveResult(MoveResult result) const  {
     return result == MoveResult::VALID || 
@@ -135,9 +271,9 @@ std::string ChessAnalysisProgram::getGameOverString() const {
 
 void ChessAnalysisProgram::undoMove() {
     // Check if we have moves to undo (need at least 2 positions)
-    if (fenStateHistory.getPositionHistory().size() > 1) {
+    if (fenStateHistory.isUndoAvailable()) {
         fenStateHistory.undoMove();
-        PositionState targetState = fenStateHistory.getCurrentPositionState();
+        const PositionState& targetState = fenStateHistory.getCurrentPositionState();
         
         if (!targetState.fenString.empty()) {
             applyPositionState(targetState);
@@ -149,6 +285,7 @@ void ChessAnalysisProgram::undoMove() {
             if (isUCIEngineEnabled()) {
                 setUCIEnginePosition();
             }
+            markDirty(DirtyFlags::BOARD | DirtyFlags::HISTORY);
         }
     }
 }
@@ -157,7 +294,7 @@ void ChessAnalysisProgram::redoMove() {
     // Check if we have moves to redo
     if (fenStateHistory.isRedoAvailable()) {
         fenStateHistory.redoMove();
-        PositionState targetState = fenStateHistory.getCurrentPositionState();
+        const PositionState& targetState = fenStateHistory.getCurrentPositionState();
         
         if (!targetState.fenString.empty()) {
             applyPositionState(targetState);
@@ -169,17 +306,44 @@ void ChessAnalysisProgram::redoMove() {
             if (isUCIEngineEnabled()) {
                 setUCIEnginePosition();
             }
+            markDirty(DirtyFlags::BOARD | DirtyFlags::HISTORY);
+        }
+    }
+}
+
+void ChessAnalysisProgram::cycleVariation() {
+    // Only moves with alternatives can switch lines
+    if (fenStateHistory.switchToNextVariation()) {
+        const PositionState& targetState = fenStateHistory.getCurrentPositionState();
+        applyPositionState(targetState);
+
+        currentGameState = gameStateAnalyzer.analyzeGameState(board, gameState, fenStateHistory);
+
+        if (isUCIEngineEnabled()) {
+            setUCIEnginePosition();
         }
+        markDirty(DirtyFlags::BOARD | DirtyFlags::HISTORY);
     }
 }
 
+bool ChessAnalysisProgram::exportPGN() const {
+    std::ofstream file(Config::PGN::OUTPUT_PATH);
+    if (!file.is_open())
+        return false;
+
+    fenStateHistory.writePGN(file, Config::PGN::EVENT_NAME);
+    return file.good();
+}
+
 void ChessAnalysisProgram::applyFen(const std::string& fenString) {
     FENLoader::applyFEN(fenString, *this);
+    markDirty(DirtyFlags::BOARD | DirtyFlags::HISTORY);
 }
 
 // Update GUI state on change (reactive vs polling)
 void ChessAnalysisProgram::setUCIEngineStateInGUI(const bool isEnabled) {
     gui->setIsUCIEngineRunning(isEnabled);
+    markDirty(DirtyFlags::ENGINE);
 }
 
 // FEN loader support methods
@@ -193,78 +357,19 @@ void ChessAnalysisProgram::clearBoardOnly() {
     board.clearBoard();
 }
 
-void ChessAnalysisProgram::applyFenDirect(const std::string& fenString) {
-    // Parse FEN components
-    std::istringstream iss(fenString);
-    std::string boardPos, activeColor, castling, enPassant, halfmove, fullmove;
-    iss >> boardPos >> activeColor >> castling >> enPassant >> halfmove >> fullmove;
-    
-    // Clear only the board pieces (not history)
-    board.clearBoard();
-    
-    // Split board position by '/' to get individual ranks
-    std::vector<std::string> ranks;
-    std::stringstream ss(boardPos);
-    std::string rank;
-    while (std::getline(ss, rank, '/')) {
-        ranks.push_back(rank);
-    }
-    
-    // Process each rank
-    for (int fenRank = 0; fenRank < 8 && fenRank < ranks.size(); fenRank++) {
-        int boardRank = 7 - fenRank; // FEN rank 8 = board rank 7, FEN rank 1 = board rank 0
-        int file = 0;
-        
-        // Process each character in this rank
-        for (char c : ranks[fenRank]) {
-            if (file >= 8) break; // Safety check
-            
-            if (c >= '1' && c <= '8') {
-                // Empty squares - skip files
-                file += (c - '0');
-            } else if ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z')) {
-                // Valid piece - place it
-                board.setPieceAt(boardRank, file, c);
-                file++;
-            }
-        }
-    }
+void ChessAnalysisProgram::applyFenDirect(std::string_view fenString) {
+    // Stored FENs come from the tracker, so only the parse itself can fail
+    FENPosition position;
+    if (!FENCodec::parse(fenString, position))
+        return;
     
-    // Set game state
-    if (!activeColor.empty()) {
-        gameState.setCurrentPlayer(activeColor[0]);
-    }
-    
-    // Set castling rights
-    bool wk = castling.find('K') != std::string::npos;
-    bool wq = castling.find('Q') != std::string::npos;
-    bool bk = castling.find('k') != std::string::npos;
-    bool bq = castling.find('q') != std::string::npos;
-    gameState.setCastlingRights(wk, wq, bk, bq);
-    
-    // Set en passant
-    if (enPassant == "-") {
-        gameState.clearEnPassantState();
-    } else if (enPassant.length() == 2) {
-        int file = enPassant[0] - 'a';
-        int rank = enPassant[1] - '1';
-        if (file >= 0 && file <= 7 && rank >= 0 && rank <= 7) {
-            gameState.setEnPassantTarget(rank, file);
-        }
-    }
-    
-    // Set move clocks
-    try {
-        if (!halfmove.empty()) gameState.setHalfmoveClock(std::stoi(halfmove));
-        if (!fullmove.empty()) gameState.setFullmoveClock(std::stoi(fullmove));
-    } catch (const std::exception&) {
-        // Ignore parsing errors
-    }
+    // Replaces board pieces and game state only (not history)
+    FENCodec::apply(position, board, gameState);
 }
 
 void ChessAnalysisProgram::applyPositionState(const PositionState& state) {
     // Apply the FEN string for board position and game state
-    applyFenDirect(state.fenString);
+    applyFenDirect(state.fenString.view());
     
     // Restore captured pieces
     board.setCapturedPieces(state.whiteCapturedPieces, state.blackCapturedPieces);
@@ -272,24 +377,154 @@ void ChessAnalysisProgram::applyPositionState(const PositionState& state) {
 
 void ChessAnalysisProgram::enableUCIEngine() {
     uciEngine->enable();
-    
-    // Get the position data
-    std::string startPos = fenStateHistory.getStartPosition();
-    std::vector<std::string> moves = fenStateHistory.getMoveHistory();
-    
-    // Debug: Force a standard starting position if none exists
-    if (startPos.empty()) {
-        startPos = "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";
-    }
-    
-    uciEngine->setPosition(startPos, moves);
+
+    // The speculative engine gets a small share of the hardware
+    EngineSettings speculativeSettings = EngineSettings::fromConfig();
+    speculativeSettings.threads = EngineCfg::SPECULATIVE_THREADS;
+    speculativeSettings.hashMb = EngineCfg::SPECULATIVE_HASH_MB;
+    speculativeEngine->configure(speculativeSettings);
+    speculativeEngine->enable();
+
+    setUCIEnginePosition();
 }
 
 
 void ChessAnalysisProgram::disableUCIEngine() {
+    speculativeEngine->disable();
     uciEngine->disable();
 }
 
+EngineAnalysis ChessAnalysisProgram::pollUCIEngineAnalysis() const {
+    EngineAnalysis liveAnalysis = uciEngine->pollAnalysis();
+
+    // Show pre-analyzed results until live analysis catches up
+    EngineAnalysis cachedAnalysis;
+    if (analysisCache.lookup(getCurrentPositionKey(), cachedAnalysis) && 
+            (liveAnalysis.key != cachedAnalysis.key || cachedAnalysis.depth > liveAnalysis.depth)) {
+        cachedAnalysis.state = liveAnalysis.state;
+        cachedAnalysis.version = liveAnalysis.version;
+        return cachedAnalysis;
+    }
+    return liveAnalysis;
+}
+
+PositionKey ChessAnalysisProgram::getCurrentPositionKey() const {
+    return {
+        fenStateHistory.getCurrentLineHash(),
+        static_cast<uint32_t>(fenStateHistory.getHistoryPath().size())
+    };
+}
+
+void ChessAnalysisProgram::scheduleSpeculation() {
+    if (!speculativeEngine->isEnabled())
+        return;
+
+    // Candidates of the previous position are stale now
+    speculativeEngine->clearPendingSearches();
+    hasSpeculatedReplies = false;
+
+    // Stepping forward through the game is the most likely next position
+    if (fenStateHistory.isRedoAvailable()) {
+        const ChessMove redoMove = fenStateHistory.getRedoMove();
+        const PositionKey redoKey = {
+            fenStateHistory.getChildLineHash(redoMove),
+            static_cast<uint32_t>(fenStateHistory.getHistoryPath().size() + 1)
+        };
+        requestSpeculativeSearch(redoKey, redoMove);
+    }
+}
+
+void ChessAnalysisProgram::scheduleReplySpeculation(const EngineAnalysis& liveAnalysis) {
+    if (hasSpeculatedReplies || !speculativeEngine->isEnabled() ||
+            liveAnalysis.key != getCurrentPositionKey() || 
+            liveAnalysis.depth < EngineCfg::SPECULATION_TRIGGER_DEPTH)
+        return;
+    hasSpeculatedReplies = true;
+
+    // The engine's top moves are the likeliest moves to be played next
+    const ChessMove redoMove = fenStateHistory.getRedoMove();
+    int scheduled = 0;
+    for (const AnalysisLine& line : liveAnalysis.lines) {
+        if (scheduled >= EngineCfg::SPECULATIVE_REPLIES)
+            break;
+        if (line.firstMove.isNull() || line.firstMove.getKey() == redoMove.getKey())
+            continue; // Redo position is already queued
+        
+        const PositionKey replyKey = {
+            fenStateHistory.getChildLineHash(line.firstMove),
+            static_cast<uint32_t>(fenStateHistory.getHistoryPath().size() + 1)
+        };
+        requestSpeculativeSearch(replyKey, line.firstMove);
+        scheduled++;
+    }
+}
+
+void ChessAnalysisProgram::requestSpeculativeSearch(const PositionKey& key, const ChessMove& extraMove) {
+    // Already analyzed deep enough (e.g. revisiting a line)
+    if (analysisCache.getDepth(key) >= EngineCfg::SPECULATIVE_DEPTH)
+        return;
+
+    const size_t baseDepth = fenStateHistory.getIrreversibleDepth();
+    std::string startFen = fenStateHistory.getPositionAt(baseDepth);
+    if (startFen.empty())
+        return;
+    std::vector<std::string> moves = fenStateHistory.getMovesSince(baseDepth);
+    moves.push_back(extraMove.toAlgebraicNotation());
+
+    SearchLimits limits;
+    limits.depth = EngineCfg::SPECULATIVE_DEPTH;
+
+    // Runs on the speculative engine thread; cancelled searches have no best move
+    speculativeEngine->requestSearch(startFen, moves, key, limits, 
+        [this](const SearchResult& result) {
+            if (!result.bestMove.empty())
+                analysisCache.store(result.key, result.analysis);
+        });
+}
+
+std::unique_ptr<AnalysisEngine> ChessAnalysisProgram::createAnalysisEngine() {
+    // Without an engine executable, analysis still works on the built-in search
+    std::error_code error;
+    if (EngineCfg::NATIVE_BACKEND || !std::filesystem::exists(EngineCfg::PATH, error))
+        return std::make_unique<NativeEngine>();
+    return std::make_unique<UCIEngine>(EngineCfg::PATH);
+}
+
+void ChessAnalysisProgram::toggleGameReview() {
+    // Pressing again cancels; searches already running are ignored by generation
+    if (gameReview.isRunning()) {
+        uciEngine->clearPendingSearches();
+        gameReview.clear();
+        return;
+    }
+
+    // The review runs on the analysis engine, ahead of interactive analysis
+    if (!isUCIEngineEnabled()) {
+        enableUCIEngine();
+        setUCIEngineStateInGUI(isUCIEngineEnabled());
+        if (!isUCIEngineEnabled())
+            return;
+    }
+
+    // The whole displayed line: played moves, then the redo line
+    std::vector<int32_t> line = fenStateHistory.getHistoryPath();
+    const std::vector<int32_t>& redoLine = fenStateHistory.getRedoLine();
+    line.insert(line.end(), redoLine.rbegin(), redoLine.rend());
+
+    std::vector<std::string> moves;
+    std::vector<PositionKey> keys;
+    moves.reserve(line.size());
+    keys.reserve(line.size());
+    for (size_t ply = 0; ply < line.size(); ply++) {
+        const PositionNode& node = fenStateHistory.getNode(line[ply]);
+        keys.push_back({node.lineHash, static_cast<uint32_t>(ply + 1)});
+        if (ply > 0)
+            moves.push_back(node.state.move.toAlgebraicNotation());
+    }
+
+    gameReview.start(*uciEngine, fenStateHistory.getNode(line.front()).state.fenString.str(), moves, keys);
+}
+
 void ChessAnalysisProgram::toggleUCIEngine() {
     bool isEnabled = true;
     if (isUCIEngineEnabled()) {
@@ -303,19 +538,30 @@ void ChessAnalysisProgram::toggleUCIEngine() {
 
 void ChessAnalysisProgram::setUCIEnginePosition() {
     if (uciEngine && isUCIEngineEnabled()) {
-        // Primary approach: Use start position + moves (better for engine understanding)
-        std::string startFen = fenStateHistory.getStartPosition();
-        std::vector<std::string> moves = fenStateHistory.getMoveHistory();
+        // Line identity is O(1); skip building the move list when nothing changed
+        const PositionKey key = getCurrentPositionKey();
+        if (uciEngine->isPositionRequested(key))
+            return;
+
+        // Start from the last irreversible position: earlier moves cannot repeat,
+        // so the engine still sees everything it needs for repetition detection
+        const size_t baseDepth = fenStateHistory.getIrreversibleDepth();
+        std::string startFen = fenStateHistory.getPositionAt(baseDepth);
         
         // Ensure we have a valid starting position
         if (startFen.empty()) {
             startFen = "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";
         }
 
-        uciEngine->setPosition(startFen, moves);
+        uciEngine->setPosition(startFen, fenStateHistory.getMovesSince(baseDepth), key);
+        scheduleSpeculation();
     }
 }
 
+bool ChessAnalysisProgram::exportProfilerTrace() const {
+    return Profiler::exportChromeTrace(Config::Profiler::TRACE_OUTPUT_PATH);
+}
+
 void ChessAnalysisProgram::resetToInitialPosition() {
     // Reset the board to starting position
     board.resetToStartingPosition();
@@ -328,6 +574,10 @@ void ChessAnalysisProgram::resetToInitialPosition() {
     setFullmoveClock(1);
     currentGameState = GameState::IN_PROGRESS;
 
+    // A review of the old game no longer applies
+    uciEngine->clearPendingSearches();
+    gameReview.clear();
+
     // Generate starting FEN position
     FENPositionTracker tempTracker;
     tempTracker.record(board, gameState);
@@ -353,4 +603,5 @@ void ChessAnalysisProgram::resetToInitialPosition() {
         uciEngine->clearAnalysis();
         setUCIEnginePosition();
     }
+    markDirty(DirtyFlags::BOARD | DirtyFlags::HISTORY);
 }
\ No newline at end of file
@@ -2,14 +2,20 @@
 
 #include <raylib.h>
 #include <vector>
-#include "../analysis_engine/uci_engine.h"
+#include "../analysis_engine/analysis_engine.h"
+#include "../analysis_engine/analysis_cache.h"
+#include "../analysis_engine/game_analyzer.h"
 #include "../core/chess_move_validator.h"
+#include "../core/legal_move_cache.h"
 #include "../core/chess_move.h"
 #include "../core/board/chess_board.h"
 #include "../core/game_state/chess_game_state.h"
 #include "../core/game_state/chess_game_state_analyzer.h"
 #include "../core/game_state/fen_position_tracker.h"
+#include "../database/opening_explorer.h"
+#include "../database/position_index.h"
 #include "../rendering/chess_gui.h"
+#include "../rendering/dirty_flags.h"
 #include "../input/chess_input_handler.h"
 
 // Type alias for cleaner code
@@ -18,6 +24,31 @@ using GameState = ChessGameStateAnalyzer::GameState;
 
 class FENLoader;
 
+// Games of the game database that reached the current position
+struct ReferenceGame {
+    IndexedGame game;
+    int ply = 0;                            // First ply at which the game reached the position
+};
+
+struct ReferenceGames {
+    uint64_t positionKey = 0;               // Zobrist key the games were looked up for
+    uint64_t totalGames = 0;                // All matching games (only the first few are listed)
+    std::vector<ReferenceGame> games;
+    uint64_t version = 0;                   // Incremented on every lookup (for display caches)
+};
+
+// Opening explorer moves of the current position
+struct ExplorerLine {
+    std::string san;
+    ExplorerMove stats;
+};
+
+struct ExplorerStats {
+    uint64_t positionKey = 0;               // Zobrist key the moves were looked up for
+    std::vector<ExplorerLine> moves;        // Most played first
+    uint64_t version = 0;                   // Incremented on every lookup (for display caches)
+};
+
 // This class manages the overall chess analysis program
 class ChessAnalysisProgram {
 public:
@@ -30,9 +61,9 @@ public:
     char getPieceAt(const int rank, const int file) const { return board.getPieceAt(rank, file); }
     std::string pieceToTextureString(const char piece) const { return board.getPieceTextureString(piece); }
     char getCurrentPlayer() const { return gameState.getCurrentPlayer(); }
-    std::vector<char> getCapturedPieces() const { return board.getCapturedPieces(); }
-    std::vector<char> getWhiteCapturedPieces() const { return board.getWhiteCapturedPieces(); }
-    std::vector<char> getBlackCapturedPieces() const { return board.getBlackCapturedPieces(); }
+    int getCapturedPieceCount() const { return board.getCapturedPieceCount(); }
+    const CapturedPieceList& getWhiteCapturedPieces() const { return board.getWhiteCapturedPieces(); }
+    const CapturedPieceList& getBlackCapturedPieces() const { return board.getBlackCapturedPieces(); }
     char getPieceOwner(const int rank, const int file) const { return board.getPieceOwner(rank, file); }
     char getPieceOwner(const char piece) const { return board.getPieceOwner(piece); }
     int getHalfmoveClock() const { return gameState.getHalfmoveClock(); }
@@ -47,6 +78,7 @@ public:
 
     // Move validation and execution methods (Controller orchestration)
     bool attemptMove(const ChessMove& move); // Validate and execute move
+    Bitboard getLegalDestinations(const int rank, const int file) const; // From the legal move cache (drag highlighting)
     
     // Game state access for GUI drawing
     GameState getGameState() const { return currentGameState; }
@@ -56,14 +88,27 @@ public:
     // FEN position tracking support methods
     void undoMove();
     void redoMove();
-    const std::vector<PositionState>& getPositionHistory() const { return fenStateHistory.getPositionHistory(); }
-    const std::vector<PositionState>& getRedoPositions() const {return fenStateHistory.getRedoPositions(); }
+    void cycleVariation(); // Switch the last move to its next alternative line
+    bool exportPGN() const; // Write the variation tree as PGN
+    const std::vector<int32_t>& getHistoryPath() const { return fenStateHistory.getHistoryPath(); }
+    std::vector<int32_t> getRedoLine() const { return fenStateHistory.getRedoLine(); }
+    const PositionNode& getPositionNode(const int32_t index) const { return fenStateHistory.getNode(index); }
+    uint64_t getHistoryVersion() const { return fenStateHistory.getVersion(); }
+
+    // Game database and opening explorer (Config::Database, built with --index)
+    bool hasGameDatabase() const { return gameDatabase.isOpen(); }
+    uint64_t getGameDatabaseSize() const { return gameDatabase.getGameCount(); }
+    const ReferenceGames& getReferenceGames() const { return referenceGames; }
+    bool hasOpeningExplorer() const { return openingExplorer.isOpen(); }
+    uint64_t getOpeningExplorerSize() const { return openingExplorer.getGameCount(); }
+    const ExplorerStats& getExplorerStats() const { return explorerStats; }
 
     // FEN loader support methods
     void setPieceAt(const int rank, const int file, const char piece) { board.setPieceAt(rank, file, piece); }
+    void setPiece(const Square square, const Piece piece) { board.setPiece(square, piece); }
     void clearBoard();
     void clearBoardOnly(); // Clear board without affecting history
-    void applyFenDirect(const std::string& fenString); // Direct FEN application for undo/redo
+    void applyFenDirect(std::string_view fenString); // Direct FEN application for undo/redo
     void applyPositionState(const PositionState& state); // Apply complete position state including captured pieces
     void setCurrentPlayer(const char player) { gameState.setCurrentPlayer(player); }
     void setCastlingRights(bool whiteKingside, bool whiteQueenside, bool blackKingside, bool blackQueenside) {
@@ -81,18 +126,45 @@ public:
     void toggleUCIEngine();
     bool isUCIEngineEnabled() const { return uciEngine->isEnabled(); }
     void setUCIEnginePosition();
-    EngineAnalysis pollUCIEngineAnalysis() const { return uciEngine->pollAnalysis(); }
+    EngineAnalysis pollUCIEngineAnalysis() const; // Live analysis, or cached analysis while it is deeper
+    uint64_t getUCIEngineAnalysisVersion() const { return uciEngine->getAnalysisVersion() + analysisCache.getVersion(); }
+    
+    // Whole-game review (history line plus redo line, searched last to first)
+    void toggleGameReview(); // Start a review, or cancel the running one
+    bool isGameReviewRunning() const { return gameReview.isRunning(); }
+    std::vector<PlyEvaluation> getGameReview() const { return gameReview.getEvaluations(); }
+    uint64_t getGameReviewVersion() const { return gameReview.getVersion(); }
     
     // Game reset functionality
     void resetToInitialPosition();
     
     // Board display options
-    void toggleBoardFlip() { isBoardFlipped = !isBoardFlipped; }
+    void toggleBoardFlip() { isBoardFlipped = !isBoardFlipped; markDirty(DirtyFlags::ALL); }
     bool getBoardFlipped() const { return isBoardFlipped; }
+
+    // Render change tracking (see DirtyFlags)
+    void markDirty(const uint32_t flags) { dirtyFlags |= flags; }
+
+    // Profiling support
+    void toggleProfilerOverlay() { isProfilerOverlayVisible = !isProfilerOverlayVisible; markDirty(DirtyFlags::OVERLAY); }
+    bool getProfilerOverlayVisible() const { return isProfilerOverlayVisible; }
+    bool exportProfilerTrace() const; // Write buffered zones as Chrome trace JSON
 private:
     // Helper methods
     bool isValidMoveResult(MoveResult result) const; // Check if move result indicates success
     void setUCIEngineStateInGUI(const bool isEnabled);
+    void collectExternalChanges(); // Engine snapshots and window events
+    PositionKey getCurrentPositionKey() const;
+    void refreshLegalMoves(); // Regenerates the legal move cache when the position changed
+    void refreshDatabaseLookups(); // Looks the position up in the game database and opening explorer when it changed
+    void refreshReferenceGames(const uint64_t positionKey);
+    void refreshExplorerStats(const uint64_t positionKey);
+    
+    // Speculative pre-analysis (redo position and likely replies)
+    void scheduleSpeculation(); // On position change
+    void scheduleReplySpeculation(const EngineAnalysis& liveAnalysis); // Once live analysis is deep enough
+    void requestSpeculativeSearch(const PositionKey& key, const ChessMove& extraMove);
+    static std::unique_ptr<AnalysisEngine> createAnalysisEngine(); // Native when configured or the engine executable is missing
 
     // Game State Management
     ChessBoard board;
@@ -101,16 +173,34 @@ private:
 
     // Validation
     ChessMoveValidator moveValidator; // Own the move validator object
+    LegalMoveCache legalMoves; // Legal moves of the current position (highlighting and drops)
+
+    // Game database
+    PositionIndex gameDatabase; // Memory-mapped position index (closed if no index file exists)
+    ReferenceGames referenceGames; // Lookup result for the current position
+    OpeningExplorer openingExplorer; // Memory-mapped opening tree (closed if no explorer file exists)
+    ExplorerStats explorerStats; // Lookup result for the current position
     
     // Analysis & UI
     std::unique_ptr<ChessGUI> gui; // Own the GUI object
     ChessInputHandler inputHandler; // Own the input handler object
     ChessGameStateAnalyzer gameStateAnalyzer; // Own the game state analyzer object
-    std::unique_ptr<UCIEngine> uciEngine; // Own the Stockfish move analysis engine manager object
+    GameAnalyzer gameReview; // Whole-game review results (must outlive the engine running its searches)
+    std::unique_ptr<AnalysisEngine> uciEngine; // Own the move analysis engine (Stockfish or the native search)
+    AnalysisCache analysisCache; // Deepest known analysis per position (must outlive the speculative engine)
+    std::unique_ptr<AnalysisEngine> speculativeEngine; // Second engine for pre-analysis of likely next positions
+    bool hasSpeculatedReplies = false; // Replies of the current position already queued
 
     // Current state
     GameState currentGameState;
     
     // Display options
     bool isBoardFlipped = false;
+    bool isProfilerOverlayVisible = false;
+
+    // Render change tracking
+    uint32_t dirtyFlags = DirtyFlags::ALL;
+    uint64_t lastEngineVersion = 0;
+    uint64_t lastReviewVersion = 0;
+    bool wasWindowFocused = true;
 };
\ No newline at end of file
@@ -0,0 +1,77 @@
+#include "corpus_indexer.h"
+#include "../config/config.h"
+#include "../database/position_index_builder.h"
+#include <iostream>
+
+namespace DatabaseCfg = Config::Database;
+
+bool IndexOptions::parseArguments(int argc, char* argv[], IndexOptions& options) {
+    options = IndexOptions{};
+    options.outputPath = DatabaseCfg::INDEX_PATH;
+    options.explorerPath = DatabaseCfg::EXPLORER_PATH;
+    options.threads = DatabaseCfg::BUILD_THREADS;
+
+    for (int i = 2; i < argc; i++) {
+        const std::string argument = argv[i];
+        const bool hasValue = (i + 1 < argc);
+        try {
+            if (argument == "--output" && hasValue)
+                options.outputPath = argv[++i];
+            else if (argument == "--explorer" && hasValue)
+                options.explorerPath = argv[++i];
+            else if (argument == "--no-explorer")
+                options.explorerPath.clear();
+            else if (argument == "--threads" && hasValue)
+                options.threads = std::stoi(argv[++i]);
+            else if (argument == "--merge")
+                options.merge = true;
+            else if (argument.compare(0, 2, "--") != 0)
+                options.inputPaths.push_back(argument);
+            else
+                return false;
+        } catch (const std::exception&) {
+            return false; // Non-numeric value
+        }
+    }
+    return !options.inputPaths.empty() && !options.outputPath.empty() && options.threads >= 0;
+}
+
+const char* IndexOptions::getUsage() {
+    return
+        "Usage: --index <file.pgn | file.gar>... [--output <file.idx>] [--explorer <file.exp> | --no-explorer] [--threads N]\n"
+        "       --index --merge <file.idx>... [--output <file.idx>]";
+}
+
+CorpusIndexer::CorpusIndexer(const IndexOptions& options) :
+    options(options) {
+}
+
+int CorpusIndexer::run() {
+    PositionIndexBuilder builder(options.threads);
+    if (!options.merge)
+        builder.setExplorerPath(options.explorerPath);
+    IndexBuildStats stats;
+    const bool isBuilt =
+        options.merge ?
+        builder.merge(options.inputPaths, options.outputPath, stats) :
+        builder.build(options.inputPaths, options.outputPath, stats);
+    if (!isBuilt) {
+        std::cerr << builder.getError() << std::endl;
+        return 1;
+    }
+
+    std::cout << "Indexed " << stats.games << " games into " << options.outputPath << std::endl;
+    std::cout << "  positions:  " << stats.keys << " distinct, " << stats.postings << " postings" << std::endl;
+    if (!options.merge) {
+        std::cout << "  replayed:   " << stats.positions << " plies in " << stats.runs << " sorted runs" << std::endl;
+        std::cout << "  truncated:  " << stats.truncatedGames << " games (illegal or unreadable move)" << std::endl;
+        if (!options.explorerPath.empty())
+            std::cout << "  explorer:   " << stats.explorerPositions << " positions, " << stats.explorerMoves << " moves in " << options.explorerPath << std::endl;
+    }
+    const double gamesPerSecond =
+        (stats.seconds > 0.0) ?
+        stats.games / stats.seconds :
+        0.0;
+    std::cout << "  time:       " << stats.seconds << " s (" << static_cast<uint64_t>(gamesPerSecond) << " games/s)" << std::endl;
+    return 0;
+}
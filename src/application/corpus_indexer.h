@@ -0,0 +1,38 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+// Command line options of the game database indexer
+struct IndexOptions {
+    std::vector<std::string> inputPaths;    // PGN or game archive files, or index files with --merge
+    std::string outputPath;
+    std::string explorerPath;               // Opening tree output (empty = none; not written by --merge)
+    int threads = 0;                        // 0 = Config::Database::BUILD_THREADS (auto)
+    bool merge = false;                     // Combine existing indexes instead of reading PGN
+
+    // "--index <file.pgn | file.gar>... [--output <file.idx>] [--explorer <file.exp> | --no-explorer] [--threads N]"
+    // or "--index --merge <file.idx>... [--output <file.idx>]"
+    static bool parseArguments(int argc, char* argv[], IndexOptions& options);
+    static const char* getUsage();
+};
+
+/**
+ * Headless builder of the position index the GUI's reference games panel reads
+ *
+ * Key features:
+ * - Builds one index from any number of PGN files or game archives
+ *   (PositionIndexBuilder), or merges indexes built separately
+ * - Builds the opening explorer tree in the same pass over the games
+ * - Reports games, distinct positions, postings, truncated games and speed
+ */
+class CorpusIndexer {
+public:
+    explicit CorpusIndexer(const IndexOptions& options);
+
+    // Build or merge; returns the process exit code
+    int run();
+
+private:
+    IndexOptions options;
+};
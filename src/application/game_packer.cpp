@@ -0,0 +1,126 @@
+#include "game_packer.h"
+#include "../config/config.h"
+#include "../core/pgn_reader.h"
+#include "../database/game_archive.h"
+#include <chrono>
+#include <fstream>
+#include <iostream>
+
+namespace DatabaseCfg = Config::Database;
+
+namespace {
+    double getSecondsSince(const std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    double getRate(const uint64_t count, const double seconds) {
+        return
+            (seconds > 0.0) ?
+            count / seconds :
+            0.0;
+    }
+}
+
+bool PackOptions::parseArguments(int argc, char* argv[], PackOptions& options) {
+    options = PackOptions{};
+    options.outputPath = DatabaseCfg::ARCHIVE_PATH;
+
+    for (int i = 2; i < argc; i++) {
+        const std::string argument = argv[i];
+        if (argument == "--output" && i + 1 < argc)
+            options.outputPath = argv[++i];
+        else if (argument.compare(0, 2, "--") != 0)
+            options.inputPaths.push_back(argument);
+        else
+            return false;
+    }
+    return !options.inputPaths.empty() && !options.outputPath.empty();
+}
+
+const char* PackOptions::getUsage() {
+    return "Usage: --pack <file.pgn>... [--output <file.gar>]";
+}
+
+GamePacker::GamePacker(const PackOptions& options) :
+    options(options) {
+}
+
+int GamePacker::run() {
+    const auto packStart = std::chrono::steady_clock::now();
+    GameArchiveWriter writer;
+    if (!writer.open(options.outputPath)) {
+        std::cerr << "Cannot write " << options.outputPath << std::endl;
+        return 1;
+    }
+
+    uint64_t inputSize = 0;
+    uint64_t truncatedGames = 0;
+    PGNGame game;
+    for (const std::string& path : options.inputPaths) {
+        PGNReader reader(path);
+        if (!reader.isOpen()) {
+            std::cerr << "Cannot open " << path << std::endl;
+            return 1;
+        }
+        inputSize += getFileSize(path);
+        while (reader.next(game)) {
+            if (!writer.addGame(game))
+                truncatedGames++;
+        }
+    }
+    const uint64_t gameCount = writer.getGameCount();
+    const uint64_t plyCount = writer.getPlyCount();
+    if (!writer.finish()) {
+        std::cerr << "Cannot write " << options.outputPath << std::endl;
+        return 1;
+    }
+    const double packSeconds = getSecondsSince(packStart);
+
+    // Replay every game from the archive: checks the file and times decoding alone
+    const auto decodeStart = std::chrono::steady_clock::now();
+    GameArchive archive;
+    if (!archive.open(options.outputPath)) {
+        std::cerr << "Cannot read back " << options.outputPath << std::endl;
+        return 1;
+    }
+    ArchivedGame archivedGame;
+    ArchivedGameReplay replay;
+    uint64_t decodedPlies = 0;
+    for (uint64_t index = 0; index < archive.getGameCount(); index++) {
+        ChessMove move;
+        if (archive.getGame(index, archivedGame) && replay.start(archivedGame)) {
+            while (replay.next(move))
+                decodedPlies++;
+        }
+    }
+    const double decodeSeconds = getSecondsSince(decodeStart);
+    if (decodedPlies != plyCount) {
+        std::cerr << "Archive check failed: " << decodedPlies << " of " << plyCount << " plies decoded" << std::endl;
+        return 1;
+    }
+
+    const uint64_t outputSize = getFileSize(options.outputPath);
+    const double bytesPerPly =
+        (plyCount > 0) ?
+        static_cast<double>(outputSize) / plyCount :
+        0.0;
+    const double ratio =
+        (outputSize > 0) ?
+        static_cast<double>(inputSize) / outputSize :
+        0.0;
+    std::cout << "Packed " << gameCount << " games into " << options.outputPath << std::endl;
+    std::cout << "  plies:      " << plyCount << " (" << archive.getStringCount() << " distinct tag strings)" << std::endl;
+    std::cout << "  truncated:  " << truncatedGames << " games (illegal or unreadable move)" << std::endl;
+    std::cout << "  size:       " << inputSize << " -> " << outputSize << " bytes (" << ratio << "x, " << bytesPerPly << " bytes/ply)" << std::endl;
+    std::cout << "  pack:       " << packSeconds << " s (" << static_cast<uint64_t>(getRate(plyCount, packSeconds)) << " plies/s, PGN parsing)" << std::endl;
+    std::cout << "  decode:     " << decodeSeconds << " s (" << static_cast<uint64_t>(getRate(decodedPlies, decodeSeconds)) << " plies/s, replayed from the archive)" << std::endl;
+    return 0;
+}
+
+uint64_t GamePacker::getFileSize(const std::string& path) {
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    return
+        file.is_open() ?
+        static_cast<uint64_t>(file.tellg()) :
+        0;
+}
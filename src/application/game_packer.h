@@ -0,0 +1,37 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+// Command line options of the game archive packer
+struct PackOptions {
+    std::vector<std::string> inputPaths;    // PGN files
+    std::string outputPath;
+
+    // "--pack <file.pgn>... [--output <file.gar>]"
+    static bool parseArguments(int argc, char* argv[], PackOptions& options);
+    static const char* getUsage();
+};
+
+/**
+ * Headless converter of PGN databases into a GameArchive
+ *
+ * Key features:
+ * - Parses every game's SAN once and stores each move as a one-byte code
+ *   (GameArchiveFormat), with tag names and values in a shared string table
+ * - Replays the finished archive to check it and to time decoding, so the
+ *   report compares PGN parsing with archive decoding on the same games
+ * - The archive is a valid --index input
+ */
+class GamePacker {
+public:
+    explicit GamePacker(const PackOptions& options);
+
+    // Pack and verify; returns the process exit code
+    int run();
+
+private:
+    PackOptions options;
+
+    static uint64_t getFileSize(const std::string& path);
+};
@@ -0,0 +1,124 @@
+#include "native_benchmark.h"
+#include "../config/config.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <iterator>
+#include <thread>
+
+namespace NativeCfg = Config::NativeEngine;
+
+namespace {
+    // Openings, middlegames with tactics, and endgames (where the table matters most)
+    constexpr const char* BENCH_POSITIONS[] = {
+        "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 10",
+        "r1bqkb1r/pppp1ppp/2n2n2/4p3/2B1P3/5N2/PPPP1PPP/RNBQK2R w KQkq - 4 4",
+        "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10",
+        "r1bq1rk1/pp2bppp/2n1pn2/3p4/2PP4/2N1PN2/PP2BPPP/R2QKB1R w KQ - 0 8",
+        "2r3k1/1q1nbppp/r3p3/3pP3/pPpP4/P1Q2N2/2RN1PPP/2R4K b - - 0 23",
+        "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+        "8/8/1p1r1k2/p1pPN1p1/P3KnP1/1P6/8/3R4 b - - 0 1",
+    };
+}
+
+bool BenchmarkOptions::parseArguments(int argc, char* argv[], BenchmarkOptions& options) {
+    options = BenchmarkOptions{};
+
+    for (int i = 2; i < argc; i++) {
+        const std::string argument = argv[i];
+        const bool hasValue = (i + 1 < argc);
+        try {
+            if (argument == "--threads" && hasValue)
+                options.threads = std::stoi(argv[++i]);
+            else if (argument == "--depth" && hasValue)
+                options.depth = std::stoi(argv[++i]);
+            else if (argument == "--hash" && hasValue)
+                options.hashMb = std::stoi(argv[++i]);
+            else
+                return false;
+        } catch (const std::exception&) {
+            return false; // Non-numeric value
+        }
+    }
+    return options.threads >= 0 && options.depth >= 0 && options.depth <= NativeCfg::MAX_DEPTH &&
+        options.hashMb >= 0;
+}
+
+const char* BenchmarkOptions::getUsage() {
+    return "Usage: --bench [--threads N] [--depth D] [--hash MB]";
+}
+
+NativeBenchmark::NativeBenchmark(const BenchmarkOptions& options) :
+    options(options), search(table) {
+
+    if (this->options.threads == 0)
+        this->options.threads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    this->options.threads = std::min(this->options.threads, NativeCfg::MAX_THREADS);
+    if (this->options.depth == 0)
+        this->options.depth = NativeCfg::BENCH_DEPTH;
+    if (this->options.hashMb == 0)
+        this->options.hashMb = NativeCfg::BENCH_HASH_MB;
+}
+
+int NativeBenchmark::run() {
+    table.resize(options.hashMb);
+    std::cout << "Native search benchmark: " << std::size(BENCH_POSITIONS) << " positions, depth "
+              << options.depth << ", hash " << options.hashMb << " MB" << std::endl;
+    std::cout << "threads        nodes    time ms          nps  nps x  ttd x" << std::endl;
+
+    RunResult baseline;
+    for (const int threads : getThreadLadder(options.threads)) {
+        const RunResult result = runPositions(threads);
+        if (threads == 1)
+            baseline = result;
+        printResult(result, baseline);
+    }
+    return 0;
+}
+
+NativeBenchmark::RunResult NativeBenchmark::runPositions(const int threads) {
+    search.setThreadCount(threads);
+    table.clear();
+
+    SearchLimits limits;
+    limits.depth = options.depth;
+    const std::atomic<bool> stop{false};
+
+    RunResult result;
+    result.threads = threads;
+    for (const char* fen : BENCH_POSITIONS) {
+        Position position;
+        if (!position.setFromFEN(fen))
+            continue;
+        const NativeSearchIteration iteration = search.run(position, {}, limits, 1, stop, nullptr);
+        result.nodes += iteration.nodes;
+        result.elapsedMs += iteration.elapsedMs;
+    }
+    return result;
+}
+
+std::vector<int> NativeBenchmark::getThreadLadder(const int maxThreads) {
+    std::vector<int> ladder;
+    for (int threads = 1; threads < maxThreads; threads *= 2)
+        ladder.push_back(threads);
+    ladder.push_back(maxThreads);
+    return ladder;
+}
+
+void NativeBenchmark::printResult(const RunResult& result, const RunResult& baseline) {
+    const int64_t elapsedMs = std::max<int64_t>(result.elapsedMs, 1);
+    const uint64_t nps = result.nodes * 1000 / elapsedMs;
+    const uint64_t baselineNps = baseline.nodes * 1000 / std::max<int64_t>(baseline.elapsedMs, 1);
+
+    char line[96];
+    std::snprintf(line, sizeof(line), "%7d %12llu %10lld %12llu %6.2f %6.2f",
+        result.threads,
+        static_cast<unsigned long long>(result.nodes),
+        static_cast<long long>(result.elapsedMs),
+        static_cast<unsigned long long>(nps),
+        static_cast<double>(nps) / std::max<uint64_t>(baselineNps, 1),
+        static_cast<double>(baseline.elapsedMs) / elapsedMs);
+    std::cout << line << std::endl;
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "../analysis_engine/native_search_group.h"
+
+// Command line options of the native search benchmark
+struct BenchmarkOptions {
+    int threads = 0;                // 0 = all hardware threads
+    int depth = 0;                  // 0 = Config::NativeEngine::BENCH_DEPTH
+    int hashMb = 0;                 // 0 = Config::NativeEngine::BENCH_HASH_MB
+
+    // "--bench [--threads N] [--depth D] [--hash MB]"
+    static bool parseArguments(int argc, char* argv[], BenchmarkOptions& options);
+    static const char* getUsage();
+};
+
+/**
+ * Headless benchmark of the native search (nps and time-to-depth scaling)
+ *
+ * Key features:
+ * - A fixed set of middlegame and endgame positions searched to a fixed depth
+ * - Runs with 1, 2, 4, ... threads up to the requested count, each run on a
+ *   freshly cleared table of the same size, so runs are comparable
+ * - Reports nodes, time, nps and both speedups against one thread: nps
+ *   (raw throughput) and time-to-depth (what Lazy-SMP actually buys)
+ */
+class NativeBenchmark {
+public:
+    explicit NativeBenchmark(const BenchmarkOptions& options);
+
+    // Run every thread count; returns the process exit code
+    int run();
+
+private:
+    struct RunResult {
+        int threads = 0;
+        uint64_t nodes = 0;
+        int64_t elapsedMs = 0;
+    };
+
+    BenchmarkOptions options;
+    TranspositionTable table;
+    NativeSearchGroup search;
+
+    RunResult runPositions(int threads);
+    static std::vector<int> getThreadLadder(int maxThreads);
+    static void printResult(const RunResult& result, const RunResult& baseline);
+};
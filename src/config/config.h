@@ -9,6 +9,7 @@ namespace Config {
         constexpr int WIDTH = 1920;
         constexpr int HEIGHT = 1080;
         constexpr int TARGET_FPS = 60;
+        constexpr double IDLE_WAIT_SECONDS = 0.02;  // Event poll interval while nothing needs redrawing
         constexpr const char* TITLE = "Chess Analysis Program";
         constexpr float CENTER_X = WIDTH / 2.0f;
         constexpr float CENTER_Y = HEIGHT / 2.0f; 
@@ -66,6 +67,7 @@ namespace Config {
             'P', 'R', 'N', 'B', 'Q', 'K', // White pieces
             'p', 'r', 'n', 'b', 'q', 'k' // Black pieces
         };
+        constexpr int MAX_CAPTURED_PIECES = 16; // Per color (15 is the legal maximum)
     }
 
     // Piece settings
@@ -87,6 +89,15 @@ namespace Config {
         constexpr int MAX_CAPTURED_IN_ROW = 7;
     }
 
+    // Legal destination hints while a piece is dragged
+    namespace MoveHints {
+        constexpr Color HINT_COLOR = {20, 85, 30, 110};             // Translucent green
+        constexpr float DOT_RADIUS = Board::SQUARE_SIZE * 0.16f;    // Empty destination
+        constexpr float RING_RADIUS = Board::SQUARE_SIZE * 0.47f;   // Capture (drawn around the piece)
+        constexpr float RING_WIDTH = Board::SQUARE_SIZE * 0.08f;
+        constexpr int RING_SEGMENTS = 32;
+    }
+
     // Game Over settings
     namespace GameOver {
         constexpr const char* DRAW_50_MOVES_STRING = "DRAW: 50 MOVE RULE";
@@ -146,9 +157,20 @@ namespace Config {
         constexpr const char* TITLE_TEXT = "GAME STATISTICS";
     }
 
+    namespace ExplorerPanel {
+        constexpr int PANEL_WIDTH = 450;           // Left column, between the engine and controls panels
+        constexpr int PANEL_HEIGHT = 220;
+        constexpr int PANEL_PADDING = 20;
+        constexpr int LINE_HEIGHT = 22;
+        constexpr int TITLE_HEIGHT = 36;
+        constexpr int FONT_SIZE = 16;
+        constexpr int MAX_ROWS = 6;                // Most played moves listed
+        constexpr const char* TITLE_TEXT = "OPENING EXPLORER";
+    }
+
     namespace ControlsPanel {
         constexpr int PANEL_WIDTH = 450;
-        constexpr int PANEL_HEIGHT = 260;
+        constexpr int PANEL_HEIGHT = 284;
         constexpr int PANEL_PADDING = 20;
         constexpr int LINE_HEIGHT = 22;
         constexpr int TITLE_HEIGHT = 36;
@@ -217,6 +239,147 @@ namespace Config {
         constexpr const char* ELLIPSIS = "...";
     }
 
+    namespace EvalGraphPanel {
+        constexpr int PANEL_WIDTH = 550;             // Same column as the moves panel
+        constexpr int PANEL_HEIGHT = 200;
+        constexpr int PANEL_MARGIN = 15;             // Gap below the moves panel
+        constexpr int PANEL_PADDING = 20;
+        constexpr int TITLE_HEIGHT = 36;
+        constexpr int SUMMARY_HEIGHT = 24;           // Text row above the graph
+        constexpr const char* TITLE_TEXT = "GAME REVIEW";
+        constexpr Color LINE_COLOR = {40, 60, 110, 255};
+        constexpr Color AXIS_COLOR = {150, 155, 165, 255};
+        constexpr Color CURRENT_PLY_COLOR = {0, 0, 139, 255};
+        constexpr Color INACCURACY_COLOR = {200, 170, 30, 255};
+        constexpr Color MISTAKE_COLOR = {230, 120, 20, 255};
+        constexpr Color BLUNDER_COLOR = {200, 30, 30, 255};
+    }
+
+    namespace ReferenceGamesPanel {
+        constexpr int PANEL_WIDTH = 550;             // Same column as the moves panel
+        constexpr int PANEL_HEIGHT = 250;
+        constexpr int PANEL_MARGIN = 15;             // Gap above the moves panel
+        constexpr int PANEL_PADDING = 20;
+        constexpr int LINE_HEIGHT = 22;
+        constexpr int TITLE_HEIGHT = 36;
+        constexpr int FONT_SIZE = 16;
+        constexpr int MAX_ROWS = 7;                  // Games listed (the total is shown as well)
+        constexpr const char* TITLE_TEXT = "REFERENCE GAMES";
+    }
+
+    // UCI engine options (applied after "uci"; unsupported options are skipped)
+    namespace Engine {
+        constexpr const char* PATH = "src/analysis_engine/stockfish.exe";
+        constexpr int THREADS = 0;                 // 0 = all hardware threads but one (GUI)
+        constexpr int HASH_MB = 256;
+        constexpr int MULTI_PV = 4;                // Lines shown in the engine panel
+        constexpr const char* EVAL_FILE = "";      // NNUE network; empty keeps the engine default
+        constexpr bool NATIVE_BACKEND = false;     // Built-in search instead of PATH (also used when PATH is missing)
+
+        // Speculative pre-analysis (second engine process)
+        constexpr int SPECULATIVE_THREADS = 1;
+        constexpr int SPECULATIVE_HASH_MB = 64;
+        constexpr int SPECULATIVE_DEPTH = 20;      // Bounded search depth per candidate
+        constexpr int SPECULATIVE_REPLIES = 2;     // Top live lines whose first move is pre-analyzed
+        constexpr int SPECULATION_TRIGGER_DEPTH = 12; // Live depth before replies are trusted
+        constexpr int ANALYSIS_CACHE_SIZE = 2048;  // Positions kept in the analysis cache
+
+        // Watchdog (crashed or hung engine processes are restarted)
+        constexpr int READY_TIMEOUT_MS = 5000;     // uciok/readyok deadline (hash allocation included)
+        constexpr int STOP_TIMEOUT_MS = 3000;      // bestmove deadline after stop
+        constexpr int STALL_PROBE_MS = 5000;       // Silence while analyzing before isready is sent
+        constexpr int MAX_RESTART_ATTEMPTS = 3;    // Consecutive failed restarts before giving up
+        constexpr int MAX_SEARCH_RETRIES = 1;      // Resubmissions of a bounded search lost to a crash
+        constexpr int RESTART_BACKOFF_MS = 500;    // Multiplied by the attempt number
+    }
+
+    // Built-in alpha-beta search (analysis backend without an engine process)
+    namespace NativeEngine {
+        constexpr int MAX_DEPTH = 64;              // Iterative deepening limit
+        constexpr int MAX_PLY = 128;               // Search stack (depth, extensions and quiescence)
+        constexpr int NODE_CHECK_INTERVAL = 1024;  // Nodes between stop/time/node limit checks
+        constexpr int NULL_MOVE_MIN_DEPTH = 3;
+        constexpr int LMR_MIN_DEPTH = 3;           // Late quiet moves are searched shallower from here
+        constexpr int LMR_MIN_MOVES = 4;           // Moves searched at full depth first
+        constexpr int MAX_THREADS = 256;           // Lazy-SMP threads (Engine::THREADS picks the count)
+
+        // Benchmark (--bench): fixed positions searched to a fixed depth
+        constexpr int BENCH_DEPTH = 12;
+        constexpr int BENCH_HASH_MB = 256;
+    }
+
+    // Whole-game review (positions searched last to first so the engine hash stays warm)
+    namespace Review {
+        constexpr int SEARCH_MOVETIME_MS = 500;    // Budget per tactical position (ThreatScanner)
+        constexpr int QUIET_SEARCH_MOVETIME_MS = 150; // Budget per quiet position
+        constexpr int INACCURACY_CP = 50;          // Centipawns lost by the mover
+        constexpr int MISTAKE_CP = 100;
+        constexpr int BLUNDER_CP = 200;
+        constexpr int EVAL_CAP_CP = 1000;          // Scores are clamped for losses and the graph
+        constexpr int MATE_SCORE_CP = 10000;       // Mate in N scores MATE_SCORE_CP - N
+    }
+
+    // Headless position-set analysis (--batch)
+    namespace Batch {
+        constexpr int ENGINES = 0;                 // 0 = hardware threads / THREADS_PER_ENGINE
+        constexpr int THREADS_PER_ENGINE = 1;      // Many single-threaded engines scale best on batches
+        constexpr int HASH_MB = 64;                // Per engine
+        constexpr int MOVETIME_MS = 100;           // Budget when neither --depth nor --movetime is given
+        constexpr int SEARCHES_PER_ENGINE = 2;     // Queued per engine so it never idles between positions
+        constexpr int CHECKPOINT_INTERVAL = 1000;  // Completed positions between checkpoints
+        constexpr const char* OUTPUT_PREFIX = "batch_results"; // <prefix>.<shard>.tsv and <prefix>.checkpoint
+    }
+
+    namespace PGN {
+        constexpr const char* OUTPUT_PATH = "analysis.pgn";
+        constexpr const char* EVENT_NAME = "Chess Analysis";
+    }
+
+    // Position index and opening tree over game databases (--index builds them, the GUI looks positions up; --pack packs PGN)
+    namespace Database {
+        constexpr const char* INDEX_PATH = "games.idx";
+        constexpr const char* EXPLORER_PATH = "openings.exp"; // Opening tree built in the same pass
+        constexpr const char* ARCHIVE_PATH = "games.gar";     // Packed games written by --pack
+        constexpr int EXPLORER_MAX_PLY = 30;       // Plies per game counted in the opening tree
+        constexpr int BUILD_THREADS = 0;           // 0 = all hardware threads
+        constexpr int BUILD_MEMORY_MB = 512;       // Postings kept in memory before sorted runs are spilled
+        constexpr int GAMES_PER_BATCH = 256;       // Games handed to a worker at once
+        constexpr int QUEUED_BATCHES_PER_THREAD = 2; // Reader lead over the workers
+        constexpr int MAX_REFERENCE_GAMES = ReferenceGamesPanel::MAX_ROWS; // Games fetched per position lookup
+    }
+
+    // Position history storage (fixed-size, no per-move heap allocation)
+    namespace History {
+        constexpr int FEN_CAPACITY = 92;             // Longest legal FEN
+        constexpr int SAN_CAPACITY = 7;              // "exd8=Q#"
+        constexpr int RESERVED_NODES = 1024;         // Node arena capacity reserved up front
+        constexpr int TRANSPOSITION_BUCKETS = 4096;  // Power of two
+    }
+
+    // Profiling settings (zones are only recorded when built with -DCHESS_PROFILING)
+    namespace Profiler {
+        constexpr int RING_BUFFER_SIZE = 16384;      // Zones kept per thread
+        constexpr int SNAPSHOT_SAFETY_MARGIN = 256;  // Slots skipped while a writer may be wrapping
+        constexpr int FRAME_HISTORY_SIZE = 240;      // Frames shown in the overlay graph
+        constexpr const char* TRACE_OUTPUT_PATH = "profile_trace.json";
+
+        // Overlay layout (top-right corner, above the moves panel)
+        constexpr int OVERLAY_WIDTH = 450;
+        constexpr int OVERLAY_HEIGHT = 280;
+        constexpr int OVERLAY_X = Window::WIDTH - OVERLAY_WIDTH - 20;
+        constexpr int OVERLAY_Y = 20;
+        constexpr int OVERLAY_PADDING = 12;
+        constexpr int OVERLAY_FONT_SIZE = 14;
+        constexpr int OVERLAY_LINE_HEIGHT = 18;
+        constexpr int GRAPH_HEIGHT = 60;
+        constexpr float GRAPH_MAX_MS = 33.3f;        // Graph ceiling (two frames at 60 FPS)
+        constexpr int MAX_ZONES_SHOWN = 8;
+        constexpr Color BACKGROUND_COLOR = {15, 20, 35, 220};
+        constexpr Color TEXT_COLOR = {220, 225, 230, 255};
+        constexpr Color GRAPH_COLOR = {46, 160, 67, 255};
+        constexpr Color BUDGET_COLOR = {220, 53, 69, 255};
+    }
+
     namespace Fonts {
         // Font file paths (relative to executable or absolute paths)
         constexpr const char* MONOSPACE_FONT_PATH = "assets/fonts/monospace.ttf";
@@ -224,7 +387,7 @@ namespace Config {
         constexpr const char* FALLBACK_MONOSPACE_PATH_2 = "C:/Windows/Fonts/cour.ttf";   // Windows Courier New
         
         // Font sizes for different UI components
-        constexpr int BASE_FONT_SIZE = 48;      // Base size for font loading (higher quality)
+        constexpr std::array<int, 7> BAKED_SIZES = {14, 16, 17, 18, 19, 22, 24}; // Glyph atlases baked at startup
         constexpr int DEFAULT_UI_SIZE = 16;     // Default UI text size
         constexpr int MONOSPACE_UI_SIZE = 14;   // Monospace text size
         constexpr int TITLE_SIZE = 22;          // Panel titles
@@ -0,0 +1,195 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include "chess_types.h"
+
+// One bit per square (bit index = Square, a1 = bit 0)
+using Bitboard = uint64_t;
+
+// Bitboard helpers and attack tables for Position and the search.
+// Every table is built at compile time, so nothing needs initializing
+// and lookups inline into the move generator.
+namespace Bitboards {
+    constexpr Bitboard EMPTY = 0;
+    constexpr Bitboard FILE_A = 0x0101010101010101ULL;
+    constexpr Bitboard FILE_H = FILE_A << 7;
+    constexpr Bitboard RANK_1 = 0xFFULL;
+    constexpr Bitboard RANK_2 = RANK_1 << 8;
+    constexpr Bitboard RANK_3 = RANK_1 << 16;
+    constexpr Bitboard RANK_6 = RANK_1 << 40;
+    constexpr Bitboard RANK_7 = RANK_1 << 48;
+    constexpr Bitboard RANK_8 = RANK_1 << 56;
+
+    constexpr Bitboard squareBit(const Square square) {
+        return 1ULL << indexOf(square);
+    }
+
+    inline int popCount(const Bitboard bitboard) {
+        return __builtin_popcountll(bitboard);
+    }
+
+    // Lowest set square (bitboard must not be empty)
+    inline Square lsb(const Bitboard bitboard) {
+        return static_cast<Square>(__builtin_ctzll(bitboard));
+    }
+
+    // Highest set square (bitboard must not be empty)
+    inline Square msb(const Bitboard bitboard) {
+        return static_cast<Square>(63 - __builtin_clzll(bitboard));
+    }
+
+    inline Square popLsb(Bitboard& bitboard) {
+        const Square square = lsb(bitboard);
+        bitboard &= bitboard - 1;
+        return square;
+    }
+
+    // Ray directions; the first four run towards higher squares
+    enum Direction { North, East, NorthEast, NorthWest, South, West, SouthEast, SouthWest, DIRECTION_COUNT };
+
+    namespace Detail {
+        using SquareTable = std::array<Bitboard, SQUARE_COUNT>;
+
+        constexpr int RANK_STEP[DIRECTION_COUNT] = { 1, 0, 1, 1, -1, 0, -1, -1 };
+        constexpr int FILE_STEP[DIRECTION_COUNT] = { 0, 1, 1, -1, 0, -1, 1, -1 };
+
+        // Squares reached by (rankStep, fileStep) offsets from every square
+        template <size_t N>
+        constexpr SquareTable buildLeaperTable(const int (&rankSteps)[N], const int (&fileSteps)[N]) {
+            SquareTable table = {};
+            for (int index = 0; index < SQUARE_COUNT; index++) {
+                for (size_t step = 0; step < N; step++) {
+                    const int rank = index / 8 + rankSteps[step];
+                    const int file = index % 8 + fileSteps[step];
+                    if (isOnBoard(rank, file))
+                        table[index] |= squareBit(makeSquare(rank, file));
+                }
+            }
+            return table;
+        }
+
+        constexpr std::array<SquareTable, DIRECTION_COUNT> buildRays() {
+            std::array<SquareTable, DIRECTION_COUNT> rays = {};
+            for (int direction = 0; direction < DIRECTION_COUNT; direction++) {
+                for (int index = 0; index < SQUARE_COUNT; index++) {
+                    int rank = index / 8 + RANK_STEP[direction];
+                    int file = index % 8 + FILE_STEP[direction];
+                    while (isOnBoard(rank, file)) {
+                        rays[direction][index] |= squareBit(makeSquare(rank, file));
+                        rank += RANK_STEP[direction];
+                        file += FILE_STEP[direction];
+                    }
+                }
+            }
+            return rays;
+        }
+
+        constexpr int KNIGHT_RANKS[8] = { 2, 2, 1, 1, -1, -1, -2, -2 };
+        constexpr int KNIGHT_FILES[8] = { 1, -1, 2, -2, 2, -2, 1, -1 };
+        constexpr int KING_RANKS[8] = { 1, 1, 1, 0, 0, -1, -1, -1 };
+        constexpr int KING_FILES[8] = { 1, 0, -1, 1, -1, 1, 0, -1 };
+        constexpr int WHITE_PAWN_RANKS[2] = { 1, 1 };
+        constexpr int BLACK_PAWN_RANKS[2] = { -1, -1 };
+        constexpr int PAWN_FILES[2] = { 1, -1 };
+
+        constexpr SquareTable KNIGHT_ATTACKS = buildLeaperTable(KNIGHT_RANKS, KNIGHT_FILES);
+        constexpr SquareTable KING_ATTACKS = buildLeaperTable(KING_RANKS, KING_FILES);
+        constexpr std::array<SquareTable, 2> PAWN_ATTACKS = {
+            buildLeaperTable(WHITE_PAWN_RANKS, PAWN_FILES),
+            buildLeaperTable(BLACK_PAWN_RANKS, PAWN_FILES)
+        };
+        constexpr std::array<SquareTable, DIRECTION_COUNT> RAYS = buildRays();
+
+        // Squares strictly between two aligned squares (empty if not aligned)
+        constexpr std::array<SquareTable, SQUARE_COUNT> buildBetween() {
+            std::array<SquareTable, SQUARE_COUNT> between = {};
+            for (int from = 0; from < SQUARE_COUNT; from++) {
+                for (int direction = 0; direction < DIRECTION_COUNT; direction++) {
+                    const Bitboard ray = RAYS[direction][from];
+                    for (int to = 0; to < SQUARE_COUNT; to++) {
+                        if (ray & squareBit(static_cast<Square>(to)))
+                            between[from][to] = ray & ~RAYS[direction][to] & ~squareBit(static_cast<Square>(to));
+                    }
+                }
+            }
+            return between;
+        }
+
+        constexpr std::array<SquareTable, SQUARE_COUNT> BETWEEN = buildBetween();
+
+        // Whole line (edge to edge) through two aligned squares (empty if not aligned)
+        constexpr std::array<SquareTable, SQUARE_COUNT> buildLines() {
+            std::array<SquareTable, SQUARE_COUNT> lines = {};
+            for (int from = 0; from < SQUARE_COUNT; from++) {
+                for (int direction = 0; direction < DIRECTION_COUNT; direction++) {
+                    int reverse = 0;
+                    while (RANK_STEP[reverse] != -RANK_STEP[direction] || FILE_STEP[reverse] != -FILE_STEP[direction])
+                        reverse++;
+                    const Bitboard line =
+                        RAYS[direction][from] | RAYS[reverse][from] | squareBit(static_cast<Square>(from));
+                    for (int to = 0; to < SQUARE_COUNT; to++) {
+                        if (RAYS[direction][from] & squareBit(static_cast<Square>(to)))
+                            lines[from][to] = line;
+                    }
+                }
+            }
+            return lines;
+        }
+
+        constexpr std::array<SquareTable, SQUARE_COUNT> LINES = buildLines();
+
+        // Attacks along one ray, stopping at (and including) the first blocker
+        template <Direction direction>
+        inline Bitboard rayAttacks(const Square square, const Bitboard occupied) {
+            const Bitboard ray = RAYS[direction][indexOf(square)];
+            const Bitboard blockers = ray & occupied;
+            if (!blockers)
+                return ray;
+            const Square blocker =
+                (direction < South) ?
+                lsb(blockers) :
+                msb(blockers);
+            return ray ^ RAYS[direction][indexOf(blocker)];
+        }
+    }
+
+    inline Bitboard pawnAttacks(const PieceColor color, const Square square) {
+        return Detail::PAWN_ATTACKS[static_cast<uint8_t>(color)][indexOf(square)];
+    }
+
+    inline Bitboard knightAttacks(const Square square) {
+        return Detail::KNIGHT_ATTACKS[indexOf(square)];
+    }
+
+    inline Bitboard kingAttacks(const Square square) {
+        return Detail::KING_ATTACKS[indexOf(square)];
+    }
+
+    inline Bitboard bishopAttacks(const Square square, const Bitboard occupied) {
+        using namespace Detail;
+        return
+            rayAttacks<NorthEast>(square, occupied) | rayAttacks<NorthWest>(square, occupied) |
+            rayAttacks<SouthEast>(square, occupied) | rayAttacks<SouthWest>(square, occupied);
+    }
+
+    inline Bitboard rookAttacks(const Square square, const Bitboard occupied) {
+        using namespace Detail;
+        return
+            rayAttacks<North>(square, occupied) | rayAttacks<East>(square, occupied) |
+            rayAttacks<South>(square, occupied) | rayAttacks<West>(square, occupied);
+    }
+
+    inline Bitboard queenAttacks(const Square square, const Bitboard occupied) {
+        return bishopAttacks(square, occupied) | rookAttacks(square, occupied);
+    }
+
+    inline Bitboard between(const Square from, const Square to) {
+        return Detail::BETWEEN[indexOf(from)][indexOf(to)];
+    }
+
+    inline Bitboard line(const Square a, const Square b) {
+        return Detail::LINES[indexOf(a)][indexOf(b)];
+    }
+}
@@ -1,4 +1,3 @@
-#include <cctype>
 #include "chess_board.h"
 
 namespace BoardCfg = Config::Board;
@@ -7,70 +6,65 @@ ChessBoard::ChessBoard() {
     boardInit();
 }
 
+// Return the piece on a square (none if off the board)
+Piece ChessBoard::getPiece(const int rank, const int file) const {
+    if (isValidBoardPosition(rank, file))
+        return squares[indexOf(makeSquare(rank, file))];
+    return Piece::None;
+}
+
+// Return the square of the king of the given color
+Square ChessBoard::getKingSquare(const PieceColor color) const {
+    const Piece kingPiece = makePiece(color, PieceType::King);
+    for (int index = 0; index < SQUARE_COUNT; index++) {
+        if (squares[index] == kingPiece)
+            return static_cast<Square>(index);
+    }
+    return Square::None; // Shouldn't happen in a valid game
+}
+
 // Return char representation of piece on board (default to empty)
 char ChessBoard::getPieceAt(const int rank, const int file) const {
-    if (isValidBoardPosition(rank, file))
-        return board[rank][file];
-    return BoardCfg::EMPTY;
+    return pieceToChar(getPiece(rank, file));
 }
 
 // Return char representation of the owner of a piece (empty if invalid)
 char ChessBoard::getPieceOwner(const int rank, const int file) const {
-    if (isValidBoardPosition(rank, file) && 
-            getPieceAt(rank, file) != BoardCfg::EMPTY)
-        return 
-            (isupper(board[rank][file])) ?
-            'w' :
-            'b';
+    const Piece piece = getPiece(rank, file);
+    if (piece != Piece::None)
+        return colorToChar(colorOf(piece));
     return BoardCfg::EMPTY;
 }
 
 char ChessBoard::getPieceOwner(const char piece) const {
-    return 
-        (isupper(piece)) ?
-        'w' :
-        'b';
+    return colorToChar(colorOf(charToPiece(piece)));
 }
 
 // Return board location of king position for specified player
 std::pair<int, int> ChessBoard::getKingPosition(const char player) const {
-    // Determine the king piece for the player
-    char kingPiece =
-        (player == 'w') ?
-        'K' :
-        'k';
-    
-    // Find the king for the player
-    for (int rank = BoardCfg::MIN_RANK; rank <= BoardCfg::MAX_RANK; rank++) {
-        for (int file = BoardCfg::MIN_FILE; file <= BoardCfg::MAX_FILE; file++) {
-            if (board[rank][file] == kingPiece)
-                return {rank, file};
-        }
-    }
-
-    return {-1, -1}; // Shouldn't happen in a valid game
+    const Square kingSquare = getKingSquare(charToColor(player));
+    if (kingSquare == Square::None)
+        return {-1, -1};
+    return {rankOf(kingSquare), fileOf(kingSquare)};
 }
 
-// Return a vector of all captured pieces (combines white and black)
-std::vector<char> ChessBoard::getCapturedPieces() const {
-    std::vector<char> allCaptured;
-    allCaptured.insert(allCaptured.end(), whiteCapturedPieces.begin(), whiteCapturedPieces.end());
-    allCaptured.insert(allCaptured.end(), blackCapturedPieces.begin(), blackCapturedPieces.end());
-    return allCaptured;
+// Return the number of captured pieces (white and black combined)
+int ChessBoard::getCapturedPieceCount() const {
+    return static_cast<int>(whiteCapturedPieces.size() + blackCapturedPieces.size());
 }
 
-// Return a vector of white captured pieces
-std::vector<char> ChessBoard::getWhiteCapturedPieces() const {
+// Return the white captured pieces
+const CapturedPieceList& ChessBoard::getWhiteCapturedPieces() const {
     return whiteCapturedPieces;
 }
 
-// Return a vector of black captured pieces
-std::vector<char> ChessBoard::getBlackCapturedPieces() const {
+// Return the black captured pieces
+const CapturedPieceList& ChessBoard::getBlackCapturedPieces() const {
     return blackCapturedPieces;
 }
 
 // Set captured pieces for both colors
-void ChessBoard::setCapturedPieces(const std::vector<char>& whiteCaptured, const std::vector<char>& blackCaptured) {
+void ChessBoard::setCapturedPieces(const CapturedPieceList& whiteCaptured, const CapturedPieceList& blackCaptured) {
     whiteCapturedPieces = whiteCaptured;
     blackCapturedPieces = blackCaptured;
 }
@@ -84,167 +78,145 @@ bool ChessBoard::isValidSquare(const int rank, const int file) const {
 // Sets a valid piece in a valid board location
 void ChessBoard::setPieceAt(const int rank, const int file, const char piece) {
     if (isValidBoardPosition(rank, file) && isValidPiece(piece))
-       board[rank][file] = piece; 
+       setPiece(makeSquare(rank, file), charToPiece(piece));
 }
 
-// Helper function to add captured pieces to color-specific vectors
-void ChessBoard::addToCapturedPieces(const char capturedPiece) {
-    if (getPieceOwner(capturedPiece) == 'w') {
-        whiteCapturedPieces.push_back(capturedPiece);
-    } else {
-        blackCapturedPieces.push_back(capturedPiece);
-    }
+// Helper function to add captured pieces to color-specific lists (kept as FEN letters for display)
+void ChessBoard::addToCapturedPieces(const Piece capturedPiece) {
+    CapturedPieceList& capturedPieces =
+        (colorOf(capturedPiece) == PieceColor::White) ?
+        whiteCapturedPieces :
+        blackCapturedPieces;
+
+    // Fails only in setups with more pieces than a legal game; the display then keeps the first ones
+    capturedPieces.push_back(pieceToChar(capturedPiece));
 }
 
 // Executes a basic move (with capture if applicable)
 void ChessBoard::executeBasicMove(const ChessMove& move) {
     // Load movement values
-    int srcRank = move.getSrcRank();
-    int srcFile = move.getSrcFile();
-    int destRank = move.getDestRank();
-    int destFile = move.getDestFile();
+    const int src = indexOf(move.getFrom());
+    const int dest = indexOf(move.getTo());
 
     // Check for capture
-    if (board[destRank][destFile] != BoardCfg::EMPTY) {
-        addToCapturedPieces(board[destRank][destFile]);
+    if (squares[dest] != Piece::None) {
+        addToCapturedPieces(squares[dest]);
     }
 
     // Execute move
-    board[destRank][destFile] = board[srcRank][srcFile];
-    board[srcRank][srcFile] = BoardCfg::EMPTY;
-    
+    squares[dest] = squares[src];
+    squares[src] = Piece::None;
+
 }
 
 // Executes a castle
 void ChessBoard::executeCastling(const ChessMove& move) {
     // Load movement values
-    int srcRank = move.getSrcRank();
-    int srcFile = move.getSrcFile();
     int destRank = move.getDestRank();
     int destFile = move.getDestFile();
 
     // Move the king
-    board[destRank][destFile] = board[srcRank][srcFile];
-    board[srcRank][srcFile] = BoardCfg::EMPTY;
+    squares[indexOf(move.getTo())] = squares[indexOf(move.getFrom())];
+    squares[indexOf(move.getFrom())] = Piece::None;
 
     // Move the rook
-    if (destFile == BoardCfg::KINGSIDE_CASTLE_KING_FILE) { // Kingside castling
-        // Move kingside rook to new position
-        board[destRank][BoardCfg::KINGSIDE_CASTLE_ROOK_FILE] = 
-            board[destRank][BoardCfg::KINGSIDE_ROOK_FILE];
-        board[destRank][BoardCfg::KINGSIDE_ROOK_FILE] = BoardCfg::EMPTY;
-    } else {
-        // Move queenside rook to new position
-        board[destRank][BoardCfg::QUEENSIDE_CASTLE_ROOK_FILE] =
-            board[destRank][BoardCfg::QUEENSIDE_ROOK_FILE];
-        board[destRank][BoardCfg::QUEENSIDE_ROOK_FILE] = BoardCfg::EMPTY;
-    }
+    const int rookFile =
+        (destFile == BoardCfg::KINGSIDE_CASTLE_KING_FILE) ?
+        BoardCfg::KINGSIDE_ROOK_FILE :
+        BoardCfg::QUEENSIDE_ROOK_FILE;
+    const int castleRookFile =
+        (destFile == BoardCfg::KINGSIDE_CASTLE_KING_FILE) ?
+        BoardCfg::KINGSIDE_CASTLE_ROOK_FILE :
+        BoardCfg::QUEENSIDE_CASTLE_ROOK_FILE;
+    const int rookSquare = indexOf(makeSquare(destRank, rookFile));
+    squares[indexOf(makeSquare(destRank, castleRookFile))] = squares[rookSquare];
+    squares[rookSquare] = Piece::None;
 }
 
 // Executes en passant
 void ChessBoard::executeEnPassant(const ChessMove& move) {
     // Load movement values
-    int srcRank = move.getSrcRank();
-    int srcFile = move.getSrcFile();
-    int destRank = move.getDestRank();
-    int destFile = move.getDestFile();
+    const int dest = indexOf(move.getTo());
+    const Piece pawn = squares[indexOf(move.getFrom())];
 
     // Move the capturing pawn
-    board[destRank][destFile] = board[srcRank][srcFile];
-    board[srcRank][srcFile] = BoardCfg::EMPTY;
+    squares[dest] = pawn;
+    squares[indexOf(move.getFrom())] = Piece::None;
 
     // Determine the rank of the captured pawn
     int enPassantCaptureRank =
-        (getPieceOwner(destRank, destFile) == 'w') ?
+        (colorOf(pawn) == PieceColor::White) ?
         BoardCfg::WHITE_EN_PASSANT_CAPTURE_RANK :
         BoardCfg::BLACK_EN_PASSANT_CAPTURE_RANK;
 
     // Capture the en passant pawn
-    addToCapturedPieces(board[enPassantCaptureRank][destFile]);
-    board[enPassantCaptureRank][destFile] = BoardCfg::EMPTY;
+    const int capturedSquare = indexOf(makeSquare(enPassantCaptureRank, move.getDestFile()));
+    addToCapturedPieces(squares[capturedSquare]);
+    squares[capturedSquare] = Piece::None;
 }
 
 // Executes promotion (default to queen)
-void ChessBoard::executePromotion(const ChessMove& move, const char promoteTo) {
+void ChessBoard::executePromotion(const ChessMove& move) {
     // Load movement values
-    int srcRank = move.getSrcRank();
-    int srcFile = move.getSrcFile();
-    int destRank = move.getDestRank();
-    int destFile = move.getDestFile();
+    const int src = indexOf(move.getFrom());
+    const int dest = indexOf(move.getTo());
+    const PieceType promoteTo =
+        (move.getFlag() == MoveFlag::Promotion) ?
+        move.getPromotion() :
+        PieceType::Queen;
 
     // Check for capture
-    if (board[destRank][destFile] != BoardCfg::EMPTY) {
-        addToCapturedPieces(board[destRank][destFile]);
+    if (squares[dest] != Piece::None) {
+        addToCapturedPieces(squares[dest]);
     }
 
-    // Move promoted piece to promotion square
-    board[destRank][destFile] = promoteTo;
-    board[srcRank][srcFile] = BoardCfg::EMPTY;
+    // Move promoted piece (same color as the pawn) to promotion square
+    squares[dest] = makePiece(colorOf(squares[src]), promoteTo);
+    squares[src] = Piece::None;
 }
 
 void ChessBoard::makeTemporaryMove(const ChessMove& move) {
-    int srcRank = move.getSrcRank();
-    int srcFile = move.getSrcFile();
-    int destRank = move.getDestRank();
-    int destFile = move.getDestFile();
+    const int src = indexOf(move.getFrom());
+    const int dest = indexOf(move.getTo());
 
-    board[destRank][destFile] = board[srcRank][srcFile];
-    board[srcRank][srcFile] = BoardCfg::EMPTY;
+    squares[dest] = squares[src];
+    squares[src] = Piece::None;
 }
 
-void ChessBoard::undoTemporaryMove(const ChessMove& move, const char capturedPiece) {
-    int srcRank = move.getSrcRank();
-    int srcFile = move.getSrcFile();
-    int destRank = move.getDestRank();
-    int destFile = move.getDestFile();
+void ChessBoard::undoTemporaryMove(const ChessMove& move, const Piece capturedPiece) {
+    const int src = indexOf(move.getFrom());
+    const int dest = indexOf(move.getTo());
 
-    board[srcRank][srcFile] = board[destRank][destFile];
-    board[destRank][destFile] = capturedPiece;
+    squares[src] = squares[dest];
+    squares[dest] = capturedPiece;
 }
 
 bool ChessBoard::isSquareEmpty(const int rank, const int file) const {
     if (isValidBoardPosition(rank, file))
-        return (board[rank][file] == BoardCfg::EMPTY);
+        return (squares[indexOf(makeSquare(rank, file))] == Piece::None);
     return false;
 }
 
 bool ChessBoard::isWhitePiece(const int rank, const int file) const {
-    if (isValidBoardPosition(rank, file))
-        return isupper(board[rank][file]);
-    return false;
+    const Piece piece = getPiece(rank, file);
+    return piece != Piece::None && colorOf(piece) == PieceColor::White;
 }
 
 bool ChessBoard::areSameColorPieces(const ChessMove& move) const {
-    int srcRank = move.getSrcRank();
-    int srcFile = move.getSrcFile();
-    int destRank = move.getDestRank();
-    int destFile = move.getDestFile();
-
-    if (isValidBoardPosition(srcRank, srcFile) && isValidBoardPosition(destRank, destFile))
-        return (getPieceOwner(srcRank, srcFile) == getPieceOwner(destRank, destFile));
-    return false;
-}
-
-bool ChessBoard::isPawn(const char piece) const {
-    return (piece == 'P' || piece == 'p');
-}
-
-bool ChessBoard::isKing(const char piece) const {
-    return (piece == 'K' || piece == 'k');
+    // Squares of a packed move are always on the board
+    const Piece srcPiece = squares[indexOf(move.getFrom())];
+    const Piece destPiece = squares[indexOf(move.getTo())];
+    if (srcPiece == Piece::None || destPiece == Piece::None)
+        return srcPiece == destPiece;
+    return colorOf(srcPiece) == colorOf(destPiece);
 }
 
 std::string ChessBoard::getPieceTextureString(const char piece) const {
-    std::string textureString = "";
-    
-    // Determine piece owner
-    if (isupper(piece))
-        textureString += "w";
-    else
-        textureString += "b";
-    
-    // Standardize piece type
-    textureString += tolower(piece);
-    
+    // Owner letter followed by the lowercase piece type ("wq", "bn")
+    const Piece typedPiece = charToPiece(piece);
+    std::string textureString(2, ' ');
+    textureString[0] = colorToChar(colorOf(typedPiece));
+    textureString[1] = pieceTypeToChar(typeOf(typedPiece));
     return textureString;
 }
 
@@ -257,27 +229,23 @@ void ChessBoard::boardInit() {
     int blackPawnRank = BoardCfg::BLACK_PAWN_START_RANK;
     int blackBackRank = BoardCfg::BLACK_BACK_RANK;
 
-    // Add back rank white pieces
-    char whiteBackPieces[] = {'R', 'N', 'B', 'Q', 'K', 'B', 'N', 'R'};
-
-    // Add back rank black pieces
-    char blackBackPieces[] = {'r', 'n', 'b', 'q', 'k', 'b', 'n', 'r'};
+    // Back rank piece order (queenside to kingside)
+    const PieceType backRankTypes[] = {
+        PieceType::Rook, PieceType::Knight, PieceType::Bishop, PieceType::Queen,
+        PieceType::King, PieceType::Bishop, PieceType::Knight, PieceType::Rook
+    };
 
     // Populate the board
     for (int file = BoardCfg::MIN_FILE; file <= BoardCfg::MAX_FILE; file++) {
-        board[whitePawnRank][file] = 'P';
-        board[blackPawnRank][file] = 'p';
-        board[whiteBackRank][file] = whiteBackPieces[file];
-        board[blackBackRank][file] = blackBackPieces[file];
+        setPiece(makeSquare(whitePawnRank, file), Piece::WhitePawn);
+        setPiece(makeSquare(blackPawnRank, file), Piece::BlackPawn);
+        setPiece(makeSquare(whiteBackRank, file), makePiece(PieceColor::White, backRankTypes[file]));
+        setPiece(makeSquare(blackBackRank, file), makePiece(PieceColor::Black, backRankTypes[file]));
     }
 }
 
 void ChessBoard::clearBoard() {
-    for (int rank = BoardCfg::MIN_RANK; rank <= BoardCfg::MAX_RANK; rank++) {
-        for (int file = BoardCfg::MIN_FILE; file <= BoardCfg::MAX_FILE; file++) {
-            board[rank][file] = BoardCfg::EMPTY;
-        }
-    }
+    squares.fill(Piece::None);
     whiteCapturedPieces.clear();
     blackCapturedPieces.clear();
 }
@@ -4,25 +4,37 @@
 #include <string>
 #include <vector>
 #include "../chess_move.h"
+#include "../chess_types.h"
+#include "../fixed_string.h"
 #include "../../config/config.h"
 
 namespace BoardCfg = Config::Board;
 
+// Captured pieces of one color, stored inline so board copies stay allocation free
+using CapturedPieceList = FixedString<BoardCfg::MAX_CAPTURED_PIECES>;
+
 class ChessBoard {
     public:
         ChessBoard();
-        
-        // Board state accessor methods
+
+        // Typed board access (core)
+        Piece getPiece(const Square square) const { return squares[indexOf(square)]; }
+        Piece getPiece(const int rank, const int file) const;
+        void setPiece(const Square square, const Piece piece) { squares[indexOf(square)] = piece; }
+        const std::array<Piece, SQUARE_COUNT>& getSquares() const { return squares; }
+        Square getKingSquare(const PieceColor color) const;
+
+        // Char board access (FEN and GUI edges)
         char getPieceAt(const int rank, const int file) const;
         char getPieceOwner(const int rank, const int file) const;
         char getPieceOwner(const char piece) const;
         std::pair<int, int> getKingPosition(const char player) const;
-        std::vector<char> getCapturedPieces() const;
-        std::vector<char> getWhiteCapturedPieces() const;
-        std::vector<char> getBlackCapturedPieces() const;
-        void setCapturedPieces(const std::vector<char>& whiteCaptured, const std::vector<char>& blackCaptured);
+        int getCapturedPieceCount() const;
+        const CapturedPieceList& getWhiteCapturedPieces() const;
+        const CapturedPieceList& getBlackCapturedPieces() const;
+        void setCapturedPieces(const CapturedPieceList& whiteCaptured, const CapturedPieceList& blackCaptured);
         bool isValidSquare(const int rank, const int file) const;
-        
+
         // Board manipulation
         void setPieceAt(const int rank, const int file, const char piece);
         void clearBoard();
@@ -30,31 +42,31 @@ class ChessBoard {
         void executeBasicMove(const ChessMove& move);
         void executeCastling(const ChessMove& move);
         void executeEnPassant(const ChessMove& move);
-        void executePromotion(const ChessMove& move, const char promoteTo = 'Q');
+        void executePromotion(const ChessMove& move); // Promotes to move.getPromotion() (queen if unset)
 
         // Temporary moves for validation
         void makeTemporaryMove(const ChessMove& move);
-        void undoTemporaryMove(const ChessMove& move, const char capturedPiece);
+        void undoTemporaryMove(const ChessMove& move, const Piece capturedPiece);
 
         // Utility methods for validator (read-only)
         bool isSquareEmpty(const int rank, const int file) const;
         bool isWhitePiece(const int rank, const int file) const;
         bool areSameColorPieces(const ChessMove& move) const;
-        bool isPawn(const char piece) const;
-        bool isKing(const char piece) const;
+        bool isPawn(const Piece piece) const { return typeOf(piece) == PieceType::Pawn; }
+        bool isKing(const Piece piece) const { return typeOf(piece) == PieceType::King; }
 
         // Piece string for textures
         std::string getPieceTextureString(const char piece) const;
 
     private:
-        std::array<std::array<char, BoardCfg::BOARD_DIMENSION>, BoardCfg::BOARD_DIMENSION> board;
-        std::vector<char> whiteCapturedPieces;
-        std::vector<char> blackCapturedPieces;
-        
+        std::array<Piece, SQUARE_COUNT> squares;    // Indexed by Square (a1 = 0)
+        CapturedPieceList whiteCapturedPieces;
+        CapturedPieceList blackCapturedPieces;
+
         // Helper functions
         void boardInit();
-        void addToCapturedPieces(const char capturedPiece);
+        void addToCapturedPieces(const Piece capturedPiece);
         bool isValidBoardPosition(const int rank, const int file) const;
         bool isValidPiece(const char piece) const;
 
-};
\ No newline at end of file
+};
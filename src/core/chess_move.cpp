@@ -1,15 +1,95 @@
 #include "chess_move.h"
 
+namespace {
+    constexpr int TO_SHIFT = 6;
+    constexpr int PROMOTION_SHIFT = 12;
+    constexpr int FLAG_SHIFT = 14;
+    constexpr uint16_t FLAG_MASK = 0xC000;
+
+    // Promotion pieces are stored as 0-3 (knight to queen)
+    constexpr uint8_t PROMOTION_BASE = static_cast<uint8_t>(PieceType::Knight);
+}
+
+ChessMove::ChessMove(
+    const int srcRank, const int srcFile,
+    const int destRank, const int destFile)
+    : data(0) {
+
+    if (isOnBoard(srcRank, srcFile) && isOnBoard(destRank, destFile))
+        *this = ChessMove{makeSquare(srcRank, srcFile), makeSquare(destRank, destFile)};
+}
+
+ChessMove::ChessMove(
+    const Square from, const Square to,
+    const MoveFlag flag,
+    const PieceType promotion) {
+
+    // Only promotions store a piece; anything but knight to queen becomes a queen
+    uint16_t promotionBits = 0;
+    if (flag == MoveFlag::Promotion)
+        promotionBits =
+            (promotion >= PieceType::Knight && promotion <= PieceType::Queen) ?
+            static_cast<uint8_t>(promotion) - PROMOTION_BASE :
+            static_cast<uint8_t>(PieceType::Queen) - PROMOTION_BASE;
+
+    data = static_cast<uint16_t>(
+        indexOf(from) |
+        (indexOf(to) << TO_SHIFT) |
+        (promotionBits << PROMOTION_SHIFT) |
+        (static_cast<uint16_t>(flag) << FLAG_SHIFT));
+}
+
+PieceType ChessMove::getPromotion() const {
+    return
+        (getFlag() == MoveFlag::Promotion) ?
+        static_cast<PieceType>(((data >> PROMOTION_SHIFT) & 3) + PROMOTION_BASE) :
+        PieceType::None;
+}
+
+uint16_t ChessMove::getKey() const {
+    // Castling and en passant are implied by the squares; promotions are not
+    return
+        (getFlag() == MoveFlag::Promotion) ?
+        data :
+        static_cast<uint16_t>(data & ~FLAG_MASK);
+}
+
+ChessMove ChessMove::withFlag(const MoveFlag flag, const PieceType promotion) const {
+    return ChessMove{getFrom(), getTo(), flag, promotion};
+}
+
 std::string ChessMove::toAlgebraicNotation() const {
-    
-    char srcFileChar = 'a' + srcFile;
-    char srcRankChar = '1' + srcRank;
-    char destFileChar = 'a' + destFile;
-    char destRankChar = '1' + destRank;
-
-    return 
-        std::string(1, srcFileChar) +
-        std::string(1, srcRankChar) +
-        std::string(1, destFileChar) +
-        std::string(1, destRankChar);
-}
\ No newline at end of file
+    if (isNull())
+        return "";
+
+    std::string text(4, ' ');
+    text[0] = static_cast<char>('a' + getSrcFile());
+    text[1] = static_cast<char>('1' + getSrcRank());
+    text[2] = static_cast<char>('a' + getDestFile());
+    text[3] = static_cast<char>('1' + getDestRank());
+    if (getFlag() == MoveFlag::Promotion)
+        text += pieceTypeToChar(getPromotion());
+    return text;
+}
+
+ChessMove ChessMove::fromUCI(std::string_view text) {
+    if (text.size() < 4 || text.size() > 5)
+        return ChessMove{};
+
+    const int srcFile = text[0] - 'a';
+    const int srcRank = text[1] - '1';
+    const int destFile = text[2] - 'a';
+    const int destRank = text[3] - '1';
+    if (!isOnBoard(srcRank, srcFile) || !isOnBoard(destRank, destFile))
+        return ChessMove{};
+
+    const Square from = makeSquare(srcRank, srcFile);
+    const Square to = makeSquare(destRank, destFile);
+    if (text.size() == 4)
+        return ChessMove{from, to};
+
+    const PieceType promotion = charToPieceType(text[4]);
+    if (promotion < PieceType::Knight || promotion > PieceType::Queen)
+        return ChessMove{};
+    return ChessMove{from, to, MoveFlag::Promotion, promotion};
+}
@@ -1,25 +1,77 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
+#include <string_view>
+#include "chess_types.h"
 
+enum class MoveFlag : uint8_t {
+    Normal = 0,
+    Promotion = 1,
+    EnPassant = 2,
+    Castling = 3
+};
+
+/**
+ * A move packed into 16 bits
+ *
+ * Layout:
+ * - bits 0-5:   source square
+ * - bits 6-11:  destination square
+ * - bits 12-13: promotion piece (knight, bishop, rook, queen; only with MoveFlag::Promotion)
+ * - bits 14-15: MoveFlag
+ *
+ * The raw value 0 (a1a1) is never legal and doubles as the null move.
+ * UCI strings only carry squares and the promotion piece, so moves parsed from
+ * them have no castling/en passant flag; getKey() compares moves on what UCI carries.
+ */
 class ChessMove {
 public:
+    ChessMove() : data(0) {}
+
+    // Off-board coordinates give the null move (rejected as a same-square move)
+    ChessMove(
+        const int srcRank, const int srcFile,
+        const int destRank, const int destFile);
     ChessMove(
-        const int srcRank, const int srcFile, 
-        const int destRank,const int destFile) 
-        : srcRank(srcRank), srcFile(srcFile),
-        destRank(destRank), destFile(destFile) {};
-    
-    int getSrcRank() const { return srcRank; };
-    int getSrcFile() const { return srcFile; };
-    int getDestRank() const {return destRank; };
-    int getDestFile() const { return destFile; };
+        const Square from, const Square to,
+        const MoveFlag flag = MoveFlag::Normal,
+        const PieceType promotion = PieceType::Queen);
+
+    Square getFrom() const { return static_cast<Square>(data & 0x3F); }
+    Square getTo() const { return static_cast<Square>((data >> 6) & 0x3F); }
+    MoveFlag getFlag() const { return static_cast<MoveFlag>(data >> 14); }
+    PieceType getPromotion() const; // PieceType::None unless MoveFlag::Promotion
+    bool isNull() const { return data == 0; }
+    uint16_t getRaw() const { return data; }
+    uint16_t getKey() const; // Squares and promotion piece only
+
+    int getSrcRank() const { return rankOf(getFrom()); }
+    int getSrcFile() const { return fileOf(getFrom()); }
+    int getDestRank() const { return rankOf(getTo()); }
+    int getDestFile() const { return fileOf(getTo()); }
 
+    // Same squares with the special move type filled in (once validation knows it)
+    ChessMove withFlag(const MoveFlag flag, const PieceType promotion = PieceType::Queen) const;
+
+    bool operator==(const ChessMove& other) const { return data == other.data; }
+    bool operator!=(const ChessMove& other) const { return data != other.data; }
+
+    // UCI notation ("e2e4", "e7e8q"); empty for the null move
     std::string toAlgebraicNotation() const;
 
+    // Parse UCI notation; anything malformed gives the null move
+    static ChessMove fromUCI(std::string_view text);
+
+    // Inverse of getRaw() (hash tables and other packed storage)
+    static ChessMove fromRaw(const uint16_t raw) {
+        ChessMove move;
+        move.data = raw;
+        return move;
+    }
+
 private:
-    int srcRank;
-    int srcFile;
-    int destRank;
-    int destFile;
-};
\ No newline at end of file
+    uint16_t data;
+};
+
+static_assert(sizeof(ChessMove) == 2, "ChessMove must stay packed into 16 bits");
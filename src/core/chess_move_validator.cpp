@@ -20,16 +20,23 @@ ChessMoveValidator::MoveResult ChessMoveValidator::validateMove(
         return MoveResult::INVALID_ILLEGAL_MOVE;
     }
 
-    // 3. Validate the player's king is not left in check
+    // 3. King safety and move type from the cached position masks
+    if (const Position* position = getPosition(board, gameState)) {
+        const ChessMove flaggedMove = position->toFlaggedMove(move);
+        if (!position->isLegal(flaggedMove))
+            return MoveResult::INVALID_ILLEGAL_MOVE;
+        return getMoveResult(flaggedMove);
+    }
+
+    // Without a legal position (not one king per side), test the move on a board copy
     if (checkValidator.wouldLeaveKingInCheck(board, gameState, move)) {
         return MoveResult::INVALID_ILLEGAL_MOVE;
     }
 
     // 4. Determine the type of valid move for return value
-    int srcRank = move.getSrcRank();
     int srcFile = move.getSrcFile();
     int destFile = move.getDestFile();
-    char movingPiece = board.getPieceAt(srcRank, srcFile);
+    const Piece movingPiece = board.getPiece(move.getFrom());
     
     // Check for castling (king-specific move)
     if (board.isKing(movingPiece)) {
@@ -68,24 +75,11 @@ bool ChessMoveValidator::wouldLeaveKingInCheck(
     const ChessBoard& board, 
     const ChessGameState& gameState,
     const ChessMove& move) const {
-    // Get player and opponent
-    char currentPlayer = gameState.getCurrentPlayer();
-    char opponent = 
-        (currentPlayer == 'w') ? 
-        'b' : 
-        'w';
-    
-    // Create a copy to test the move (efficient for standard chess board)
-    ChessBoard testBoard = board;
-    
-    // Make the temporary move
-    testBoard.makeTemporaryMove(move);
-    
-    // Find the king position after the move
-    std::pair<int, int> kingPos = testBoard.getKingPosition(currentPlayer);
-    
-    // Check if the king is under attack
-    return isSquareUnderAttack(testBoard, gameState, kingPos.first, kingPos.second, opponent);
+
+    // The pin and check masks answer without making the move
+    if (const Position* position = getPosition(board, gameState))
+        return !position->isLegal(position->toFlaggedMove(move));
+    return checkValidator.wouldLeaveKingInCheck(board, gameState, move);
 }
 
 bool ChessMoveValidator::isSquareUnderAttack(
@@ -94,11 +88,62 @@ bool ChessMoveValidator::isSquareUnderAttack(
     const int defRank, 
     const int defFile, 
     const char attackingPlayer) const {
-    
+
+    if (const Position* position = getPosition(board, gameState))
+        return position->isAttacked(makeSquare(defRank, defFile), charToColor(attackingPlayer));
     return checkValidator.isSquareUnderAttack(
             board, gameState, defRank, defFile, attackingPlayer);
 }
 
+bool ChessMoveValidator::isInCheck(const ChessBoard& board, const ChessGameState& gameState) const {
+    if (const Position* position = getPosition(board, gameState))
+        return position->isInCheck();
+
+    const char currentPlayer = gameState.getCurrentPlayer();
+    const std::pair<int, int> kingPosition = board.getKingPosition(currentPlayer);
+    const char opponent = 
+        (currentPlayer == 'w') ?
+        'b' :
+        'w';
+    return checkValidator.isSquareUnderAttack(board, gameState, kingPosition.first, kingPosition.second, opponent);
+}
+
+bool ChessMoveValidator::hasLegalMove(const ChessBoard& board, const ChessGameState& gameState) const {
+    if (const Position* position = getPosition(board, gameState)) {
+        MoveList moves;
+        position->generateLegalMoves(moves);
+        return !moves.isEmpty();
+    }
+    return hasLegalMoveOnBoard(board, gameState);
+}
+
+const Position* ChessMoveValidator::getPosition(const ChessBoard& board, const ChessGameState& gameState) const {
+    PositionKey key;
+    key.squares = board.getSquares();
+    key.player = gameState.getCurrentPlayer();
+    key.castling = static_cast<uint8_t>(
+        (gameState.canCastleKingside('w') ? 1 : 0) | (gameState.canCastleQueenside('w') ? 2 : 0) |
+        (gameState.canCastleKingside('b') ? 4 : 0) | (gameState.canCastleQueenside('b') ? 8 : 0));
+    if (gameState.isEnPassantAvailable())
+        key.enPassant = gameState.getEnPassantTarget();
+
+    // Rebuild only when the board or state changed since the last query
+    if (!hasCachedKey || !(key == cachedKey)) {
+        cachedKey = key;
+        hasCachedKey = true;
+        isCachedPositionValid = cachedPosition.set(board, gameState);
+    }
+    return
+        isCachedPositionValid ?
+        &cachedPosition :
+        nullptr;
+}
+
+bool ChessMoveValidator::PositionKey::operator==(const PositionKey& other) const {
+    return squares == other.squares && player == other.player &&
+        castling == other.castling && enPassant == other.enPassant;
+}
+
 bool ChessMoveValidator::isValidMoveResult(const MoveResult result) const {
     return (result == MoveResult::VALID ||
             result == MoveResult::VALID_CASTLE_KINGSIDE ||
@@ -111,6 +156,61 @@ bool ChessMoveValidator::isInvalidMoveResult(MoveResult result) const {
     return !isValidMoveResult(result);
 }
 
+ChessMove ChessMoveValidator::getFlaggedMove(const ChessMove& move, const MoveResult result) const {
+    switch (result) {
+        case MoveResult::VALID_CASTLE_KINGSIDE:
+        case MoveResult::VALID_CASTLE_QUEENSIDE:
+            return move.withFlag(MoveFlag::Castling);
+        case MoveResult::VALID_EN_PASSANT:
+            return move.withFlag(MoveFlag::EnPassant);
+        case MoveResult::VALID_PROMOTION:
+            return
+                (move.getFlag() == MoveFlag::Promotion) ?
+                move :
+                move.withFlag(MoveFlag::Promotion, PieceType::Queen);
+        default:
+            return move;
+    }
+}
+
+ChessMoveValidator::MoveResult ChessMoveValidator::getMoveResult(const ChessMove& flaggedMove) const {
+    switch (flaggedMove.getFlag()) {
+        case MoveFlag::Castling:
+            return
+                (flaggedMove.getDestFile() > flaggedMove.getSrcFile()) ?
+                MoveResult::VALID_CASTLE_KINGSIDE :
+                MoveResult::VALID_CASTLE_QUEENSIDE;
+        case MoveFlag::EnPassant:
+            return MoveResult::VALID_EN_PASSANT;
+        case MoveFlag::Promotion:
+            return MoveResult::VALID_PROMOTION;
+        default:
+            return MoveResult::VALID;
+    }
+}
+
+bool ChessMoveValidator::hasLegalMoveOnBoard(const ChessBoard& board, const ChessGameState& gameState) const {
+    const PieceColor currentColor = charToColor(gameState.getCurrentPlayer());
+
+    // Try every destination of every piece of the side to move
+    for (int srcRank = BoardCfg::MIN_RANK; srcRank <= BoardCfg::MAX_RANK; srcRank++) {
+        for (int srcFile = BoardCfg::MIN_FILE; srcFile <= BoardCfg::MAX_FILE; srcFile++) {
+            const Piece piece = board.getPiece(srcRank, srcFile);
+            if (piece == Piece::None || colorOf(piece) != currentColor)
+                continue;
+
+            for (int destRank = BoardCfg::MIN_RANK; destRank <= BoardCfg::MAX_RANK; destRank++) {
+                for (int destFile = BoardCfg::MIN_FILE; destFile <= BoardCfg::MAX_FILE; destFile++) {
+                    ChessMove move{srcRank, srcFile, destRank, destFile};
+                    if (isValidMoveResult(validateMove(board, gameState, move)))
+                        return true;
+                }
+            }
+        }
+    }
+    return false;
+}
+
 ChessMoveValidator::MoveResult ChessMoveValidator::convertBasicResult(BasicMoveValidator::ValidationResult result) const {
     switch (result) {
         case BasicMoveValidator::ValidationResult::VALID:
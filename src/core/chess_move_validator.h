@@ -6,11 +6,25 @@
 #include "board/chess_board.h"
 #include "game_state/chess_game_state.h"
 #include "chess_move.h"
+#include "position.h"
 #include "validators/basic_move_validator.h"
 #include "validators/piece_movement_validator.h"
 #include "validators/special_move_validator.h"
 #include "validators/check_validator.h"
 
+/**
+ * Legality of GUI and PGN moves on a ChessBoard
+ *
+ * Key features:
+ * - Bounds, turn and piece movement rules checked on the char-level board
+ * - King safety, castling and en passant answered from a cached Position whose
+ *   check, pin and king-danger masks make each query a few mask tests instead of
+ *   a board copy and a full attack scan
+ * - The cache is rebuilt only when the board or game state changes, so the many
+ *   queries per position (SAN disambiguation, mate and stalemate detection) share it
+ * - Falls back to the board-scanning validators when the board has no legal
+ *   Position (not exactly one king per side)
+ */
 class ChessMoveValidator {
 public:
     enum class MoveResult {
@@ -38,10 +52,23 @@ public:
     bool isValidMoveResult(const MoveResult result) const;
     bool isInvalidMoveResult(const MoveResult result) const;
 
+    // The move with its special move flag set from a valid result (promotions default to a queen)
+    ChessMove getFlaggedMove(const ChessMove& move, const MoveResult result) const;
+
+    // Inverse of getFlaggedMove() for a legal move that carries its flag (generated moves)
+    MoveResult getMoveResult(const ChessMove& flaggedMove) const;
+
     // Delegate methods for backward compatibility (if needed)
     bool isSquareUnderAttack(const ChessBoard& board, const ChessGameState& gameState, const int defRank, const int defFile, const char attackingPlayer) const;
     bool wouldLeaveKingInCheck(const ChessBoard& board, const ChessGameState& gameState, const ChessMove& move) const;
 
+    // Side to move state (mate and stalemate detection)
+    bool isInCheck(const ChessBoard& board, const ChessGameState& gameState) const;
+    bool hasLegalMove(const ChessBoard& board, const ChessGameState& gameState) const;
+
+    // The position of the board and game state with its masks, or null if it has no legal Position
+    const Position* getPosition(const ChessBoard& board, const ChessGameState& gameState) const;
+
 private:
     // Specialized validators
     BasicMoveValidator basicValidator;
@@ -49,6 +76,23 @@ private:
     SpecialMoveValidator specialValidator;
     CheckValidator checkValidator;
     
+    // Inputs the cached position was built from (the clocks do not affect legality)
+    struct PositionKey {
+        std::array<Piece, SQUARE_COUNT> squares{};
+        char player = 0;
+        uint8_t castling = 0;
+        std::pair<int, int> enPassant{-1, -1};
+
+        bool operator==(const PositionKey& other) const;
+    };
+
+    // Position cache, refreshed by getPosition()
+    mutable PositionKey cachedKey;
+    mutable Position cachedPosition;
+    mutable bool hasCachedKey = false;
+    mutable bool isCachedPositionValid = false;
+
     // Helper method to convert BasicMoveValidator result to MoveResult
     MoveResult convertBasicResult(BasicMoveValidator::ValidationResult result) const;
+    bool hasLegalMoveOnBoard(const ChessBoard& board, const ChessGameState& gameState) const;
 };
\ No newline at end of file
@@ -0,0 +1,132 @@
+#pragma once
+
+#include <cstdint>
+
+// Piece and square encoding shared by the board, validators and moves.
+// FEN letters ('P', 'k', '-') and square names ("e4") only appear at the
+// edges (FEN, GUI, UCI); the core compares small integers instead.
+
+enum class PieceColor : uint8_t {
+    White = 0,
+    Black = 1
+};
+
+enum class PieceType : uint8_t {
+    None = 0,
+    Pawn,
+    Knight,
+    Bishop,
+    Rook,
+    Queen,
+    King
+};
+
+// Low three bits are the PieceType, bit 3 is the PieceColor
+enum class Piece : uint8_t {
+    None = 0,
+    WhitePawn = 1, WhiteKnight, WhiteBishop, WhiteRook, WhiteQueen, WhiteKing,
+    BlackPawn = 9, BlackKnight, BlackBishop, BlackRook, BlackQueen, BlackKing
+};
+
+// a1 = 0 ... h8 = 63 (rank * 8 + file)
+enum class Square : uint8_t {
+    A1, B1, C1, D1, E1, F1, G1, H1,
+    A2, B2, C2, D2, E2, F2, G2, H2,
+    A3, B3, C3, D3, E3, F3, G3, H3,
+    A4, B4, C4, D4, E4, F4, G4, H4,
+    A5, B5, C5, D5, E5, F5, G5, H5,
+    A6, B6, C6, D6, E6, F6, G6, H6,
+    A7, B7, C7, D7, E7, F7, G7, H7,
+    A8, B8, C8, D8, E8, F8, G8, H8,
+    None
+};
+
+constexpr int SQUARE_COUNT = 64;
+
+// --- Pieces ---
+constexpr Piece makePiece(const PieceColor color, const PieceType type) {
+    return static_cast<Piece>((static_cast<uint8_t>(color) << 3) | static_cast<uint8_t>(type));
+}
+
+constexpr PieceType typeOf(const Piece piece) {
+    return static_cast<PieceType>(static_cast<uint8_t>(piece) & 7);
+}
+
+// Only meaningful for Piece::None when combined with a None check
+constexpr PieceColor colorOf(const Piece piece) {
+    return static_cast<PieceColor>(static_cast<uint8_t>(piece) >> 3);
+}
+
+constexpr PieceColor opposite(const PieceColor color) {
+    return static_cast<PieceColor>(static_cast<uint8_t>(color) ^ 1);
+}
+
+// --- Squares ---
+constexpr bool isOnBoard(const int rank, const int file) {
+    return (rank | file) >= 0 && rank < 8 && file < 8;
+}
+
+constexpr Square makeSquare(const int rank, const int file) {
+    return static_cast<Square>(rank * 8 + file);
+}
+
+constexpr int rankOf(const Square square) {
+    return static_cast<uint8_t>(square) >> 3;
+}
+
+constexpr int fileOf(const Square square) {
+    return static_cast<uint8_t>(square) & 7;
+}
+
+constexpr int indexOf(const Square square) {
+    return static_cast<uint8_t>(square);
+}
+
+// --- Edge conversions (table lookups, no locale) ---
+constexpr char pieceToChar(const Piece piece) {
+    return "-PNBRQK--pnbrqk-"[static_cast<uint8_t>(piece) & 15];
+}
+
+// Lowercase type letter, as used by UCI promotions ("e7e8q")
+constexpr char pieceTypeToChar(const PieceType type) {
+    return "-pnbrqk-"[static_cast<uint8_t>(type) & 7];
+}
+
+// Unknown characters (including '-') give Piece::None
+constexpr Piece charToPiece(const char c) {
+    switch (c) {
+        case 'P': return Piece::WhitePawn;
+        case 'N': return Piece::WhiteKnight;
+        case 'B': return Piece::WhiteBishop;
+        case 'R': return Piece::WhiteRook;
+        case 'Q': return Piece::WhiteQueen;
+        case 'K': return Piece::WhiteKing;
+        case 'p': return Piece::BlackPawn;
+        case 'n': return Piece::BlackKnight;
+        case 'b': return Piece::BlackBishop;
+        case 'r': return Piece::BlackRook;
+        case 'q': return Piece::BlackQueen;
+        case 'k': return Piece::BlackKing;
+        default: return Piece::None;
+    }
+}
+
+// Case-insensitive type letter ('q' or 'Q'); unknown characters give PieceType::None
+constexpr PieceType charToPieceType(const char c) {
+    return typeOf(charToPiece(c));
+}
+
+// Side-to-move letters used by FEN and ChessGameState
+constexpr char colorToChar(const PieceColor color) {
+    return
+        (color == PieceColor::White) ?
+        'w' :
+        'b';
+}
+
+constexpr PieceColor charToColor(const char player) {
+    return
+        (player == 'w') ?
+        PieceColor::White :
+        PieceColor::Black;
+}
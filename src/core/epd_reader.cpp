@@ -0,0 +1,113 @@
+#include "epd_reader.h"
+#include <cctype>
+#include <sstream>
+
+EPDReader::EPDReader(const std::string& path) :
+    buffer(READ_BUFFER_SIZE) {
+
+    // The buffer must be installed before the file is opened
+    file.rdbuf()->pubsetbuf(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    file.open(path, std::ios::binary);
+}
+
+bool EPDReader::next(EPDRecord& record) {
+    if (!readPositionLine())
+        return false;
+
+    record = EPDRecord{};
+    record.index = positionIndex++;
+    record.lineNumber = lineNumber;
+    if (!parseLine(line, record))
+        record.fen.clear();
+    return true;
+}
+
+uint64_t EPDReader::skip(uint64_t count) {
+    uint64_t skipped = 0;
+    while (skipped < count && readPositionLine()) {
+        positionIndex++;
+        skipped++;
+    }
+    return skipped;
+}
+
+bool EPDReader::readPositionLine() {
+    while (std::getline(file, line)) {
+        lineNumber++;
+
+        // Windows line endings
+        if (!line.empty() && line.back() == '\r')
+            line.pop_back();
+
+        const size_t first = line.find_first_not_of(" \t");
+        if (first == std::string::npos || line[first] == '#')
+            continue;
+        return true;
+    }
+    return false;
+}
+
+bool EPDReader::parseLine(const std::string& line, EPDRecord& record) {
+    std::istringstream stream(line);
+    std::string board, side, castling, enPassant;
+    if (!(stream >> board >> side >> castling >> enPassant))
+        return false;
+
+    // Plain FEN: two numeric clock fields follow; otherwise the rest are EPD opcodes
+    std::string halfmove = "0";
+    std::string fullmove = "1";
+    std::streampos opcodesStart = stream.tellg();
+    std::string first, second;
+    if (stream >> first >> second && 
+            std::isdigit(static_cast<unsigned char>(first[0])) && 
+            std::isdigit(static_cast<unsigned char>(second[0]))) {
+        halfmove = first;
+        fullmove = second;
+        opcodesStart = stream.tellg();
+    }
+    std::string opcodes = 
+        (opcodesStart == std::streampos(-1)) ?
+        "" :
+        line.substr(static_cast<size_t>(opcodesStart));
+
+    // Opcodes: "<opcode> <operands...>;" repeated
+    std::istringstream opcodeStream(opcodes);
+    std::string operation;
+    while (std::getline(opcodeStream, operation, ';')) {
+        std::istringstream operationStream(operation);
+        std::string opcode;
+        if (!(operationStream >> opcode))
+            continue;
+        std::string operands;
+        std::getline(operationStream, operands);
+
+        if (opcode == "bm")
+            record.bestMoves = splitOperands(operands);
+        else if (opcode == "am")
+            record.avoidMoves = splitOperands(operands);
+        else if (opcode == "id") {
+            // Quoted string operand
+            const size_t open = operands.find('"');
+            const size_t close = operands.rfind('"');
+            record.id = 
+                (open != std::string::npos && close > open) ?
+                operands.substr(open + 1, close - open - 1) :
+                operands;
+        } else if (opcode == "hmvc" && !splitOperands(operands).empty())
+            halfmove = splitOperands(operands).front();
+        else if (opcode == "fmvn" && !splitOperands(operands).empty())
+            fullmove = splitOperands(operands).front();
+    }
+
+    record.fen = board + " " + side + " " + castling + " " + enPassant + " " + halfmove + " " + fullmove;
+    return true;
+}
+
+std::vector<std::string> EPDReader::splitOperands(const std::string& operands) {
+    std::vector<std::string> tokens;
+    std::istringstream stream(operands);
+    std::string token;
+    while (stream >> token)
+        tokens.push_back(token);
+    return tokens;
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// One position line of an EPD or FEN file
+struct EPDRecord {
+    uint64_t index = 0;                     // Position number in the file (0-based, blank and comment lines excluded)
+    uint64_t lineNumber = 0;                // 1-based source line (for error messages)
+    std::string fen;                        // Six-field FEN; empty if the line could not be parsed
+    std::string id;                         // "id" opcode (empty if absent)
+    std::vector<std::string> bestMoves;     // "bm" opcode (SAN or UCI)
+    std::vector<std::string> avoidMoves;    // "am" opcode (SAN or UCI)
+};
+
+/**
+ * Streaming reader for EPD/FEN position files
+ *
+ * Key features:
+ * - One line in memory at a time (large read buffer), so files with tens of
+ *   millions of positions are read at disk speed
+ * - Accepts plain FEN lines and EPD lines with opcodes; EPD clocks come from
+ *   hmvc/fmvn (default "0 1")
+ * - Blank lines and lines starting with '#' are skipped and not numbered
+ * - Unparsable lines still get an index (with an empty FEN) so position
+ *   numbers stay stable for checkpoints
+ */
+class EPDReader {
+public:
+    explicit EPDReader(const std::string& path);
+
+    bool isOpen() const { return file.is_open(); }
+
+    // Read the next position line; false at end of file
+    bool next(EPDRecord& record);
+
+    // Skip position lines without parsing them (resume); returns the number skipped
+    uint64_t skip(uint64_t count);
+
+    // Parse one line into FEN and opcodes; false if it has fewer than four fields
+    static bool parseLine(const std::string& line, EPDRecord& record);
+
+private:
+    static constexpr size_t READ_BUFFER_SIZE = 1 << 20;
+
+    std::vector<char> buffer;               // Must outlive the stream using it
+    std::ifstream file;
+    std::string line;                       // Reused between reads
+    uint64_t lineNumber = 0;
+    uint64_t positionIndex = 0;
+
+    bool readPositionLine(); // Next non-blank, non-comment line into `line`
+    static std::vector<std::string> splitOperands(const std::string& operands);
+};
@@ -0,0 +1,225 @@
+#include "fen_codec.h"
+#include <algorithm>
+#include <charconv>
+
+namespace HistoryCfg = Config::History;
+
+int FENPosition::countPieces(const Piece piece) const {
+    return static_cast<int>(std::count(squares.begin(), squares.end(), piece));
+}
+
+size_t FENCodec::write(const ChessBoard& board, const ChessGameState& gameState, char (&out)[HistoryCfg::FEN_CAPACITY]) {
+    char* cursor = out;
+    char* const end = out + HistoryCfg::FEN_CAPACITY;
+
+    // Board, rank 8 first (at most 71 characters, always fits)
+    for (int rank = 7; rank >= 0; rank--) {
+        int emptyCount = 0;
+        for (int file = 0; file < 8; file++) {
+            const Piece piece = board.getPiece(makeSquare(rank, file));
+            if (piece == Piece::None) {
+                emptyCount++;
+                continue;
+            }
+            if (emptyCount > 0) {
+                *cursor++ = static_cast<char>('0' + emptyCount);
+                emptyCount = 0;
+            }
+            *cursor++ = pieceToChar(piece);
+        }
+        if (emptyCount > 0)
+            *cursor++ = static_cast<char>('0' + emptyCount);
+        if (rank > 0)
+            *cursor++ = '/';
+    }
+
+    // Side to move
+    *cursor++ = ' ';
+    *cursor++ = gameState.getCurrentPlayer();
+    *cursor++ = ' ';
+
+    // Castling rights
+    char* const castlingStart = cursor;
+    if (gameState.canCastleKingside('w'))
+        *cursor++ = 'K';
+    if (gameState.canCastleQueenside('w'))
+        *cursor++ = 'Q';
+    if (gameState.canCastleKingside('b'))
+        *cursor++ = 'k';
+    if (gameState.canCastleQueenside('b'))
+        *cursor++ = 'q';
+    if (cursor == castlingStart)
+        *cursor++ = '-';
+    *cursor++ = ' ';
+
+    // En passant target
+    if (gameState.isEnPassantAvailable()) {
+        auto [rank, file] = gameState.getEnPassantTarget();
+        *cursor++ = static_cast<char>('a' + file);
+        *cursor++ = static_cast<char>('1' + rank);
+    } else
+        *cursor++ = '-';
+
+    // Clocks are the only unbounded fields; stop at the buffer end like FenString does
+    *cursor++ = ' ';
+    std::to_chars_result result = std::to_chars(cursor, end, gameState.getHalfmoveClock());
+    if (result.ec != std::errc() || result.ptr == end)
+        return static_cast<size_t>(cursor - out);
+    cursor = result.ptr;
+    *cursor++ = ' ';
+    result = std::to_chars(cursor, end, gameState.getFullmoveClock());
+    if (result.ec != std::errc())
+        return static_cast<size_t>(cursor - out);
+    return static_cast<size_t>(result.ptr - out);
+}
+
+void FENCodec::write(const ChessBoard& board, const ChessGameState& gameState, FenString& fen) {
+    char buffer[HistoryCfg::FEN_CAPACITY];
+    fen.assign(std::string_view(buffer, write(board, gameState, buffer)));
+}
+
+bool FENCodec::parse(std::string_view fen, FENPosition& position) {
+    position = FENPosition(); // Missing fields keep their defaults
+
+    size_t pos = 0;
+    std::string_view fields[6];
+    while (position.fieldCount < 6) {
+        const std::string_view field = nextField(fen, pos);
+        if (field.empty())
+            break;
+        fields[position.fieldCount++] = field;
+    }
+    if (position.fieldCount == 0)
+        return false;
+
+    if (parseBoard(fields[0], position.squares))
+        position.validFields |= FENFields::BOARD;
+
+    // Side to move
+    if (position.fieldCount > 1 && fields[1].size() == 1 && (fields[1][0] == 'w' || fields[1][0] == 'b')) {
+        position.sideToMove = fields[1][0];
+        position.validFields |= FENFields::SIDE;
+    }
+
+    // Castling rights ("-" or any of KQkq)
+    if (position.fieldCount > 2 && fields[2].find_first_not_of("KQkq-") == std::string_view::npos) {
+        position.whiteKingside = fields[2].find('K') != std::string_view::npos;
+        position.whiteQueenside = fields[2].find('Q') != std::string_view::npos;
+        position.blackKingside = fields[2].find('k') != std::string_view::npos;
+        position.blackQueenside = fields[2].find('q') != std::string_view::npos;
+        position.validFields |= FENFields::CASTLING;
+    }
+
+    // En passant target ("-" or a square)
+    if (position.fieldCount > 3) {
+        const std::string_view enPassant = fields[3];
+        if (enPassant == "-") {
+            position.enPassantRank = -1;
+            position.enPassantFile = -1;
+            position.validFields |= FENFields::EN_PASSANT;
+        } else if (enPassant.size() == 2 && isOnBoard(enPassant[1] - '1', enPassant[0] - 'a')) {
+            position.enPassantRank = enPassant[1] - '1';
+            position.enPassantFile = enPassant[0] - 'a';
+            position.validFields |= FENFields::EN_PASSANT;
+        }
+    }
+
+    // Clocks
+    if (position.fieldCount > 4 && parseNumber(fields[4], position.halfmoveClock) && position.halfmoveClock >= 0)
+        position.validFields |= FENFields::HALFMOVE;
+    if (position.fieldCount > 5 && parseNumber(fields[5], position.fullmoveNumber) && position.fullmoveNumber >= 1)
+        position.validFields |= FENFields::FULLMOVE;
+
+    return position.hasFields(FENFields::BOARD);
+}
+
+bool FENCodec::parseBoard(std::string_view piecePositions, std::array<Piece, SQUARE_COUNT>& squares) {
+    std::array<Piece, SQUARE_COUNT> parsed = {};
+    int rank = 7;
+    int file = 0;
+    for (const char c : piecePositions) {
+        if (c == '/') {
+            if (file != 8 || rank == 0)
+                return false; // Short rank or more than 8 ranks
+            rank--;
+            file = 0;
+        } else if (c >= '1' && c <= '8') {
+            file += c - '0';
+            if (file > 8)
+                return false; // Too many empty squares
+        } else {
+            const Piece piece = charToPiece(c);
+            if (piece == Piece::None || file >= 8)
+                return false; // Invalid character or too many pieces in rank
+            parsed[indexOf(makeSquare(rank, file++))] = piece;
+        }
+    }
+    if (rank != 0 || file != 8)
+        return false; // Must have exactly 8 ranks of 8 squares
+
+    squares = parsed;
+    return true;
+}
+
+void FENCodec::apply(const FENPosition& position, ChessBoard& board, ChessGameState& gameState) {
+    board.clearBoard();
+    for (int index = 0; index < SQUARE_COUNT; index++) {
+        if (position.squares[index] != Piece::None)
+            board.setPiece(static_cast<Square>(index), position.squares[index]);
+    }
+
+    gameState.setCurrentPlayer(position.sideToMove);
+    gameState.setCastlingRights(
+        position.whiteKingside, position.whiteQueenside,
+        position.blackKingside, position.blackQueenside);
+    if (position.enPassantRank >= 0)
+        gameState.setEnPassantTarget(position.enPassantRank, position.enPassantFile);
+    else
+        gameState.clearEnPassantState();
+    if (position.hasFields(FENFields::HALFMOVE))
+        gameState.setHalfmoveClock(position.halfmoveClock);
+    if (position.hasFields(FENFields::FULLMOVE))
+        gameState.setFullmoveClock(position.fullmoveNumber);
+}
+
+int FENCodec::getHalfmoveClock(std::string_view fen) {
+    size_t pos = 0;
+    for (int field = 0; field < 4; field++)
+        nextField(fen, pos);
+    int halfmoveClock = 0;
+    return parseNumber(nextField(fen, pos), halfmoveClock) ? halfmoveClock : 0;
+}
+
+int FENCodec::getFullmoveNumber(std::string_view fen) {
+    size_t pos = 0;
+    for (int field = 0; field < 5; field++)
+        nextField(fen, pos);
+    int fullmoveNumber = 1;
+    return parseNumber(nextField(fen, pos), fullmoveNumber) ? fullmoveNumber : 1;
+}
+
+size_t FENCodec::getPositionKeyLength(std::string_view fen) {
+    size_t pos = 0;
+    for (int field = 0; field < 4; field++)
+        nextField(fen, pos);
+    // pos is just past the en passant field (or the end)
+    return std::min(pos, fen.size());
+}
+
+bool FENCodec::parseNumber(std::string_view text, int& value) {
+    if (text.empty())
+        return false;
+    const std::from_chars_result result = std::from_chars(text.data(), text.data() + text.size(), value);
+    return result.ec == std::errc() && result.ptr == text.data() + text.size();
+}
+
+std::string_view FENCodec::nextField(std::string_view fen, size_t& pos) {
+    // Fields are separated by any run of whitespace (files may end in "\r")
+    auto isSeparator = [](const char c) { return c == ' ' || c == '\t' || c == '\r' || c == '\n'; };
+    while (pos < fen.size() && isSeparator(fen[pos]))
+        pos++;
+    const size_t start = pos;
+    while (pos < fen.size() && !isSeparator(fen[pos]))
+        pos++;
+    return fen.substr(start, pos - start);
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include "chess_types.h"
+#include "fixed_string.h"
+#include "board/chess_board.h"
+#include "game_state/chess_game_state.h"
+#include "../config/config.h"
+
+using FenString = FixedString<Config::History::FEN_CAPACITY>;
+
+// Bits of FENPosition::validFields
+namespace FENFields {
+    constexpr uint8_t NONE       = 0;
+    constexpr uint8_t BOARD      = 1u << 0;
+    constexpr uint8_t SIDE       = 1u << 1;
+    constexpr uint8_t CASTLING   = 1u << 2;
+    constexpr uint8_t EN_PASSANT = 1u << 3;
+    constexpr uint8_t HALFMOVE   = 1u << 4;
+    constexpr uint8_t FULLMOVE   = 1u << 5;
+    constexpr uint8_t POSITION   = BOARD | SIDE | CASTLING | EN_PASSANT;   // Everything but the clocks
+    constexpr uint8_t ALL        = POSITION | HALFMOVE | FULLMOVE;
+}
+
+// A parsed FEN; only the fields flagged in validFields hold parsed values
+struct FENPosition {
+    std::array<Piece, SQUARE_COUNT> squares = {};   // Indexed by Square (a1 = 0)
+    char sideToMove = 'w';
+    bool whiteKingside = false;
+    bool whiteQueenside = false;
+    bool blackKingside = false;
+    bool blackQueenside = false;
+    int enPassantRank = -1;                         // -1 if none
+    int enPassantFile = -1;
+    int halfmoveClock = 0;
+    int fullmoveNumber = 1;
+    int fieldCount = 0;                             // Whitespace-separated fields present
+    uint8_t validFields = FENFields::NONE;
+
+    bool hasFields(const uint8_t fields) const { return (validFields & fields) == fields; }
+    int countPieces(const Piece piece) const;
+};
+
+/**
+ * The one FEN reader and writer of the program
+ *
+ * Key features:
+ * - Writing fills a fixed char[FEN_CAPACITY] buffer straight from the typed board
+ * - Parsing walks a string_view once: no splitting, streams or temporary strings;
+ *   numbers use std::from_chars
+ * - Parsing never throws and reports each field's validity, so strict callers
+ *   (batch loading) and lenient ones (user FEN files) share the same code
+ * - Field extractors for stored FENs (clocks, repetition key) without a full parse
+ */
+class FENCodec {
+public:
+    // Write board and game state as FEN; returns the length (output is not null-terminated)
+    static size_t write(const ChessBoard& board, const ChessGameState& gameState, char (&out)[Config::History::FEN_CAPACITY]);
+    static void write(const ChessBoard& board, const ChessGameState& gameState, FenString& fen);
+
+    // Parse every field present; returns true if the board field is valid
+    static bool parse(std::string_view fen, FENPosition& position);
+
+    // Board field only (8 ranks of 8 squares); fills squares on success
+    static bool parseBoard(std::string_view piecePositions, std::array<Piece, SQUARE_COUNT>& squares);
+
+    // Replace board and game state with the parsed fields (clocks only if valid)
+    static void apply(const FENPosition& position, ChessBoard& board, ChessGameState& gameState);
+
+    // Field extraction from a stored FEN
+    static int getHalfmoveClock(std::string_view fen);          // 0 if missing
+    static int getFullmoveNumber(std::string_view fen);         // 1 if missing
+    static size_t getPositionKeyLength(std::string_view fen);   // Length of the board, side, castling and en passant fields
+
+private:
+    static bool parseNumber(std::string_view text, int& value);
+    static std::string_view nextField(std::string_view fen, size_t& pos);
+};
@@ -24,56 +24,62 @@ bool FENLoader::applyFEN(const std::string& fenString, ChessAnalysisProgram& con
 }
 
 bool FENLoader::applyFEN(const std::string& fenString, ChessAnalysisProgram& controller, bool preserveHistory) {
-    // Split FEN string into its components
-    std::vector<std::string> parts = splitString(fenString, ' ');
-    
-    // At minimum, we need the board position (first component)
-    if (parts.empty())
-        return false; // No data at all
+    // Parse all fields at once; the board position is mandatory
+    FENPosition position;
+    if (!FENCodec::parse(fenString, position))
+        return false; // No data or invalid board position - fail completely
 
-    // Parse and apply board position - this is mandatory
-    if (!parseBoardPosition(parts[0], controller, preserveHistory))
-        return false; // Invalid board position - fail completely
+    placePieces(position, controller, preserveHistory);
     
-    // If we have additional parts, try to parse game state
+    // If we have the full record, try to apply game state
     // But don't fail the entire load if game state parsing fails
-    if (parts.size() >= 6) {
-        // Try to parse full game state, but don't fail if it's invalid
-        parseGameState(parts[1], parts[2], parts[3], parts[4], parts[5], controller);
+    if (position.fieldCount >= 6) {
+        // Try to apply full game state, but don't fail if it's invalid
+        applyGameState(position, controller);
     }
     // If we have fewer than 6 parts, just use default game state
     
     return true; // Successfully loaded at least the board position
 }
 
-bool FENLoader::parseBoardPosition(const std::string& piecePositions, ChessAnalysisProgram& controller, bool preserveHistory) {
-    // Split board into ranks (rows) and validate first
-    std::vector<std::string> ranks = splitString(piecePositions, '/');
-    
-    if (ranks.size() != 8)
-        return false; // Must have exactly 8 ranks
-    
+bool FENLoader::parseBoardPosition(std::string_view piecePositions, ChessAnalysisProgram& controller, bool preserveHistory) {
     // Validate all ranks before clearing the board
-    for (int fenRank = 0; fenRank < 8; fenRank++) {
-        int file = 0;
-        for (char c : ranks[fenRank]) {
-            if (isDigit(c)) {
-                int emptySquares = charToInt(c);
-                if (emptySquares < 1 || emptySquares > 8 || file + emptySquares > 8)
-                    return false; // Invalid number of empty squares
-                file += emptySquares;
-            } else if (isValidFENChar(c)) {
-                if (file >= 8)
-                    return false; // Too many pieces in rank
-                file++;
-            } else {
-                return false; // Invalid character
-            }
-        }
-        if (file != 8)
-            return false; // Rank doesn't have exactly 8 squares
-    }
-    
+    FENPosition position;
+    if (!FENCodec::parseBoard(piecePositions, position.squares))
+        return false;
+
+    placePieces(position, controller, preserveHistory);
+    return true;
+}
+
+bool FENLoader::isValidBoardPosition(std::string_view piecePositions) {
+    std::array<Piece, SQUARE_COUNT> squares;
+    return FENCodec::parseBoard(piecePositions, squares);
+}
+
+bool FENLoader::loadPosition(const std::string& fenString, ChessBoard& board, ChessGameState& gameState) {
+    // Validate everything before touching the board
+    FENPosition position;
+    FENCodec::parse(fenString, position);
+    if (!position.hasFields(FENFields::POSITION))
+        return false; // Board, side, castling and en passant are mandatory
+    if (position.countPieces(Piece::WhiteKing) != 1 || position.countPieces(Piece::BlackKing) != 1)
+        return false; // Engines reject positions without exactly one king per side
+    if (position.enPassantRank >= 0 && position.enPassantRank != 2 && position.enPassantRank != 5)
+        return false; // En passant targets are on the third or sixth rank
+    if ((position.fieldCount > 4 && !position.hasFields(FENFields::HALFMOVE)) ||
+            (position.fieldCount > 5 && !position.hasFields(FENFields::FULLMOVE)))
+        return false; // Clocks are optional, but must be valid when present
+    
+    FENCodec::apply(position, board, gameState);
+    if (!position.hasFields(FENFields::HALFMOVE))
+        gameState.setHalfmoveClock(0);
+    if (!position.hasFields(FENFields::FULLMOVE))
+        gameState.setFullmoveClock(1);
+    return true;
+}
+
+void FENLoader::placePieces(const FENPosition& position, ChessAnalysisProgram& controller, bool preserveHistory) {
     // Only clear the board after validation passes
     // Use appropriate clear method based on preserveHistory flag
     if (preserveHistory) {
@@ -82,117 +88,33 @@ bool FENLoader::parseBoardPosition(const std::string& piecePositions, ChessAnaly
         controller.clearBoard();
     }
     
-    // Process each rank (FEN rank 8 = board rank 7, FEN rank 1 = board rank 0)
-    // Validation already done above, so we can safely place pieces
-    for (int fenRank = 0; fenRank < 8; fenRank++) {
-        int boardRank = 7 - fenRank; // Convert FEN rank to board rank
-        int file = 0;
-        
-        for (char c : ranks[fenRank]) {
-            if (isDigit(c)) {
-                // Number represents empty squares
-                int emptySquares = charToInt(c);
-                file += emptySquares; // Skip empty squares
-            } else if (isValidFENChar(c)) {
-                // Valid piece character - place it
-                controller.setPieceAt(boardRank, file, c);
-                file++;
-            }
-        }
+    // Validation already done by the codec, so we can safely place pieces
+    for (int index = 0; index < SQUARE_COUNT; index++) {
+        if (position.squares[index] != Piece::None)
+            controller.setPiece(static_cast<Square>(index), position.squares[index]);
     }
-    
-    return true;
 }
 
-bool FENLoader::parseGameState(const std::string& activeColor, const std::string& castlingRights,
-                              const std::string& enPassant, const std::string& halfmove,
-                              const std::string& fullmove, ChessAnalysisProgram& controller) {
-    bool success = true;
-    
-    // Try to set current player
-    if (activeColor == "w" || activeColor == "b")
-        controller.setCurrentPlayer(activeColor[0]);
-    else
-        success = false; // Invalid, but continue trying other parts
-    
-    // Try to set castling rights
-    bool validCastling = true;
-    for (char c : castlingRights) {
-        if (c != 'K' && c != 'Q' && c != 'k' && c != 'q' && c != '-') {
-            validCastling = false;
-            break;
-        }
+bool FENLoader::applyGameState(const FENPosition& position, ChessAnalysisProgram& controller) {
+    // Fields the codec rejected are left unchanged
+    if (position.hasFields(FENFields::SIDE))
+        controller.setCurrentPlayer(position.sideToMove);
+    
+    if (position.hasFields(FENFields::CASTLING))
+        controller.setCastlingRights(position.whiteKingside, position.whiteQueenside, position.blackKingside, position.blackQueenside);
+    
+    if (position.hasFields(FENFields::EN_PASSANT)) {
+        if (position.enPassantRank < 0)
+            controller.clearEnPassantTarget();
+        else
+            controller.setEnPassantTarget(position.enPassantRank, position.enPassantFile);
     }
-    if (validCastling) {
-        bool whiteKingside = castlingRights.find('K') != std::string::npos;
-        bool whiteQueenside = castlingRights.find('Q') != std::string::npos;
-        bool blackKingside = castlingRights.find('k') != std::string::npos;
-        bool blackQueenside = castlingRights.find('q') != std::string::npos;
-        controller.setCastlingRights(whiteKingside, whiteQueenside, blackKingside, blackQueenside);
-    } else
-        success = false;
     
-    // Try to set en passant target
-    if (enPassant == "-")
-        controller.clearEnPassantTarget();
-    else if (enPassant.length() == 2) {
-        char file = enPassant[0];
-        char rank = enPassant[1];
-        if (file >= 'a' && file <= 'h' && rank >= '1' && rank <= '8') {
-            int fileNum = file - 'a'; // Convert 'a'-'h' to 0-7
-            int rankNum = rank - '1'; // Convert '1'-'8' to 0-7
-            controller.setEnPassantTarget(rankNum, fileNum);
-        } else
-            success = false;
-    } else
-        success = false;
-    
-    // Try to set halfmove clock
-    try {
-        int halfmoveCount = std::stoi(halfmove);
-        if (halfmoveCount >= 0) 
-            controller.setHalfmoveClock(halfmoveCount);
-        else 
-            success = false;
-    } catch (const std::exception&) {
-        success = false;
-    }
+    if (position.hasFields(FENFields::HALFMOVE))
+        controller.setHalfmoveClock(position.halfmoveClock);
     
-    // Try to set fullmove number
-    try {
-        int fullmoveCount = std::stoi(fullmove);
-        if (fullmoveCount >= 1)
-            controller.setFullmoveClock(fullmoveCount);
-        else 
-            success = false;
-    } catch (const std::exception&) { 
-        success = false;
-    }
+    if (position.hasFields(FENFields::FULLMOVE))
+        controller.setFullmoveClock(position.fullmoveNumber);
     
-    return success; // Returns true only if ALL parts were valid
-}
-
-bool FENLoader::isValidFENChar(char c) {
-    return c == 'P' || c == 'R' || c == 'N' || c == 'B' || c == 'Q' || c == 'K' ||
-           c == 'p' || c == 'r' || c == 'n' || c == 'b' || c == 'q' || c == 'k';
+    return position.hasFields(FENFields::ALL); // Returns true only if ALL parts were valid
 }
-
-bool FENLoader::isDigit(char c) {
-    return c >= '1' && c <= '8';
-}
-
-int FENLoader::charToInt(char c) {
-    return c - '0';
-}
-
-std::vector<std::string> FENLoader::splitString(const std::string& str, char delimiter) {
-    std::vector<std::string> tokens;
-    std::stringstream ss(str);
-    std::string token;
-    
-    while (std::getline(ss, token, delimiter)) {
-        tokens.push_back(token);
-    }
-    
-    return tokens;
-}
\ No newline at end of file
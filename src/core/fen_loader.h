@@ -1,10 +1,9 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <fstream>
-#include <sstream>
-#include <vector>
-#include <iostream>
+#include "fen_codec.h"
 #include "../application/chess_analysis_program.h"
 
 class FENLoader {
@@ -17,16 +16,17 @@ public:
     static bool applyFEN(const std::string& fenString, ChessAnalysisProgram& controller, bool preserveHistory);
     
     // Helper methods for parsing FEN components (public for direct access)
-    static bool parseBoardPosition(const std::string& piecePositions, ChessAnalysisProgram& controller, bool preserveHistory = false);
+    static bool parseBoardPosition(std::string_view piecePositions, ChessAnalysisProgram& controller, bool preserveHistory = false);
+    
+    // Strict load into a standalone board and game state (headless use): every
+    // field must be valid and each side needs exactly one king; clocks are optional
+    static bool loadPosition(const std::string& fenString, ChessBoard& board, ChessGameState& gameState);
+    
+    // Validation only (no board is touched)
+    static bool isValidBoardPosition(std::string_view piecePositions);
 
 private:
-    static bool parseGameState(const std::string& activeColor, const std::string& castlingRights,
-                              const std::string& enPassant, const std::string& halfmove,
-                              const std::string& fullmove, ChessAnalysisProgram& controller);
-
-    // Utility methods
-    static bool isValidFENChar(char c);
-    static bool isDigit(char c);
-    static int charToInt(char c);
-    static std::vector<std::string> splitString(const std::string& str, char delimiter);
+    // Apply the valid game state fields of a parsed FEN (invalid ones are skipped)
+    static bool applyGameState(const FENPosition& position, ChessAnalysisProgram& controller);
+    static void placePieces(const FENPosition& position, ChessAnalysisProgram& controller, bool preserveHistory);
 };
\ No newline at end of file
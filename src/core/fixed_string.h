@@ -0,0 +1,72 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+
+/**
+ * Null-terminated string with inline storage for at most Capacity characters
+ *
+ * Used for history data (FEN, moves, captured pieces) so recording and copying
+ * positions never touches the heap. Writes that do not fit fail (return false)
+ * and leave the string unchanged, so text is never silently truncated.
+ */
+template <size_t Capacity>
+class FixedString {
+    static_assert(Capacity <= UINT8_MAX, "FixedString length is stored in a byte");
+
+public:
+    FixedString() = default;
+
+    bool assign(std::string_view text) {
+        if (text.size() > Capacity)
+            return false;
+        length = static_cast<uint8_t>(text.size());
+        std::memcpy(buffer.data(), text.data(), length);
+        buffer[length] = '\0';
+        return true;
+    }
+
+    bool push_back(const char c) {
+        if (length >= Capacity)
+            return false;
+        buffer[length++] = c;
+        buffer[length] = '\0';
+        return true;
+    }
+
+    bool append(std::string_view text) {
+        if (text.size() > Capacity - length)
+            return false;
+        std::memcpy(buffer.data() + length, text.data(), text.size());
+        length = static_cast<uint8_t>(length + text.size());
+        buffer[length] = '\0';
+        return true;
+    }
+
+    void clear() {
+        length = 0;
+        buffer[0] = '\0';
+    }
+
+    const char* c_str() const { return buffer.data(); }
+    std::string_view view() const { return std::string_view(buffer.data(), length); }
+    std::string str() const { return std::string(buffer.data(), length); }
+    operator std::string_view() const { return view(); }
+
+    size_t size() const { return length; }
+    bool empty() const { return length == 0; }
+    char operator[](const size_t index) const { return buffer[index]; }
+    const char* begin() const { return buffer.data(); }
+    const char* end() const { return buffer.data() + length; }
+
+    bool operator==(const FixedString& other) const { return view() == other.view(); }
+    bool operator!=(const FixedString& other) const { return view() != other.view(); }
+
+private:
+    std::array<char, Capacity + 1> buffer = {};
+    uint8_t length = 0;
+};
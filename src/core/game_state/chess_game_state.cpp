@@ -13,11 +13,11 @@ void ChessGameState::makeMove(const ChessMove& move) {
     fullmoveClock++;
     halfmoveClock++; // Assume no pawn movement or capture
     
-    char srcPiece = board->getPieceAt(move.getSrcRank(), move.getSrcFile());
-    char destPiece = board->getPieceAt(move.getDestRank(), move.getDestFile());
+    const Piece srcPiece = board->getPiece(move.getFrom());
+    const Piece destPiece = board->getPiece(move.getTo());
 
     // Check for halfmove clock reset
-    if (board->isPawn(srcPiece) || destPiece != BoardCfg::EMPTY)
+    if (board->isPawn(srcPiece) || destPiece != Piece::None)
         resetHalfmoveClock();
     
     // Update special move states
@@ -83,7 +83,7 @@ bool ChessGameState::hasThreefoldRepetition() const {
     return false; //TODO: Implement threefold repetition tracking in ChessHistoryTracker class
 }
 
-void ChessGameState::updateCastlingRights(const ChessMove& move, const char srcPiece, const char destPiece) {
+void ChessGameState::updateCastlingRights(const ChessMove& move, const Piece srcPiece, const Piece destPiece) {
     // Load movement info
     int srcRank = move.getSrcRank();
     int srcFile = move.getSrcFile();
@@ -91,29 +91,29 @@ void ChessGameState::updateCastlingRights(const ChessMove& move, const char srcP
     int destFile = move.getDestFile();
 
     // Update king movement
-    whiteKingMoved = whiteKingMoved || (srcPiece == 'K');
-    blackKingMoved = blackKingMoved || (srcPiece == 'k');
+    whiteKingMoved = whiteKingMoved || (srcPiece == Piece::WhiteKing);
+    blackKingMoved = blackKingMoved || (srcPiece == Piece::BlackKing);
 
     // Check for rook movement 
-    if (srcPiece == 'R' && srcRank == BoardCfg::WHITE_BACK_RANK) {
+    if (srcPiece == Piece::WhiteRook && srcRank == BoardCfg::WHITE_BACK_RANK) {
         whiteKRookMoved = whiteKRookMoved || srcFile == BoardCfg::KINGSIDE_ROOK_FILE;
         whiteQRookMoved = whiteQRookMoved || srcFile == BoardCfg::QUEENSIDE_ROOK_FILE;
-    } else if (srcPiece == 'r' && srcRank == BoardCfg::BLACK_BACK_RANK) {
+    } else if (srcPiece == Piece::BlackRook && srcRank == BoardCfg::BLACK_BACK_RANK) {
         blackKRookMoved = blackKRookMoved || srcFile == BoardCfg::KINGSIDE_ROOK_FILE;
         blackQRookMoved = blackQRookMoved || srcFile == BoardCfg::QUEENSIDE_ROOK_FILE;
     }
     
     // Check for rook capture
-    if (destPiece == 'R' && destRank == BoardCfg::WHITE_BACK_RANK) {
+    if (destPiece == Piece::WhiteRook && destRank == BoardCfg::WHITE_BACK_RANK) {
         whiteKRookMoved = whiteKRookMoved || destFile == BoardCfg::KINGSIDE_ROOK_FILE;
         whiteQRookMoved = whiteQRookMoved || destFile == BoardCfg::QUEENSIDE_ROOK_FILE;
-    } else if (destPiece == 'r' && destRank == BoardCfg::BLACK_BACK_RANK) {
+    } else if (destPiece == Piece::BlackRook && destRank == BoardCfg::BLACK_BACK_RANK) {
         blackKRookMoved = blackKRookMoved || destFile == BoardCfg::KINGSIDE_ROOK_FILE;
         blackQRookMoved = blackQRookMoved || destFile == BoardCfg::QUEENSIDE_ROOK_FILE;
     }
 }
 
-void ChessGameState::updateEnPassantState(const ChessMove& move, const char srcPiece) {
+void ChessGameState::updateEnPassantState(const ChessMove& move, const Piece srcPiece) {
     // Load movement info
     int srcRank = move.getSrcRank();
     int srcFile = move.getSrcFile();
@@ -124,7 +124,7 @@ void ChessGameState::updateEnPassantState(const ChessMove& move, const char srcP
     clearEnPassantState();
 
     // Check if a pawn made a double move
-    if (srcPiece == 'P' || srcPiece == 'p') {
+    if (board->isPawn(srcPiece)) {
         int rankDiff = abs(destRank - srcRank);
 
         enPassantPawnRank = destRank;
@@ -57,8 +57,8 @@ private:
     int enPassantPawnRank, enPassantPawnFile;
 
     // Updating states
-    void updateCastlingRights(const ChessMove& move, const char srcPiece, const char destPiece);
-    void updateEnPassantState(const ChessMove& move, const char srcPiece);
+    void updateCastlingRights(const ChessMove& move, const Piece srcPiece, const Piece destPiece);
+    void updateEnPassantState(const ChessMove& move, const Piece srcPiece);
     void resetHalfmoveClock();
     void resetCastlingRights();
 };
\ No newline at end of file
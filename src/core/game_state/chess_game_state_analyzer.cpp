@@ -1,4 +1,5 @@
 #include "chess_game_state_analyzer.h"
+#include "../../profiling/profiler.h"
 
 using StateAnalyzer = ChessGameStateAnalyzer;
 namespace BoardCfg = Config::Board;
@@ -7,6 +8,8 @@ StateAnalyzer::GameState StateAnalyzer::analyzeGameState(
     const ChessBoard& board,
     const ChessGameState& gameState,
     const FENPositionTracker& fenStateHistory) {
+    PROFILE_SCOPE("ChessGameStateAnalyzer::analyzeGameState");
+
     // Check 50-Move Rule
     if (isDraw50Moves(gameState)) 
         return StateAnalyzer::GameState::DRAW_50_MOVES;
@@ -47,24 +50,24 @@ bool StateAnalyzer::isInsufficientMaterial(const ChessBoard& board) const {
     // Check each board position
     for (int rank = BoardCfg::MIN_RANK; rank <= BoardCfg::MAX_RANK; rank++) {
         for (int file = BoardCfg::MIN_FILE; file <= BoardCfg::MAX_FILE; file++) {
-            char piece = board.getPieceAt(rank, file);
+            const Piece piece = board.getPiece(rank, file);
             // If empty, skip
-            if (piece == BoardCfg::EMPTY) 
+            if (piece == Piece::None) 
                 continue;
             // If a pawn exists, there is sufficient material
             else if (board.isPawn(piece))
                 sufficientMaterial = true;
             // Check for white bishops
-            else if (piece == 'B') 
+            else if (piece == Piece::WhiteBishop) 
                 whiteBishopCount++;
             // Check for black bishops
-            else if (piece == 'b') 
+            else if (piece == Piece::BlackBishop) 
                 blackBishopCount++;
             // Check for white knights
-            else if (piece == 'N') 
+            else if (piece == Piece::WhiteKnight) 
                 whiteKnightCount++;
             // Check for black knights
-            else if (piece == 'n') 
+            else if (piece == Piece::BlackKnight) 
                 blackKnightCount++;
             // For any other piece except king
             else if (!board.isKing(piece))
@@ -103,56 +106,9 @@ bool StateAnalyzer::isThreefoldRepetition(const FENPositionTracker& fenStateHist
 
 // --- HELPERS ---
 bool StateAnalyzer::isInCheck(const ChessBoard& board, const ChessGameState& gameState) const {
-    char currentPlayer = gameState.getCurrentPlayer();
-    std::pair<int, int> kingPosition = board.getKingPosition(currentPlayer);
-    char opponent = 
-        (currentPlayer == 'w') ?
-        'b' :
-        'w';
-
-    return validator.isSquareUnderAttack(board, gameState, kingPosition.first, kingPosition.second, opponent);
+    return validator.isInCheck(board, gameState);
 }
 
 bool StateAnalyzer::hasLegalMoves(const ChessBoard& board, const ChessGameState& gameState) const {
-    char currentPlayer = gameState.getCurrentPlayer();
-
-    // Iterate through all squares on the board to find current player's pieces
-    for (int srcRank = BoardCfg::MIN_RANK; srcRank <= BoardCfg::MAX_RANK; srcRank++) {
-        for (int srcFile = BoardCfg::MIN_FILE; srcFile <= BoardCfg::MAX_FILE; srcFile++){
-            char piece = board.getPieceAt(srcRank, srcFile);
-            
-            // Skip empty squares
-            if (piece == BoardCfg::EMPTY) 
-                continue;
-            
-            // Check if this piece belongs to the current player
-            bool isCurrentPlayerPiece = 
-                (currentPlayer == 'w') ?
-                board.isWhitePiece(srcRank, srcFile) :
-                !board.isWhitePiece(srcRank, srcFile);
-            
-            if (!isCurrentPlayerPiece) 
-                continue;
-
-            // Try all possible destination squares for this piece
-            for (int destRank = BoardCfg::MIN_RANK; destRank <= BoardCfg::MAX_RANK; destRank++) {
-                for (int destFile = BoardCfg::MIN_FILE; destFile <= BoardCfg::MAX_FILE; destFile++){
-                    // Skip moving to the same square
-                    if (srcRank == destRank && srcFile == destFile) 
-                        continue;
-                    
-                    
-                    // Test if this move is valid
-                    ChessMoveValidator::MoveResult result = 
-                        validator.validateMove(board, gameState, ChessMove{srcRank, srcFile, destRank, destFile});
-                    
-                    // If we find any legal move, the player has legal moves
-                    if (validator.isValidMoveResult(result))
-                        return true; // Found a legal move
-                }
-            }
-        }
-    }
-    // No legal moves found
-    return false;
+    return validator.hasLegalMove(board, gameState);
 }
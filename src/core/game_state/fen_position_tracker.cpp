@@ -1,160 +1,243 @@
 #include "fen_position_tracker.h"
 #include "../../config/config.h"
+#include "../position.h"
+#include <algorithm>
 
 namespace BoardCfg = Config::Board;
 
-FENPositionTracker::FENPositionTracker() {
-    positionHistory = {};
-    positionRedo = {};
-}
+// Returned when there is no current/redo position
+static const PositionState EMPTY_POSITION_STATE{};
 
-const std::vector<PositionState>& FENPositionTracker::getPositionHistory() const {
-    return positionHistory;
+FENPositionTracker::FENPositionTracker() {
+    // Reserve once; clearHistory keeps the capacity so later games reuse it
+    nodes.reserve(HistoryCfg::RESERVED_NODES);
+    historyPath.reserve(HistoryCfg::RESERVED_NODES);
+    transpositionHeads.assign(HistoryCfg::TRANSPOSITION_BUCKETS, PositionNode::NONE);
 }
 
 std::string FENPositionTracker::getStartPosition() const {
     return 
-        (positionHistory.empty()) ?
+        (nodes.empty()) ?
         "" :
-        positionHistory.front().fenString;
+        nodes.front().state.fenString.str();
 }
 
 std::string FENPositionTracker::getCurrentPosition() const {
     return 
-        (positionHistory.empty()) ?
+        (historyPath.empty()) ?
         "" :
-        positionHistory.back().fenString;
+        nodes[historyPath.back()].state.fenString.str();
 }
 
 void FENPositionTracker::record(
     const ChessBoard& board, 
     const ChessGameState& gameState, 
-    const std::string& algebraicMove) {
-
-    std::string newPosition = "";
-
-    newPosition += getBoardState(board);
-    newPosition += " ";
-
-    newPosition += std::string(1, gameState.getCurrentPlayer());
-    newPosition += " ";
-
-    newPosition += getCastlingRights(gameState);
-    newPosition += " ";
-
-    newPosition += getEnPassantTarget(gameState);
-    newPosition += " ";
+    const ChessMove& move,
+    std::string_view sanMove) {
 
-    newPosition += std::to_string(gameState.getHalfmoveClock());
-    newPosition += " ";
-    
-    newPosition += std::to_string(gameState.getFullmoveClock());
+    // Write the FEN into the position's inline buffer
+    PositionState state;
+    FENCodec::write(board, gameState, state.fenString);
 
-    // Create PositionState with FEN, captured pieces, algebraic move, and move owner
-    PositionState newState(
-        newPosition, 
-        board.getWhiteCapturedPieces(), 
-        board.getBlackCapturedPieces(), 
-        algebraicMove,
-        gameState.getCurrentPlayer());
-    
-    positionHistory.push_back(newState);
+    // Captured pieces, move, and move owner
+    state.whiteCapturedPieces = board.getWhiteCapturedPieces();
+    state.blackCapturedPieces = board.getBlackCapturedPieces();
+    state.move = move;
+    state.sanMove.assign(sanMove); // Stays empty if it does not fit: PGN export then writes the UCI move
+    state.movedBy = gameState.getCurrentPlayer();
 
-    if (!positionRedo.empty()) {
-        if (newPosition == positionRedo.back().fenString)
-            positionRedo.pop_back(); // Pop position redone from stack
-        else
-            positionRedo.clear(); // Clear stack; different future
-    }
+    record(state);
 }
 
 void FENPositionTracker::record(const PositionState& state) {
-    positionHistory.push_back(state);
-    if (!positionRedo.empty()) {
-        if (state.fenString == positionRedo.back().fenString)
-            positionRedo.pop_back(); // Pop position redone from stack
-        else
-            positionRedo.clear(); // Clear stack; different future
+    // First position becomes the root
+    if (historyPath.empty()) {
+        historyPath.push_back(addNode(state, PositionNode::NONE));
+        version++;
+        return;
     }
+
+    // A new move branches a variation, keeping every existing line in the tree;
+    // replaying a known move re-enters its line (redo continues from the child)
+    const int32_t current = historyPath.back();
+    int32_t child = findChild(current, state.fenString);
+    if (child == PositionNode::NONE)
+        child = addNode(state, current);
+    nodes[current].lastVisitedChild = child;
+    historyPath.push_back(child);
+    version++;
 }
 
 void FENPositionTracker::record(const ChessBoard& board, const ChessGameState& gameState) {
-    record(board, gameState, "");
+    record(board, gameState, ChessMove());
 }
 
 void FENPositionTracker::undoMove() {
-    if (positionHistory.size() > 1) { // Need at least 2 positions to undo
-        PositionState lastPosition = positionHistory.back();
-        positionHistory.pop_back();
-        positionRedo.push_back(lastPosition);
+    if (historyPath.size() > 1) { // Need at least 2 positions to undo
+        // Parent's lastVisitedChild already points here, so redo re-enters this line
+        historyPath.pop_back();
+        version++;
     }
 }
 
 void FENPositionTracker::redoMove() {
-    if (!positionRedo.empty()) {
-        PositionState nextPosition = positionRedo.back();
-        positionRedo.pop_back();
-        positionHistory.push_back(nextPosition);
+    const int32_t next = getRedoNode();
+    if (next != PositionNode::NONE) {
+        historyPath.push_back(next);
+        version++;
     }
 }
 
 const bool FENPositionTracker::isUndoAvailable() const {
     // We can undo if we have more than 1 position (initial position + at least 1 move)
-    return positionHistory.size() > 1;
+    return historyPath.size() > 1;
 }
 
 const bool FENPositionTracker::isRedoAvailable() const {
-    return !positionRedo.empty();
+    return getRedoNode() != PositionNode::NONE;
 }
 
 const std::string FENPositionTracker::getRedoPosition() const {
+    const int32_t next = getRedoNode();
     return
-        (positionRedo.empty()) ?
+        (next == PositionNode::NONE) ?
         "" :
-        positionRedo.back().fenString;
+        nodes[next].state.fenString.str();
 }
 
-const std::string FENPositionTracker::getRedoMove() const {
+ChessMove FENPositionTracker::getRedoMove() const {
+    const int32_t next = getRedoNode();
     return
-        (positionRedo.empty()) ?
-        "" :
-        positionRedo.back().algebraicMove;
+        (next == PositionNode::NONE) ?
+        ChessMove() :
+        nodes[next].state.move;
+}
+
+std::vector<int32_t> FENPositionTracker::getRedoLine() const {
+    // Follow the last visited continuation from the current node, then reverse into stack order
+    std::vector<int32_t> redoLine;
+    for (int32_t next = getRedoNode(); 
+            next != PositionNode::NONE; 
+            next = nodes[next].lastVisitedChild)
+        redoLine.push_back(next);
+    std::reverse(redoLine.begin(), redoLine.end());
+    return redoLine;
 }
 
-const std::vector<PositionState>& FENPositionTracker::getRedoPositions() const {
-    return positionRedo;
+bool FENPositionTracker::switchToNextVariation() {
+    if (historyPath.size() < 2)
+        return false;
+
+    const int32_t current = historyPath.back();
+    const int32_t parent = nodes[current].parent;
+    int32_t next = nodes[current].nextSibling;
+    if (next == PositionNode::NONE)
+        next = nodes[parent].firstChild; // Wrap around to the main line
+    if (next == current)
+        return false; // No alternatives
+
+    // Redo continues from the alternative's own last visited continuation
+    historyPath.back() = next;
+    nodes[parent].lastVisitedChild = next;
+    version++;
+    return true;
+}
+
+int FENPositionTracker::getVariationCount() const {
+    if (historyPath.size() < 2)
+        return 0;
+
+    int count = 0;
+    for (int32_t child = nodes[nodes[historyPath.back()].parent].firstChild; 
+            child != PositionNode::NONE; 
+            child = nodes[child].nextSibling)
+        count++;
+    return count;
 }
 
-void FENPositionTracker::setStartingPosition(const std::string& fen) {
+bool FENPositionTracker::setStartingPosition(const std::string& fen) {
+    // A FEN longer than a node holds is not a position FENCodec writes; keep the current history
+    PositionState state;
+    if (!state.fenString.assign(fen))
+        return false;
+
     clearHistory();
-    // Starting position has no captured pieces and no move (empty string)
-    PositionState startState(fen, {}, {}, "");
-    positionHistory.push_back(startState);
+    // Starting position has no captured pieces and no move
+    record(state);
+    return true;
 }
 
 void FENPositionTracker::clearHistory() {
-    positionHistory.clear();
-    positionRedo.clear();
+    nodes.clear();
+    historyPath.clear();
+    std::fill(transpositionHeads.begin(), transpositionHeads.end(), PositionNode::NONE);
+    version++;
 }
 
-const std::vector<std::string> FENPositionTracker::getMoveHistory() const {
+uint64_t FENPositionTracker::getCurrentLineHash() const {
+    return historyPath.empty() ? 0 : nodes[historyPath.back()].lineHash;
+}
+
+uint64_t FENPositionTracker::getChildLineHash(const ChessMove& move) const {
+    // Same chaining as addNode, without recording the move
+    return hashMove(getCurrentLineHash(), move);
+}
+
+uint64_t FENPositionTracker::getCurrentZobristKey() const {
+    // Same key as positions replayed by the game database indexer, so transpositions match
+    Position position;
+    if (historyPath.empty() || !position.setFromFEN(getCurrentPositionState().fenString.view()))
+        return 0;
+    return position.getKey();
+}
+
+size_t FENPositionTracker::getIrreversibleDepth() const {
+    if (historyPath.empty())
+        return 0;
+
+    // The halfmove clock counts plies since the last capture or pawn move
+    const size_t currentDepth = historyPath.size() - 1;
+    const size_t halfmoveClock = static_cast<size_t>(
+        FENCodec::getHalfmoveClock(nodes[historyPath.back()].state.fenString));
+    return (halfmoveClock >= currentDepth) ? 0 : currentDepth - halfmoveClock;
+}
+
+std::string FENPositionTracker::getPositionAt(const size_t depth) const {
+    return 
+        (depth >= historyPath.size()) ?
+        "" :
+        nodes[historyPath[depth]].state.fenString.str();
+}
+
+std::vector<std::string> FENPositionTracker::getMovesSince(const size_t depth) const {
     std::vector<std::string> moves;
-    for (auto position : positionHistory) {
-        moves.push_back(position.algebraicMove);
+    if (depth + 1 >= historyPath.size())
+        return moves;
+
+    moves.reserve(historyPath.size() - depth - 1);
+    for (size_t i = depth + 1; i < historyPath.size(); i++) {
+        moves.push_back(nodes[historyPath[i]].state.move.toAlgebraicNotation()); // Short enough for SSO
     }
     return moves;
 }
 
 bool FENPositionTracker::isThreefoldRepetition() const {
-    if (positionHistory.empty())
+    if (historyPath.empty())
         return false;
 
-    // Only need to track the last move
-    std::string currentPos = extractPositionKey(positionHistory.back().fenString);
+    // Only need to track the last move: walk its transposition chain
+    const PositionNode& current = nodes[historyPath.back()];
     int count = 0;
 
-    for (const auto& state : positionHistory) {
-        if (extractPositionKey(state.fenString) == currentPos){
+    const size_t bucket = current.positionKeyHash & (HistoryCfg::TRANSPOSITION_BUCKETS - 1);
+
+    for (int32_t index = transpositionHeads[bucket]; 
+            index != PositionNode::NONE; 
+            index = nodes[index].nextTransposition) {
+        // Buckets are shared and hashes can collide: the hash filters, the FEN key decides
+        if (nodes[index].positionKeyHash == current.positionKeyHash && 
+                isOnHistoryPath(index) &&
+                getPositionKey(nodes[index].state.fenString) == getPositionKey(current.state.fenString)) {
             count++;
             if (count >= 3)
                 return true;
@@ -163,98 +246,173 @@ bool FENPositionTracker::isThreefoldRepetition() const {
     return false;
 }
 
-PositionState FENPositionTracker::getCurrentPositionState() const {
-    return positionHistory.empty() ? PositionState() : positionHistory.back();
+const PositionState& FENPositionTracker::getCurrentPositionState() const {
+    return historyPath.empty() ? EMPTY_POSITION_STATE : nodes[historyPath.back()].state;
 }
 
-PositionState FENPositionTracker::getRedoPositionState() const {
-    return positionRedo.empty() ? PositionState() : positionRedo.back();
+const PositionState& FENPositionTracker::getRedoPositionState() const {
+    const int32_t next = getRedoNode();
+    return next == PositionNode::NONE ? EMPTY_POSITION_STATE : nodes[next].state;
 }
 
-std::string FENPositionTracker::getCurrentMove() const {
-    return positionHistory.empty() ? "" : positionHistory.back().algebraicMove;
+ChessMove FENPositionTracker::getCurrentMove() const {
+    return historyPath.empty() ? ChessMove() : nodes[historyPath.back()].state.move;
 }
 
-std::string FENPositionTracker::getBoardState(const ChessBoard& board) const {
-    std::string positionString = "";
-    int emptyCount = 0;
-
-    // FEN notation goes from rank 8 to rank 1 (top to bottom)  
-    // Our internal representation: rank 7 = FEN rank 8, rank 0 = FEN rank 1
-    for (int rank = BoardCfg::MAX_RANK; rank >= BoardCfg::MIN_RANK; rank--) {
-        
-        for (int file = BoardCfg::MIN_FILE; file <= BoardCfg::MAX_FILE; file++) {
-            
-            char piece = board.getPieceAt(rank, file);
-            
-            if (piece == BoardCfg::EMPTY) {
-                emptyCount++;
-                continue;
-            }
-            
-            if (emptyCount > 0) {
-                positionString += std::to_string(emptyCount);
-                emptyCount = 0;
-            }
-
-            positionString += std::string(1, piece);
-        }
-        
-        // Add remaining empty squares at end of rank
-        if (emptyCount > 0) {
-            positionString += std::to_string(emptyCount);
-        }
-        // Reset empty count
-        emptyCount = 0;
-        // Add rank separator (except for the last rank)
-        if (rank != BoardCfg::MIN_RANK) {
-            positionString += "/";
+void FENPositionTracker::writePGN(std::ostream& out, const std::string& eventName) const {
+    const std::string standardStartPos = "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";
+    const std::string startPos = getStartPosition();
+
+    // Seven tag roster (plus SetUp/FEN for custom starting positions)
+    out << "[Event \"" << eventName << "\"]\n";
+    out << "[Site \"?\"]\n";
+    out << "[Date \"????.??.??\"]\n";
+    out << "[Round \"?\"]\n";
+    out << "[White \"?\"]\n";
+    out << "[Black \"?\"]\n";
+    out << "[Result \"*\"]\n";
+    if (!startPos.empty() && startPos != standardStartPos) {
+        out << "[SetUp \"1\"]\n";
+        out << "[FEN \"" << startPos << "\"]\n";
+    }
+    out << "\n";
+
+    // Movetext, wrapped below 80 columns
+    std::ostringstream movetext;
+    if (!nodes.empty())
+        writePGNLine(movetext, 0);
+    movetext << "*";
+
+    std::istringstream tokens(movetext.str());
+    std::string token;
+    size_t lineLength = 0;
+    while (tokens >> token) {
+        if (lineLength > 0 && lineLength + 1 + token.size() > 79) {
+            out << "\n";
+            lineLength = 0;
+        } else if (lineLength > 0) {
+            out << " ";
+            lineLength++;
         }
+        out << token;
+        lineLength += token.size();
     }
+    out << "\n";
+}
 
-    return positionString;
+int32_t FENPositionTracker::addNode(const PositionState& state, const int32_t parent) {
+    const int32_t index = static_cast<int32_t>(nodes.size());
+    nodes.emplace_back();
+    PositionNode& node = nodes.back();
+    node.state = state;
+    node.parent = parent;
+    node.depth = (parent == PositionNode::NONE) ? 0 : nodes[parent].depth + 1;
+
+    // movedBy holds the side to move after the move: 'b' means white just moved
+    const int fullmove = FENCodec::getFullmoveNumber(state.fenString);
+    node.moveNumber = (state.movedBy == 'b') ? fullmove : fullmove - 1;
+
+    // Append as the last alternative of the parent
+    if (parent != PositionNode::NONE) {
+        PositionNode& parentNode = nodes[parent];
+        if (parentNode.firstChild == PositionNode::NONE)
+            parentNode.firstChild = index;
+        else
+            nodes[parentNode.lastChild].nextSibling = index;
+        parentNode.lastChild = index;
+    }
+
+    // Line identity: root FEN, then each move chained onto the parent's hash
+    node.lineHash = (parent == PositionNode::NONE) ? 
+        hashText(FNV_OFFSET_BASIS, state.fenString.view()) :
+        hashMove(nodes[parent].lineHash, state.move);
+
+    // Chain onto earlier nodes in the same position bucket
+    node.positionKeyHash = hashPositionKey(state.fenString);
+    const size_t bucket = node.positionKeyHash & (HistoryCfg::TRANSPOSITION_BUCKETS - 1);
+    node.nextTransposition = transpositionHeads[bucket];
+    transpositionHeads[bucket] = index;
+
+    return index;
 }
 
-std::string FENPositionTracker::getCastlingRights(const ChessGameState& gameState) const {
-    std::string castlingString = "";
+int32_t FENPositionTracker::findChild(const int32_t parent, const FenString& fenString) const {
+    for (int32_t child = nodes[parent].firstChild; child != PositionNode::NONE; child = nodes[child].nextSibling) {
+        if (nodes[child].state.fenString == fenString)
+            return child;
+    }
+    return PositionNode::NONE;
+}
 
-    if (gameState.canCastleKingside('w'))
-        castlingString += "K";
-    if (gameState.canCastleQueenside('w'))
-        castlingString += "Q";
-    if (gameState.canCastleKingside('b'))
-        castlingString += "k";
-    if (gameState.canCastleQueenside('b'))
-        castlingString += "q";
-    if (castlingString.empty())
-        castlingString = "-";
-    
-    return castlingString;
+bool FENPositionTracker::isOnHistoryPath(const int32_t index) const {
+    const int32_t depth = nodes[index].depth;
+    return depth < static_cast<int32_t>(historyPath.size()) && historyPath[depth] == index;
 }
 
-std::string FENPositionTracker::getEnPassantTarget(const ChessGameState& gameState) const {
-    std::string enPassantString = "-";
+int32_t FENPositionTracker::getRedoNode() const {
+    return historyPath.empty() ? PositionNode::NONE : nodes[historyPath.back()].lastVisitedChild;
+}
 
-    if (gameState.isEnPassantAvailable()){
-        auto [rank, file] = gameState.getEnPassantTarget();
-        
-        // Convert to algebraic notition
-        char fileChar = 'a' + file;
-        char rankChar = '1' + rank;
+void FENPositionTracker::writePGNMove(std::ostream& out, const int32_t index, const bool forceMoveNumber) const {
+    const PositionNode& node = nodes[index];
+    if (node.state.movedBy == 'b') // White moved
+        out << node.moveNumber << ". ";
+    else if (forceMoveNumber)
+        out << node.moveNumber << "... ";
+
+    if (node.state.sanMove.empty())
+        out << node.state.move.toAlgebraicNotation() << " ";
+    else
+        out << node.state.sanMove.view() << " ";
+}
 
-        enPassantString = std::string(1, fileChar) + std::string(1, rankChar);
+void FENPositionTracker::writePGNLine(std::ostream& out, int32_t parent) const {
+    // Iterate the main continuation; recurse only into alternatives
+    bool forceMoveNumber = true;
+    while (nodes[parent].firstChild != PositionNode::NONE) {
+        const int32_t mainMove = nodes[parent].firstChild;
+        writePGNMove(out, mainMove, forceMoveNumber);
+        forceMoveNumber = false;
+
+        for (int32_t alternative = nodes[mainMove].nextSibling; 
+                alternative != PositionNode::NONE; 
+                alternative = nodes[alternative].nextSibling) {
+            out << "( ";
+            writePGNMove(out, alternative, true);
+            writePGNLine(out, alternative);
+            out << ") ";
+            forceMoveNumber = true; // Resume the main line with a move number
+        }
+        parent = mainMove;
     }
+}
 
-    return enPassantString;
+std::string_view FENPositionTracker::getPositionKey(const FenString& fenString) {
+    // First four FEN fields only (clocks do not affect repetition)
+    const std::string_view fen = fenString.view();
+    return fen.substr(0, FENCodec::getPositionKeyLength(fen));
 }
 
-std::string FENPositionTracker::extractPositionKey(const std::string& fenString) const {
-    
-    std::istringstream iss(fenString);
-    std::string board, activeColor, castling, enPassant;
+uint64_t FENPositionTracker::hashPositionKey(const FenString& fenString) const {
+    return hashText(FNV_OFFSET_BASIS, getPositionKey(fenString));
+}
 
-    // Whitespace is the default delimiter when using extraction operator
-    iss >> board >> activeColor >> castling >> enPassant;
+uint64_t FENPositionTracker::hashText(uint64_t hash, std::string_view text) {
+    // FNV-1a
+    for (char c : text) {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
 
-    return board + " " + activeColor + " " + castling + " " + enPassant;
-}
\ No newline at end of file
+uint64_t FENPositionTracker::hashMove(uint64_t hash, const ChessMove& move) {
+    // FNV-1a over the two key bytes (fixed width, so moves need no separator); the key
+    // ignores flags UCI moves do not carry
+    const uint16_t key = move.getKey();
+    hash ^= static_cast<uint8_t>(key & 0xFF);
+    hash *= 1099511628211ULL;
+    hash ^= static_cast<uint8_t>(key >> 8);
+    hash *= 1099511628211ULL;
+    return hash;
+}
@@ -1,35 +1,73 @@
 #pragma once
 
+#include <cstdint>
+#include <ostream>
 #include <sstream>
 #include <string>
+#include <string_view>
 #include <vector>
 #include "../board/chess_board.h"
+#include "../fen_codec.h"
+#include "../fixed_string.h"
 #include "chess_game_state.h"
 
-// Structure to hold complete position state including captured pieces
+namespace HistoryCfg = Config::History;
+
+using SanString = FixedString<HistoryCfg::SAN_CAPACITY>;
+
+// Structure to hold complete position state including captured pieces (fixed size, trivially copyable)
 struct PositionState {
-    std::string fenString;
-    std::vector<char> whiteCapturedPieces;
-    std::vector<char> blackCapturedPieces;
-    std::string algebraicMove; // The move that led to this position (empty for initial position)
-    char movedBy; // The player who made the move (empty for initial position)
-
-    PositionState() = default;
-    PositionState(const std::string& fen, const std::vector<char>& whiteCaptured, const std::vector<char>& blackCaptured, const std::string& move = "", const char movedBy = ' ')
-        : fenString(fen), whiteCapturedPieces(whiteCaptured), blackCapturedPieces(blackCaptured), algebraicMove(move), movedBy(movedBy) {}
+    FenString fenString;
+    CapturedPieceList whiteCapturedPieces;
+    CapturedPieceList blackCapturedPieces;
+    ChessMove move; // The move that led to this position (null for initial position)
+    SanString sanMove; // The same move in Standard Algebraic Notation (for PGN export)
+    char movedBy = ' '; // The player who made the move (empty for initial position)
 };
 
+// A position in the variation tree; links are indices into the node arena
+struct PositionNode {
+    static constexpr int32_t NONE = -1;
+
+    PositionState state;
+    uint64_t positionKeyHash = 0;         // Hash of the repetition-relevant FEN fields
+    uint64_t lineHash = 0;                // Hash of the root FEN and every move leading here
+    int moveNumber = 0;                   // PGN move number of the move leading here
+    int32_t parent = NONE;
+    int32_t firstChild = NONE;            // Main continuation
+    int32_t lastChild = NONE;             // For O(1) appends
+    int32_t nextSibling = NONE;           // Next alternative to this move
+    int32_t lastVisitedChild = NONE;      // Continuation re-entered by redo
+    int32_t nextTransposition = NONE;     // Earlier node reaching the same position
+    int32_t depth = 0;                    // Plies from the root
+};
+
+/**
+ * Position history stored as a variation tree
+ *
+ * Key features:
+ * - Nodes live in one contiguous arena and link by index, never by pointer;
+ *   nodes are fixed size and the arena only grows, so recording is allocation free
+ * - Playing a different move after undo starts a new variation instead of
+ *   discarding the old line
+ * - Undo, redo, branching and variation switching are O(1) per step
+ * - Nodes with the same position are chained (transpositions), which also
+ *   makes repetition checks integer comparisons
+ * - PGN export with nested variations
+ */
 class FENPositionTracker {
 public:
     FENPositionTracker();
-    
+
     // Position tracking
-   const std::vector<PositionState>& getPositionHistory() const;
+    const std::vector<int32_t>& getHistoryPath() const { return historyPath; } // Root to current node
+    std::vector<int32_t> getRedoLine() const;                                  // Next position at the back
+    const PositionNode& getNode(const int32_t index) const { return nodes[index]; }
     std::string getStartPosition() const;
     std::string getCurrentPosition() const;
 
     // Record once
-    void record(const ChessBoard& board, const ChessGameState& gameState, const std::string& algebraicMove);
+    void record(const ChessBoard& board, const ChessGameState& gameState, const ChessMove& move, std::string_view sanMove = "");
     void record(const ChessBoard& board, const ChessGameState& gameState);
     void record(const PositionState& state);
 
@@ -39,33 +77,58 @@ public:
     const bool isUndoAvailable() const;
     const bool isRedoAvailable() const;
     const std::string getRedoPosition() const;
-    const std::string getRedoMove() const;
-    const std::vector<PositionState>& getRedoPositions() const;
-    
+    ChessMove getRedoMove() const; // Null move if redo is unavailable
+
+    // Variations
+    bool switchToNextVariation(); // Replace the current move with its next alternative (wraps)
+    int getVariationCount() const; // Alternatives at the current move (including itself)
+
     // Get complete position state (FEN + captured pieces + move)
-    PositionState getCurrentPositionState() const;
-    PositionState getRedoPositionState() const;
-    
-    // Get move that led to current position
-    std::string getCurrentMove() const;
+    const PositionState& getCurrentPositionState() const;
+    const PositionState& getRedoPositionState() const;
+
+    // Get move that led to current position (null move at the root)
+    ChessMove getCurrentMove() const;
 
     // For UCI support
-    void setStartingPosition(const std::string& fen);
+    bool setStartingPosition(const std::string& fen); // False (history unchanged) if the FEN does not fit a node
     void clearHistory();
-    const std::vector<std::string> getMoveHistory() const;
+    uint64_t getCurrentLineHash() const; // Identity of the current line (with getHistoryPath().size())
+    uint64_t getChildLineHash(const ChessMove& move) const; // Line hash after playing a move
+    uint64_t getCurrentZobristKey() const; // Position::getKey() of the current position (game database lookups); 0 if it has no legal setup
+    size_t getIrreversibleDepth() const; // History path index of the last capture/pawn move position
+    std::string getPositionAt(const size_t depth) const;
+    std::vector<std::string> getMovesSince(const size_t depth) const; // UCI notation
 
     // Game state accessors
     bool isThreefoldRepetition() const;
 
+    // Write the whole tree as PGN (main line plus every variation)
+    void writePGN(std::ostream& out, const std::string& eventName) const;
+
+    // Incremented on every history or redo change (for display caches)
+    uint64_t getVersion() const { return version; }
+
 private:
-    std::vector<PositionState> positionHistory;
-    std::vector<PositionState> positionRedo;
+    std::vector<PositionNode> nodes;                        // Node arena (index 0 is the root)
+    std::vector<int32_t> historyPath;                       // Root to current node (redo follows lastVisitedChild)
+    std::vector<int32_t> transpositionHeads;                // Latest node per key bucket
+    uint64_t version = 0;
+
+    // Tree helpers
+    int32_t addNode(const PositionState& state, const int32_t parent);
+    int32_t findChild(const int32_t parent, const FenString& fenString) const;
+    bool isOnHistoryPath(const int32_t index) const;
+    int32_t getRedoNode() const; // Current node's last visited continuation
 
-    // Position tracking helpers
-    std::string getBoardState(const ChessBoard& board) const;
-    std::string getCastlingRights(const ChessGameState& gameState) const;
-    std::string getEnPassantTarget(const ChessGameState& gameState) const;
+    // PGN helpers
+    void writePGNMove(std::ostream& out, const int32_t index, const bool forceMoveNumber) const;
+    void writePGNLine(std::ostream& out, int32_t parent) const;
 
     // FEN string data extraction
-    std::string extractPositionKey(const std::string& fenString) const;
-};
\ No newline at end of file
+    static std::string_view getPositionKey(const FenString& fenString); // Board, side, castling, en passant
+    uint64_t hashPositionKey(const FenString& fenString) const;
+    static constexpr uint64_t FNV_OFFSET_BASIS = 14695981039346656037ULL;
+    static uint64_t hashText(uint64_t hash, std::string_view text);
+    static uint64_t hashMove(uint64_t hash, const ChessMove& move); // Chains a move's key onto a line hash
+};
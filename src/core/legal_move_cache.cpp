@@ -0,0 +1,55 @@
+#include "legal_move_cache.h"
+#include <algorithm>
+
+using namespace Bitboards;
+
+void LegalMoveCache::update(const Position& position) {
+    if (hasPosition && position.getKey() == key)
+        return;
+
+    MoveList generated;
+    position.generateLegalMoves(generated);
+
+    // Counting sort by origin square, so each square's moves are contiguous
+    firstMove.fill(0);
+    destinations.fill(EMPTY);
+    for (const ChessMove& move : generated) {
+        firstMove[indexOf(move.getFrom()) + 1]++;
+        destinations[indexOf(move.getFrom())] |= squareBit(move.getTo());
+    }
+    for (int index = 0; index < SQUARE_COUNT; index++)
+        firstMove[index + 1] += firstMove[index];
+
+    std::array<uint16_t, SQUARE_COUNT> next;
+    std::copy(firstMove.begin(), firstMove.end() - 1, next.begin());
+    for (const ChessMove& move : generated)
+        moves[next[indexOf(move.getFrom())]++] = move;
+
+    key = position.getKey();
+    hasPosition = true;
+}
+
+void LegalMoveCache::clear() {
+    firstMove.fill(0);
+    destinations.fill(EMPTY);
+    key = 0;
+    hasPosition = false;
+}
+
+ChessMove LegalMoveCache::findMove(const ChessMove& move) const {
+    const int from = indexOf(move.getFrom());
+    if (!(destinations[from] & squareBit(move.getTo())))
+        return ChessMove{};
+
+    const PieceType promotion =
+        (move.getFlag() == MoveFlag::Promotion) ?
+        move.getPromotion() :
+        PieceType::Queen;
+    for (int index = firstMove[from]; index < firstMove[from + 1]; index++) {
+        const ChessMove& candidate = moves[index];
+        if (candidate.getTo() == move.getTo() &&
+                (candidate.getFlag() != MoveFlag::Promotion || candidate.getPromotion() == promotion))
+            return candidate;
+    }
+    return ChessMove{};
+}
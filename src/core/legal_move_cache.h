@@ -0,0 +1,37 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include "bitboard.h"
+#include "chess_move.h"
+#include "position.h"
+
+/**
+ * Legal moves of one position, grouped by origin square
+ *
+ * Key features:
+ * - Generated once per position (keyed by its Zobrist hash); update() with an
+ *   unchanged position is a key comparison
+ * - Legal destinations of a square in O(1) as a bitboard (drag highlighting)
+ * - findMove() returns the generated move with its special move flag set, so a
+ *   GUI move found here needs no further validation
+ */
+class LegalMoveCache {
+public:
+    void update(const Position& position);
+    void clear();
+    bool isValid() const { return hasPosition; }
+    uint64_t getKey() const { return key; }
+
+    Bitboard getDestinations(const Square from) const { return destinations[indexOf(from)]; }
+
+    // The legal move with the same squares (promotions without a piece become queens), or the null move
+    ChessMove findMove(const ChessMove& move) const;
+
+private:
+    std::array<ChessMove, MAX_MOVES> moves;             // Grouped by origin square
+    std::array<uint16_t, SQUARE_COUNT + 1> firstMove{}; // Moves of square s: [firstMove[s], firstMove[s + 1])
+    std::array<Bitboard, SQUARE_COUNT> destinations{};
+    uint64_t key = 0;
+    bool hasPosition = false;
+};
@@ -0,0 +1,54 @@
+#include "memory_mapped_file.h"
+#include <windows.h>
+
+MemoryMappedFile::~MemoryMappedFile() {
+    close();
+}
+
+bool MemoryMappedFile::open(const std::string& path) {
+    close();
+
+    // Convert path to wide string for Windows API
+    std::wstring widePath(path.begin(), path.end());
+    HANDLE file = CreateFileW(widePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+        OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_RANDOM_ACCESS, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        return false;
+    fileHandle = file;
+
+    // Zero-length files cannot be mapped
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart <= 0) {
+        close();
+        return false;
+    }
+
+    HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping) {
+        close();
+        return false;
+    }
+    mappingHandle = mapping;
+
+    const void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!view) {
+        close();
+        return false;
+    }
+    data = static_cast<const uint8_t*>(view);
+    size = static_cast<uint64_t>(fileSize.QuadPart);
+    return true;
+}
+
+void MemoryMappedFile::close() {
+    if (data)
+        UnmapViewOfFile(data);
+    if (mappingHandle)
+        CloseHandle(static_cast<HANDLE>(mappingHandle));
+    if (fileHandle)
+        CloseHandle(static_cast<HANDLE>(fileHandle));
+    data = nullptr;
+    mappingHandle = nullptr;
+    fileHandle = nullptr;
+    size = 0;
+}
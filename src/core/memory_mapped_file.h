@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+/**
+ * Read-only memory mapping of a whole file
+ *
+ * Key features:
+ * - Pages are loaded by the OS on first touch, so opening a multi-gigabyte
+ *   index is instant and a lookup only reads the pages it visits
+ * - Several processes (or program instances) share the same physical pages
+ * - Empty or missing files fail to open
+ */
+class MemoryMappedFile {
+public:
+    MemoryMappedFile() = default;
+    ~MemoryMappedFile();
+
+    // Non-copyable (owns OS handles)
+    MemoryMappedFile(const MemoryMappedFile&) = delete;
+    MemoryMappedFile& operator=(const MemoryMappedFile&) = delete;
+
+    bool open(const std::string& path);
+    void close();
+
+    bool isOpen() const { return data != nullptr; }
+    const uint8_t* getData() const { return data; }
+    uint64_t getSize() const { return size; }
+
+private:
+    void* fileHandle = nullptr;
+    void* mappingHandle = nullptr;
+    const uint8_t* data = nullptr;
+    uint64_t size = 0;
+};
@@ -0,0 +1,181 @@
+#include "pgn_reader.h"
+#include <cctype>
+#include <cstring>
+
+std::string_view PGNGame::getTag(std::string_view name) const {
+    for (const PGNTag& tag : tags) {
+        if (tag.name == name)
+            return tag.value;
+    }
+    return {};
+}
+
+PGNReader::PGNReader(const std::string& path) :
+    buffer(READ_BUFFER_SIZE) {
+
+    // The buffer must be installed before the file is opened
+    file.rdbuf()->pubsetbuf(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    file.open(path, std::ios::binary);
+}
+
+bool PGNReader::next(PGNGame& game) {
+    game.tags.clear();
+    game.moves.clear();
+    game.result.clear();
+    isInComment = false;
+    variationDepth = 0;
+    bool hasContent = false;
+    bool hasMovetext = false;
+
+    while (hasPendingLine || readLine()) {
+        hasPendingLine = false;
+
+        // Blank lines and "%" escape lines
+        const size_t first = line.find_first_not_of(" \t");
+        if (first == std::string::npos || line[0] == '%')
+            continue;
+
+        // A tag section after movetext starts the next game (this one had no result)
+        const bool isTagLine = !isInComment && line[first] == '[';
+        if (isTagLine && hasMovetext) {
+            hasPendingLine = true;
+            break;
+        }
+
+        if (!hasContent) {
+            game.index = gameIndex++;
+            game.offset = lineOffset;
+            game.lineNumber = lineNumber;
+            hasContent = true;
+        }
+
+        if (isTagLine) {
+            PGNTag tag;
+            if (parseTag(line, tag))
+                game.tags.push_back(std::move(tag));
+            continue;
+        }
+
+        hasMovetext = true;
+        if (parseMovetext(line, game))
+            return true;
+    }
+    return hasContent;
+}
+
+bool PGNReader::readLine() {
+    if (!std::getline(file, line))
+        return false;
+    lineNumber++;
+    lineOffset = nextOffset;
+    nextOffset += line.size() + 1;
+
+    // Windows line endings
+    if (!line.empty() && line.back() == '\r')
+        line.pop_back();
+
+    // UTF-8 byte order mark
+    if (lineNumber == 1 && line.compare(0, 3, "\xEF\xBB\xBF") == 0)
+        line.erase(0, 3);
+    return true;
+}
+
+bool PGNReader::parseTag(const std::string& line, PGNTag& tag) {
+    // [Name "Value"] with \" and \\ escapes in the value
+    const size_t nameStart = line.find('[') + 1;
+    const size_t nameEnd = line.find_first_of(" \t\"]", nameStart);
+    const size_t quote =
+        (nameEnd == std::string::npos) ?
+        std::string::npos :
+        line.find('"', nameEnd);
+    if (quote == std::string::npos || nameEnd == nameStart)
+        return false;
+
+    tag.name.assign(line, nameStart, nameEnd - nameStart);
+    tag.value.clear();
+    for (size_t i = quote + 1; i < line.size(); i++) {
+        if (line[i] == '"')
+            return true;
+        if (line[i] == '\\' && i + 1 < line.size())
+            i++;
+        tag.value += line[i];
+    }
+    return false; // Unterminated value
+}
+
+bool PGNReader::parseMovetext(const std::string& line, PGNGame& game) {
+    size_t i = 0;
+    while (i < line.size()) {
+        const char c = line[i];
+
+        // Brace comments may span lines
+        if (isInComment) {
+            const size_t close = line.find('}', i);
+            if (close == std::string::npos)
+                return false;
+            isInComment = false;
+            i = close + 1;
+            continue;
+        }
+        if (c == '{') {
+            isInComment = true;
+            i++;
+            continue;
+        }
+        if (c == ';')
+            return false; // Comment to the end of the line
+        if (c == '(' || c == ')') {
+            if (c == '(')
+                variationDepth++;
+            else if (variationDepth > 0)
+                variationDepth--;
+            i++;
+            continue;
+        }
+        if (std::isspace(static_cast<unsigned char>(c))) {
+            i++;
+            continue;
+        }
+
+        size_t end = i;
+        while (end < line.size() && !std::isspace(static_cast<unsigned char>(line[end])) && !std::strchr("{}();", line[end]))
+            end++;
+        std::string_view token(line.data() + i, end - i);
+        i = end;
+
+        // Variations and NAGs are not part of the main line
+        if (variationDepth > 0 || token[0] == '$')
+            continue;
+        if (isResultToken(token)) {
+            game.result = token;
+            return true;
+        }
+
+        // Move numbers: "12.", "12..." or glued to the move ("12.e4")
+        size_t digits = 0;
+        while (digits < token.size() && std::isdigit(static_cast<unsigned char>(token[digits])))
+            digits++;
+        if (digits == token.size())
+            continue;
+        if (digits > 0 && token[digits] == '.') {
+            const size_t moveStart = token.find_first_not_of('.', digits);
+            if (moveStart == std::string_view::npos)
+                continue;
+            token.remove_prefix(moveStart);
+        }
+
+        std::string move(token);
+        if (move.compare(0, 3, "0-0") == 0) {
+            for (char& square : move) {
+                if (square == '0')
+                    square = 'O';
+            }
+        }
+        game.moves.push_back(std::move(move));
+    }
+    return false;
+}
+
+bool PGNReader::isResultToken(std::string_view token) {
+    return token == "1-0" || token == "0-1" || token == "1/2-1/2" || token == "*";
+}
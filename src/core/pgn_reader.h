@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+struct PGNTag {
+    std::string name;
+    std::string value;
+};
+
+// One game of a PGN file (main line only)
+struct PGNGame {
+    uint64_t index = 0;                     // Game number in the file (0-based)
+    uint64_t offset = 0;                    // Byte offset of the game's first line (reload it from the file)
+    uint64_t lineNumber = 0;                // 1-based first line (for error messages)
+    std::vector<PGNTag> tags;               // In file order
+    std::vector<std::string> moves;         // Main line SAN; comments, NAGs, move numbers and variations removed
+    std::string result;                     // "1-0", "0-1", "1/2-1/2", "*" or empty if the movetext has none
+
+    // Value of a tag, or empty if the game does not have it
+    std::string_view getTag(std::string_view name) const;
+};
+
+/**
+ * Streaming reader for PGN game files
+ *
+ * Key features:
+ * - One line in memory at a time (large read buffer), so databases with
+ *   millions of games are read at disk speed
+ * - Brace and semicolon comments (including multi-line ones), NAGs, move
+ *   numbers and nested variations are skipped; only the main line is kept
+ * - A game ends at its result token, or at the next tag section when the
+ *   result is missing
+ * - "0-0" castling (zeros) is normalized to "O-O"
+ */
+class PGNReader {
+public:
+    explicit PGNReader(const std::string& path);
+
+    bool isOpen() const { return file.is_open(); }
+
+    // Read the next game; false at end of file
+    bool next(PGNGame& game);
+
+private:
+    static constexpr size_t READ_BUFFER_SIZE = 1 << 20;
+
+    std::vector<char> buffer;               // Must outlive the stream using it
+    std::ifstream file;
+    std::string line;                       // Reused between reads
+    bool hasPendingLine = false;            // `line` starts the next game (read ahead)
+    uint64_t lineNumber = 0;
+    uint64_t lineOffset = 0;                // Byte offset of `line`
+    uint64_t nextOffset = 0;                // Byte offset of the line after it
+    uint64_t gameIndex = 0;
+
+    // Parser state of the game being read
+    bool isInComment = false;               // Inside a { } comment
+    int variationDepth = 0;
+
+    bool readLine();
+    static bool parseTag(const std::string& line, PGNTag& tag);
+    bool parseMovetext(const std::string& line, PGNGame& game); // True once the result token is read
+    static bool isResultToken(std::string_view token);
+};
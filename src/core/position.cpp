@@ -0,0 +1,631 @@
+#include "position.h"
+#include <cstdlib>
+
+using namespace Bitboards;
+
+namespace {
+    constexpr std::string_view STARTING_FEN = "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";
+
+    // Zobrist keys from a fixed seed (splitmix64), so keys are stable across runs
+    struct ZobristKeys {
+        uint64_t pieceSquare[16][SQUARE_COUNT] = {};
+        uint64_t castling[16] = {};
+        uint64_t enPassantFile[8] = {};
+        uint64_t blackToMove = 0;
+    };
+
+    constexpr uint64_t nextRandom(uint64_t& state) {
+        uint64_t value = (state += 0x9E3779B97F4A7C15ULL);
+        value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+        return value ^ (value >> 31);
+    }
+
+    constexpr ZobristKeys buildZobristKeys() {
+        ZobristKeys keys;
+        uint64_t state = 0x5EED;
+        for (int piece = 0; piece < 16; piece++) {
+            for (int square = 0; square < SQUARE_COUNT; square++)
+                keys.pieceSquare[piece][square] = nextRandom(state);
+        }
+        // Castling keys combine per-right keys so a rights change is one XOR
+        uint64_t rightKeys[4] = { nextRandom(state), nextRandom(state), nextRandom(state), nextRandom(state) };
+        for (int rights = 0; rights < 16; rights++) {
+            for (int bit = 0; bit < 4; bit++) {
+                if (rights & (1 << bit))
+                    keys.castling[rights] ^= rightKeys[bit];
+            }
+        }
+        for (int file = 0; file < 8; file++)
+            keys.enPassantFile[file] = nextRandom(state);
+        keys.blackToMove = nextRandom(state);
+        return keys;
+    }
+
+    constexpr ZobristKeys ZOBRIST = buildZobristKeys();
+
+    // Rights kept when a piece leaves or lands on a square (king and rook home squares clear them)
+    constexpr std::array<uint8_t, SQUARE_COUNT> buildCastlingMasks() {
+        std::array<uint8_t, SQUARE_COUNT> masks = {};
+        for (int square = 0; square < SQUARE_COUNT; square++)
+            masks[square] = CastlingRights::ALL;
+        masks[indexOf(Square::A1)] &= ~CastlingRights::WHITE_QUEENSIDE;
+        masks[indexOf(Square::H1)] &= ~CastlingRights::WHITE_KINGSIDE;
+        masks[indexOf(Square::E1)] &= ~(CastlingRights::WHITE_KINGSIDE | CastlingRights::WHITE_QUEENSIDE);
+        masks[indexOf(Square::A8)] &= ~CastlingRights::BLACK_QUEENSIDE;
+        masks[indexOf(Square::H8)] &= ~CastlingRights::BLACK_KINGSIDE;
+        masks[indexOf(Square::E8)] &= ~(CastlingRights::BLACK_KINGSIDE | CastlingRights::BLACK_QUEENSIDE);
+        return masks;
+    }
+
+    constexpr std::array<uint8_t, SQUARE_COUNT> CASTLING_MASKS = buildCastlingMasks();
+
+    constexpr PieceType PROMOTION_TYPES[] = { PieceType::Queen, PieceType::Knight, PieceType::Rook, PieceType::Bishop };
+
+    void addPromotions(MoveList& moves, const Square from, const Square to, const bool queenOnly) {
+        for (const PieceType type : PROMOTION_TYPES) {
+            moves.add(ChessMove{from, to, MoveFlag::Promotion, type});
+            if (queenOnly)
+                break;
+        }
+    }
+}
+
+Position::Position() {
+    setStartingPosition();
+}
+
+void Position::setStartingPosition() {
+    setFromFEN(STARTING_FEN);
+}
+
+bool Position::setFromFEN(std::string_view fen) {
+    FENPosition parsed;
+    return FENCodec::parse(fen, parsed) && set(parsed);
+}
+
+bool Position::set(const FENPosition& fen) {
+    if (!fen.hasFields(FENFields::BOARD) ||
+            fen.countPieces(Piece::WhiteKing) != 1 || fen.countPieces(Piece::BlackKing) != 1)
+        return false;
+
+    clear();
+    for (int index = 0; index < SQUARE_COUNT; index++) {
+        if (fen.squares[index] != Piece::None)
+            putPiece(static_cast<Square>(index), fen.squares[index]);
+    }
+    sideToMove = charToColor(fen.sideToMove);
+
+    // Rights whose king or rook has left its home square are dropped
+    if (fen.whiteKingside && board[indexOf(Square::E1)] == Piece::WhiteKing && board[indexOf(Square::H1)] == Piece::WhiteRook)
+        castlingRights |= CastlingRights::WHITE_KINGSIDE;
+    if (fen.whiteQueenside && board[indexOf(Square::E1)] == Piece::WhiteKing && board[indexOf(Square::A1)] == Piece::WhiteRook)
+        castlingRights |= CastlingRights::WHITE_QUEENSIDE;
+    if (fen.blackKingside && board[indexOf(Square::E8)] == Piece::BlackKing && board[indexOf(Square::H8)] == Piece::BlackRook)
+        castlingRights |= CastlingRights::BLACK_KINGSIDE;
+    if (fen.blackQueenside && board[indexOf(Square::E8)] == Piece::BlackKing && board[indexOf(Square::A8)] == Piece::BlackRook)
+        castlingRights |= CastlingRights::BLACK_QUEENSIDE;
+
+    if (fen.enPassantRank >= 0)
+        setEnPassantSquare(makeSquare(fen.enPassantRank, fen.enPassantFile));
+    halfmoveClock = fen.halfmoveClock;
+    fullmoveNumber = fen.fullmoveNumber;
+    key = computeKey();
+    updateKingSafety();
+    return true;
+}
+
+bool Position::set(const ChessBoard& board, const ChessGameState& gameState) {
+    FENPosition fen;
+    for (int index = 0; index < SQUARE_COUNT; index++)
+        fen.squares[index] = board.getPiece(static_cast<Square>(index));
+    fen.sideToMove = gameState.getCurrentPlayer();
+    fen.whiteKingside = gameState.canCastleKingside('w');
+    fen.whiteQueenside = gameState.canCastleQueenside('w');
+    fen.blackKingside = gameState.canCastleKingside('b');
+    fen.blackQueenside = gameState.canCastleQueenside('b');
+    if (gameState.isEnPassantAvailable())
+        std::tie(fen.enPassantRank, fen.enPassantFile) = gameState.getEnPassantTarget();
+    fen.halfmoveClock = gameState.getHalfmoveClock();
+    fen.fullmoveNumber = gameState.getFullmoveClock();
+    fen.validFields = FENFields::ALL;
+    return set(fen);
+}
+
+void Position::clear() {
+    board.fill(Piece::None);
+    pieces.fill(EMPTY);
+    colorPieces.fill(EMPTY);
+    occupied = EMPTY;
+    sideToMove = PieceColor::White;
+    castlingRights = CastlingRights::NONE;
+    enPassantSquare = Square::None;
+    halfmoveClock = 0;
+    fullmoveNumber = 1;
+    key = 0;
+    checkers = EMPTY;
+    pinned = EMPTY;
+    kingDanger = EMPTY;
+}
+
+void Position::putPiece(const Square square, const Piece piece) {
+    const Bitboard bit = squareBit(square);
+    board[indexOf(square)] = piece;
+    pieces[static_cast<uint8_t>(piece)] |= bit;
+    colorPieces[static_cast<uint8_t>(colorOf(piece))] |= bit;
+    occupied |= bit;
+    key ^= ZOBRIST.pieceSquare[static_cast<uint8_t>(piece)][indexOf(square)];
+}
+
+void Position::removePiece(const Square square) {
+    const Bitboard bit = squareBit(square);
+    const Piece piece = board[indexOf(square)];
+    board[indexOf(square)] = Piece::None;
+    pieces[static_cast<uint8_t>(piece)] ^= bit;
+    colorPieces[static_cast<uint8_t>(colorOf(piece))] ^= bit;
+    occupied ^= bit;
+    key ^= ZOBRIST.pieceSquare[static_cast<uint8_t>(piece)][indexOf(square)];
+}
+
+void Position::movePiece(const Square from, const Square to) {
+    const Piece piece = board[indexOf(from)];
+    const Bitboard fromTo = squareBit(from) | squareBit(to);
+    board[indexOf(from)] = Piece::None;
+    board[indexOf(to)] = piece;
+    pieces[static_cast<uint8_t>(piece)] ^= fromTo;
+    colorPieces[static_cast<uint8_t>(colorOf(piece))] ^= fromTo;
+    occupied ^= fromTo;
+    key ^= ZOBRIST.pieceSquare[static_cast<uint8_t>(piece)][indexOf(from)] ^
+           ZOBRIST.pieceSquare[static_cast<uint8_t>(piece)][indexOf(to)];
+}
+
+void Position::setEnPassantSquare(const Square square) {
+    // The side to move captures; its pawns attack the square from where an enemy pawn would
+    const Bitboard capturers = pawnAttacks(opposite(sideToMove), square) & getPieces(sideToMove, PieceType::Pawn);
+    if (!capturers)
+        return;
+    enPassantSquare = square;
+    key ^= ZOBRIST.enPassantFile[fileOf(square)];
+}
+
+uint64_t Position::computeKey() const {
+    uint64_t fullKey = 0;
+    for (int index = 0; index < SQUARE_COUNT; index++) {
+        if (board[index] != Piece::None)
+            fullKey ^= ZOBRIST.pieceSquare[static_cast<uint8_t>(board[index])][index];
+    }
+    fullKey ^= ZOBRIST.castling[castlingRights];
+    if (enPassantSquare != Square::None)
+        fullKey ^= ZOBRIST.enPassantFile[fileOf(enPassantSquare)];
+    if (sideToMove == PieceColor::Black)
+        fullKey ^= ZOBRIST.blackToMove;
+    return fullKey;
+}
+
+void Position::updateKingSafety() {
+    const PieceColor us = sideToMove;
+    const PieceColor them = opposite(us);
+    const Square king = getKingSquare(us);
+    const Bitboard enemyDiagonal = getPieces(them, PieceType::Bishop) | getPieces(them, PieceType::Queen);
+    const Bitboard enemyStraight = getPieces(them, PieceType::Rook) | getPieces(them, PieceType::Queen);
+
+    checkers = getAttackersTo(king, occupied) & getPieces(them);
+
+    // A lone own piece between the king and an enemy slider on an open line is pinned
+    pinned = EMPTY;
+    Bitboard snipers = (bishopAttacks(king, EMPTY) & enemyDiagonal) | (rookAttacks(king, EMPTY) & enemyStraight);
+    while (snipers) {
+        const Bitboard blockers = between(king, popLsb(snipers)) & occupied;
+        if (blockers && !(blockers & (blockers - 1)))
+            pinned |= blockers & getPieces(us);
+    }
+
+    // Sliders see through the king, so it cannot retreat along a checking line
+    const Bitboard occupancy = occupied ^ squareBit(king);
+    Bitboard pawns = getPieces(them, PieceType::Pawn);
+    kingDanger =
+        (them == PieceColor::White) ?
+        ((pawns & ~FILE_A) << 7) | ((pawns & ~FILE_H) << 9) :
+        ((pawns & ~FILE_A) >> 9) | ((pawns & ~FILE_H) >> 7);
+    kingDanger |= kingAttacks(getKingSquare(them));
+    Bitboard knights = getPieces(them, PieceType::Knight);
+    while (knights)
+        kingDanger |= knightAttacks(popLsb(knights));
+    Bitboard diagonal = enemyDiagonal;
+    while (diagonal)
+        kingDanger |= bishopAttacks(popLsb(diagonal), occupancy);
+    Bitboard straight = enemyStraight;
+    while (straight)
+        kingDanger |= rookAttacks(popLsb(straight), occupancy);
+}
+
+Bitboard Position::getPinRay(const Square square) const {
+    return
+        (pinned & squareBit(square)) ?
+        line(getKingSquare(sideToMove), square) :
+        ~EMPTY;
+}
+
+Bitboard Position::getCheckBlockMask() const {
+    if (!checkers)
+        return ~EMPTY;
+    if (checkers & (checkers - 1))
+        return EMPTY; // Double check: only the king moves
+    const Square checker = lsb(checkers);
+    return between(getKingSquare(sideToMove), checker) | checkers;
+}
+
+Bitboard Position::getAttackersTo(const Square square, const Bitboard occupancy) const {
+    const Bitboard diagonal = getPieces(PieceType::Bishop) | getPieces(PieceType::Queen);
+    const Bitboard straight = getPieces(PieceType::Rook) | getPieces(PieceType::Queen);
+    return
+        (pawnAttacks(PieceColor::White, square) & getPieces(PieceColor::Black, PieceType::Pawn)) |
+        (pawnAttacks(PieceColor::Black, square) & getPieces(PieceColor::White, PieceType::Pawn)) |
+        (knightAttacks(square) & getPieces(PieceType::Knight)) |
+        (kingAttacks(square) & getPieces(PieceType::King)) |
+        (bishopAttacks(square, occupancy) & diagonal) |
+        (rookAttacks(square, occupancy) & straight);
+}
+
+bool Position::isAttacked(const Square square, const PieceColor by) const {
+    // Cheapest tests first
+    if (pawnAttacks(opposite(by), square) & getPieces(by, PieceType::Pawn))
+        return true;
+    if (knightAttacks(square) & getPieces(by, PieceType::Knight))
+        return true;
+    if (kingAttacks(square) & getPieces(by, PieceType::King))
+        return true;
+    const Bitboard queens = getPieces(by, PieceType::Queen);
+    if (bishopAttacks(square, occupied) & (getPieces(by, PieceType::Bishop) | queens))
+        return true;
+    return (rookAttacks(square, occupied) & (getPieces(by, PieceType::Rook) | queens)) != 0;
+}
+
+void Position::generateLegalMoves(MoveList& moves) const {
+    MoveList pseudoLegal;
+    generateMoves(pseudoLegal);
+    moves.clear();
+    for (const ChessMove& move : pseudoLegal) {
+        if (isLegal(move))
+            moves.add(move);
+    }
+}
+
+void Position::generateMoves(MoveList& moves) const {
+    moves.clear();
+    generatePawnMoves(moves, false);
+    generatePieceMoves(moves, ~getPieces(sideToMove));
+    generateCastling(moves);
+}
+
+void Position::generateCaptures(MoveList& moves) const {
+    moves.clear();
+    generatePawnMoves(moves, true);
+    generatePieceMoves(moves, getPieces(opposite(sideToMove)));
+}
+
+void Position::generatePawnMoves(MoveList& moves, const bool capturesOnly) const {
+    const PieceColor us = sideToMove;
+    const Bitboard enemies = getPieces(opposite(us));
+    const int forward =
+        (us == PieceColor::White) ?
+        8 :
+        -8;
+    const Bitboard startRank =
+        (us == PieceColor::White) ?
+        RANK_2 :
+        RANK_7;
+    const Bitboard lastRank =
+        (us == PieceColor::White) ?
+        RANK_8 :
+        RANK_1;
+
+    Bitboard pawns = getPieces(us, PieceType::Pawn);
+    while (pawns) {
+        const Square from = popLsb(pawns);
+
+        // Pushes (quiet, except promotions, which quiescence treats as captures)
+        const Square oneStep = static_cast<Square>(indexOf(from) + forward);
+        if (!(occupied & squareBit(oneStep))) {
+            if (squareBit(oneStep) & lastRank)
+                addPromotions(moves, from, oneStep, capturesOnly);
+            else if (!capturesOnly) {
+                moves.add(ChessMove{from, oneStep});
+                const Square twoSteps = static_cast<Square>(indexOf(oneStep) + forward);
+                if ((squareBit(from) & startRank) && !(occupied & squareBit(twoSteps)))
+                    moves.add(ChessMove{from, twoSteps});
+            }
+        }
+
+        // Captures
+        Bitboard targets = pawnAttacks(us, from) & enemies;
+        while (targets) {
+            const Square to = popLsb(targets);
+            if (squareBit(to) & lastRank)
+                addPromotions(moves, from, to, capturesOnly);
+            else
+                moves.add(ChessMove{from, to});
+        }
+        if (enPassantSquare != Square::None && (pawnAttacks(us, from) & squareBit(enPassantSquare)))
+            moves.add(ChessMove{from, enPassantSquare, MoveFlag::EnPassant});
+    }
+}
+
+void Position::generatePieceMoves(MoveList& moves, const Bitboard targets) const {
+    const PieceColor us = sideToMove;
+    for (PieceType type = PieceType::Knight; type <= PieceType::King; type = static_cast<PieceType>(static_cast<uint8_t>(type) + 1)) {
+        Bitboard fromSquares = getPieces(us, type);
+        while (fromSquares) {
+            const Square from = popLsb(fromSquares);
+            Bitboard attacks = EMPTY;
+            switch (type) {
+                case PieceType::Knight: attacks = knightAttacks(from); break;
+                case PieceType::Bishop: attacks = bishopAttacks(from, occupied); break;
+                case PieceType::Rook: attacks = rookAttacks(from, occupied); break;
+                case PieceType::Queen: attacks = queenAttacks(from, occupied); break;
+                default: attacks = kingAttacks(from); break;
+            }
+            attacks &= targets;
+            while (attacks)
+                moves.add(ChessMove{from, popLsb(attacks)});
+        }
+    }
+}
+
+void Position::generateCastling(MoveList& moves) const {
+    const PieceColor us = sideToMove;
+    const bool isWhite = (us == PieceColor::White);
+    const uint8_t kingside =
+        isWhite ?
+        CastlingRights::WHITE_KINGSIDE :
+        CastlingRights::BLACK_KINGSIDE;
+    const uint8_t queenside =
+        isWhite ?
+        CastlingRights::WHITE_QUEENSIDE :
+        CastlingRights::BLACK_QUEENSIDE;
+    if (!(castlingRights & (kingside | queenside)))
+        return;
+
+    // Rights imply king and rook are home (set() and makeMove keep them consistent)
+    const int rank =
+        isWhite ?
+        0 :
+        7;
+    const Square king = makeSquare(rank, 4);
+    if (checkers)
+        return;
+
+    // The king may not pass or land on a danger square
+    if ((castlingRights & kingside) &&
+            !(occupied & between(king, makeSquare(rank, 7))) &&
+            !(kingDanger & (squareBit(makeSquare(rank, 5)) | squareBit(makeSquare(rank, 6)))))
+        moves.add(ChessMove{king, makeSquare(rank, 6), MoveFlag::Castling});
+    if ((castlingRights & queenside) &&
+            !(occupied & between(king, makeSquare(rank, 0))) &&
+            !(kingDanger & (squareBit(makeSquare(rank, 3)) | squareBit(makeSquare(rank, 2)))))
+        moves.add(ChessMove{king, makeSquare(rank, 2), MoveFlag::Castling});
+}
+
+bool Position::isLegal(const ChessMove& move) const {
+    if (move.getFlag() == MoveFlag::Castling)
+        return isCastlingLegal(move);
+
+    const Square from = move.getFrom();
+    const Square to = move.getTo();
+    const Bitboard target = squareBit(to);
+
+    // The king may not step onto a danger square (sliders already see through it)
+    if (typeOf(board[indexOf(from)]) == PieceType::King)
+        return !(kingDanger & target);
+
+    // En passant removes two pieces from a line: look at the board after the move
+    if (move.getFlag() == MoveFlag::EnPassant) {
+        const Bitboard captured = squareBit(makeSquare(rankOf(from), fileOf(to)));
+        const Bitboard occupancy = (occupied ^ squareBit(from) ^ captured) | target;
+        return !(getAttackersTo(getKingSquare(sideToMove), occupancy) & getPieces(opposite(sideToMove)) & ~captured);
+    }
+
+    // Others must capture or block a single checker, and stay on their pin line
+    return (target & getCheckBlockMask()) && (target & getPinRay(from));
+}
+
+bool Position::isCastlingLegal(const ChessMove& move) const {
+    const PieceColor us = sideToMove;
+    const bool isWhite = (us == PieceColor::White);
+    const int rank =
+        isWhite ?
+        0 :
+        7;
+    const Square king = makeSquare(rank, 4);
+    if (move.getFrom() != king || rankOf(move.getTo()) != rank || checkers)
+        return false;
+
+    const bool isKingside = (fileOf(move.getTo()) == 6);
+    if (!isKingside && fileOf(move.getTo()) != 2)
+        return false;
+    const uint8_t right =
+        isWhite ?
+        (isKingside ? CastlingRights::WHITE_KINGSIDE : CastlingRights::WHITE_QUEENSIDE) :
+        (isKingside ? CastlingRights::BLACK_KINGSIDE : CastlingRights::BLACK_QUEENSIDE);
+    const Square rook = makeSquare(rank, isKingside ? 7 : 0);
+    return (castlingRights & right) && !(occupied & between(king, rook)) &&
+        !(kingDanger & (between(king, move.getTo()) | squareBit(move.getTo())));
+}
+
+bool Position::isCapture(const ChessMove& move) const {
+    return board[indexOf(move.getTo())] != Piece::None || move.getFlag() == MoveFlag::EnPassant;
+}
+
+ChessMove Position::toFlaggedMove(const ChessMove& move) const {
+    const Square from = move.getFrom();
+    const Square to = move.getTo();
+    const PieceType type = typeOf(board[indexOf(from)]);
+
+    if (type == PieceType::King && rankOf(from) == rankOf(to) && std::abs(fileOf(to) - fileOf(from)) == 2)
+        return ChessMove{from, to, MoveFlag::Castling};
+    if (type == PieceType::Pawn) {
+        if (to == enPassantSquare && fileOf(from) != fileOf(to))
+            return ChessMove{from, to, MoveFlag::EnPassant};
+        if (rankOf(to) == 0 || rankOf(to) == 7) {
+            const PieceType promotion =
+                (move.getFlag() == MoveFlag::Promotion) ?
+                move.getPromotion() :
+                PieceType::Queen;
+            return ChessMove{from, to, MoveFlag::Promotion, promotion};
+        }
+    }
+    return ChessMove{from, to};
+}
+
+ChessMove Position::findLegalMove(const ChessMove& move) const {
+    MoveList moves;
+    generateLegalMoves(moves);
+    for (const ChessMove& legalMove : moves) {
+        if (legalMove.getKey() == move.getKey())
+            return legalMove;
+    }
+    return ChessMove{};
+}
+
+void Position::makeMove(const ChessMove& move, PositionUndo& undo) {
+    const PieceColor us = sideToMove;
+    const Square from = move.getFrom();
+    const Square to = move.getTo();
+    const Piece piece = board[indexOf(from)];
+
+    undo.captured = Piece::None;
+    undo.castlingRights = castlingRights;
+    undo.enPassantSquare = enPassantSquare;
+    undo.halfmoveClock = halfmoveClock;
+    undo.key = key;
+    undo.checkers = checkers;
+    undo.pinned = pinned;
+    undo.kingDanger = kingDanger;
+
+    if (enPassantSquare != Square::None) {
+        key ^= ZOBRIST.enPassantFile[fileOf(enPassantSquare)];
+        enPassantSquare = Square::None;
+    }
+    halfmoveClock++;
+
+    if (move.getFlag() == MoveFlag::Castling) {
+        // The rook jumps to the square the king crossed
+        const int rank = rankOf(from);
+        const bool isKingside = fileOf(to) == 6;
+        movePiece(from, to);
+        movePiece(
+            makeSquare(rank, isKingside ? 7 : 0),
+            makeSquare(rank, isKingside ? 5 : 3));
+    } else {
+        const Square captureSquare =
+            (move.getFlag() == MoveFlag::EnPassant) ?
+            makeSquare(rankOf(from), fileOf(to)) :
+            to;
+        undo.captured = board[indexOf(captureSquare)];
+        if (undo.captured != Piece::None) {
+            removePiece(captureSquare);
+            halfmoveClock = 0;
+        }
+        movePiece(from, to);
+
+        if (typeOf(piece) == PieceType::Pawn) {
+            halfmoveClock = 0;
+            if (move.getFlag() == MoveFlag::Promotion) {
+                removePiece(to);
+                putPiece(to, makePiece(us, move.getPromotion()));
+            }
+        }
+    }
+
+    key ^= ZOBRIST.castling[castlingRights];
+    castlingRights &= CASTLING_MASKS[indexOf(from)] & CASTLING_MASKS[indexOf(to)];
+    key ^= ZOBRIST.castling[castlingRights];
+
+    if (us == PieceColor::Black)
+        fullmoveNumber++;
+    sideToMove = opposite(us);
+    key ^= ZOBRIST.blackToMove;
+
+    // Double pawn push (checked after the side switch: the opponent captures)
+    if (typeOf(piece) == PieceType::Pawn && (indexOf(to) ^ indexOf(from)) == 16)
+        setEnPassantSquare(static_cast<Square>((indexOf(from) + indexOf(to)) / 2));
+    updateKingSafety();
+}
+
+void Position::undoMove(const ChessMove& move, const PositionUndo& undo) {
+    sideToMove = opposite(sideToMove);
+    const PieceColor us = sideToMove;
+    const Square from = move.getFrom();
+    const Square to = move.getTo();
+
+    if (us == PieceColor::Black)
+        fullmoveNumber--;
+
+    if (move.getFlag() == MoveFlag::Castling) {
+        const int rank = rankOf(from);
+        const bool isKingside = fileOf(to) == 6;
+        movePiece(to, from);
+        movePiece(
+            makeSquare(rank, isKingside ? 5 : 3),
+            makeSquare(rank, isKingside ? 7 : 0));
+    } else {
+        if (move.getFlag() == MoveFlag::Promotion) {
+            removePiece(to);
+            putPiece(to, makePiece(us, PieceType::Pawn));
+        }
+        movePiece(to, from);
+        if (undo.captured != Piece::None) {
+            const Square captureSquare =
+                (move.getFlag() == MoveFlag::EnPassant) ?
+                makeSquare(rankOf(from), fileOf(to)) :
+                to;
+            putPiece(captureSquare, undo.captured);
+        }
+    }
+
+    castlingRights = undo.castlingRights;
+    enPassantSquare = undo.enPassantSquare;
+    halfmoveClock = undo.halfmoveClock;
+    key = undo.key;
+    checkers = undo.checkers;
+    pinned = undo.pinned;
+    kingDanger = undo.kingDanger;
+}
+
+void Position::makeNullMove(PositionUndo& undo) {
+    undo.captured = Piece::None;
+    undo.castlingRights = castlingRights;
+    undo.enPassantSquare = enPassantSquare;
+    undo.halfmoveClock = halfmoveClock;
+    undo.key = key;
+    undo.checkers = checkers;
+    undo.pinned = pinned;
+    undo.kingDanger = kingDanger;
+
+    if (enPassantSquare != Square::None) {
+        key ^= ZOBRIST.enPassantFile[fileOf(enPassantSquare)];
+        enPassantSquare = Square::None;
+    }
+    halfmoveClock++;
+    sideToMove = opposite(sideToMove);
+    key ^= ZOBRIST.blackToMove;
+    updateKingSafety();
+}
+
+void Position::undoNullMove(const PositionUndo& undo) {
+    sideToMove = opposite(sideToMove);
+    enPassantSquare = undo.enPassantSquare;
+    halfmoveClock = undo.halfmoveClock;
+    key = undo.key;
+    checkers = undo.checkers;
+    pinned = undo.pinned;
+    kingDanger = undo.kingDanger;
+}
+
+bool Position::hasInsufficientMaterial() const {
+    const Bitboard heavy = getPieces(PieceType::Pawn) | getPieces(PieceType::Rook) | getPieces(PieceType::Queen);
+    if (heavy)
+        return false;
+    const Bitboard minors = getPieces(PieceType::Knight) | getPieces(PieceType::Bishop);
+    return popCount(minors) <= 1;
+}
@@ -0,0 +1,155 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string_view>
+#include "bitboard.h"
+#include "chess_move.h"
+#include "chess_types.h"
+#include "fen_codec.h"
+
+constexpr int MAX_MOVES = 256; // More than any legal position has
+
+// Bits of Position::getCastlingRights()
+namespace CastlingRights {
+    constexpr uint8_t NONE            = 0;
+    constexpr uint8_t WHITE_KINGSIDE  = 1u << 0;
+    constexpr uint8_t WHITE_QUEENSIDE = 1u << 1;
+    constexpr uint8_t BLACK_KINGSIDE  = 1u << 2;
+    constexpr uint8_t BLACK_QUEENSIDE = 1u << 3;
+    constexpr uint8_t ALL             = 15;
+}
+
+// Fixed-capacity move list (no allocation per node)
+class MoveList {
+public:
+    void add(const ChessMove& move) { moves[count++] = move; }
+    void clear() { count = 0; }
+    int size() const { return count; }
+    bool isEmpty() const { return count == 0; }
+    ChessMove& operator[](const int index) { return moves[index]; }
+    const ChessMove& operator[](const int index) const { return moves[index]; }
+    const ChessMove* begin() const { return moves.data(); }
+    const ChessMove* end() const { return moves.data() + count; }
+
+private:
+    std::array<ChessMove, MAX_MOVES> moves;
+    int count = 0;
+};
+
+// What Position::undoMove needs that the move itself does not carry
+struct PositionUndo {
+    Piece captured = Piece::None;
+    uint8_t castlingRights = CastlingRights::NONE;
+    Square enPassantSquare = Square::None;
+    int halfmoveClock = 0;
+    uint64_t key = 0;
+    Bitboard checkers = 0;
+    Bitboard pinned = 0;
+    Bitboard kingDanger = 0;
+};
+
+/**
+ * Bitboard position with make/undo, for searching and move generation
+ *
+ * Key features:
+ * - One bitboard per piece and per color next to a square array, so both
+ *   "what is on e4" and "where are the knights" are single lookups
+ * - Incremental Zobrist key (side, castling rights, en passant file)
+ * - Moves carry their MoveFlag; makeMove trusts it, so only moves produced by
+ *   the generator (or matched through findLegalMove) may be made
+ * - The en passant square is only kept when a capture on it is possible, so
+ *   keys of equal positions are equal
+ * - Checkers, pinned pieces and king danger squares are kept with the
+ *   position (restored on undo), so legality is a mask test, not a trial move
+ * - Copyable and allocation free: search threads take their own copy
+ */
+class Position {
+public:
+    Position(); // Standard starting position
+
+    // Setup; false (and the position unchanged) unless each side has one king
+    bool setFromFEN(std::string_view fen);
+    bool set(const FENPosition& fen);
+    bool set(const ChessBoard& board, const ChessGameState& gameState);
+    void setStartingPosition();
+
+    // Piece access
+    Piece getPiece(const Square square) const { return board[indexOf(square)]; }
+    Bitboard getPieces(const PieceColor color) const { return colorPieces[static_cast<uint8_t>(color)]; }
+    Bitboard getPieces(const PieceColor color, const PieceType type) const { return pieces[static_cast<uint8_t>(makePiece(color, type))]; }
+    Bitboard getPieces(const PieceType type) const { return getPieces(PieceColor::White, type) | getPieces(PieceColor::Black, type); }
+    Bitboard getOccupied() const { return occupied; }
+    Square getKingSquare(const PieceColor color) const { return Bitboards::lsb(getPieces(color, PieceType::King)); }
+
+    // State
+    PieceColor getSideToMove() const { return sideToMove; }
+    uint8_t getCastlingRights() const { return castlingRights; }
+    Square getEnPassantSquare() const { return enPassantSquare; } // Square::None unless capturable
+    int getHalfmoveClock() const { return halfmoveClock; }
+    int getFullmoveNumber() const { return fullmoveNumber; }
+    uint64_t getKey() const { return key; }
+
+    // Attacks
+    Bitboard getAttackersTo(const Square square, const Bitboard occupancy) const; // Both colors
+    bool isAttacked(const Square square, const PieceColor by) const;
+    bool isInCheck() const { return checkers != 0; }
+
+    // King safety of the side to move (computed once per position by set and makeMove)
+    Bitboard getCheckers() const { return checkers; }       // Enemy pieces giving check
+    Bitboard getPinned() const { return pinned; }           // Own pieces pinned to the king
+    Bitboard getKingDanger() const { return kingDanger; }   // Squares attacked with the king off the board
+    Bitboard getPinRay(const Square square) const;          // Where a piece may go without exposing the king
+    Bitboard getCheckBlockMask() const;                     // Targets that resolve a single check (all if none)
+
+    // Move generation
+    void generateLegalMoves(MoveList& moves) const;
+    void generateMoves(MoveList& moves) const;       // Pseudo-legal (may leave the king attacked)
+    void generateCaptures(MoveList& moves) const;    // Pseudo-legal captures and queen promotions
+    bool isLegal(const ChessMove& move) const;       // For a pseudo-legal move (O(1) but for en passant)
+    bool isCapture(const ChessMove& move) const;
+
+    // Same squares with the flag the position implies (UI and UCI moves carry none);
+    // a pawn reaching the last rank keeps its promotion piece, or becomes a queen
+    ChessMove toFlaggedMove(const ChessMove& move) const;
+
+    // Legal move with the same squares and promotion (UCI strings carry no flag); null if none
+    ChessMove findLegalMove(const ChessMove& move) const;
+
+    // Make/undo
+    void makeMove(const ChessMove& move, PositionUndo& undo);
+    void undoMove(const ChessMove& move, const PositionUndo& undo);
+    void makeNullMove(PositionUndo& undo);
+    void undoNullMove(const PositionUndo& undo);
+
+    // Neither side can mate (bare kings, or a single minor piece)
+    bool hasInsufficientMaterial() const;
+
+private:
+    std::array<Piece, SQUARE_COUNT> board;
+    std::array<Bitboard, 16> pieces;        // Indexed by Piece
+    std::array<Bitboard, 2> colorPieces;    // Indexed by PieceColor
+    Bitboard occupied;
+    PieceColor sideToMove;
+    uint8_t castlingRights;
+    Square enPassantSquare;
+    int halfmoveClock;
+    int fullmoveNumber;
+    uint64_t key;
+    Bitboard checkers;
+    Bitboard pinned;
+    Bitboard kingDanger;
+
+    void clear();
+    void putPiece(const Square square, const Piece piece);
+    void removePiece(const Square square);
+    void movePiece(const Square from, const Square to);
+    void setEnPassantSquare(const Square square);   // Keeps it only if a pawn can capture on it
+    uint64_t computeKey() const;
+    void updateKingSafety();                        // checkers, pinned and kingDanger for sideToMove
+    bool isCastlingLegal(const ChessMove& move) const;
+
+    void generatePawnMoves(MoveList& moves, const bool capturesOnly) const;
+    void generatePieceMoves(MoveList& moves, const Bitboard targets) const;
+    void generateCastling(MoveList& moves) const;
+};
@@ -0,0 +1,101 @@
+#include "san_formatter.h"
+
+namespace BoardCfg = Config::Board;
+using MoveResult = ChessMoveValidator::MoveResult;
+
+std::string SANFormatter::formatMove(
+    const ChessBoard& board, 
+    const ChessGameState& gameState, 
+    const ChessMoveValidator& validator,
+    const ChessMove& move, 
+    const MoveResult result) {
+
+    if (result == MoveResult::VALID_CASTLE_KINGSIDE)
+        return "O-O";
+    if (result == MoveResult::VALID_CASTLE_QUEENSIDE)
+        return "O-O-O";
+
+    const Piece piece = board.getPiece(move.getFrom());
+    const bool isCapture = 
+        result == MoveResult::VALID_EN_PASSANT ||
+        board.getPiece(move.getTo()) != Piece::None;
+
+    std::string san = "";
+    if (board.isPawn(piece)) {
+        // Pawn captures name the source file
+        if (isCapture)
+            san += std::string(1, 'a' + move.getSrcFile());
+    } else {
+        san += pieceToChar(makePiece(PieceColor::White, typeOf(piece))); // SAN piece letters are uppercase
+        san += getDisambiguation(board, gameState, validator, move);
+    }
+
+    if (isCapture)
+        san += "x";
+    san += squareToString(move.getDestRank(), move.getDestFile());
+
+    // Promotion piece from the move (queen unless the move names another)
+    if (result == MoveResult::VALID_PROMOTION) {
+        const PieceType promoteTo =
+            (move.getFlag() == MoveFlag::Promotion) ?
+            move.getPromotion() :
+            PieceType::Queen;
+        san += "=";
+        san += pieceToChar(makePiece(PieceColor::White, promoteTo));
+    }
+
+    return san;
+}
+
+std::string SANFormatter::getCheckSuffix(
+    const ChessBoard& board, 
+    const ChessGameState& gameState, 
+    const ChessMoveValidator& validator) {
+
+    if (!validator.isInCheck(board, gameState))
+        return "";
+
+    // Only positions in check need the (early exit) legal move scan
+    return validator.hasLegalMove(board, gameState) ? "+" : "#";
+}
+
+std::string SANFormatter::getDisambiguation(
+    const ChessBoard& board, 
+    const ChessGameState& gameState, 
+    const ChessMoveValidator& validator,
+    const ChessMove& move) {
+
+    const Piece piece = board.getPiece(move.getFrom());
+    bool isAmbiguous = false;
+    bool sharesFile = false;
+    bool sharesRank = false;
+
+    // Find other identical pieces that can legally reach the same square
+    for (int rank = BoardCfg::MIN_RANK; rank <= BoardCfg::MAX_RANK; rank++) {
+        for (int file = BoardCfg::MIN_FILE; file <= BoardCfg::MAX_FILE; file++) {
+            if (board.getPiece(rank, file) != piece || 
+                    (rank == move.getSrcRank() && file == move.getSrcFile()))
+                continue;
+
+            ChessMove otherMove{rank, file, move.getDestRank(), move.getDestFile()};
+            if (!validator.isValidMoveResult(validator.validateMove(board, gameState, otherMove)))
+                continue;
+
+            isAmbiguous = true;
+            sharesFile |= (file == move.getSrcFile());
+            sharesRank |= (rank == move.getSrcRank());
+        }
+    }
+
+    if (!isAmbiguous)
+        return "";
+    if (!sharesFile)
+        return std::string(1, 'a' + move.getSrcFile());
+    if (!sharesRank)
+        return std::string(1, '1' + move.getSrcRank());
+    return squareToString(move.getSrcRank(), move.getSrcFile());
+}
+
+std::string SANFormatter::squareToString(const int rank, const int file) {
+    return std::string(1, 'a' + file) + std::string(1, '1' + rank);
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <string>
+#include "board/chess_board.h"
+#include "game_state/chess_game_state.h"
+#include "chess_move.h"
+#include "chess_move_validator.h"
+
+// Formats moves in Standard Algebraic Notation (for PGN export)
+class SANFormatter {
+public:
+    // SAN without check suffix; call BEFORE the move is executed
+    static std::string formatMove(
+        const ChessBoard& board, 
+        const ChessGameState& gameState, 
+        const ChessMoveValidator& validator,
+        const ChessMove& move, 
+        const ChessMoveValidator::MoveResult result);
+
+    // "+", "#" or ""; call AFTER the move is executed
+    static std::string getCheckSuffix(
+        const ChessBoard& board, 
+        const ChessGameState& gameState, 
+        const ChessMoveValidator& validator);
+
+private:
+    static std::string getDisambiguation(
+        const ChessBoard& board, 
+        const ChessGameState& gameState, 
+        const ChessMoveValidator& validator,
+        const ChessMove& move);
+    static std::string squareToString(const int rank, const int file);
+};
@@ -0,0 +1,82 @@
+#include "san_parser.h"
+
+ChessMove SANParser::parse(const Position& position, std::string_view san) {
+    while (!san.empty() && (san.back() == '+' || san.back() == '#' || san.back() == '!' || san.back() == '?'))
+        san.remove_suffix(1);
+    if (san == "O-O")
+        return parseCastling(position, true);
+    if (san == "O-O-O")
+        return parseCastling(position, false);
+
+    // Moving piece (no letter for pawns)
+    PieceType type = PieceType::Pawn;
+    if (!san.empty() && san[0] >= 'A' && san[0] <= 'Z') {
+        type = charToPieceType(san[0]);
+        if (type == PieceType::None || type == PieceType::Pawn)
+            return ChessMove();
+        san.remove_prefix(1);
+    }
+
+    // Promotion piece ("=Q", or the letter right after the rank)
+    PieceType promotion = PieceType::None;
+    if (san.size() >= 2 && san[san.size() - 2] == '=') {
+        promotion = charToPieceType(san.back());
+        san.remove_suffix(2);
+    }
+    else if (type == PieceType::Pawn && san.size() >= 3 && san[san.size() - 2] >= '1' && san[san.size() - 2] <= '8') {
+        promotion = charToPieceType(san.back());
+        san.remove_suffix(1);
+    }
+    if (promotion == PieceType::Pawn || promotion == PieceType::King)
+        return ChessMove();
+
+    // Destination square
+    if (san.size() < 2)
+        return ChessMove();
+    const int destFile = san[san.size() - 2] - 'a';
+    const int destRank = san[san.size() - 1] - '1';
+    if (!isOnBoard(destRank, destFile))
+        return ChessMove();
+    san.remove_suffix(2);
+
+    // Disambiguation and capture mark ("Nbd7", "R1e2", "Qh4xe1", "exd5")
+    int srcFile = -1;
+    int srcRank = -1;
+    for (const char c : san) {
+        if (c >= 'a' && c <= 'h')
+            srcFile = c - 'a';
+        else if (c >= '1' && c <= '8')
+            srcRank = c - '1';
+        else if (c != 'x' && c != ':' && c != '-')
+            return ChessMove();
+    }
+
+    const Square to = makeSquare(destRank, destFile);
+    MoveList moves;
+    position.generateLegalMoves(moves);
+    ChessMove match;
+    for (const ChessMove& move : moves) {
+        if (move.getTo() != to || move.getFlag() == MoveFlag::Castling)
+            continue;
+        if (typeOf(position.getPiece(move.getFrom())) != type)
+            continue;
+        if ((srcFile >= 0 && move.getSrcFile() != srcFile) || (srcRank >= 0 && move.getSrcRank() != srcRank))
+            continue;
+        if (move.getPromotion() != promotion)
+            continue;
+        if (!match.isNull())
+            return ChessMove(); // Ambiguous
+        match = move;
+    }
+    return match;
+}
+
+ChessMove SANParser::parseCastling(const Position& position, const bool isKingside) {
+    MoveList moves;
+    position.generateLegalMoves(moves);
+    for (const ChessMove& move : moves) {
+        if (move.getFlag() == MoveFlag::Castling && (move.getDestFile() > move.getSrcFile()) == isKingside)
+            return move;
+    }
+    return ChessMove();
+}
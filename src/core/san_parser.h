@@ -0,0 +1,17 @@
+#pragma once
+
+#include <string_view>
+#include "chess_move.h"
+#include "position.h"
+
+// Parses Standard Algebraic Notation (PGN movetext) against a position
+class SANParser {
+public:
+    // Legal move for "Nbd7", "exd6", "e8=Q+", "O-O-O" and similar; the null move
+    // if the text is malformed, illegal or ambiguous. Check and annotation suffixes
+    // ("+", "#", "!?") are ignored; "e8Q" is accepted for "e8=Q".
+    static ChessMove parse(const Position& position, std::string_view san);
+
+private:
+    static ChessMove parseCastling(const Position& position, const bool isKingside);
+};
@@ -0,0 +1,95 @@
+#include "static_exchange.h"
+#include <algorithm>
+
+using namespace Bitboards;
+
+namespace {
+    // Longest possible swap list: every piece of both sides
+    constexpr int MAX_EXCHANGE_LENGTH = 32;
+
+    // Indexed by PieceType (the king is never captured, its value only ends lists)
+    constexpr int EXCHANGE_VALUES[] = { 0, 100, 300, 300, 500, 900, 10000 };
+
+    constexpr PieceType ATTACKER_ORDER[] = {
+        PieceType::Pawn, PieceType::Knight, PieceType::Bishop,
+        PieceType::Rook, PieceType::Queen, PieceType::King
+    };
+}
+
+int StaticExchange::getPieceValue(const PieceType type) {
+    return EXCHANGE_VALUES[static_cast<uint8_t>(type)];
+}
+
+int StaticExchange::evaluate(const Position& position, const ChessMove& move) {
+    if (move.getFlag() == MoveFlag::Castling)
+        return 0;
+
+    const Square from = move.getFrom();
+    const Square to = move.getTo();
+    const bool isEnPassant = (move.getFlag() == MoveFlag::EnPassant);
+
+    // gain[d]: material of the side making capture d if the exchange stopped right after it
+    int gain[MAX_EXCHANGE_LENGTH];
+    const PieceType captured =
+        isEnPassant ?
+        PieceType::Pawn :
+        typeOf(position.getPiece(to));
+    PieceType onSquare = typeOf(position.getPiece(from));
+    gain[0] = getPieceValue(captured);
+    if (move.getFlag() == MoveFlag::Promotion) {
+        onSquare = move.getPromotion();
+        gain[0] += getPieceValue(onSquare) - getPieceValue(PieceType::Pawn);
+    }
+
+    Bitboard occupancy = position.getOccupied() ^ squareBit(from);
+    if (isEnPassant)
+        occupancy ^= squareBit(makeSquare(rankOf(from), fileOf(to)));
+    const Bitboard diagonal = position.getPieces(PieceType::Bishop) | position.getPieces(PieceType::Queen);
+    const Bitboard straight = position.getPieces(PieceType::Rook) | position.getPieces(PieceType::Queen);
+    Bitboard attackers = position.getAttackersTo(to, occupancy) & occupancy;
+    PieceColor side = opposite(colorOf(position.getPiece(from)));
+
+    int depth = 0;
+    while (depth + 1 < MAX_EXCHANGE_LENGTH) {
+        const Bitboard ours = attackers & position.getPieces(side);
+        if (!ours)
+            break;
+
+        // Least valuable attacker; the king only takes when nothing defends the square
+        PieceType attacker = PieceType::None;
+        Bitboard attackerBit = EMPTY;
+        for (const PieceType type : ATTACKER_ORDER) {
+            const Bitboard candidates = ours & position.getPieces(side, type);
+            if (candidates) {
+                attacker = type;
+                attackerBit = candidates & (0 - candidates);
+                break;
+            }
+        }
+        if (attacker == PieceType::King && (attackers & position.getPieces(opposite(side))))
+            break;
+
+        depth++;
+        gain[depth] = getPieceValue(onSquare) - gain[depth - 1];
+
+        // The previous capture pays whatever follows: the exchange is decided without this one
+        if (std::max(-gain[depth - 1], gain[depth]) < 0) {
+            depth--;
+            break;
+        }
+
+        // Sliders lined up behind the capturer are uncovered (x-ray)
+        occupancy ^= attackerBit;
+        attackers |= (bishopAttacks(to, occupancy) & diagonal) | (rookAttacks(to, occupancy) & straight);
+        attackers &= occupancy;
+        onSquare = attacker;
+        side = opposite(side);
+    }
+
+    // Each side only continues the exchange when it pays
+    while (depth > 0) {
+        gain[depth - 1] = -std::max(-gain[depth - 1], gain[depth]);
+        depth--;
+    }
+    return gain[0];
+}
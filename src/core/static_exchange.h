@@ -0,0 +1,26 @@
+#pragma once
+
+#include "chess_move.h"
+#include "position.h"
+
+/**
+ * Static exchange evaluation: the material outcome of a capture sequence on one square
+ *
+ * Key features:
+ * - Both sides recapture with their least valuable attacker and may stop
+ *   whenever continuing would lose material (swap list, minimaxed backwards)
+ * - X-rays: sliders behind a piece that has just captured join the exchange
+ * - Promotions and en passant are valued; castling is neutral
+ * - Pins are ignored, as usual for SEE; the result is a cheap estimate,
+ *   not a search
+ * - Bitboard only (no make/undo), so it is cheap enough for every capture of
+ *   every position of a corpus
+ */
+class StaticExchange {
+public:
+    // Material the mover wins (negative: loses) in centipawns, for a pseudo-legal move
+    static int evaluate(const Position& position, const ChessMove& move);
+
+    // Exchange values: pawn 100, knight and bishop 300, rook 500, queen 900
+    static int getPieceValue(const PieceType type);
+};
@@ -0,0 +1,61 @@
+#include "threat_scanner.h"
+#include "static_exchange.h"
+#include <algorithm>
+
+using namespace Bitboards;
+
+void ThreatScanner::scan(const Position& position, ThreatReport& report) {
+    report.isInCheck = position.isInCheck();
+    report.hanging.clear();
+    report.losingCaptures.clear();
+    report.winningCaptureGain = 0;
+
+    findHangingPieces(position, PieceColor::White, report);
+    findHangingPieces(position, PieceColor::Black, report);
+    std::sort(report.hanging.begin(), report.hanging.end(),
+        [](const HangingPiece& a, const HangingPiece& b) { return a.loss > b.loss; });
+
+    MoveList captures;
+    position.generateCaptures(captures);
+    for (const ChessMove& move : captures) {
+        if (!position.isCapture(move) || !position.isLegal(move))
+            continue;
+        const int exchange = StaticExchange::evaluate(position, move);
+        if (exchange < 0)
+            report.losingCaptures.push_back(LosingCapture{move, exchange});
+        report.winningCaptureGain = std::max(report.winningCaptureGain, exchange);
+    }
+    std::sort(report.losingCaptures.begin(), report.losingCaptures.end(),
+        [](const LosingCapture& a, const LosingCapture& b) { return a.exchange < b.exchange; });
+}
+
+void ThreatScanner::findHangingPieces(const Position& position, const PieceColor color, ThreatReport& report) {
+    const PieceColor enemy = opposite(color);
+    const Bitboard occupancy = position.getOccupied();
+    const Bitboard enemies = position.getPieces(enemy);
+    const Bitboard lastRank =
+        (enemy == PieceColor::White) ?
+        RANK_8 :
+        RANK_1;
+
+    Bitboard targets = position.getPieces(color) & ~position.getPieces(color, PieceType::King);
+    while (targets) {
+        const Square square = popLsb(targets);
+        Bitboard attackers = position.getAttackersTo(square, occupancy) & enemies;
+
+        // Each attacker may start the exchange; the opponent picks the best
+        int bestGain = 0;
+        while (attackers) {
+            const Square from = popLsb(attackers);
+            const bool isPromotion =
+                typeOf(position.getPiece(from)) == PieceType::Pawn && (squareBit(square) & lastRank);
+            const ChessMove capture =
+                isPromotion ?
+                ChessMove(from, square, MoveFlag::Promotion, PieceType::Queen) :
+                ChessMove(from, square);
+            bestGain = std::max(bestGain, StaticExchange::evaluate(position, capture));
+        }
+        if (bestGain > 0)
+            report.hanging.push_back(HangingPiece{square, position.getPiece(square), bestGain});
+    }
+}
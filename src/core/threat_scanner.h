@@ -0,0 +1,48 @@
+#pragma once
+
+#include <vector>
+#include "chess_move.h"
+#include "chess_types.h"
+#include "position.h"
+
+// A piece the opponent could win material on by capturing it now
+struct HangingPiece {
+    Square square = Square::None;
+    Piece piece = Piece::None;
+    int loss = 0;                   // Best static exchange for the opponent (> 0)
+};
+
+// A legal capture of the side to move that loses material
+struct LosingCapture {
+    ChessMove move;
+    int exchange = 0;               // Static exchange result (< 0)
+};
+
+// Tactical summary of one position (vectors are reused between scans)
+struct ThreatReport {
+    bool isInCheck = false;
+    std::vector<HangingPiece> hanging;          // Both colors, largest loss first
+    std::vector<LosingCapture> losingCaptures;  // Side to move, worst first
+    int winningCaptureGain = 0;     // Best static exchange among the side to move's captures (0 if none wins)
+
+    // Anything worth spending search time on: check, material en prise, or a capture that wins
+    bool isTactical() const { return isInCheck || !hanging.empty() || winningCaptureGain > 0; }
+};
+
+/**
+ * Engine-free threat detection on Position (static exchange evaluation)
+ *
+ * Key features:
+ * - Hanging pieces of both sides: every non-king piece the opponent attacks is
+ *   tried with each attacker, and kept if some capture wins material
+ * - Losing captures: legal captures of the side to move with a negative exchange
+ * - No search and no allocation once the report's vectors have grown, so every
+ *   ply of a corpus can be scanned to pick the positions that deserve engine time
+ */
+class ThreatScanner {
+public:
+    static void scan(const Position& position, ThreatReport& report);
+
+private:
+    static void findHangingPieces(const Position& position, PieceColor color, ThreatReport& report);
+};
@@ -23,16 +23,12 @@ BasicMoveValidator::ValidationResult BasicMoveValidator::validateBasics(
         return ValidationResult::INVALID_SAME_POSITION;
     
     // 3. Check if there's a piece to move
-    char piece = board.getPieceAt(srcRank, srcFile);
-    if (piece == BoardCfg::EMPTY) 
+    const Piece piece = board.getPiece(move.getFrom());
+    if (piece == Piece::None) 
         return ValidationResult::INVALID_NO_PIECE;
     
     // 4. Check if it's the correct player's turn
-    char currentPlayer = gameState.getCurrentPlayer();
-    if ((currentPlayer == 'w' && 
-            !board.isWhitePiece(srcRank, srcFile)) || 
-            (currentPlayer == 'b' && 
-            board.isWhitePiece(srcRank, srcFile))) 
+    if (colorOf(piece) != charToColor(gameState.getCurrentPlayer())) 
         return ValidationResult::INVALID_WRONG_TURN;
     
     // 5. Check destination square validity
@@ -37,40 +37,34 @@ bool CheckValidator::isSquareUnderAttack(
     const int defFile, 
     const char attackingPlayer) const {
     
+    const PieceColor attackerColor = charToColor(attackingPlayer);
+    const int pawnDirection =
+        (attackerColor == PieceColor::White) ?
+        BoardCfg::WHITE_PAWN_DIRECTION :
+        BoardCfg::BLACK_PAWN_DIRECTION;
+    PieceMovementValidator pieceValidator;
+
     // Check all squares on the board for pieces belonging to the attacking player
-    for (int atkRank = BoardCfg::MIN_RANK; atkRank <= BoardCfg::MAX_RANK; atkRank++) {
-        for (int atkFile = BoardCfg::MIN_FILE; atkFile <= BoardCfg::MAX_FILE; atkFile++) {
-            char attackingPiece = board.getPieceAt(atkRank, atkFile);
-            
-            // Skip empty squares
-            if (attackingPiece == BoardCfg::EMPTY) 
-                continue;
-            
-            // Check if this piece belongs to the attacking player
-            bool isAttackersPiece = 
-                (attackingPlayer == 'w') ?
-                board.isWhitePiece(atkRank, atkFile) :
-                !board.isWhitePiece(atkRank, atkFile);
-            
-            if (!isAttackersPiece) 
-                continue;
-            
-            // Check if this piece can attack the target square
-            // For pawns, special logic since they attack differently than they move
-            if (board.isPawn(attackingPiece)) {
-                int direction =
-                    (attackingPiece == 'P') ? 
-                    BoardCfg::WHITE_PAWN_DIRECTION : 
-                    BoardCfg::BLACK_PAWN_DIRECTION;
-                
-                if (defRank == atkRank + direction && abs(defFile - atkFile) == 1) 
-                    return true; // Pawn can attack diagonally
-            } else {
-                // For other pieces, use existing movement validation
-                PieceMovementValidator pieceValidator;
-                if (pieceValidator.validateBasicPieceMovement(board, gameState, attackingPiece, ChessMove{atkRank, atkFile, defRank, defFile}))
-                    return true;
-            }
+    for (int index = 0; index < SQUARE_COUNT; index++) {
+        const Square atkSquare = static_cast<Square>(index);
+        const Piece attackingPiece = board.getPiece(atkSquare);
+
+        // Skip empty squares and the defender's pieces
+        if (attackingPiece == Piece::None || colorOf(attackingPiece) != attackerColor)
+            continue;
+
+        const int atkRank = rankOf(atkSquare);
+        const int atkFile = fileOf(atkSquare);
+
+        // Check if this piece can attack the target square
+        // For pawns, special logic since they attack differently than they move
+        if (board.isPawn(attackingPiece)) {
+            if (defRank == atkRank + pawnDirection && abs(defFile - atkFile) == 1)
+                return true; // Pawn can attack diagonally
+        } else {
+            // For other pieces, use existing movement validation
+            if (pieceValidator.validateBasicPieceMovement(board, gameState, attackingPiece, ChessMove{atkRank, atkFile, defRank, defFile}))
+                return true;
         }
     }
     return false; // No piece can attack this square
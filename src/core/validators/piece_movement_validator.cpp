@@ -9,9 +9,7 @@ bool PieceMovementValidator::validatePieceMovement(
     const ChessGameState& gameState,
     const ChessMove& move) const {
     
-    int srcRank = move.getSrcRank();
-    int srcFile = move.getSrcFile();
-    char piece = board.getPieceAt(srcRank, srcFile);
+    const Piece piece = board.getPiece(move.getFrom());
     
     // Special case for pawns - they have unique movement rules
     if (board.isPawn(piece)) 
@@ -72,13 +70,13 @@ bool PieceMovementValidator::validatePawnMove(
     int destFile = move.getDestFile();
     
     // Setup variables for checking
-    char piece = board.getPieceAt(srcRank, srcFile);
+    const bool isWhitePawn = (board.getPiece(move.getFrom()) == Piece::WhitePawn);
     int direction = 
-        (piece == 'P') ? 
+        isWhitePawn ? 
         BoardCfg::WHITE_PAWN_DIRECTION : 
         BoardCfg::BLACK_PAWN_DIRECTION;
     int startRank = 
-        (piece == 'P') ? 
+        isWhitePawn ? 
         BoardCfg::WHITE_PAWN_START_RANK : 
         BoardCfg::BLACK_PAWN_START_RANK;
 
@@ -113,7 +111,7 @@ bool PieceMovementValidator::validatePawnMove(
 bool PieceMovementValidator::validateBasicPieceMovement(
     const ChessBoard& board, 
     const ChessGameState& gameState,
-    const char piece,
+    const Piece piece,
     const ChessMove& move) const {
     
     int srcRank = move.getSrcRank();
@@ -123,30 +121,25 @@ bool PieceMovementValidator::validateBasicPieceMovement(
     
     // This validates piece movement without checking destination square ownership
     // Used for attack detection where we want to know if a piece CAN reach a square
-    switch (piece) {
-        case 'R':
-        case 'r':
+    switch (typeOf(piece)) {
+        case PieceType::Rook:
             return (srcRank == destRank || srcFile == destFile) && // Horizontal and vertical
                 isPathClearForSlidingPiece(board, move); // Sliding piece
         
-        case 'B':
-        case 'b':
+        case PieceType::Bishop:
             return (abs(destRank - srcRank) == abs(destFile - srcFile)) && // Diagonal 
                 isPathClearForSlidingPiece(board, move); // Sliding piece
         
-        case 'Q':
-        case 'q': 
+        case PieceType::Queen:
             return ((srcRank == destRank || srcFile == destFile || // Horizontal and vertical
                 abs(destRank - srcRank) == abs(destFile - srcFile)) && // Diagonal
                 isPathClearForSlidingPiece(board, move)); // Sliding piece
         
-        case 'N':
-        case 'n': 
+        case PieceType::Knight:
             return (abs(destRank - srcRank) == 2 && abs(destFile - srcFile) == 1) ||  // Vertical L
                 (abs(destRank - srcRank) == 1 && abs(destFile - srcFile) == 2); // Horizontal L
         
-        case 'K':
-        case 'k': { 
+        case PieceType::King: {
             // Normal king move (one square in any direction)
             if (abs(destRank - srcRank) <= 1 && abs(destFile - srcFile) <= 1) 
                 return true;            
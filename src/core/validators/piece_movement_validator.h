@@ -10,7 +10,7 @@ public:
     ~PieceMovementValidator() = default;
 
     bool validatePieceMovement(const ChessBoard& board, const ChessGameState& gameState, const ChessMove& move) const;
-    bool validateBasicPieceMovement(const ChessBoard& board, const ChessGameState& gameState, const char piece, const ChessMove& move) const;
+    bool validateBasicPieceMovement(const ChessBoard& board, const ChessGameState& gameState, const Piece piece, const ChessMove& move) const;
     
     // Piece specific validation (made public for use by SpecialMoveValidator)
     bool validatePawnMove(const ChessBoard& board, const ChessGameState& gameState, const ChessMove& move) const;
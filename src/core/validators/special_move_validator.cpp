@@ -22,8 +22,7 @@ bool SpecialMoveValidator::validateCastling(
     char currentPlayer = gameState.getCurrentPlayer();
     
     // Check if this is a king making a castling move
-    char piece = board.getPieceAt(srcRank, srcFile);
-    if (!board.isKing(piece))
+    if (!board.isKing(board.getPiece(move.getFrom())))
         return false; // Not a king move
 
     // Check if the move is a potential castling move (king moves 2 squares horizontally)
@@ -120,18 +119,17 @@ bool SpecialMoveValidator::validateEnPassant(
     int pawnFile = enPassantPawn.second;
     
     // Verify the en passant pawn exists and is the opponent's pawn
-    char targetPawn = board.getPieceAt(pawnRank, pawnFile);
-    if (targetPawn == BoardCfg::EMPTY) 
+    if (board.getPiece(pawnRank, pawnFile) == Piece::None) 
         return false;
     
     // Verify it's an opponent's pawn
-    char movingPiece = board.getPieceAt(srcRank, srcFile);
+    const Piece movingPiece = board.getPiece(move.getFrom());
     if (board.areSameColorPieces(ChessMove{srcRank, srcFile, pawnRank, pawnFile})) 
         return false; // Cannot capture your own pawn
     
     // Verify the capturing pawn is on the correct rank for en passant
     int expectedRank = 
-        (movingPiece == 'P') ? 
+        (movingPiece == Piece::WhitePawn) ? 
         BoardCfg::WHITE_EN_PASSANT_CAPTURE_RANK : 
         BoardCfg::BLACK_EN_PASSANT_CAPTURE_RANK;
     if (srcRank != expectedRank) 
@@ -148,11 +146,11 @@ bool SpecialMoveValidator::validatePromotion(
     int destRank = move.getDestRank();
     
     // Get the piece being promoted
-    char piece = board.getPieceAt(move.getSrcRank(), move.getSrcFile());
+    const Piece piece = board.getPiece(move.getFrom());
     
     // Determine promotion rank based on pawn color
     int promotionRank = 
-        (piece == 'P') ? 
+        (piece == Piece::WhitePawn) ? 
         BoardCfg::WHITE_PROMOTES_AT_RANK : 
         BoardCfg::BLACK_PROMOTES_AT_RANK;
     
@@ -0,0 +1,37 @@
+#include "binary_io.h"
+
+namespace {
+    constexpr size_t COPY_CHUNK_SIZE = 1 << 20;
+}
+
+void BinaryIO::writeVarint(std::vector<uint8_t>& out, uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(value));
+}
+
+bool BinaryIO::readVarint(const uint8_t*& cursor, const uint8_t* end, uint64_t& value) {
+    value = 0;
+    for (int shift = 0; shift < 64 && cursor < end; shift += 7) {
+        const uint8_t byte = *cursor++;
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if (!(byte & 0x80))
+            return true;
+    }
+    return false; // Truncated or overlong
+}
+
+bool BinaryIO::appendFile(std::ofstream& output, const std::string& sourcePath) {
+    std::ifstream input(sourcePath, std::ios::binary);
+    if (!input.is_open())
+        return false;
+
+    std::vector<char> chunk(COPY_CHUNK_SIZE);
+    while (input) {
+        input.read(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+        output.write(chunk.data(), input.gcount());
+    }
+    return !output.fail();
+}
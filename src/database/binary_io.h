@@ -0,0 +1,18 @@
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// Encoding helpers shared by the database file formats (position index, game archive)
+namespace BinaryIO {
+    // LEB128: 7 bits per byte, high bit set on all but the last byte
+    void writeVarint(std::vector<uint8_t>& out, uint64_t value);
+
+    // Advances cursor past the value; false if it is truncated or overlong
+    bool readVarint(const uint8_t*& cursor, const uint8_t* end, uint64_t& value);
+
+    // Copies a whole file to the end of output in fixed-size chunks; false on a read or write error
+    bool appendFile(std::ofstream& output, const std::string& sourcePath);
+}
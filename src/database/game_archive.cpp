@@ -0,0 +1,304 @@
+#include "game_archive.h"
+#include <cstdio>
+#include <cstring>
+#include "binary_io.h"
+#include "../core/san_parser.h"
+
+namespace Format = GameArchiveFormat;
+using BinaryIO::readVarint;
+using BinaryIO::writeVarint;
+
+// --- GameArchiveFormat ---
+
+int Format::encodeMove(const Position& position, const ChessMove& move, MoveList& legalMoves) {
+    position.generateLegalMoves(legalMoves);
+    for (int i = 0; i < legalMoves.size(); i++) {
+        if (legalMoves[i] == move)
+            return i;
+    }
+    return -1;
+}
+
+ChessMove Format::decodeMove(const Position& position, const uint8_t code, MoveList& legalMoves) {
+    position.generateLegalMoves(legalMoves);
+    return
+        (code < legalMoves.size()) ?
+        legalMoves[code] :
+        ChessMove();
+}
+
+uint32_t Format::getMoveOrderSignature() {
+    static const uint32_t signature = [] {
+        // Quiet moves and castling, promotions, en passant
+        constexpr const char* FENS[] = {
+            "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+            "n1n5/PPPk4/8/8/8/8/4Kppp/5N1N b - - 0 1",
+            "rnbqkbnr/ppp1p1pp/8/3pPp2/8/8/PPPP1PPP/RNBQKBNR w KQkq f6 0 3"
+        };
+
+        // FNV-1a over the raw moves in generation order
+        uint32_t hash = 2166136261u;
+        Position position;
+        MoveList legalMoves;
+        for (const char* fen : FENS) {
+            position.setFromFEN(fen);
+            position.generateLegalMoves(legalMoves);
+            for (const ChessMove& move : legalMoves) {
+                hash = (hash ^ (move.getRaw() & 0xFF)) * 16777619u;
+                hash = (hash ^ (move.getRaw() >> 8)) * 16777619u;
+            }
+        }
+        return hash;
+    }();
+    return signature;
+}
+
+// --- ArchivedGame ---
+
+std::string_view ArchivedGame::getTag(std::string_view name) const {
+    for (const PGNTag& tag : tags) {
+        if (tag.name == name)
+            return tag.value;
+    }
+    return {};
+}
+
+// --- GameArchive ---
+
+bool GameArchive::open(const std::string& path) {
+    close();
+    if (!file.open(path) || file.getSize() < sizeof(Format::Header)) {
+        close();
+        return false;
+    }
+    std::memcpy(&header, file.getData(), sizeof(header));
+
+    // Sections are contiguous, so each one must end exactly where the next begins
+    const uint64_t size = file.getSize();
+    const bool isValid =
+        std::memcmp(header.magic, Format::MAGIC, sizeof(Format::MAGIC)) == 0 &&
+        header.version == Format::VERSION &&
+        header.moveOrder == Format::getMoveOrderSignature() &&
+        header.fileSize == size &&
+        header.gamesOffset == sizeof(Format::Header) &&
+        header.gamesOffset <= header.stringsOffset &&
+        header.stringsOffset <= header.stringOffsetsOffset &&
+        header.stringOffsetsOffset <= size &&
+        header.stringCount < size / sizeof(uint64_t) &&
+        header.gameCount <= size / sizeof(Format::GameEntry) &&
+        header.entriesOffset == header.stringOffsetsOffset + (header.stringCount + 1) * sizeof(uint64_t) &&
+        header.fileSize == header.entriesOffset + header.gameCount * sizeof(Format::GameEntry);
+    if (!isValid) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+void GameArchive::close() {
+    file.close();
+    header = {};
+}
+
+bool GameArchive::getGame(const uint64_t index, ArchivedGame& game) const {
+    game.index = index;
+    game.tags.clear();
+    game.result = GameResult::Unknown;
+    game.isTruncated = false;
+    game.moveCodes = {};
+    if (!isOpen() || index >= header.gameCount)
+        return false;
+
+    Format::GameEntry entry;
+    std::memcpy(&entry, file.getData() + header.entriesOffset + index * sizeof(entry), sizeof(entry));
+    const uint64_t gamesSize = header.stringsOffset - header.gamesOffset;
+    if (entry.recordOffset > gamesSize || entry.recordSize > gamesSize - entry.recordOffset)
+        return false;
+    game.result = static_cast<GameResult>(entry.result);
+    game.isTruncated = (entry.flags & Format::FLAG_TRUNCATED) != 0;
+
+    const uint8_t* cursor = file.getData() + header.gamesOffset + entry.recordOffset;
+    const uint8_t* end = cursor + entry.recordSize;
+    uint64_t tagCount;
+    if (!readVarint(cursor, end, tagCount) || tagCount > entry.recordSize)
+        return false;
+    game.tags.resize(tagCount);
+    for (PGNTag& tag : game.tags) {
+        uint64_t nameId;
+        uint64_t valueId;
+        if (!readVarint(cursor, end, nameId) || !readVarint(cursor, end, valueId) ||
+            !getString(nameId, tag.name) || !getString(valueId, tag.value))
+            return false;
+    }
+
+    // The rest of the record is the moves
+    game.moveCodes = std::string_view(reinterpret_cast<const char*>(cursor), static_cast<size_t>(end - cursor));
+    return true;
+}
+
+bool GameArchive::getString(const uint64_t id, std::string& text) const {
+    if (id >= header.stringCount)
+        return false;
+    uint64_t offsets[2];
+    std::memcpy(offsets, file.getData() + header.stringOffsetsOffset + id * sizeof(uint64_t), sizeof(offsets));
+    const uint64_t stringsSize = header.stringOffsetsOffset - header.stringsOffset;
+    if (offsets[0] > offsets[1] || offsets[1] > stringsSize)
+        return false;
+    text.assign(reinterpret_cast<const char*>(file.getData() + header.stringsOffset + offsets[0]), static_cast<size_t>(offsets[1] - offsets[0]));
+    return true;
+}
+
+// --- ArchivedGameReplay ---
+
+bool ArchivedGameReplay::start(const ArchivedGame& game) {
+    moveCodes = game.moveCodes;
+    ply = 0;
+    const std::string_view fen = game.getTag("FEN");
+    if (fen.empty()) {
+        position.setStartingPosition();
+        return true;
+    }
+    if (position.setFromFEN(fen))
+        return true;
+    moveCodes = {};
+    return false;
+}
+
+bool ArchivedGameReplay::next(ChessMove& move) {
+    if (ply >= static_cast<int>(moveCodes.size()))
+        return false;
+    move = Format::decodeMove(position, static_cast<uint8_t>(moveCodes[ply]), legalMoves);
+    if (move.isNull())
+        return false;
+    position.makeMove(move, undo);
+    ply++;
+    return true;
+}
+
+// --- GameArchiveWriter ---
+
+GameArchiveWriter::~GameArchiveWriter() {
+    // Unfinished: the partial output is useless
+    if (output.is_open()) {
+        output.close();
+        entriesFile.close();
+        std::remove(getEntriesPath().c_str());
+        std::remove(path.c_str());
+    }
+}
+
+bool GameArchiveWriter::open(const std::string& path) {
+    this->path = path;
+    header = {};
+    std::memcpy(header.magic, Format::MAGIC, sizeof(Format::MAGIC));
+    header.version = Format::VERSION;
+    header.moveOrder = Format::getMoveOrderSignature();
+    header.gamesOffset = sizeof(Format::Header);
+    gamesSize = 0;
+    stringIds.clear();
+    strings.clear();
+
+    output.open(path, std::ios::binary | std::ios::trunc);
+    entriesFile.open(getEntriesPath(), std::ios::binary | std::ios::trunc);
+
+    // Placeholder until finish() knows the section offsets
+    output.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    return output.good() && entriesFile.good();
+}
+
+bool GameArchiveWriter::addGame(const PGNGame& game) {
+    record.clear();
+    writeVarint(record, game.tags.size());
+    for (const PGNTag& tag : game.tags) {
+        writeVarint(record, getStringId(tag.name));
+        writeVarint(record, getStringId(tag.value));
+    }
+
+    // Games that cannot be set up keep their headers and no moves
+    const std::string_view fen = game.getTag("FEN");
+    bool isComplete = true;
+    if (fen.empty())
+        position.setStartingPosition();
+    else
+        isComplete = position.setFromFEN(fen);
+    if (isComplete) {
+        PositionUndo undo;
+        for (const std::string& san : game.moves) {
+            const ChessMove move = SANParser::parse(position, san);
+            const int code =
+                move.isNull() ?
+                -1 :
+                Format::encodeMove(position, move, legalMoves);
+            if (code < 0) {
+                isComplete = false;
+                break;
+            }
+            record.push_back(static_cast<uint8_t>(code));
+            position.makeMove(move, undo);
+            header.plyCount++;
+        }
+    }
+
+    Format::GameEntry entry{};
+    entry.recordOffset = gamesSize;
+    entry.recordSize = static_cast<uint32_t>(record.size());
+    entry.result = static_cast<uint8_t>(parseGameResult(
+        game.result.empty() ?
+        game.getTag("Result") :
+        std::string_view(game.result)));
+    entry.flags =
+        isComplete ?
+        0 :
+        Format::FLAG_TRUNCATED;
+    entriesFile.write(reinterpret_cast<const char*>(&entry), sizeof(entry));
+    output.write(reinterpret_cast<const char*>(record.data()), static_cast<std::streamsize>(record.size()));
+    gamesSize += record.size();
+    header.gameCount++;
+    return isComplete;
+}
+
+bool GameArchiveWriter::finish() {
+    entriesFile.close();
+
+    // String table: bytes, then the offset of each string and the end
+    header.stringsOffset = header.gamesOffset + gamesSize;
+    header.stringCount = strings.size();
+    std::vector<uint64_t> offsets;
+    offsets.reserve(strings.size() + 1);
+    uint64_t stringsSize = 0;
+    for (const std::string* text : strings) {
+        offsets.push_back(stringsSize);
+        output.write(text->data(), static_cast<std::streamsize>(text->size()));
+        stringsSize += text->size();
+    }
+    offsets.push_back(stringsSize);
+    header.stringOffsetsOffset = header.stringsOffset + stringsSize;
+    output.write(reinterpret_cast<const char*>(offsets.data()), static_cast<std::streamsize>(offsets.size() * sizeof(uint64_t)));
+    header.entriesOffset = header.stringOffsetsOffset + offsets.size() * sizeof(uint64_t);
+    bool isWritten = BinaryIO::appendFile(output, getEntriesPath());
+
+    // Final header
+    header.fileSize = static_cast<uint64_t>(output.tellp());
+    output.seekp(0);
+    output.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    output.close();
+    isWritten = isWritten && !output.fail();
+
+    std::remove(getEntriesPath().c_str());
+    if (!isWritten)
+        std::remove(path.c_str());
+    stringIds.clear();
+    strings.clear();
+    return isWritten;
+}
+
+uint32_t GameArchiveWriter::getStringId(const std::string& text) {
+    const auto [it, isNew] = stringIds.try_emplace(text, static_cast<uint32_t>(strings.size()));
+    if (isNew)
+        strings.push_back(&it->first);
+    return it->second;
+}
+
+std::string GameArchiveWriter::getEntriesPath() const {
+    return path + ".entries.tmp";
+}
@@ -0,0 +1,174 @@
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "position_index.h"
+#include "../core/chess_move.h"
+#include "../core/memory_mapped_file.h"
+#include "../core/pgn_reader.h"
+#include "../core/position.h"
+
+// On-disk layout (little endian, all offsets from the start of the file)
+//
+//   header | games | strings | string offsets | entries
+//
+// - games:          per game, varint tag count, then (varint name id, varint
+//   value id) per tag, then one move code per ply up to the end of the record
+// - strings:        every distinct tag name and value once, not terminated
+// - string offsets: stringCount + 1 offsets into the strings section; string
+//   i is [offsets[i], offsets[i + 1])
+// - entries:        GameEntry per game, in file order (random access by index)
+//
+// A move code is the move's index in Position::generateLegalMoves() order (at
+// most 218 legal moves, so one byte). The header records a signature of that
+// order: an archive written by a build whose generator orders moves
+// differently fails to open instead of decoding the wrong moves.
+namespace GameArchiveFormat {
+    constexpr char MAGIC[8] = {'C', 'A', 'P', 'G', 'A', 'M', '0', '1'};
+    constexpr uint32_t VERSION = 1;
+    constexpr uint8_t FLAG_TRUNCATED = 1u << 0;    // Moves stop before an illegal or unreadable one
+
+    struct Header {
+        char magic[8];
+        uint32_t version;
+        uint32_t moveOrder;                 // getMoveOrderSignature() of the writer
+        uint64_t gameCount;
+        uint64_t plyCount;
+        uint64_t stringCount;
+        uint64_t gamesOffset;
+        uint64_t stringsOffset;
+        uint64_t stringOffsetsOffset;
+        uint64_t entriesOffset;
+        uint64_t fileSize;
+    };
+
+    struct GameEntry {
+        uint64_t recordOffset;              // Relative to the games section
+        uint32_t recordSize;
+        uint8_t result;                     // GameResult
+        uint8_t flags;
+        uint8_t reserved[2];
+    };
+
+    static_assert(sizeof(Header) == 80, "Archive header layout changed");
+    static_assert(sizeof(GameEntry) == 16, "Archive game entry layout changed");
+
+    // Code of a legal move (-1 if it is not legal); legalMoves is scratch space
+    int encodeMove(const Position& position, const ChessMove& move, MoveList& legalMoves);
+
+    // Legal move of a code (null move if out of range); legalMoves is scratch space
+    ChessMove decodeMove(const Position& position, const uint8_t code, MoveList& legalMoves);
+
+    // Hash of the generator's move order on positions covering every move kind
+    uint32_t getMoveOrderSignature();
+}
+
+// Headers of an archived game and its still encoded moves
+struct ArchivedGame {
+    uint64_t index = 0;
+    std::vector<PGNTag> tags;               // In the original file order
+    GameResult result = GameResult::Unknown;
+    bool isTruncated = false;               // The source game had an illegal or unreadable move
+    std::string_view moveCodes;             // One code per ply (points into the archive's mapping)
+
+    // Value of a tag, or empty if the game does not have it
+    std::string_view getTag(std::string_view name) const;
+};
+
+/**
+ * Read-only binary game archive (about one byte per ply)
+ *
+ * Key features:
+ * - Memory mapped: getGame() is random access through the entry table and
+ *   only touches the game's own record and strings
+ * - Moves stay encoded until replayed, so scanning headers costs nothing
+ *   per move; ArchivedGameReplay decodes them with the core move generator,
+ *   with no SAN parsing or disambiguation
+ * - Every section is bounds checked on open, and every record on access
+ */
+class GameArchive {
+public:
+    bool open(const std::string& path);
+    void close();
+    bool isOpen() const { return file.isOpen(); }
+
+    uint64_t getGameCount() const { return header.gameCount; }
+    uint64_t getPlyCount() const { return header.plyCount; }
+    uint64_t getStringCount() const { return header.stringCount; }
+
+    // Game by index; false for an out-of-range index or a damaged record
+    bool getGame(const uint64_t index, ArchivedGame& game) const;
+
+private:
+    MemoryMappedFile file;
+    GameArchiveFormat::Header header{};
+
+    bool getString(const uint64_t id, std::string& text) const;
+};
+
+/**
+ * Streaming decoder of an archived game's moves
+ *
+ * Keeps the position of the last decoded ply, so a caller analysing every
+ * position of a game never rebuilds one from scratch.
+ */
+class ArchivedGameReplay {
+public:
+    // Start at the game's initial position (its FEN tag, or the standard one); false for a bad FEN
+    bool start(const ArchivedGame& game);
+
+    // Decode and play the next move; false at the end of the game or at a corrupt code
+    bool next(ChessMove& move);
+
+    const Position& getPosition() const { return position; }
+    int getPly() const { return ply; }
+
+private:
+    Position position;
+    PositionUndo undo;
+    MoveList legalMoves;
+    std::string_view moveCodes;
+    int ply = 0;
+};
+
+/**
+ * Streaming writer of GameArchive files
+ *
+ * Game records are written straight to the output and game entries to a
+ * temporary file next to it; only the string table (distinct tag names and
+ * values) is kept in memory. finish() appends the strings and entries and
+ * writes the final header.
+ */
+class GameArchiveWriter {
+public:
+    ~GameArchiveWriter();
+
+    bool open(const std::string& path);
+
+    // Encodes the main line up to the first illegal or unreadable move; false if it stopped early
+    bool addGame(const PGNGame& game);
+
+    bool finish();
+
+    uint64_t getGameCount() const { return header.gameCount; }
+    uint64_t getPlyCount() const { return header.plyCount; }
+
+private:
+    std::string path;
+    std::ofstream output;
+    std::ofstream entriesFile;
+    GameArchiveFormat::Header header{};
+    uint64_t gamesSize = 0;
+    std::unordered_map<std::string, uint32_t> stringIds;
+    std::vector<const std::string*> strings;            // By id (keys of stringIds)
+    std::vector<uint8_t> record;                        // Reused game record encoding
+    Position position;
+    MoveList legalMoves;
+
+    uint32_t getStringId(const std::string& text);
+    std::string getEntriesPath() const;
+};
@@ -0,0 +1,190 @@
+#include "opening_explorer.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+namespace Format = OpeningExplorerFormat;
+namespace IndexFormat = PositionIndexFormat;
+
+// --- OpeningTree ---
+
+void OpeningTree::add(const uint64_t positionKey, const ChessMove& move, const GameResult result, const int moverRating) {
+    MoveCounts& counts = entries[{positionKey, move.getRaw()}];
+    counts.games++;
+    switch (result) {
+        case GameResult::WhiteWins: counts.whiteWins++; break;
+        case GameResult::BlackWins: counts.blackWins++; break;
+        case GameResult::Draw: counts.draws++; break;
+        default: break;
+    }
+    if (moverRating > 0) {
+        counts.ratedGames++;
+        counts.ratingSum += static_cast<uint64_t>(moverRating);
+    }
+}
+
+void OpeningTree::merge(OpeningTree& other) {
+    // Walk the smaller map into the larger one
+    if (other.entries.size() > entries.size())
+        entries.swap(other.entries);
+    for (const auto& [key, otherCounts] : other.entries) {
+        MoveCounts& counts = entries[key];
+        counts.games += otherCounts.games;
+        counts.whiteWins += otherCounts.whiteWins;
+        counts.draws += otherCounts.draws;
+        counts.blackWins += otherCounts.blackWins;
+        counts.ratedGames += otherCounts.ratedGames;
+        counts.ratingSum += otherCounts.ratingSum;
+    }
+    gameCount += other.gameCount;
+    other.entries.clear();
+    other.gameCount = 0;
+}
+
+bool OpeningTree::write(const std::string& path, uint64_t& positionCount) const {
+    positionCount = 0;
+    if (entries.size() > UINT32_MAX)
+        return false;
+
+    // Positions by key, then each position's moves by popularity
+    using Entry = std::pair<MoveKey, MoveCounts>;
+    std::vector<Entry> sorted(entries.begin(), entries.end());
+    std::sort(sorted.begin(), sorted.end(), [](const Entry& a, const Entry& b) {
+        if (a.first.positionKey != b.first.positionKey)
+            return a.first.positionKey < b.first.positionKey;
+        if (a.second.games != b.second.games)
+            return a.second.games > b.second.games;
+        return a.first.move < b.first.move;
+    });
+
+    std::vector<Format::PositionEntry> positions;
+    std::vector<Format::MoveEntry> moves;
+    moves.reserve(sorted.size());
+    for (const auto& [key, counts] : sorted) {
+        if (positions.empty() || positions.back().key != key.positionKey)
+            positions.push_back({key.positionKey, static_cast<uint32_t>(moves.size()), 0});
+        positions.back().moveCount++;
+
+        const uint64_t averageRating =
+            (counts.ratedGames > 0) ?
+            counts.ratingSum / counts.ratedGames :
+            0;
+        moves.push_back({
+            counts.games, counts.whiteWins, counts.draws, counts.blackWins,
+            key.move, static_cast<uint16_t>(std::min<uint64_t>(averageRating, UINT16_MAX))
+        });
+    }
+
+    // Same bucket directory scheme as the position index
+    Format::Header header{};
+    std::memcpy(header.magic, Format::MAGIC, sizeof(Format::MAGIC));
+    header.version = Format::VERSION;
+    header.bucketBits = IndexFormat::chooseBucketBits(positions.size());
+    header.positionCount = positions.size();
+    header.moveCount = moves.size();
+    header.gameCount = gameCount;
+    header.positionsOffset = sizeof(Format::Header);
+    header.movesOffset = header.positionsOffset + positions.size() * sizeof(Format::PositionEntry);
+    header.bucketsOffset = header.movesOffset + moves.size() * sizeof(Format::MoveEntry);
+
+    std::vector<uint64_t> buckets((1ull << header.bucketBits) + 1, 0);
+    for (const Format::PositionEntry& position : positions)
+        buckets[IndexFormat::getBucket(position.key, header.bucketBits) + 1]++;
+    for (size_t bucket = 1; bucket < buckets.size(); bucket++)
+        buckets[bucket] += buckets[bucket - 1];
+    header.fileSize = header.bucketsOffset + buckets.size() * sizeof(uint64_t);
+
+    std::ofstream output(path, std::ios::binary | std::ios::trunc);
+    output.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    output.write(reinterpret_cast<const char*>(positions.data()), static_cast<std::streamsize>(positions.size() * sizeof(Format::PositionEntry)));
+    output.write(reinterpret_cast<const char*>(moves.data()), static_cast<std::streamsize>(moves.size() * sizeof(Format::MoveEntry)));
+    output.write(reinterpret_cast<const char*>(buckets.data()), static_cast<std::streamsize>(buckets.size() * sizeof(uint64_t)));
+    output.close();
+
+    positionCount = positions.size();
+    return !output.fail();
+}
+
+// --- OpeningExplorer ---
+
+bool OpeningExplorer::open(const std::string& path) {
+    close();
+    if (!file.open(path) || file.getSize() < sizeof(Format::Header)) {
+        close();
+        return false;
+    }
+    std::memcpy(&header, file.getData(), sizeof(header));
+
+    // Sections are contiguous, so each one must end exactly where the next begins
+    const bool isValid =
+        std::memcmp(header.magic, Format::MAGIC, sizeof(Format::MAGIC)) == 0 &&
+        header.version == Format::VERSION &&
+        header.bucketBits <= IndexFormat::MAX_BUCKET_BITS &&
+        header.fileSize == file.getSize() &&
+        header.positionCount <= UINT32_MAX &&
+        header.moveCount <= UINT32_MAX &&
+        header.positionsOffset == sizeof(Format::Header) &&
+        header.movesOffset == header.positionsOffset + header.positionCount * sizeof(Format::PositionEntry) &&
+        header.bucketsOffset == header.movesOffset + header.moveCount * sizeof(Format::MoveEntry) &&
+        header.fileSize == header.bucketsOffset + ((1ull << header.bucketBits) + 1) * sizeof(uint64_t);
+    if (!isValid) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+void OpeningExplorer::close() {
+    file.close();
+    header = {};
+}
+
+bool OpeningExplorer::lookup(const uint64_t positionKey, std::vector<ExplorerMove>& moves) const {
+    moves.clear();
+    if (!isOpen() || header.positionCount == 0)
+        return false;
+
+    const uint64_t bucket = IndexFormat::getBucket(positionKey, header.bucketBits);
+    uint64_t low = std::min(readBucket(bucket), header.positionCount);
+    uint64_t high = std::min(readBucket(bucket + 1), header.positionCount);
+    while (low < high) {
+        const uint64_t middle = low + (high - low) / 2;
+        if (readPosition(middle).key < positionKey)
+            low = middle + 1;
+        else
+            high = middle;
+    }
+    if (low >= header.positionCount)
+        return false;
+    const Format::PositionEntry position = readPosition(low);
+    if (position.key != positionKey || position.firstMove > header.moveCount || position.moveCount > header.moveCount - position.firstMove)
+        return false;
+
+    moves.reserve(position.moveCount);
+    for (uint32_t i = 0; i < position.moveCount; i++) {
+        Format::MoveEntry entry;
+        std::memcpy(&entry, file.getData() + header.movesOffset + (static_cast<uint64_t>(position.firstMove) + i) * sizeof(entry), sizeof(entry));
+
+        ExplorerMove move;
+        move.move = ChessMove::fromRaw(entry.move);
+        move.games = entry.games;
+        move.whiteWins = entry.whiteWins;
+        move.draws = entry.draws;
+        move.blackWins = entry.blackWins;
+        move.averageRating = entry.averageRating;
+        moves.push_back(move);
+    }
+    return true;
+}
+
+Format::PositionEntry OpeningExplorer::readPosition(const uint64_t index) const {
+    Format::PositionEntry entry;
+    std::memcpy(&entry, file.getData() + header.positionsOffset + index * sizeof(entry), sizeof(entry));
+    return entry;
+}
+
+uint64_t OpeningExplorer::readBucket(const uint64_t bucket) const {
+    uint64_t index;
+    std::memcpy(&index, file.getData() + header.bucketsOffset + bucket * sizeof(index), sizeof(index));
+    return index;
+}
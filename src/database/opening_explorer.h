@@ -0,0 +1,135 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "position_index.h"
+#include "../core/chess_move.h"
+#include "../core/memory_mapped_file.h"
+
+// Games, results and ratings of one move played from one position
+struct ExplorerMove {
+    ChessMove move;                         // Flagged as generated by Position (castling, en passant)
+    uint32_t games = 0;
+    uint32_t whiteWins = 0;
+    uint32_t draws = 0;
+    uint32_t blackWins = 0;                 // games - whiteWins - draws - blackWins had no result
+    uint16_t averageRating = 0;             // Mover's Elo; 0 if no game had one
+};
+
+// On-disk layout (little endian, all offsets from the start of the file)
+//
+//   header | positions | moves | buckets
+//
+// - positions: PositionEntry per position, ascending by key
+// - moves:     MoveEntry per (position, move), grouped by position, most played first
+// - buckets:   2^bucketBits + 1 position indices (same scheme as PositionIndexFormat)
+namespace OpeningExplorerFormat {
+    constexpr char MAGIC[8] = {'C', 'A', 'P', 'E', 'X', 'P', '0', '1'};
+    constexpr uint32_t VERSION = 1;
+
+    struct Header {
+        char magic[8];
+        uint32_t version;
+        uint32_t bucketBits;
+        uint64_t positionCount;
+        uint64_t moveCount;
+        uint64_t gameCount;                 // Games aggregated into the tree
+        uint64_t positionsOffset;
+        uint64_t movesOffset;
+        uint64_t bucketsOffset;
+        uint64_t fileSize;
+    };
+
+    struct PositionEntry {
+        uint64_t key;
+        uint32_t firstMove;                 // Index into the moves section
+        uint32_t moveCount;
+    };
+
+    struct MoveEntry {
+        uint32_t games;
+        uint32_t whiteWins;
+        uint32_t draws;
+        uint32_t blackWins;
+        uint16_t move;                      // ChessMove::getRaw()
+        uint16_t averageRating;
+    };
+
+    static_assert(sizeof(Header) == 72, "Explorer header layout changed");
+    static_assert(sizeof(PositionEntry) == 16, "Explorer position entry layout changed");
+    static_assert(sizeof(MoveEntry) == 20, "Explorer move entry layout changed");
+}
+
+/**
+ * In-memory opening tree: per position, per move, game and result counts
+ *
+ * Key features:
+ * - One tree per indexing thread, filled without locks while games are
+ *   replayed (map), then merged pairwise into one (reduce)
+ * - write() sorts positions by key and moves by popularity into the
+ *   OpeningExplorer file format
+ */
+class OpeningTree {
+public:
+    void add(const uint64_t positionKey, const ChessMove& move, const GameResult result, const int moverRating);
+    void merge(OpeningTree& other);         // Moves the other tree's counts into this one (other is left empty)
+    void addGames(const uint64_t games) { gameCount += games; }
+
+    size_t getMoveCount() const { return entries.size(); }
+    bool write(const std::string& path, uint64_t& positionCount) const;
+
+private:
+    struct MoveKey {
+        uint64_t positionKey;
+        uint16_t move;
+
+        bool operator==(const MoveKey& other) const { return positionKey == other.positionKey && move == other.move; }
+    };
+
+    struct MoveKeyHash {
+        size_t operator()(const MoveKey& key) const {
+            return static_cast<size_t>(key.positionKey ^ (static_cast<uint64_t>(key.move) * 0x9E3779B97F4A7C15ULL));
+        }
+    };
+
+    struct MoveCounts {
+        uint32_t games = 0;
+        uint32_t whiteWins = 0;
+        uint32_t draws = 0;
+        uint32_t blackWins = 0;
+        uint32_t ratedGames = 0;
+        uint64_t ratingSum = 0;
+    };
+
+    std::unordered_map<MoveKey, MoveCounts, MoveKeyHash> entries;
+    uint64_t gameCount = 0;
+};
+
+/**
+ * Read-only opening explorer (memory mapped OpeningTree)
+ *
+ * A lookup reads one bucket entry, binary searches the few positions in it
+ * and copies the position's moves: well under a millisecond, and only the
+ * touched pages are ever loaded from disk.
+ */
+class OpeningExplorer {
+public:
+    bool open(const std::string& path);
+    void close();
+    bool isOpen() const { return file.isOpen(); }
+
+    uint64_t getGameCount() const { return header.gameCount; }
+    uint64_t getPositionCount() const { return header.positionCount; }
+
+    // Moves played from the position, most played first; false if the position is not in the tree
+    bool lookup(const uint64_t positionKey, std::vector<ExplorerMove>& moves) const;
+
+private:
+    MemoryMappedFile file;
+    OpeningExplorerFormat::Header header{};
+
+    OpeningExplorerFormat::PositionEntry readPosition(const uint64_t index) const;
+    uint64_t readBucket(const uint64_t bucket) const;
+};
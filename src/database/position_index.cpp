@@ -0,0 +1,298 @@
+#include "position_index.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <iterator>
+#include "binary_io.h"
+
+namespace Format = PositionIndexFormat;
+using BinaryIO::readVarint;
+using BinaryIO::writeVarint;
+
+namespace {
+    constexpr size_t KEY_CHUNK_ENTRIES = 1 << 16;
+
+    // Tag values may not contain the field separator
+    void appendField(std::string& out, const std::string& value) {
+        for (const char c : value)
+            out += (c == '\t' || c == '\n' || c == '\r') ? ' ' : c;
+    }
+}
+
+// --- PositionIndex ---
+
+bool PositionIndex::open(const std::string& path) {
+    close();
+    if (!file.open(path) || file.getSize() < sizeof(Format::Header)) {
+        close();
+        return false;
+    }
+    std::memcpy(&header, file.getData(), sizeof(header));
+
+    const uint64_t size = file.getSize();
+    const bool isValid =
+        std::memcmp(header.magic, Format::MAGIC, sizeof(Format::MAGIC)) == 0 &&
+        header.version == Format::VERSION &&
+        header.bucketBits <= Format::MAX_BUCKET_BITS &&
+        header.fileSize == size &&
+        header.gameCount <= UINT32_MAX &&
+        header.postingsOffset == sizeof(Format::Header) &&
+        header.postingsOffset <= header.stringsOffset &&
+        header.stringsOffset <= header.gamesOffset &&
+        isSectionValid(header.gamesOffset, header.gameCount, sizeof(Format::GameEntry), header.keysOffset) &&
+        isSectionValid(header.keysOffset, header.keyCount, sizeof(Format::KeyEntry), header.bucketsOffset) &&
+        isSectionValid(header.bucketsOffset, (1ull << header.bucketBits) + 1, sizeof(uint64_t), size);
+    if (!isValid) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+void PositionIndex::close() {
+    file.close();
+    header = {};
+}
+
+uint64_t PositionIndex::lookup(const uint64_t key, std::vector<PositionHit>& hits, const size_t maxHits) const {
+    hits.clear();
+    if (!isOpen() || header.keyCount == 0)
+        return 0;
+
+    // The bucket directory narrows the search to about KEYS_PER_BUCKET keys
+    const uint64_t bucket = Format::getBucket(key, header.bucketBits);
+    uint64_t low = std::min(readBucket(bucket), header.keyCount);
+    uint64_t high = std::min(readBucket(bucket + 1), header.keyCount);
+    while (low < high) {
+        const uint64_t middle = low + (high - low) / 2;
+        if (getKeyAt(middle) < key)
+            low = middle + 1;
+        else
+            high = middle;
+    }
+    if (low >= header.keyCount || getKeyAt(low) != key)
+        return 0;
+    return getPostings(low, hits, maxHits);
+}
+
+IndexedGame PositionIndex::getGame(const uint32_t gameId) const {
+    IndexedGame game;
+    if (!isOpen() || gameId >= header.gameCount)
+        return game;
+
+    Format::GameEntry entry;
+    std::memcpy(&entry, file.getData() + header.gamesOffset + gameId * sizeof(entry), sizeof(entry));
+    const uint64_t stringsSize = header.gamesOffset - header.stringsOffset;
+    if (entry.stringOffset > stringsSize || entry.stringLength > stringsSize - entry.stringOffset)
+        return game;
+    if (entry.result <= static_cast<uint8_t>(GameResult::Draw))
+        game.result = static_cast<GameResult>(entry.result);
+
+    // "white\tblack\tevent\tdate"
+    const char* text = reinterpret_cast<const char*>(file.getData() + header.stringsOffset + entry.stringOffset);
+    std::string* fields[] = {&game.white, &game.black, &game.event, &game.date};
+    size_t field = 0;
+    for (uint32_t i = 0; i < entry.stringLength; i++) {
+        if (text[i] == '\t') {
+            if (++field == std::size(fields))
+                break;
+        } else {
+            *fields[field] += text[i];
+        }
+    }
+    return game;
+}
+
+uint64_t PositionIndex::getKeyAt(const uint64_t keyIndex) const {
+    return readKeyEntry(keyIndex).key;
+}
+
+uint64_t PositionIndex::getPostings(const uint64_t keyIndex, std::vector<PositionHit>& hits, const size_t maxHits) const {
+    hits.clear();
+    if (!isOpen() || keyIndex >= header.keyCount)
+        return 0;
+
+    const Format::KeyEntry entry = readKeyEntry(keyIndex);
+    if (entry.postingsOffset >= header.stringsOffset - header.postingsOffset)
+        return 0;
+    const uint8_t* cursor = file.getData() + header.postingsOffset + entry.postingsOffset;
+    const uint8_t* end = file.getData() + header.stringsOffset;
+
+    uint64_t count = 0;
+    if (!readVarint(cursor, end, count))
+        return 0;
+    hits.reserve(static_cast<size_t>(std::min<uint64_t>(count, maxHits)));
+
+    // Game ids are stored as deltas from the previous game
+    uint64_t gameId = 0;
+    for (uint64_t i = 0; i < count && hits.size() < maxHits; i++) {
+        uint64_t delta = 0;
+        uint64_t ply = 0;
+        if (!readVarint(cursor, end, delta) || !readVarint(cursor, end, ply))
+            break;
+        gameId += delta;
+        hits.push_back({
+            static_cast<uint32_t>(gameId),
+            static_cast<uint16_t>(std::min<uint64_t>(ply, UINT16_MAX))
+        });
+    }
+    return count;
+}
+
+Format::KeyEntry PositionIndex::readKeyEntry(const uint64_t keyIndex) const {
+    Format::KeyEntry entry;
+    std::memcpy(&entry, file.getData() + header.keysOffset + keyIndex * sizeof(entry), sizeof(entry));
+    return entry;
+}
+
+uint64_t PositionIndex::readBucket(const uint64_t bucket) const {
+    uint64_t keyIndex;
+    std::memcpy(&keyIndex, file.getData() + header.bucketsOffset + bucket * sizeof(keyIndex), sizeof(keyIndex));
+    return keyIndex;
+}
+
+bool PositionIndex::isSectionValid(const uint64_t offset, const uint64_t count, const uint64_t entrySize, const uint64_t end) const {
+    // The section fills [offset, end) exactly
+    return offset <= end && (end - offset) % entrySize == 0 && (end - offset) / entrySize == count;
+}
+
+// --- PositionIndexWriter ---
+
+PositionIndexWriter::~PositionIndexWriter() {
+    // Unfinished: the partial output is useless
+    if (output.is_open()) {
+        output.close();
+        keysFile.close();
+        gamesFile.close();
+        stringsFile.close();
+        removeTempFiles();
+        std::remove(path.c_str());
+    }
+}
+
+bool PositionIndexWriter::open(const std::string& path) {
+    this->path = path;
+    header = {};
+    std::memcpy(header.magic, Format::MAGIC, sizeof(Format::MAGIC));
+    header.version = Format::VERSION;
+    header.postingsOffset = sizeof(Format::Header);
+    postingsSize = 0;
+    stringsSize = 0;
+    lastKey = 0;
+
+    output.open(path, std::ios::binary | std::ios::trunc);
+    keysFile.open(getTempPath(".keys.tmp"), std::ios::binary | std::ios::trunc);
+    gamesFile.open(getTempPath(".games.tmp"), std::ios::binary | std::ios::trunc);
+    stringsFile.open(getTempPath(".strings.tmp"), std::ios::binary | std::ios::trunc);
+
+    // Placeholder until finish() knows the section offsets
+    output.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    return output.good() && keysFile.good() && gamesFile.good() && stringsFile.good();
+}
+
+void PositionIndexWriter::addGame(const IndexedGame& game) {
+    std::string text;
+    appendField(text, game.white);
+    text += '\t';
+    appendField(text, game.black);
+    text += '\t';
+    appendField(text, game.event);
+    text += '\t';
+    appendField(text, game.date);
+
+    Format::GameEntry entry{};
+    entry.stringOffset = stringsSize;
+    entry.stringLength = static_cast<uint32_t>(text.size());
+    entry.result = static_cast<uint8_t>(game.result);
+    gamesFile.write(reinterpret_cast<const char*>(&entry), sizeof(entry));
+    stringsFile.write(text.data(), static_cast<std::streamsize>(text.size()));
+    stringsSize += text.size();
+    header.gameCount++;
+}
+
+void PositionIndexWriter::addPostings(const uint64_t key, const std::vector<PositionHit>& hits) {
+    // Out-of-order keys would break the binary search; callers merge sorted runs
+    if (hits.empty() || (header.keyCount > 0 && key <= lastKey))
+        return;
+
+    encodeBuffer.clear();
+    writeVarint(encodeBuffer, hits.size());
+    uint32_t previousGame = 0;
+    for (const PositionHit& hit : hits) {
+        writeVarint(encodeBuffer, hit.gameId - previousGame);
+        writeVarint(encodeBuffer, hit.ply);
+        previousGame = hit.gameId;
+    }
+
+    const Format::KeyEntry entry{key, postingsSize};
+    keysFile.write(reinterpret_cast<const char*>(&entry), sizeof(entry));
+    output.write(reinterpret_cast<const char*>(encodeBuffer.data()), static_cast<std::streamsize>(encodeBuffer.size()));
+    postingsSize += encodeBuffer.size();
+    header.keyCount++;
+    header.postingCount += hits.size();
+    lastKey = key;
+}
+
+bool PositionIndexWriter::finish() {
+    keysFile.close();
+    gamesFile.close();
+    stringsFile.close();
+
+    header.stringsOffset = header.postingsOffset + postingsSize;
+    header.gamesOffset = header.stringsOffset + stringsSize;
+    header.keysOffset = header.gamesOffset + header.gameCount * sizeof(Format::GameEntry);
+    bool isWritten =
+        BinaryIO::appendFile(output, getTempPath(".strings.tmp")) &&
+        BinaryIO::appendFile(output, getTempPath(".games.tmp")) &&
+        appendKeysAndBuckets();
+
+    // Final header
+    header.fileSize = static_cast<uint64_t>(output.tellp());
+    output.seekp(0);
+    output.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    output.close();
+    isWritten = isWritten && !output.fail();
+
+    removeTempFiles();
+    if (!isWritten)
+        std::remove(path.c_str());
+    return isWritten;
+}
+
+std::string PositionIndexWriter::getTempPath(const char* suffix) const {
+    return path + suffix;
+}
+
+void PositionIndexWriter::removeTempFiles() const {
+    std::remove(getTempPath(".keys.tmp").c_str());
+    std::remove(getTempPath(".games.tmp").c_str());
+    std::remove(getTempPath(".strings.tmp").c_str());
+}
+
+bool PositionIndexWriter::appendKeysAndBuckets() {
+    std::ifstream input(getTempPath(".keys.tmp"), std::ios::binary);
+    if (!input.is_open())
+        return false;
+
+    // Keys arrive sorted, so counting per bucket and a prefix sum give each bucket's first key
+    header.bucketBits = Format::chooseBucketBits(header.keyCount);
+    std::vector<uint64_t> buckets((1ull << header.bucketBits) + 1, 0);
+    std::vector<Format::KeyEntry> chunk(KEY_CHUNK_ENTRIES);
+    uint64_t copied = 0;
+    while (copied < header.keyCount) {
+        const uint64_t entries = std::min<uint64_t>(chunk.size(), header.keyCount - copied);
+        input.read(reinterpret_cast<char*>(chunk.data()), static_cast<std::streamsize>(entries * sizeof(Format::KeyEntry)));
+        if (!input)
+            return false;
+        for (uint64_t i = 0; i < entries; i++)
+            buckets[Format::getBucket(chunk[i].key, header.bucketBits) + 1]++;
+        output.write(reinterpret_cast<const char*>(chunk.data()), static_cast<std::streamsize>(entries * sizeof(Format::KeyEntry)));
+        copied += entries;
+    }
+    for (size_t bucket = 1; bucket < buckets.size(); bucket++)
+        buckets[bucket] += buckets[bucket - 1];
+
+    header.bucketsOffset = header.keysOffset + header.keyCount * sizeof(Format::KeyEntry);
+    output.write(reinterpret_cast<const char*>(buckets.data()), static_cast<std::streamsize>(buckets.size() * sizeof(uint64_t)));
+    return !output.fail();
+}
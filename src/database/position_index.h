@@ -0,0 +1,187 @@
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "../core/memory_mapped_file.h"
+
+enum class GameResult : uint8_t {
+    Unknown = 0,
+    WhiteWins,
+    BlackWins,
+    Draw
+};
+
+// PGN result token ("1-0", "0-1", "1/2-1/2"); anything else is Unknown
+inline GameResult parseGameResult(const std::string_view result) {
+    if (result == "1-0")
+        return GameResult::WhiteWins;
+    if (result == "0-1")
+        return GameResult::BlackWins;
+    if (result == "1/2-1/2")
+        return GameResult::Draw;
+    return GameResult::Unknown;
+}
+
+// A game containing a position, and the first ply at which it was reached
+struct PositionHit {
+    uint32_t gameId = 0;
+    uint16_t ply = 0;                       // 0 = the game's starting position
+};
+
+// Header data of an indexed game
+struct IndexedGame {
+    std::string white;
+    std::string black;
+    std::string event;
+    std::string date;
+    GameResult result = GameResult::Unknown;
+};
+
+// On-disk layout (little endian, all offsets from the start of the file)
+//
+//   header | postings | strings | games | keys | buckets
+//
+// - postings: per key, varint game count then (varint game id delta, varint ply)
+//   per game; game ids ascending
+// - strings:  "white\tblack\tevent\tdate" per game, not terminated
+// - games:    GameEntry per game id
+// - keys:     KeyEntry per distinct position key, ascending by key
+// - buckets:  2^bucketBits + 1 key indices; keys whose top bucketBits bits
+//   equal b are at [buckets[b], buckets[b + 1])
+namespace PositionIndexFormat {
+    constexpr char MAGIC[8] = {'C', 'A', 'P', 'I', 'D', 'X', '0', '1'};
+    constexpr uint32_t VERSION = 1;
+    constexpr uint32_t MAX_BUCKET_BITS = 24;
+    constexpr uint64_t KEYS_PER_BUCKET = 16;
+
+    // Bucket of a key: its top bucketBits bits
+    inline uint64_t getBucket(const uint64_t key, const uint32_t bucketBits) {
+        return
+            (bucketBits == 0) ?
+            0 :
+            key >> (64 - bucketBits);
+    }
+
+    // Smallest directory averaging at most KEYS_PER_BUCKET keys per bucket
+    inline uint32_t chooseBucketBits(const uint64_t keyCount) {
+        uint32_t bits = 0;
+        while (bits < MAX_BUCKET_BITS && (KEYS_PER_BUCKET << bits) < keyCount)
+            bits++;
+        return bits;
+    }
+
+    struct Header {
+        char magic[8];
+        uint32_t version;
+        uint32_t bucketBits;
+        uint64_t gameCount;
+        uint64_t keyCount;
+        uint64_t postingCount;              // (key, game) pairs
+        uint64_t postingsOffset;
+        uint64_t stringsOffset;
+        uint64_t gamesOffset;
+        uint64_t keysOffset;
+        uint64_t bucketsOffset;
+        uint64_t fileSize;
+    };
+
+    struct GameEntry {
+        uint64_t stringOffset;              // Relative to the strings section
+        uint32_t stringLength;
+        uint8_t result;                     // GameResult
+        uint8_t reserved[3];
+    };
+
+    struct KeyEntry {
+        uint64_t key;
+        uint64_t postingsOffset;            // Relative to the postings section
+    };
+
+    static_assert(sizeof(Header) == 88, "Index header layout changed");
+    static_assert(sizeof(GameEntry) == 16, "Index game entry layout changed");
+    static_assert(sizeof(KeyEntry) == 16, "Index key entry layout changed");
+}
+
+/**
+ * Read-only position index over a game database (position key -> games)
+ *
+ * Key features:
+ * - Memory mapped: opening is instant, and a lookup touches one bucket entry,
+ *   a handful of key entries (binary search inside the bucket) and the
+ *   position's posting list
+ * - Keys are Position::getKey() Zobrist hashes, so transpositions from
+ *   different move orders find the same games
+ * - Posting lists are delta and varint compressed (a few bytes per game)
+ * - Every section is bounds checked on open; a truncated or foreign file
+ *   fails to open instead of being read out of bounds
+ */
+class PositionIndex {
+public:
+    bool open(const std::string& path);
+    void close();
+    bool isOpen() const { return file.isOpen(); }
+
+    uint64_t getGameCount() const { return header.gameCount; }
+    uint64_t getKeyCount() const { return header.keyCount; }
+    uint64_t getPostingCount() const { return header.postingCount; }
+
+    // Games reaching the position (up to maxHits, by game id); returns the total number of games
+    uint64_t lookup(const uint64_t key, std::vector<PositionHit>& hits, const size_t maxHits) const;
+
+    // Game headers by id (empty fields for an out-of-range id)
+    IndexedGame getGame(const uint32_t gameId) const;
+
+    // Sequential access by key index (merging indexes)
+    uint64_t getKeyAt(const uint64_t keyIndex) const;
+    uint64_t getPostings(const uint64_t keyIndex, std::vector<PositionHit>& hits, const size_t maxHits) const;
+
+private:
+    MemoryMappedFile file;
+    PositionIndexFormat::Header header{};
+
+    PositionIndexFormat::KeyEntry readKeyEntry(const uint64_t keyIndex) const;
+    uint64_t readBucket(const uint64_t bucket) const;
+    bool isSectionValid(const uint64_t offset, const uint64_t count, const uint64_t entrySize, const uint64_t end) const;
+};
+
+/**
+ * Streaming writer of PositionIndex files
+ *
+ * Posting lists are written straight to the output in key order; key entries,
+ * game entries and strings go to temporary files next to the output, so memory
+ * use does not grow with the database. finish() appends those sections, builds
+ * the bucket directory and writes the final header.
+ */
+class PositionIndexWriter {
+public:
+    ~PositionIndexWriter();
+
+    bool open(const std::string& path);
+
+    // Games in id order (the first is game 0)
+    void addGame(const IndexedGame& game);
+
+    // Keys strictly ascending; hits by ascending game id, one per game
+    void addPostings(const uint64_t key, const std::vector<PositionHit>& hits);
+
+    bool finish();
+
+private:
+    std::string path;
+    std::ofstream output;
+    std::ofstream keysFile;
+    std::ofstream gamesFile;
+    std::ofstream stringsFile;
+    PositionIndexFormat::Header header{};
+    uint64_t postingsSize = 0;
+    uint64_t stringsSize = 0;
+    uint64_t lastKey = 0;
+    std::vector<uint8_t> encodeBuffer;                  // Reused posting list encoding
+
+    std::string getTempPath(const char* suffix) const;
+    void removeTempFiles() const;
+    bool appendKeysAndBuckets();
+};
@@ -0,0 +1,482 @@
+#include "position_index_builder.h"
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <queue>
+#include <thread>
+#include <utility>
+#include "../config/config.h"
+#include "../core/pgn_reader.h"
+#include "../core/position.h"
+#include "../core/san_parser.h"
+
+namespace DatabaseCfg = Config::Database;
+
+namespace {
+    constexpr size_t RUN_BUFFER_ENTRIES = 1 << 14; // Postings read ahead per run while merging
+    constexpr size_t MIN_RUN_CAPACITY = 1 << 16;
+
+    double getSecondsSince(const std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+}
+
+PositionIndexBuilder::PositionIndexBuilder(const int threads) :
+    threadCount(threads) {
+
+    if (threadCount <= 0)
+        threadCount = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+}
+
+bool PositionIndexBuilder::build(const std::vector<std::string>& gamePaths, const std::string& outputPath, IndexBuildStats& stats) {
+    const auto startTime = std::chrono::steady_clock::now();
+    stats = IndexBuildStats{};
+    error.clear();
+    runPaths.clear();
+    queue.clear();
+    isReadingDone = false;
+    positionCount = 0;
+    truncatedCount = 0;
+    hasFailed = false;
+    runPrefix = outputPath + ".run";
+    openingTrees.clear();
+    openingTrees.resize(threadCount);
+
+    // The memory budget is split between the workers
+    const size_t budget = static_cast<size_t>(DatabaseCfg::BUILD_MEMORY_MB) * 1024 * 1024;
+    runCapacity = std::max(MIN_RUN_CAPACITY, budget / sizeof(Posting) / threadCount);
+
+    PositionIndexWriter writer;
+    if (!writer.open(outputPath)) {
+        error = "Cannot write " + outputPath;
+        return false;
+    }
+
+    std::vector<std::thread> workers;
+    for (int i = 0; i < threadCount; i++)
+        workers.emplace_back(&PositionIndexBuilder::workerLoop, this, static_cast<size_t>(i));
+
+    uint64_t gameCount = 0;
+    const bool isRead = readGames(gamePaths, writer, gameCount);
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        isReadingDone = true;
+    }
+    queueNotEmpty.notify_all();
+    for (std::thread& worker : workers)
+        worker.join();
+
+    stats.games = gameCount;
+    stats.positions = positionCount;
+    stats.truncatedGames = truncatedCount;
+    stats.runs = runPaths.size();
+    if (hasFailed && error.empty())
+        error = "Cannot write sorted runs next to " + outputPath;
+
+    const bool isBuilt =
+        isRead &&
+        !hasFailed &&
+        mergeRuns(writer, stats) &&
+        writer.finish() &&
+        writeExplorer(stats);
+    if (!isBuilt && error.empty())
+        error = "Cannot write " + outputPath;
+
+    removeRuns();
+    openingTrees.clear();
+    stats.seconds = getSecondsSince(startTime);
+    return isBuilt;
+}
+
+bool PositionIndexBuilder::merge(const std::vector<std::string>& indexPaths, const std::string& outputPath, IndexBuildStats& stats) {
+    const auto startTime = std::chrono::steady_clock::now();
+    stats = IndexBuildStats{};
+    error.clear();
+
+    // Game ids of each input are shifted past the games of the inputs before it
+    std::vector<std::unique_ptr<PositionIndex>> indexes;
+    std::vector<uint32_t> gameOffsets;
+    uint64_t gameCount = 0;
+    for (const std::string& path : indexPaths) {
+        auto index = std::make_unique<PositionIndex>();
+        if (path == outputPath || !index->open(path)) {
+            error = "Cannot open index " + path;
+            return false;
+        }
+        gameOffsets.push_back(static_cast<uint32_t>(gameCount));
+        gameCount += index->getGameCount();
+        if (gameCount > UINT32_MAX) {
+            error = "Too many games for one index";
+            return false;
+        }
+        indexes.push_back(std::move(index));
+    }
+
+    PositionIndexWriter writer;
+    if (!writer.open(outputPath)) {
+        error = "Cannot write " + outputPath;
+        return false;
+    }
+    for (const auto& index : indexes) {
+        for (uint32_t gameId = 0; gameId < index->getGameCount(); gameId++)
+            writer.addGame(index->getGame(gameId));
+    }
+
+    // k-way merge of the key tables; equal keys pop in input order, so game ids stay ascending
+    using KeyCursor = std::pair<uint64_t, size_t>;
+    std::priority_queue<KeyCursor, std::vector<KeyCursor>, std::greater<KeyCursor>> heap;
+    std::vector<uint64_t> keyIndices(indexes.size(), 0);
+    for (size_t input = 0; input < indexes.size(); input++) {
+        if (indexes[input]->getKeyCount() > 0)
+            heap.push({indexes[input]->getKeyAt(0), input});
+    }
+
+    std::vector<PositionHit> hits;
+    std::vector<PositionHit> inputHits;
+    while (!heap.empty()) {
+        const uint64_t key = heap.top().first;
+        hits.clear();
+        while (!heap.empty() && heap.top().first == key) {
+            const size_t input = heap.top().second;
+            heap.pop();
+            indexes[input]->getPostings(keyIndices[input], inputHits, SIZE_MAX);
+            for (const PositionHit& hit : inputHits)
+                hits.push_back({hit.gameId + gameOffsets[input], hit.ply});
+            if (++keyIndices[input] < indexes[input]->getKeyCount())
+                heap.push({indexes[input]->getKeyAt(keyIndices[input]), input});
+        }
+        writer.addPostings(key, hits);
+        stats.keys++;
+        stats.postings += hits.size();
+    }
+
+    stats.games = gameCount;
+    if (!writer.finish()) {
+        error = "Cannot write " + outputPath;
+        return false;
+    }
+    stats.seconds = getSecondsSince(startTime);
+    return true;
+}
+
+bool PositionIndexBuilder::readGames(const std::vector<std::string>& gamePaths, PositionIndexWriter& writer, uint64_t& gameCount) {
+    GameBatch batch;
+    for (const std::string& path : gamePaths) {
+        // Anything that is not a valid archive is read as PGN
+        GameArchive archive;
+        const bool isRead =
+            archive.open(path) ?
+            readArchive(path, archive, writer, gameCount, batch) :
+            readPGN(path, writer, gameCount, batch);
+        if (!isRead)
+            return false;
+    }
+    if (!batch.empty())
+        pushBatch(std::move(batch));
+    return true;
+}
+
+bool PositionIndexBuilder::readPGN(const std::string& path, PositionIndexWriter& writer, uint64_t& gameCount, GameBatch& batch) {
+    PGNReader reader(path);
+    if (!reader.isOpen()) {
+        error = "Cannot open " + path;
+        return false;
+    }
+
+    PGNGame game;
+    while (reader.next(game)) {
+        const GameResult result = parseGameResult(
+            game.result.empty() ?
+            game.getTag("Result") :
+            std::string_view(game.result));
+        GameRecord record;
+        record.moves = std::move(game.moves);
+        if (!queueGame(game, result, std::move(record), writer, gameCount, batch))
+            return false;
+    }
+    return true;
+}
+
+bool PositionIndexBuilder::readArchive(const std::string& path, const GameArchive& archive, PositionIndexWriter& writer, uint64_t& gameCount, GameBatch& batch) {
+    ArchivedGame game;
+    for (uint64_t index = 0; index < archive.getGameCount(); index++) {
+        if (!archive.getGame(index, game)) {
+            error = "Damaged game " + std::to_string(index) + " in " + path;
+            return false;
+        }
+
+        // Codes are copied: the batch outlives this archive's mapping
+        GameRecord record;
+        record.moveCodes.assign(game.moveCodes.data(), game.moveCodes.size());
+        record.isTruncated = game.isTruncated;
+        if (!queueGame(game, game.result, std::move(record), writer, gameCount, batch))
+            return false;
+    }
+    return true;
+}
+
+template <typename Game>
+bool PositionIndexBuilder::queueGame(const Game& game, const GameResult result, GameRecord&& record, PositionIndexWriter& writer, uint64_t& gameCount, GameBatch& batch) {
+    if (hasFailed)
+        return false;
+    if (gameCount >= UINT32_MAX) {
+        error = "Too many games for one index (build several and merge them)";
+        return false;
+    }
+
+    // Headers are written here, in game id order; workers only produce postings
+    writer.addGame(toIndexedGame(game, result));
+    record.gameId = static_cast<uint32_t>(gameCount++);
+    record.startFen = game.getTag("FEN");
+    record.result = result;
+    record.whiteRating = parseRating(game.getTag("WhiteElo"));
+    record.blackRating = parseRating(game.getTag("BlackElo"));
+    batch.push_back(std::move(record));
+
+    if (batch.size() >= static_cast<size_t>(DatabaseCfg::GAMES_PER_BATCH)) {
+        pushBatch(std::move(batch));
+        batch = GameBatch{};
+    }
+    return true;
+}
+
+void PositionIndexBuilder::pushBatch(GameBatch&& batch) {
+    const size_t maxQueued = static_cast<size_t>(threadCount) * DatabaseCfg::QUEUED_BATCHES_PER_THREAD;
+    {
+        std::unique_lock<std::mutex> lock(queueMutex);
+        queueNotFull.wait(lock, [&] { return queue.size() < maxQueued || hasFailed; });
+        queue.push_back(std::move(batch));
+    }
+    queueNotEmpty.notify_one();
+}
+
+void PositionIndexBuilder::workerLoop(const size_t workerIndex) {
+    Position position;
+    std::vector<Posting> postings;
+    postings.reserve(runCapacity);
+
+    while (true) {
+        GameBatch batch;
+        {
+            std::unique_lock<std::mutex> lock(queueMutex);
+            queueNotEmpty.wait(lock, [&] { return !queue.empty() || isReadingDone; });
+            if (queue.empty())
+                break;
+            batch = std::move(queue.front());
+            queue.pop_front();
+        }
+        queueNotFull.notify_one();
+
+        for (const GameRecord& game : batch)
+            replayGame(game, position, postings, openingTrees[workerIndex]);
+
+        if (postings.size() >= runCapacity && !spillRun(postings))
+            break;
+    }
+
+    if (!postings.empty())
+        spillRun(postings);
+}
+
+void PositionIndexBuilder::replayGame(const GameRecord& game, Position& position, std::vector<Posting>& postings, OpeningTree& openingTree) {
+    if (game.startFen.empty()) {
+        position.setStartingPosition();
+    } else if (!position.setFromFEN(game.startFen)) {
+        truncatedCount++;
+        return;
+    }
+
+    postings.push_back({position.getKey(), game.gameId, 0, 0});
+    openingTree.addGames(1);
+    const bool isArchived = !game.moveCodes.empty();
+    const size_t moveCount =
+        isArchived ?
+        game.moveCodes.size() :
+        game.moves.size();
+    uint64_t plies = 0;
+    PositionUndo undo;
+    MoveList legalMoves;
+    for (size_t i = 0; i < moveCount; i++) {
+        const ChessMove move =
+            isArchived ?
+            GameArchiveFormat::decodeMove(position, static_cast<uint8_t>(game.moveCodes[i]), legalMoves) :
+            SANParser::parse(position, game.moves[i]);
+        if (move.isNull())
+            break;
+        if (!explorerPath.empty() && plies < static_cast<uint64_t>(DatabaseCfg::EXPLORER_MAX_PLY)) {
+            const int moverRating =
+                (position.getSideToMove() == PieceColor::White) ?
+                game.whiteRating :
+                game.blackRating;
+            openingTree.add(position.getKey(), move, game.result, moverRating);
+        }
+        position.makeMove(move, undo);
+        plies++;
+        const uint16_t ply = static_cast<uint16_t>(std::min<uint64_t>(plies, UINT16_MAX));
+        postings.push_back({position.getKey(), game.gameId, ply, 0});
+    }
+    if (plies < moveCount || game.isTruncated)
+        truncatedCount++;
+    positionCount += plies + 1;
+}
+
+bool PositionIndexBuilder::spillRun(std::vector<Posting>& postings) {
+    // Repeats of a position within a game keep the first ply (sorted by ply within a game)
+    std::sort(postings.begin(), postings.end(), isPostingLess);
+    postings.erase(
+        std::unique(postings.begin(), postings.end(), [](const Posting& a, const Posting& b) {
+            return a.key == b.key && a.gameId == b.gameId;
+        }),
+        postings.end());
+
+    std::string path;
+    {
+        std::lock_guard<std::mutex> lock(runMutex);
+        path = runPrefix + std::to_string(runPaths.size()) + ".tmp";
+        runPaths.push_back(path);
+    }
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char*>(postings.data()), static_cast<std::streamsize>(postings.size() * sizeof(Posting)));
+    file.close();
+    postings.clear();
+    if (!file.fail())
+        return true;
+
+    // Stop the reader too (it may be waiting for queue space)
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        hasFailed = true;
+    }
+    queueNotFull.notify_all();
+    return false;
+}
+
+bool PositionIndexBuilder::mergeRuns(PositionIndexWriter& writer, IndexBuildStats& stats) {
+    struct RunCursor {
+        std::ifstream file;
+        std::vector<Posting> buffer;
+        size_t next = 0;
+        size_t count = 0;
+    };
+
+    auto readPosting = [](RunCursor& run, Posting& posting) {
+        if (run.next == run.count) {
+            run.file.read(reinterpret_cast<char*>(run.buffer.data()), static_cast<std::streamsize>(run.buffer.size() * sizeof(Posting)));
+            run.count = static_cast<size_t>(run.file.gcount()) / sizeof(Posting);
+            run.next = 0;
+            if (run.count == 0)
+                return false;
+        }
+        posting = run.buffer[run.next++];
+        return true;
+    };
+
+    std::vector<RunCursor> runs(runPaths.size());
+    using RunHead = std::pair<Posting, size_t>;
+    auto isLater = [](const RunHead& a, const RunHead& b) { return isPostingLess(b.first, a.first); };
+    std::priority_queue<RunHead, std::vector<RunHead>, decltype(isLater)> heap(isLater);
+    for (size_t i = 0; i < runs.size(); i++) {
+        runs[i].file.open(runPaths[i], std::ios::binary);
+        runs[i].buffer.resize(RUN_BUFFER_ENTRIES);
+        if (!runs[i].file.is_open()) {
+            error = "Cannot read sorted run " + runPaths[i];
+            return false;
+        }
+        Posting posting;
+        if (readPosting(runs[i], posting))
+            heap.push({posting, i});
+    }
+
+    // Postings arrive by key, then game, then ply; one posting list per key
+    std::vector<PositionHit> hits;
+    uint64_t currentKey = 0;
+    auto flushKey = [&]() {
+        writer.addPostings(currentKey, hits);
+        stats.keys++;
+        stats.postings += hits.size();
+        hits.clear();
+    };
+    while (!heap.empty()) {
+        const RunHead head = heap.top();
+        heap.pop();
+        Posting posting;
+        if (readPosting(runs[head.second], posting))
+            heap.push({posting, head.second});
+
+        if (!hits.empty() && head.first.key != currentKey)
+            flushKey();
+        currentKey = head.first.key;
+        if (hits.empty() || hits.back().gameId != head.first.gameId)
+            hits.push_back({head.first.gameId, head.first.ply});
+    }
+    if (!hits.empty())
+        flushKey();
+
+    for (size_t i = 0; i < runs.size(); i++) {
+        if (runs[i].file.bad()) {
+            error = "Cannot read sorted run " + runPaths[i];
+            return false;
+        }
+    }
+    return true;
+}
+
+void PositionIndexBuilder::removeRuns() {
+    for (const std::string& path : runPaths)
+        std::remove(path.c_str());
+    runPaths.clear();
+}
+
+bool PositionIndexBuilder::writeExplorer(IndexBuildStats& stats) {
+    if (explorerPath.empty())
+        return true;
+
+    // Reduce: merge the worker trees pairwise, each round's merges in parallel
+    for (size_t stride = 1; stride < openingTrees.size(); stride *= 2) {
+        std::vector<std::thread> mergers;
+        for (size_t i = 0; i + stride < openingTrees.size(); i += 2 * stride)
+            mergers.emplace_back([this, i, stride] { openingTrees[i].merge(openingTrees[i + stride]); });
+        for (std::thread& merger : mergers)
+            merger.join();
+    }
+
+    stats.explorerMoves = openingTrees.front().getMoveCount();
+    if (!openingTrees.front().write(explorerPath, stats.explorerPositions)) {
+        error = "Cannot write " + explorerPath;
+        return false;
+    }
+    return true;
+}
+
+template <typename Game>
+IndexedGame PositionIndexBuilder::toIndexedGame(const Game& game, const GameResult result) {
+    IndexedGame indexed;
+    indexed.white = game.getTag("White");
+    indexed.black = game.getTag("Black");
+    indexed.event = game.getTag("Event");
+    indexed.date = game.getTag("Date");
+    indexed.result = result;
+    return indexed;
+}
+
+int PositionIndexBuilder::parseRating(std::string_view rating) {
+    // "?" or "-" for unknown ratings
+    int value = 0;
+    const auto [end, error] = std::from_chars(rating.data(), rating.data() + rating.size(), value);
+    return
+        (error == std::errc() && value > 0) ?
+        value :
+        0;
+}
+
+bool PositionIndexBuilder::isPostingLess(const Posting& a, const Posting& b) {
+    if (a.key != b.key)
+        return a.key < b.key;
+    if (a.gameId != b.gameId)
+        return a.gameId < b.gameId;
+    return a.ply < b.ply;
+}
@@ -0,0 +1,121 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "game_archive.h"
+#include "opening_explorer.h"
+#include "position_index.h"
+
+class Position;
+
+struct IndexBuildStats {
+    uint64_t games = 0;
+    uint64_t positions = 0;                 // Plies replayed, starting positions included
+    uint64_t keys = 0;                      // Distinct positions in the index
+    uint64_t postings = 0;                  // (position, game) pairs after removing repeats
+    uint64_t truncatedGames = 0;            // Replay stopped at an illegal or unreadable move
+    uint64_t runs = 0;                      // Sorted runs spilled to disk
+    uint64_t explorerPositions = 0;         // Opening tree positions (0 without an explorer output)
+    uint64_t explorerMoves = 0;             // Opening tree (position, move) entries
+    double seconds = 0.0;
+};
+
+/**
+ * Builds PositionIndex files from PGN databases, or merges existing indexes
+ *
+ * Key features:
+ * - The calling thread reads the PGN files (or GameArchive files, whose
+ *   moves workers decode without SAN parsing) and numbers the games; worker
+ *   threads replay batches of games and emit (key, game, ply) postings
+ * - A bounded batch queue keeps the reader at most a few batches ahead, and
+ *   each worker sorts and spills its postings to a run file once its share
+ *   of Config::Database::BUILD_MEMORY_MB is full, so corpora far larger
+ *   than memory index in a single pass
+ * - A k-way merge of the runs streams posting lists into PositionIndexWriter
+ *   in key order; a game reaching a position more than once keeps its first ply
+ * - Optionally aggregates an opening tree in the same pass: each worker
+ *   counts moves, results and ratings of the first Config::Database::EXPLORER_MAX_PLY
+ *   plies in its own OpeningTree (map), and the trees are merged pairwise
+ *   in parallel once the workers finish (reduce)
+ * - merge() combines indexes built separately (e.g. one per PGN file or per
+ *   machine); game ids of each input follow those of the inputs before it
+ */
+class PositionIndexBuilder {
+public:
+    explicit PositionIndexBuilder(const int threads); // 0 = hardware threads
+
+    // Inputs are PGN files or GameArchive files (detected by content)
+    bool build(const std::vector<std::string>& gamePaths, const std::string& outputPath, IndexBuildStats& stats);
+    bool merge(const std::vector<std::string>& indexPaths, const std::string& outputPath, IndexBuildStats& stats);
+
+    // Also write an opening explorer file during build() (empty = none)
+    void setExplorerPath(const std::string& path) { explorerPath = path; }
+
+    const std::string& getError() const { return error; }
+
+private:
+    struct Posting {
+        uint64_t key;
+        uint32_t gameId;
+        uint16_t ply;
+        uint16_t reserved;
+    };
+
+    struct GameRecord {
+        uint32_t gameId = 0;
+        std::string startFen;               // Empty for the standard starting position
+        std::vector<std::string> moves;     // SAN, or empty for an archived game
+        std::string moveCodes;              // Archived game: GameArchiveFormat move codes
+        bool isTruncated = false;           // Archived game whose source had an illegal move
+        GameResult result = GameResult::Unknown;
+        int whiteRating = 0;                // 0 = unknown
+        int blackRating = 0;
+    };
+
+    using GameBatch = std::vector<GameRecord>;
+
+    int threadCount;
+    std::string error;
+    std::string explorerPath;
+    std::string runPrefix;                  // <output>.run<N>.tmp
+    size_t runCapacity = 0;                 // Postings per worker before a spill
+
+    // Reader -> worker queue
+    std::mutex queueMutex;
+    std::condition_variable queueNotEmpty;
+    std::condition_variable queueNotFull;
+    std::deque<GameBatch> queue;
+    bool isReadingDone = false;
+
+    // Worker results
+    std::mutex runMutex;
+    std::vector<std::string> runPaths;
+    std::atomic<uint64_t> positionCount{0};
+    std::atomic<uint64_t> truncatedCount{0};
+    std::atomic<bool> hasFailed{false};
+    std::vector<OpeningTree> openingTrees;  // One per worker
+
+    bool readGames(const std::vector<std::string>& gamePaths, PositionIndexWriter& writer, uint64_t& gameCount);
+    bool readPGN(const std::string& path, PositionIndexWriter& writer, uint64_t& gameCount, GameBatch& batch);
+    bool readArchive(const std::string& path, const GameArchive& archive, PositionIndexWriter& writer, uint64_t& gameCount, GameBatch& batch);
+    template <typename Game>
+    bool queueGame(const Game& game, const GameResult result, GameRecord&& record, PositionIndexWriter& writer, uint64_t& gameCount, GameBatch& batch);
+    void pushBatch(GameBatch&& batch);
+    void workerLoop(const size_t workerIndex);
+    void replayGame(const GameRecord& game, Position& position, std::vector<Posting>& postings, OpeningTree& openingTree);
+    bool spillRun(std::vector<Posting>& postings);
+    bool mergeRuns(PositionIndexWriter& writer, IndexBuildStats& stats);
+    void removeRuns();
+    bool writeExplorer(IndexBuildStats& stats);
+
+    template <typename Game>
+    static IndexedGame toIndexedGame(const Game& game, const GameResult result);
+    static int parseRating(std::string_view rating);
+    static bool isPostingLess(const Posting& a, const Posting& b);
+};
@@ -1,6 +1,7 @@
 #include "chess_input_handler.h"
 #include "../rendering/chess_gui.h"
 #include "../application/chess_analysis_program.h"
+#include "../profiling/profiler.h"
 
 ChessInputHandler::ChessInputHandler(ChessAnalysisProgram& controller) 
     : controller(controller) {
@@ -13,6 +14,7 @@ ChessInputHandler::~ChessInputHandler()
 {}
 
 void ChessInputHandler::handleInput(const ChessGUI& gui) {
+    PROFILE_SCOPE("ChessInputHandler::handleInput");
 
     const Vector2 mousePos = GetMousePosition();
     
@@ -42,8 +44,17 @@ void ChessInputHandler::handleInput(const ChessGUI& gui) {
                 mousePos.x - pieceCenterPos.x,
                 mousePos.y - pieceCenterPos.y
             };
+
+            // The origin square is now drawn empty
+            controller.markDirty(DirtyFlags::BOARD);
         }
     }
+    // The dragged piece follows the mouse
+    if (isDragging) {
+        const Vector2 mouseDelta = GetMouseDelta();
+        if (mouseDelta.x != 0.0f || mouseDelta.y != 0.0f)
+            controller.markDirty(DirtyFlags::INPUT);
+    }
     // Check for piece drop
     if (isDragging && IsMouseButtonReleased(MOUSE_LEFT_BUTTON)) {
         // Get the position of the dropped piece
@@ -56,6 +67,7 @@ void ChessInputHandler::handleInput(const ChessGUI& gui) {
         
         // Stop dragging regardless of move success
         resetDragState();
+        controller.markDirty(DirtyFlags::BOARD);
     }
 
     if (IsKeyPressed(KEY_X))
@@ -72,6 +84,21 @@ void ChessInputHandler::handleInput(const ChessGUI& gui) {
 
     if (IsKeyPressed(KEY_RIGHT))
         controller.redoMove();
+
+    if (IsKeyPressed(KEY_DOWN))
+        controller.cycleVariation();
+
+    if (IsKeyPressed(KEY_P))
+        controller.exportPGN();
+
+    if (IsKeyPressed(KEY_G))
+        controller.toggleGameReview();
+
+    if (IsKeyPressed(KEY_F3))
+        controller.toggleProfilerOverlay();
+
+    if (IsKeyPressed(KEY_F4))
+        controller.exportProfilerTrace();
 }
 
 void ChessInputHandler::resetDragState() {
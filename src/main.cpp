@@ -1,11 +1,60 @@
 #include "application/chess_analysis_program.h"
+#include "application/batch_analyzer.h"
+#include "application/native_benchmark.h"
+#include "application/corpus_indexer.h"
+#include "application/game_packer.h"
 
 #include <iostream>
+#include <string>
 
-int main() {
+int main(int argc, char* argv[]) {
+    
+    // Headless position-set analysis: no window is created
+    if (argc > 1 && std::string(argv[1]) == "--batch") {
+        BatchOptions options;
+        if (!BatchOptions::parseArguments(argc, argv, options)) {
+            std::cerr << BatchOptions::getUsage() << std::endl;
+            return 2;
+        }
+        BatchAnalyzer analyzer{options};
+        return analyzer.run();
+    }
+
+    // Native search scaling (nps and time-to-depth per thread count)
+    if (argc > 1 && std::string(argv[1]) == "--bench") {
+        BenchmarkOptions options;
+        if (!BenchmarkOptions::parseArguments(argc, argv, options)) {
+            std::cerr << BenchmarkOptions::getUsage() << std::endl;
+            return 2;
+        }
+        NativeBenchmark benchmark{options};
+        return benchmark.run();
+    }
+
+    // Position index over PGN game databases (read by the reference games panel)
+    if (argc > 1 && std::string(argv[1]) == "--index") {
+        IndexOptions options;
+        if (!IndexOptions::parseArguments(argc, argv, options)) {
+            std::cerr << IndexOptions::getUsage() << std::endl;
+            return 2;
+        }
+        CorpusIndexer indexer{options};
+        return indexer.run();
+    }
+
+    // PGN databases packed into a binary game archive (about one byte per move)
+    if (argc > 1 && std::string(argv[1]) == "--pack") {
+        PackOptions options;
+        if (!PackOptions::parseArguments(argc, argv, options)) {
+            std::cerr << PackOptions::getUsage() << std::endl;
+            return 2;
+        }
+        GamePacker packer{options};
+        return packer.run();
+    }
     
     ChessAnalysisProgram app{};
     app.run();
     
     return 0;
-}
\ No newline at end of file
+}
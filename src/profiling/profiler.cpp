@@ -0,0 +1,174 @@
+#include "profiler.h"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <unordered_map>
+
+namespace ProfilerCfg = Config::Profiler;
+
+// Static member initialization
+std::mutex Profiler::registryMutex_;
+std::vector<std::unique_ptr<Profiler::ThreadBuffer>> Profiler::buffers_;
+std::mutex Profiler::frameMutex_;
+Profiler::ThreadBuffer* Profiler::frameThread_ = nullptr;
+int64_t Profiler::frameStartNs_ = -1;
+int64_t Profiler::lastFrameStartNs_ = -1;
+int64_t Profiler::lastFrameEndNs_ = -1;
+std::array<float, Config::Profiler::FRAME_HISTORY_SIZE> Profiler::frameHistoryMs_ = {};
+size_t Profiler::frameCount_ = 0;
+
+int64_t Profiler::nowNs() {
+    static const auto epoch = std::chrono::steady_clock::now();
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - epoch).count();
+}
+
+void Profiler::record(const char* name, int64_t startNs, int64_t durationNs) {
+    ThreadBuffer& buffer = threadBuffer();
+
+    // Single writer per buffer: fill the slot, then publish it by bumping head
+    uint64_t head = buffer.head.load(std::memory_order_relaxed);
+    Slot& slot = buffer.events[head % ProfilerCfg::RING_BUFFER_SIZE];
+    slot.name.store(name, std::memory_order_relaxed);
+    slot.startNs.store(startNs, std::memory_order_relaxed);
+    slot.durationNs.store(durationNs, std::memory_order_relaxed);
+    buffer.head.store(head + 1, std::memory_order_release);
+}
+
+void Profiler::setThreadName(const std::string& name) {
+    ThreadBuffer& buffer = threadBuffer();
+    std::lock_guard<std::mutex> lock(registryMutex_);
+    buffer.threadName = name;
+}
+
+void Profiler::markFrame() {
+    int64_t now = nowNs();
+    ThreadBuffer& buffer = threadBuffer();
+
+    std::lock_guard<std::mutex> lock(frameMutex_);
+    frameThread_ = &buffer;
+
+    // Close the previous frame (if any) and store its duration
+    if (frameStartNs_ >= 0) {
+        lastFrameStartNs_ = frameStartNs_;
+        lastFrameEndNs_ = now;
+        frameHistoryMs_[frameCount_ % frameHistoryMs_.size()] =
+            static_cast<float>(now - frameStartNs_) / 1.0e6f;
+        frameCount_++;
+    }
+    frameStartNs_ = now;
+}
+
+std::vector<float> Profiler::getFrameHistoryMs() {
+    std::lock_guard<std::mutex> lock(frameMutex_);
+
+    std::vector<float> history;
+    size_t count = std::min(frameCount_, frameHistoryMs_.size());
+    history.reserve(count);
+    for (size_t i = frameCount_ - count; i < frameCount_; i++)
+        history.push_back(frameHistoryMs_[i % frameHistoryMs_.size()]);
+
+    return history;
+}
+
+std::vector<ProfileZoneSummary> Profiler::getLastFrameZones() {
+    ThreadBuffer* frameThread;
+    int64_t frameStart, frameEnd;
+    {
+        std::lock_guard<std::mutex> lock(frameMutex_);
+        frameThread = frameThread_;
+        frameStart = lastFrameStartNs_;
+        frameEnd = lastFrameEndNs_;
+    }
+
+    std::vector<ProfileZoneSummary> zones;
+    if (!frameThread || frameStart < 0)
+        return zones;
+
+    // Sum every zone that lies completely inside the last frame
+    for (const ProfileEvent& event : snapshot(*frameThread)) {
+        if (event.startNs < frameStart || event.startNs + event.durationNs > frameEnd)
+            continue;
+
+        auto existing = std::find_if(zones.begin(), zones.end(),
+            [&event](const ProfileZoneSummary& zone) { return zone.name == event.name; });
+        if (existing == zones.end())
+            zones.push_back({event.name, event.durationNs, 1});
+        else {
+            existing->totalNs += event.durationNs;
+            existing->calls++;
+        }
+    }
+
+    std::sort(zones.begin(), zones.end(),
+        [](const ProfileZoneSummary& a, const ProfileZoneSummary& b) { return a.totalNs > b.totalNs; });
+    return zones;
+}
+
+bool Profiler::exportChromeTrace(const std::string& path) {
+    std::ofstream file(path);
+    if (!file.is_open()) {
+        std::cerr << "Failed to open trace output file: " << path << std::endl;
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(registryMutex_);
+
+    // Chrome trace format: complete ("X") events with microsecond timestamps
+    file << "{\"traceEvents\":[\n";
+    bool first = true;
+    for (const std::unique_ptr<ThreadBuffer>& buffer : buffers_) {
+        if (!buffer->threadName.empty()) {
+            file << (first ? "" : ",\n")
+                 << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->threadId
+                 << ",\"args\":{\"name\":\"" << buffer->threadName << "\"}}";
+            first = false;
+        }
+
+        for (const ProfileEvent& event : snapshot(*buffer)) {
+            file << (first ? "" : ",\n")
+                 << "{\"name\":\"" << event.name << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->threadId
+                 << ",\"ts\":" << event.startNs / 1000.0
+                 << ",\"dur\":" << event.durationNs / 1000.0 << "}";
+            first = false;
+        }
+    }
+    file << "\n],\"displayTimeUnit\":\"ms\"}\n";
+
+    std::cout << "Profiler trace written to " << path << std::endl;
+    return file.good();
+}
+
+Profiler::ThreadBuffer& Profiler::threadBuffer() {
+    // Buffers are never freed, so the cached pointer stays valid for the thread's lifetime
+    thread_local ThreadBuffer* buffer = nullptr;
+    if (!buffer) {
+        std::lock_guard<std::mutex> lock(registryMutex_);
+        buffers_.push_back(std::make_unique<ThreadBuffer>());
+        buffer = buffers_.back().get();
+        buffer->threadId = static_cast<uint32_t>(buffers_.size());
+    }
+    return *buffer;
+}
+
+std::vector<ProfileEvent> Profiler::snapshot(const ThreadBuffer& buffer) {
+    uint64_t head = buffer.head.load(std::memory_order_acquire);
+
+    // Skip the oldest slots: the owning thread may be overwriting them right now
+    uint64_t available = std::min<uint64_t>(head,
+        ProfilerCfg::RING_BUFFER_SIZE - ProfilerCfg::SNAPSHOT_SAFETY_MARGIN);
+
+    std::vector<ProfileEvent> events;
+    events.reserve(available);
+    for (uint64_t i = head - available; i < head; i++) {
+        const Slot& slot = buffer.events[i % ProfilerCfg::RING_BUFFER_SIZE];
+        ProfileEvent event;
+        event.name = slot.name.load(std::memory_order_relaxed);
+        event.startNs = slot.startNs.load(std::memory_order_relaxed);
+        event.durationNs = slot.durationNs.load(std::memory_order_relaxed);
+        if (event.name)
+            events.push_back(event);
+    }
+    return events;
+}
@@ -0,0 +1,155 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "../config/config.h"
+
+/**
+ * Lightweight scoped-timer instrumentation
+ *
+ * Key features:
+ * - RAII zones (PROFILE_SCOPE) recorded into per-thread ring buffers
+ * - Lock-free recording: each thread only ever writes its own buffer
+ * - Frame markers for frame-time history and the on-screen overlay
+ * - Chrome trace JSON export (chrome://tracing or ui.perfetto.dev)
+ *
+ * Zones compile to nothing unless CHESS_PROFILING is defined, so release
+ * builds pay no cost for the instrumentation left in hot paths.
+ */
+
+/**
+ * A single completed zone
+ */
+struct ProfileEvent {
+    const char* name = nullptr;     // Zone name (must be a string literal)
+    int64_t startNs = 0;            // Start time relative to profiler epoch
+    int64_t durationNs = 0;         // Zone duration
+};
+
+/**
+ * Aggregated timing of one zone over a frame (used by the overlay)
+ */
+struct ProfileZoneSummary {
+    const char* name = nullptr;
+    int64_t totalNs = 0;
+    int calls = 0;
+};
+
+class Profiler {
+public:
+    /**
+     * Current time in nanoseconds since the profiler epoch
+     */
+    static int64_t nowNs();
+
+    /**
+     * Record a completed zone into the calling thread's ring buffer
+     */
+    static void record(const char* name, int64_t startNs, int64_t durationNs);
+
+    /**
+     * Name the calling thread (shown in trace exports)
+     */
+    static void setThreadName(const std::string& name);
+
+    /**
+     * Mark the start of a new frame on the main thread
+     * Closes the previous frame and pushes its duration into the history.
+     */
+    static void markFrame();
+
+    /**
+     * Check if zones are compiled in (CHESS_PROFILING defined)
+     */
+    static constexpr bool isCompiledIn() {
+#ifdef CHESS_PROFILING
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    /**
+     * Frame-time history in milliseconds, oldest first
+     */
+    static std::vector<float> getFrameHistoryMs();
+
+    /**
+     * Aggregate the main-thread zones recorded during the last complete frame
+     * @return Zones sorted by total time, most expensive first
+     */
+    static std::vector<ProfileZoneSummary> getLastFrameZones();
+
+    /**
+     * Write every buffered event from every thread as Chrome trace JSON
+     * @param path Output file path
+     * @return true if the file was written, false otherwise
+     */
+    static bool exportChromeTrace(const std::string& path);
+
+private:
+    // Ring buffer slot; relaxed atomics keep concurrent snapshots race-free
+    struct Slot {
+        std::atomic<const char*> name{nullptr};
+        std::atomic<int64_t> startNs{0};
+        std::atomic<int64_t> durationNs{0};
+    };
+
+    // One ring buffer per thread; only the owning thread writes to it
+    struct ThreadBuffer {
+        std::array<Slot, Config::Profiler::RING_BUFFER_SIZE> events;
+        std::atomic<uint64_t> head{0};   // Total events ever written
+        uint32_t threadId = 0;
+        std::string threadName;
+    };
+
+    static ThreadBuffer& threadBuffer();
+    static std::vector<ProfileEvent> snapshot(const ThreadBuffer& buffer);
+
+    static std::mutex registryMutex_;
+    static std::vector<std::unique_ptr<ThreadBuffer>> buffers_;
+
+    // Frame tracking (main thread only)
+    static std::mutex frameMutex_;
+    static ThreadBuffer* frameThread_;
+    static int64_t frameStartNs_;
+    static int64_t lastFrameStartNs_;
+    static int64_t lastFrameEndNs_;
+    static std::array<float, Config::Profiler::FRAME_HISTORY_SIZE> frameHistoryMs_;
+    static size_t frameCount_;
+};
+
+/**
+ * RAII zone: measures from construction to destruction
+ */
+class ProfileZone {
+public:
+    explicit ProfileZone(const char* name) : name_(name), startNs_(Profiler::nowNs()) {}
+    ~ProfileZone() { Profiler::record(name_, startNs_, Profiler::nowNs() - startNs_); }
+
+    // Non-copyable
+    ProfileZone(const ProfileZone&) = delete;
+    ProfileZone& operator=(const ProfileZone&) = delete;
+
+private:
+    const char* name_;
+    int64_t startNs_;
+};
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+
+#ifdef CHESS_PROFILING
+#define PROFILE_SCOPE(name) ProfileZone PROFILE_CONCAT(profileZone_, __LINE__){name}
+#define PROFILE_FRAME() Profiler::markFrame()
+#define PROFILE_THREAD(name) Profiler::setThreadName(name)
+#else
+#define PROFILE_SCOPE(name) ((void)0)
+#define PROFILE_FRAME() ((void)0)
+#define PROFILE_THREAD(name) ((void)0)
+#endif
@@ -1,6 +1,7 @@
 #include "chess_gui.h"
 #include "../application/chess_analysis_program.h"
 #include "components/ui_renderer.h"
+#include "../profiling/profiler.h"
 
 namespace WinCfg = Config::Window;
 
@@ -8,9 +9,13 @@ ChessGUI::ChessGUI(const ChessAnalysisProgram& controller):
     controller(controller), boardComp(std::make_unique<BoardComp>(controller)),
     controlsComp(std::make_unique<ControlsComp>(controller)),
     engineComp(std::make_unique<EngineComp>(controller)), 
+    evalGraphComp(std::make_unique<EvalGraphComp>(controller)),
+    explorerComp(std::make_unique<ExplorerComp>(controller)),
     gameOverlay(std::make_unique<GameOverlay>(controller)),
     movesComp(std::make_unique<MovesComp>(controller)),
-    statsPanel(std::make_unique<StatsPanel>(controller))
+    referenceGamesComp(std::make_unique<ReferenceGamesComp>(controller)),
+    statsPanel(std::make_unique<StatsPanel>(controller)),
+    profilerOverlay(std::make_unique<ProfilerOverlay>(controller))
 {
     InitWindow(WinCfg::WIDTH, WinCfg::HEIGHT, WinCfg::TITLE);
 
@@ -24,23 +29,34 @@ ChessGUI::ChessGUI(const ChessAnalysisProgram& controller):
 }
 
 ChessGUI::~ChessGUI() {
+    // Release GPU targets while the context still exists
+    contentLayer.unload();
+    staticLayer.unload();
     UIRenderer::cleanupFonts(); // Clean up custom fonts
     CloseWindow(); // Close window and OpenGL context
 }
 
-void ChessGUI::draw() const {
+void ChessGUI::draw(uint32_t dirtyFlags) {
+    PROFILE_SCOPE("ChessGUI::draw");
+
+    // Static layers only change with the window size or board orientation
+    if (IsWindowResized() || staticLayerFlipped != controller.getBoardFlipped())
+        invalidateStaticLayers();
+    if (!staticLayer.isValid())
+        rebuildStaticLayers();
+
+    // Redraw only the components whose state changed since the last frame
+    updateContentLayer(dirtyFlags);
+
     BeginDrawing();
     
-    // Draw modern background first
-    drawModernBackground();
+    // Background, chrome and component content in a single blit
+    contentLayer.draw();
     
-    // Draw components in order: StatsPanel at top, EngineComp below StatsPanel, ControlsComp below EngineComp
-    boardComp->draw();
-    statsPanel->draw();
-    engineComp->draw();
-    controlsComp->draw();
-    movesComp->draw();
+    // Live elements above the cached layers
+    boardComp->drawDraggedPiece();
     gameOverlay->draw();  // Last to overlay on top
+    profilerOverlay->draw(); // Debug overlay above everything
     
     EndDrawing();
 }
@@ -66,7 +82,96 @@ void ChessGUI::setIsUCIEngineRunning(const bool isRunning) {
     engineComp->setEngineRunning(isRunning);
 }
 
+void ChessGUI::invalidateStaticLayers() {
+    staticLayer.invalidate();
+    contentLayer.invalidate();
+}
+
+void ChessGUI::rebuildStaticLayers() {
+    PROFILE_SCOPE("ChessGUI::rebuildStaticLayers");
+
+    const Color clearColor = {15, 20, 35, 255}; // Matches the bottom of the background gradient
+    staticLayer.setBounds({
+        0.0f, 
+        0.0f, 
+        static_cast<float>(GetScreenWidth()), 
+        static_cast<float>(GetScreenHeight())
+    });
+
+    staticLayer.begin(clearColor);
+    drawModernBackground();
+    boardComp->drawStaticLayer();
+    statsPanel->drawChrome();
+    engineComp->drawChrome();
+    explorerComp->drawChrome();
+    controlsComp->draw();
+    movesComp->drawChrome();
+    referenceGamesComp->drawChrome();
+    evalGraphComp->drawChrome();
+    staticLayer.end();
+
+    staticLayerFlipped = controller.getBoardFlipped();
+}
+
+void ChessGUI::updateContentLayer(uint32_t dirtyFlags) {
+    const bool rebuild = !contentLayer.isValid();
+    const uint32_t contentFlags = DirtyFlags::BOARD | DirtyFlags::HISTORY | DirtyFlags::ENGINE;
+    if (!rebuild && !(dirtyFlags & contentFlags))
+        return;
+
+    PROFILE_SCOPE("ChessGUI::updateContentLayer");
+
+    if (rebuild) {
+        contentLayer.setBounds(staticLayer.getBounds());
+        contentLayer.begin();
+        staticLayer.draw();
+        dirtyFlags = DirtyFlags::ALL;
+    } else
+        contentLayer.beginUpdate();
+
+    // Each region is restored from the static layer before its content is redrawn
+    // Draw in order: StatsPanel at top, EngineComp and ExplorerComp below it (ControlsComp is fully static)
+    if (dirtyFlags & DirtyFlags::BOARD) {
+        if (!rebuild)
+            staticLayer.drawRegion(boardComp->getBounds());
+        boardComp->draw();
+    }
+    if (dirtyFlags & (DirtyFlags::BOARD | DirtyFlags::HISTORY)) {
+        if (!rebuild)
+            staticLayer.drawRegion(statsPanel->getPanelBounds());
+        statsPanel->draw();
+    }
+    if (dirtyFlags & DirtyFlags::ENGINE) {
+        if (!rebuild)
+            staticLayer.drawRegion(engineComp->getDialogBounds());
+        engineComp->draw();
+    }
+    if (dirtyFlags & DirtyFlags::HISTORY) {
+        if (!rebuild)
+            staticLayer.drawRegion(explorerComp->getDialogBounds());
+        explorerComp->draw();
+    }
+    if (dirtyFlags & DirtyFlags::HISTORY) {
+        if (!rebuild)
+            staticLayer.drawRegion(movesComp->getDialogBounds());
+        movesComp->draw();
+    }
+    if (dirtyFlags & DirtyFlags::HISTORY) {
+        if (!rebuild)
+            staticLayer.drawRegion(referenceGamesComp->getDialogBounds());
+        referenceGamesComp->draw();
+    }
+    if (dirtyFlags & (DirtyFlags::HISTORY | DirtyFlags::ENGINE)) {
+        if (!rebuild)
+            staticLayer.drawRegion(evalGraphComp->getDialogBounds());
+        evalGraphComp->draw();
+    }
+
+    contentLayer.end();
+}
+
 void ChessGUI::drawModernBackground() const {
+    PROFILE_SCOPE("ChessGUI::drawModernBackground");
     // Get window dimensions from config
     const int windowWidth = WinCfg::WIDTH;
     const int windowHeight = WinCfg::HEIGHT;
@@ -1,29 +1,40 @@
 #pragma once
 
 #include <raylib.h>
+#include <cstdint>
 #include <memory>
 #include "components/board_comp.h"
 #include "components/controls_comp.h"
 #include "components/engine_comp.h"
+#include "components/eval_graph_comp.h"
+#include "components/explorer_comp.h"
 #include "components/game_overlay.h"
 #include "components/moves_comp.h"
+#include "components/reference_games_comp.h"
 #include "components/stats_panel.h"
+#include "components/profiler_overlay.h"
+#include "components/render_layer.h"
+#include "dirty_flags.h"
 #include "../config/config.h"
 
 class ChessAnalysisProgram;
 class BoardComp;
 class ControlsComp;
 class EngineComp;
+class EvalGraphComp;
+class ExplorerComp;
 class GameOverlay;
 class MovesComp;
+class ReferenceGamesComp;
 class StatsPanel;
+class ProfilerOverlay;
 
 class ChessGUI {
 public:
     ChessGUI(const ChessAnalysisProgram& controller);
     ~ChessGUI();
 
-    void draw() const;
+    void draw(uint32_t dirtyFlags); // DirtyFlags bits changed since the last drawn frame
     
     // Board interaction methods
     Vector2 screenPosToBoardPos(const Vector2 pos) const;
@@ -34,7 +45,14 @@ public:
     // Engine state updates
     void setIsUCIEngineRunning(const bool isRunning);
 
+    // Force the cached static layers to re-render (e.g. after a theme change)
+    void invalidateStaticLayers();
+
 private:
+    // Cached static layers (background, board frame, panel chrome)
+    void rebuildStaticLayers();
+    void updateContentLayer(uint32_t dirtyFlags);
+
     // Background rendering
     void drawModernBackground() const;
     void drawGeometricPattern() const;
@@ -45,7 +63,16 @@ private:
     std::unique_ptr<BoardComp> boardComp;
     std::unique_ptr<ControlsComp> controlsComp;
     std::unique_ptr<EngineComp> engineComp;
+    std::unique_ptr<EvalGraphComp> evalGraphComp;
+    std::unique_ptr<ExplorerComp> explorerComp;
     std::unique_ptr<GameOverlay> gameOverlay;
     std::unique_ptr<MovesComp> movesComp;
+    std::unique_ptr<ReferenceGamesComp> referenceGamesComp;
     std::unique_ptr<StatsPanel> statsPanel;
+    std::unique_ptr<ProfilerOverlay> profilerOverlay;
+
+    // Layer caches: chrome only, and chrome plus component content
+    RenderLayer staticLayer;
+    RenderLayer contentLayer;
+    bool staticLayerFlipped = false;
 };
\ No newline at end of file
@@ -1,6 +1,7 @@
 #include "board_comp.h"
 #include "../../application/chess_analysis_program.h"
 #include "../../config/config.h"
+#include "../../profiling/profiler.h"
 
 namespace BoardCfg = Config::Board;
 namespace PieceCfg = Config::Pieces;
@@ -12,20 +13,48 @@ BoardComp::BoardComp(const ChessAnalysisProgram& controller) :
     boardRenderer = std::make_unique<BoardRenderer>(*textureManager);
     coordinateRenderer = std::make_unique<CoordinateRenderer>(controller);
     pieceRenderer = std::make_unique<PieceRenderer>(controller, *textureManager);
+    moveHintRenderer = std::make_unique<MoveHintRenderer>(controller, *pieceRenderer);
     capturedPiecesRenderer = std::make_unique<CapturedPiecesRenderer>(controller, *textureManager);
 }
 
 void BoardComp::draw() const {
+    PROFILE_SCOPE("BoardComp::draw");
     // Ensure textures are loaded before drawing
     if (!textureManager->areTexturesLoaded()) {
         textureManager->loadTextures();
     }
     
+    // Draw dynamic components (board and labels come from the static layer)
+    moveHintRenderer->draw(); // Under the pieces, so capture rings frame them
+    pieceRenderer->draw();
+    capturedPiecesRenderer->draw();
+}
+
+void BoardComp::drawStaticLayer() const {
+    if (!textureManager->areTexturesLoaded()) {
+        textureManager->loadTextures();
+    }
+    
     // Draw components in order
     boardRenderer->draw();
     coordinateRenderer->draw();
-    pieceRenderer->draw();
-    capturedPiecesRenderer->draw();
+    capturedPiecesRenderer->drawBackgrounds();
+}
+
+void BoardComp::drawDraggedPiece() const {
+    pieceRenderer->drawDraggedPiece();
+}
+
+Rectangle BoardComp::getBounds() const {
+    // Everything between the left panels and the moves panel (board and captured pieces)
+    float left = Config::StatsPanel::PANEL_WIDTH;
+    float right = Config::Window::WIDTH - Config::MovesPanel::PANEL_WIDTH;
+    return Rectangle{
+        left,
+        0,
+        right - left,
+        Config::Window::HEIGHT
+    };
 }
 
 Vector2 BoardComp::screenPosToBoardPos(const Vector2 pos) const {
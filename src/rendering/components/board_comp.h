@@ -6,6 +6,7 @@
 #include "board_renderer.h"
 #include "coordinate_renderer.h"
 #include "piece_renderer.h"
+#include "move_hint_renderer.h"
 #include "captured_pieces_renderer.h"
 
 class ChessAnalysisProgram;
@@ -19,6 +20,9 @@ public:
     ~BoardComp() = default;
     
     void draw() const;
+    void drawStaticLayer() const; // Frame, board texture, coordinates and captured boxes (cached by ChessGUI)
+    void drawDraggedPiece() const; // Drawn over the cached layers every frame
+    Rectangle getBounds() const; // Screen area redrawn when the board changes
     
     // Board utilities
     Vector2 screenPosToBoardPos(const Vector2 pos) const;
@@ -34,5 +38,6 @@ private:
     std::unique_ptr<BoardRenderer> boardRenderer;
     std::unique_ptr<CoordinateRenderer> coordinateRenderer;
     std::unique_ptr<PieceRenderer> pieceRenderer;
+    std::unique_ptr<MoveHintRenderer> moveHintRenderer;
     std::unique_ptr<CapturedPiecesRenderer> capturedPiecesRenderer;
 };
\ No newline at end of file
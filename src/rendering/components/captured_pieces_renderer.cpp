@@ -9,6 +9,10 @@ namespace CapturedCfg = Config::CapturedPieces;
 namespace DecorCfg = Config::Decorations;
 namespace PieceCfg = Config::Pieces;
 
+// Static dimensions for 2 pieces high, 8 columns wide
+static constexpr float CAPTURED_AREA_WIDTH = (8 * PieceCfg::CAPTURED_SIZE) + (PieceCfg::CAPTURED_SIZE * 0.2f);
+static constexpr float CAPTURED_AREA_HEIGHT = (2 * PieceCfg::CAPTURED_STEP) + (PieceCfg::CAPTURED_SIZE * 0.1f) + (PieceCfg::CAPTURED_SIZE * 0.5f);
+
 CapturedPiecesRenderer::CapturedPiecesRenderer(const ChessAnalysisProgram& controller, const TextureManager& textureManager) :
     controller(controller), textureManager(textureManager) {
 }
@@ -17,41 +21,43 @@ void CapturedPiecesRenderer::draw() const {
     drawCapturedPieces();
 }
 
-void CapturedPiecesRenderer::drawCapturedPieces() const {
-    // Calculate static dimensions for 2 pieces high, 8 columns wide
-    const float staticWidth = (8 * PieceCfg::CAPTURED_SIZE) + (PieceCfg::CAPTURED_SIZE * 0.2f);
-    const float staticHeight = (2 * PieceCfg::CAPTURED_STEP) + (PieceCfg::CAPTURED_SIZE * 0.1f) + (PieceCfg::CAPTURED_SIZE * 0.5f);
-    
-    // Determine positions based on board flip state
-    bool isFlipped = controller.getBoardFlipped();
+void CapturedPiecesRenderer::drawBackgrounds() const {
+    float whiteAreaY, blackAreaY;
+    getCapturedAreaPositions(whiteAreaY, blackAreaY);
     
-    // Calculate positions for white and black areas
-    float whiteAreaX = PieceCfg::CAPTURED_OFFSET_X;
-    float blackAreaX = PieceCfg::CAPTURED_OFFSET_X;
+    // Always draw both backgrounds (static)
+    drawCapturedPiecesBackground(PieceCfg::CAPTURED_OFFSET_X, whiteAreaY, CAPTURED_AREA_WIDTH, CAPTURED_AREA_HEIGHT, true);
+    drawCapturedPiecesBackground(PieceCfg::CAPTURED_OFFSET_X, blackAreaY, CAPTURED_AREA_WIDTH, CAPTURED_AREA_HEIGHT, false);
     
-    float whiteAreaY, blackAreaY;
-    if (isFlipped) {
+    // Draw labels
+    drawCapturedPiecesLabels(PieceCfg::CAPTURED_OFFSET_X, whiteAreaY, PieceCfg::CAPTURED_OFFSET_X, blackAreaY,
+        CAPTURED_AREA_WIDTH, controller.getBoardFlipped());
+}
+
+void CapturedPiecesRenderer::getCapturedAreaPositions(float& whiteAreaY, float& blackAreaY) const {
+    if (controller.getBoardFlipped()) {
         // When flipped, white goes to bottom, black to top
-        whiteAreaY = PieceCfg::CAPTURED_OFFSET_Y_BLACK - staticHeight + PieceCfg::CAPTURED_SIZE * 1.3f;
+        whiteAreaY = PieceCfg::CAPTURED_OFFSET_Y_BLACK - CAPTURED_AREA_HEIGHT + PieceCfg::CAPTURED_SIZE * 1.3f;
         blackAreaY = PieceCfg::CAPTURED_OFFSET_Y_WHITE - PieceCfg::CAPTURED_SIZE * 0.3f;
     } else {
         // Normal: white at top, black at bottom
         whiteAreaY = PieceCfg::CAPTURED_OFFSET_Y_WHITE - PieceCfg::CAPTURED_SIZE * 0.3f;
-        blackAreaY = PieceCfg::CAPTURED_OFFSET_Y_BLACK - staticHeight + PieceCfg::CAPTURED_SIZE * 1.3f;
+        blackAreaY = PieceCfg::CAPTURED_OFFSET_Y_BLACK - CAPTURED_AREA_HEIGHT + PieceCfg::CAPTURED_SIZE * 1.3f;
     }
-    
-    // Always draw both backgrounds (static)
-    drawCapturedPiecesBackground(whiteAreaX, whiteAreaY, staticWidth, staticHeight, true);
-    drawCapturedPiecesBackground(blackAreaX, blackAreaY, staticWidth, staticHeight, false);
-    
-    // Draw labels
-    drawCapturedPiecesLabels(whiteAreaX, whiteAreaY, blackAreaX, blackAreaY, staticWidth, isFlipped);
+}
+
+void CapturedPiecesRenderer::drawCapturedPieces() const {
+    // Backgrounds and labels are cached in the static layer; only pieces are drawn here
+    float whiteAreaX = PieceCfg::CAPTURED_OFFSET_X;
+    float blackAreaX = PieceCfg::CAPTURED_OFFSET_X;
+    float whiteAreaY, blackAreaY;
+    getCapturedAreaPositions(whiteAreaY, blackAreaY);
     
     // Get captured pieces by color directly from the board
-    std::vector<char> whiteCaptured = controller.getWhiteCapturedPieces();
-    std::vector<char> blackCaptured = controller.getBlackCapturedPieces();
+    const CapturedPieceList& whiteCaptured = controller.getWhiteCapturedPieces();
+    const CapturedPieceList& blackCaptured = controller.getBlackCapturedPieces();
     
-    // If no captured pieces, still draw the empty backgrounds
+    // Nothing to draw on top of the cached backgrounds
     if (whiteCaptured.empty() && blackCaptured.empty()) {
         return;
     }
@@ -59,7 +65,6 @@ void CapturedPiecesRenderer::drawCapturedPieces() const {
     // Draw white captured pieces
     for (int i = 0; i < whiteCaptured.size(); i++) {
         char piece = whiteCaptured[i];
-        std::string pieceString = controller.pieceToTextureString(piece);
         
         // Calculate column and row within the box
         int row = (i <= PieceCfg::MAX_CAPTURED_IN_ROW) ? 0 : 1;
@@ -69,14 +74,12 @@ void CapturedPiecesRenderer::drawCapturedPieces() const {
         float xPos = whiteAreaX + (PieceCfg::CAPTURED_SIZE * 0.25f) + (col * PieceCfg::CAPTURED_STEP);
         float yPos = whiteAreaY + (PieceCfg::CAPTURED_SIZE * 0.05f) + (row * PieceCfg::CAPTURED_STEP);
         
-        DrawTextureEx(textureManager.getPieceTexture(pieceString), {xPos, yPos}, 0.0f, 
-            PieceCfg::CAPTURED_SCALE, WHITE);
+        textureManager.drawPiece(piece, {xPos, yPos}, PieceCfg::CAPTURED_SCALE);
     }
     
     // Draw black captured pieces
     for (int i = 0; i < blackCaptured.size(); i++) {
         char piece = blackCaptured[i];
-        std::string pieceString = controller.pieceToTextureString(piece);
         
         // Calculate column and row within the box
         int row = (i <= PieceCfg::MAX_CAPTURED_IN_ROW) ? 0 : 1;
@@ -86,8 +89,7 @@ void CapturedPiecesRenderer::drawCapturedPieces() const {
         float xPos = blackAreaX + (PieceCfg::CAPTURED_SIZE * 0.25f) + (col * PieceCfg::CAPTURED_STEP);
         float yPos = blackAreaY + (PieceCfg::CAPTURED_SIZE * 0.05f) + (row * PieceCfg::CAPTURED_STEP);
         
-        DrawTextureEx(textureManager.getPieceTexture(pieceString), {xPos, yPos}, 0.0f, 
-            PieceCfg::CAPTURED_SCALE, WHITE);
+        textureManager.drawPiece(piece, {xPos, yPos}, PieceCfg::CAPTURED_SCALE);
     }
 }
 
@@ -15,12 +15,14 @@ public:
     CapturedPiecesRenderer(const ChessAnalysisProgram& controller, const TextureManager& textureManager);
     
     void draw() const;
+    void drawBackgrounds() const; // Static boxes and labels (cached by ChessGUI)
 
 private:
     const ChessAnalysisProgram& controller;
     const TextureManager& textureManager;
     
     void drawCapturedPieces() const;
+    void getCapturedAreaPositions(float& whiteAreaY, float& blackAreaY) const;
     void drawCapturedPiecesBackground(float x, float y, float width, float height, bool isWhite) const;
     void drawCapturedPiecesLabels(float whiteX, float whiteY, float blackX, float blackY, float width, bool isFlipped) const;
     void drawBorderLayers(float borderX, float borderY, float borderWidth, float borderHeight) const;
@@ -1,6 +1,7 @@
 #include "controls_comp.h"
 #include "ui_renderer.h"
 #include "../../config/config.h"
+#include "../../profiling/profiler.h"
 
 namespace ControlsPanelCfg = Config::ControlsPanel;
 
@@ -8,16 +9,17 @@ ControlsComp::ControlsComp(const ChessAnalysisProgram& controller) :
     controller(controller) {}
 
 void ControlsComp::draw() const {
+    PROFILE_SCOPE("ControlsComp::draw");
     drawControlsPanel();
 }
 
 Rectangle ControlsComp::getPanelBounds() const {
-    // Position below the engine component
-    float totalPanelHeight = Config::StatsPanel::PANEL_HEIGHT + Config::EngineDialog::DIALOG_HEIGHT + ControlsPanelCfg::PANEL_HEIGHT;
+    // Position below the opening explorer
+    float totalPanelHeight = Config::StatsPanel::PANEL_HEIGHT + Config::EngineDialog::DIALOG_HEIGHT + Config::ExplorerPanel::PANEL_HEIGHT + ControlsPanelCfg::PANEL_HEIGHT;
     float verticalCenterOffset = (Config::Window::HEIGHT - totalPanelHeight) / 2.0f;
     return Rectangle{
         0,  // Align to left edge
-        verticalCenterOffset + Config::StatsPanel::PANEL_HEIGHT + Config::EngineDialog::DIALOG_HEIGHT,  // Position below both StatsPanel and EngineComp
+        verticalCenterOffset + Config::StatsPanel::PANEL_HEIGHT + Config::EngineDialog::DIALOG_HEIGHT + Config::ExplorerPanel::PANEL_HEIGHT,  // Position below StatsPanel, EngineComp and ExplorerComp
         ControlsPanelCfg::PANEL_WIDTH,
         ControlsPanelCfg::PANEL_HEIGHT
     };
@@ -50,7 +52,8 @@ void ControlsComp::drawControlsPanel() const {
     
     // Engine Controls
     drawControlGroup("Engine Controls:", {
-        "X - Toggle engine analysis"
+        "X - Toggle engine analysis",
+        "G - Review whole game"
     }, currentY);
     
 }
@@ -12,7 +12,7 @@ class ControlsComp {
 public:
     ControlsComp(const ChessAnalysisProgram& controller);
     
-    void draw() const;
+    void draw() const; // Fully static: only drawn into ChessGUI's cached layer
 
 private:
     const ChessAnalysisProgram& controller;
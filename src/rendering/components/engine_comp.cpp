@@ -1,7 +1,8 @@
 #include "engine_comp.h"
 #include "ui_renderer.h"
 #include "../../config/config.h"
-#include "../../analysis_engine/uci_engine.h"
+#include "../../analysis_engine/analysis_engine.h"
+#include "../../profiling/profiler.h"
 
 namespace EngineDialogCfg = Config::EngineDialog;
 
@@ -12,6 +13,7 @@ EngineComp::EngineComp(const ChessAnalysisProgram& controller) :
 }
 
 void EngineComp::draw() const {
+    PROFILE_SCOPE("EngineComp::draw");
     drawDialogWindow();
 }
 
@@ -21,7 +23,7 @@ void EngineComp::setEngineRunning(bool isRunning) {
 
 Rectangle EngineComp::getDialogBounds() const {
     // Position as a built-in panel on the left side, below StatsPanel
-    float totalPanelHeight = Config::StatsPanel::PANEL_HEIGHT + EngineDialogCfg::DIALOG_HEIGHT + Config::ControlsPanel::PANEL_HEIGHT;
+    float totalPanelHeight = Config::StatsPanel::PANEL_HEIGHT + EngineDialogCfg::DIALOG_HEIGHT + Config::ExplorerPanel::PANEL_HEIGHT + Config::ControlsPanel::PANEL_HEIGHT;
     float verticalCenterOffset = (Config::Window::HEIGHT - totalPanelHeight) / 2.0f;
     return Rectangle{
         0,  // Align to left edge
@@ -31,19 +33,26 @@ Rectangle EngineComp::getDialogBounds() const {
     };
 }
 
-void EngineComp::drawDialogWindow() const {
+void EngineComp::drawChrome() const {
     Rectangle panelBounds = getDialogBounds();
     
     // Draw panel using UIRenderer
     UIRenderer::drawPanelBackground(panelBounds, UIRenderer::PanelStyle::Engine);
     UIRenderer::drawPanelBorder(panelBounds);
     UIRenderer::drawPanelShadowRight(panelBounds, 8);
-    
-    // Draw content
     drawDialogTitle();
-    drawEngineControls();
-    drawEngineStatus();
-    drawEngineAnalysis();
+}
+
+void EngineComp::drawDialogWindow() const {
+    // Re-layout only for a new engine snapshot (chrome is cached in the static layer)
+    const uint64_t layoutKey = (controller.getUCIEngineAnalysisVersion() << 1) | (isEngineRunning ? 1u : 0u);
+    if (!textLayout.isCurrent(layoutKey)) {
+        textLayout.begin(layoutKey);
+        layoutEngineControls();
+        layoutEngineStatus();
+        layoutEngineAnalysis();
+    }
+    textLayout.draw();
 }
 
 void EngineComp::drawDialogTitle() const {
@@ -52,7 +61,7 @@ void EngineComp::drawDialogTitle() const {
                               EngineDialogCfg::TITLE_HEIGHT, EngineDialogCfg::DIALOG_PADDING);
 }
 
-void EngineComp::drawEngineControls() const {
+void EngineComp::layoutEngineControls() const {
     Rectangle panelBounds = getDialogBounds();
     
     std::string controlText = isEngineRunning ? 
@@ -62,10 +71,10 @@ void EngineComp::drawEngineControls() const {
     int textX = panelBounds.x + EngineDialogCfg::DIALOG_PADDING;
     int textY = panelBounds.y + EngineDialogCfg::TITLE_HEIGHT + 8 + EngineDialogCfg::DIALOG_PADDING;
     
-    drawText(controlText, textX, textY, 18, Color{90, 95, 100, 255});
+    addText(controlText, textX, textY, 18, Color{90, 95, 100, 255});
 }
 
-void EngineComp::drawEngineStatus() const {
+void EngineComp::layoutEngineStatus() const {
     Rectangle panelBounds = getDialogBounds();
     
     std::string statusText = isEngineRunning ? 
@@ -79,18 +88,18 @@ void EngineComp::drawEngineStatus() const {
     int textX = panelBounds.x + EngineDialogCfg::DIALOG_PADDING;
     int textY = panelBounds.y + EngineDialogCfg::TITLE_HEIGHT + 8 + EngineDialogCfg::DIALOG_PADDING + EngineDialogCfg::LINE_HEIGHT + 8;
     
-    drawText(statusText, textX, textY, 18, statusColor);
+    addText(statusText, textX, textY, 18, statusColor);
 }
 
-void EngineComp::drawEngineAnalysis() const {
+void EngineComp::layoutEngineAnalysis() const {
     Rectangle panelBounds = getDialogBounds();
     
     if (!isEngineRunning) {
         int textX = panelBounds.x + EngineDialogCfg::DIALOG_PADDING;
         int textY = panelBounds.y + EngineDialogCfg::TITLE_HEIGHT + 8 + EngineDialogCfg::DIALOG_PADDING + (EngineDialogCfg::LINE_HEIGHT * 3) + 10;
         
-        drawText("Engine is not running.", textX, textY, 18, Color{128, 128, 128, 255});
-        drawText("Start the engine to see analysis.", textX, textY + EngineDialogCfg::LINE_HEIGHT, 18, Color{128, 128, 128, 255});
+        addText("Engine is not running.", textX, textY, 18, Color{128, 128, 128, 255});
+        addText("Start the engine to see analysis.", textX, textY + EngineDialogCfg::LINE_HEIGHT, 18, Color{128, 128, 128, 255});
         return;
     }
     
@@ -115,20 +124,24 @@ void EngineComp::drawEngineAnalysis() const {
     }
     
     std::string engineStateText = "Engine State: " + stateText;
-    drawText(engineStateText, textX, currentY, 19, stateColor);
+    addText(engineStateText, textX, currentY, 19, stateColor);
     currentY += EngineDialogCfg::LINE_HEIGHT + 5;
-    DrawLine(textX, currentY, panelBounds.x + panelBounds.width - EngineDialogCfg::DIALOG_PADDING, currentY,
+    textLayout.addLine(textX, currentY, panelBounds.x + panelBounds.width - EngineDialogCfg::DIALOG_PADDING, currentY,
              Color{200, 200, 200, 255});
     currentY += 10;
     
     if (analysis.hasResult && !analysis.lines.empty()) {
-        drawText("Analysis Results:", textX, currentY, 19, Color{60, 60, 60, 255});
+        std::string resultsText = 
+            (analysis.depth > 0) ?
+            "Analysis Results (depth " + std::to_string(analysis.depth) + "):" :
+            "Analysis Results:";
+        addText(resultsText, textX, currentY, 19, Color{60, 60, 60, 255});
         currentY += EngineDialogCfg::LINE_HEIGHT + 5;
         
         // Draw analysis lines
         for (const AnalysisLine& line : analysis.lines) {
             if (!line.text.empty() && currentY < panelBounds.y + panelBounds.height - EngineDialogCfg::DIALOG_PADDING) {
-                drawAnalysisLine(line.text, line.multipv, currentY);
+                layoutAnalysisLine(line.text, line.multipv, currentY);
             }
         }
     } else {
@@ -146,11 +159,11 @@ void EngineComp::drawEngineAnalysis() const {
             helpText = "No analysis results available";
         }
         
-        drawText(helpText, textX, currentY, 18, Color{128, 128, 128, 255});
+        addText(helpText, textX, currentY, 18, Color{128, 128, 128, 255});
     }
 }
 
-void EngineComp::drawAnalysisLine(const std::string& text, const int multipv, int& currentY) const {
+void EngineComp::layoutAnalysisLine(const std::string& text, const int multipv, int& currentY) const {
     Rectangle panelBounds = getDialogBounds();
     
     int textX = panelBounds.x + EngineDialogCfg::DIALOG_PADDING + 8; // Slight indent for analysis lines
@@ -159,7 +172,7 @@ void EngineComp::drawAnalysisLine(const std::string& text, const int multipv, in
     std::string displayText = text;
     int maxWidth = EngineDialogCfg::DIALOG_WIDTH - (EngineDialogCfg::DIALOG_PADDING * 2) - 16;
     
-    while (MeasureText(displayText.c_str(), 16) > maxWidth && displayText.length() > 10) {
+    while (UIRenderer::measureMonospaceText(displayText, 16) > maxWidth && displayText.length() > 10) {
         displayText = displayText.substr(0, displayText.length() - 4) + "...";
     }
     
@@ -172,10 +185,10 @@ void EngineComp::drawAnalysisLine(const std::string& text, const int multipv, in
         default: lineColor = Color{108, 117, 125, 255}; break; // Secondary gray
     }
     
-    drawText(displayText, textX, currentY, 16, lineColor);
+    addText(displayText, textX, currentY, 16, lineColor);
     currentY += EngineDialogCfg::LINE_HEIGHT;
 }
 
-void EngineComp::drawText(const std::string& text, int x, int y, int fontSize, Color textColor) const {
-    UIRenderer::drawTextWithShadow(text, x, y, fontSize, textColor);
+void EngineComp::addText(const std::string& text, int x, int y, int fontSize, Color textColor) const {
+    textLayout.addText(text, x, y, fontSize, textColor);
 }
\ No newline at end of file
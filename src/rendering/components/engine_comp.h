@@ -3,6 +3,7 @@
 #include <raylib.h>
 #include "../../config/config.h"
 #include "../../application/chess_analysis_program.h"
+#include "text_layout_cache.h"
 
 class ChessAnalysisProgram;
 
@@ -11,20 +12,22 @@ public:
     EngineComp(const ChessAnalysisProgram& controller);
     
     void draw() const;
+    void drawChrome() const; // Static background, border and title (cached by ChessGUI)
     void setEngineRunning(bool isRunning);
+    Rectangle getDialogBounds() const;
 
 private:
     const ChessAnalysisProgram& controller;
     bool isEngineRunning;
+    mutable TextLayoutCache textLayout; // Rebuilt when the engine snapshot version or running state changes
     
     void drawDialogWindow() const;
     void drawDialogTitle() const;
-    void drawEngineStatus() const;
-    void drawEngineAnalysis() const;
-    void drawAnalysisLine(const std::string& text, const int multipv, int& currentY) const;
-    void drawEngineControls() const;
+    void layoutEngineStatus() const;
+    void layoutEngineAnalysis() const;
+    void layoutAnalysisLine(const std::string& text, const int multipv, int& currentY) const;
+    void layoutEngineControls() const;
     
     // Helper functions
-    Rectangle getDialogBounds() const;
-    void drawText(const std::string& text, int x, int y, int fontSize, Color textColor) const;
+    void addText(const std::string& text, int x, int y, int fontSize, Color textColor) const;
 };
\ No newline at end of file
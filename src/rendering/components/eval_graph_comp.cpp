@@ -0,0 +1,187 @@
+#include "eval_graph_comp.h"
+#include "ui_renderer.h"
+#include "../../config/config.h"
+#include "../../profiling/profiler.h"
+
+namespace EvalGraphCfg = Config::EvalGraphPanel;
+
+EvalGraphComp::EvalGraphComp(const ChessAnalysisProgram& controller) :
+    controller(controller) {}
+
+void EvalGraphComp::draw() const {
+    PROFILE_SCOPE("EvalGraphComp::draw");
+
+    // Both versions only grow, so their sum changes whenever either does
+    const uint64_t layoutKey = controller.getGameReviewVersion() + controller.getHistoryVersion();
+    if (!textLayout.isCurrent(layoutKey)) {
+        textLayout.begin(layoutKey);
+        layoutReview(getDialogBounds());
+    }
+    textLayout.draw();
+}
+
+void EvalGraphComp::drawChrome() const {
+    Rectangle panelBounds = getDialogBounds();
+
+    UIRenderer::drawPanelBackground(panelBounds, UIRenderer::PanelStyle::Moves);
+    UIRenderer::drawPanelBorder(panelBounds);
+    UIRenderer::drawPanelShadowLeft(panelBounds, 8);
+    drawDialogTitle(panelBounds);
+}
+
+Rectangle EvalGraphComp::getDialogBounds() const {
+    // Right side, directly below the moves panel
+    float movesBottom = (Config::Window::HEIGHT + Config::MovesPanel::PANEL_HEIGHT) / 2.0f;
+    return Rectangle{
+        static_cast<float>(Config::Window::WIDTH - EvalGraphCfg::PANEL_WIDTH),
+        movesBottom + EvalGraphCfg::PANEL_MARGIN,
+        EvalGraphCfg::PANEL_WIDTH,
+        EvalGraphCfg::PANEL_HEIGHT
+    };
+}
+
+void EvalGraphComp::drawDialogTitle(const Rectangle& panelBounds) const {
+    UIRenderer::drawPanelTitle(panelBounds, EvalGraphCfg::TITLE_TEXT,
+                                EvalGraphCfg::TITLE_HEIGHT, EvalGraphCfg::PANEL_PADDING);
+}
+
+void EvalGraphComp::layoutReview(const Rectangle& panelBounds) const {
+    const std::vector<PlyEvaluation> evaluations = controller.getGameReview();
+    if (evaluations.empty()) {
+        textLayout.addText(
+            "Press (G) to review the whole game",
+            panelBounds.x + EvalGraphCfg::PANEL_PADDING,
+            panelBounds.y + EvalGraphCfg::TITLE_HEIGHT + 8 + EvalGraphCfg::PANEL_PADDING,
+            18,
+            Color{128, 128, 128, 255});
+        return;
+    }
+
+    layoutSummary(panelBounds, evaluations);
+    layoutGraph(getGraphBounds(panelBounds), evaluations);
+}
+
+void EvalGraphComp::layoutSummary(const Rectangle& panelBounds, const std::vector<PlyEvaluation>& evaluations) const {
+    // Inaccuracies/mistakes/blunders per side, or progress while the review runs
+    int counts[2][3] = {};
+    int analyzed = 0;
+    for (const PlyEvaluation& evaluation : evaluations) {
+        if (evaluation.isAnalyzed)
+            analyzed++;
+        const int side =
+            (evaluation.sideToMove == 'w') ?
+            0 :
+            1;
+        switch (evaluation.classification) {
+            case MoveClassification::Inaccuracy: counts[side][0]++; break;
+            case MoveClassification::Mistake: counts[side][1]++; break;
+            case MoveClassification::Blunder: counts[side][2]++; break;
+            default: break;
+        }
+    }
+
+    std::string summary;
+    if (controller.isGameReviewRunning())
+        summary = "Reviewing... " + std::to_string(analyzed) + "/" + std::to_string(evaluations.size()) + " positions";
+    else
+        summary = 
+            "White " + std::to_string(counts[0][0]) + "?! " + std::to_string(counts[0][1]) + "? " + std::to_string(counts[0][2]) + "??" +
+            "   Black " + std::to_string(counts[1][0]) + "?! " + std::to_string(counts[1][1]) + "? " + std::to_string(counts[1][2]) + "??";
+
+    textLayout.addText(
+        summary,
+        panelBounds.x + EvalGraphCfg::PANEL_PADDING,
+        panelBounds.y + EvalGraphCfg::TITLE_HEIGHT + 8,
+        16,
+        Color{60, 65, 70, 255});
+}
+
+void EvalGraphComp::layoutGraph(const Rectangle& graphBounds, const std::vector<PlyEvaluation>& evaluations) const {
+    const size_t plyCount = evaluations.size();
+
+    // Equal position axis
+    const int zeroY = scoreToY(graphBounds, 0);
+    textLayout.addLine(graphBounds.x, zeroY, graphBounds.x + graphBounds.width, zeroY, EvalGraphCfg::AXIS_COLOR);
+
+    // Bad moves as markers at the position they led to
+    for (size_t ply = 0; ply + 1 < plyCount; ply++) {
+        const MoveClassification classification = evaluations[ply].classification;
+        if (classification != MoveClassification::Inaccuracy &&
+                classification != MoveClassification::Mistake &&
+                classification != MoveClassification::Blunder)
+            continue;
+        const Color markerColor =
+            (classification == MoveClassification::Blunder) ?
+            EvalGraphCfg::BLUNDER_COLOR :
+            (classification == MoveClassification::Mistake) ?
+            EvalGraphCfg::MISTAKE_COLOR :
+            EvalGraphCfg::INACCURACY_COLOR;
+        const int x = plyToX(graphBounds, ply + 1, plyCount);
+        textLayout.addLine(x, graphBounds.y, x, graphBounds.y + graphBounds.height, markerColor);
+    }
+
+    // Where the board is, if it is on the reviewed line
+    const int currentPly = getCurrentReviewPly(evaluations);
+    if (currentPly >= 0) {
+        const int x = plyToX(graphBounds, currentPly, plyCount);
+        textLayout.addLine(x, graphBounds.y, x, graphBounds.y + graphBounds.height, EvalGraphCfg::CURRENT_PLY_COLOR);
+    }
+
+    // Evaluation curve (White's point of view) through the analyzed positions
+    bool hasPrevious = false;
+    int previousX = 0;
+    int previousY = 0;
+    for (size_t ply = 0; ply < plyCount; ply++) {
+        if (!evaluations[ply].isAnalyzed) {
+            hasPrevious = false;
+            continue;
+        }
+        const int x = plyToX(graphBounds, ply, plyCount);
+        const int y = scoreToY(graphBounds, GameAnalyzer::getCappedScore(evaluations[ply]));
+        if (hasPrevious)
+            textLayout.addLine(previousX, previousY, x, y, EvalGraphCfg::LINE_COLOR);
+        else
+            textLayout.addLine(x, y, x + 1, y, EvalGraphCfg::LINE_COLOR); // Isolated point
+        hasPrevious = true;
+        previousX = x;
+        previousY = y;
+    }
+}
+
+Rectangle EvalGraphComp::getGraphBounds(const Rectangle& panelBounds) const {
+    const float top = panelBounds.y + EvalGraphCfg::TITLE_HEIGHT + 8 + EvalGraphCfg::SUMMARY_HEIGHT;
+    return Rectangle{
+        panelBounds.x + EvalGraphCfg::PANEL_PADDING,
+        top,
+        panelBounds.width - 2 * EvalGraphCfg::PANEL_PADDING,
+        panelBounds.y + panelBounds.height - EvalGraphCfg::PANEL_PADDING - top
+    };
+}
+
+int EvalGraphComp::plyToX(const Rectangle& graphBounds, const size_t ply, const size_t plyCount) const {
+    if (plyCount < 2)
+        return static_cast<int>(graphBounds.x);
+    return static_cast<int>(graphBounds.x + graphBounds.width * ply / (plyCount - 1));
+}
+
+int EvalGraphComp::scoreToY(const Rectangle& graphBounds, const int score) const {
+    // White advantage up, capped scores span the full height
+    const float centerY = graphBounds.y + graphBounds.height / 2.0f;
+    return static_cast<int>(centerY - (graphBounds.height / 2.0f) * score / Config::Review::EVAL_CAP_CP);
+}
+
+int EvalGraphComp::getCurrentReviewPly(const std::vector<PlyEvaluation>& evaluations) const {
+    const std::vector<int32_t>& historyPath = controller.getHistoryPath();
+    const size_t ply = historyPath.size() - 1;
+    if (ply >= evaluations.size())
+        return -1;
+
+    const PositionKey currentKey = {
+        controller.getPositionNode(historyPath.back()).lineHash,
+        static_cast<uint32_t>(historyPath.size())
+    };
+    return 
+        (evaluations[ply].key == currentKey) ?
+        static_cast<int>(ply) :
+        -1;
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <raylib.h>
+#include <vector>
+#include "../../config/config.h"
+#include "../../application/chess_analysis_program.h"
+#include "text_layout_cache.h"
+
+class ChessAnalysisProgram;
+
+class EvalGraphComp {
+public:
+    EvalGraphComp(const ChessAnalysisProgram& controller);
+
+    void draw() const;
+    void drawChrome() const; // Static background, border and title (cached by ChessGUI)
+    Rectangle getDialogBounds() const;
+
+private:
+    const ChessAnalysisProgram& controller;
+    mutable TextLayoutCache textLayout; // Rebuilt when the review or the position history changes
+
+    void drawDialogTitle(const Rectangle& panelBounds) const;
+    void layoutReview(const Rectangle& panelBounds) const;
+    void layoutSummary(const Rectangle& panelBounds, const std::vector<PlyEvaluation>& evaluations) const;
+    void layoutGraph(const Rectangle& graphBounds, const std::vector<PlyEvaluation>& evaluations) const;
+
+    // Helper functions
+    Rectangle getGraphBounds(const Rectangle& panelBounds) const;
+    int plyToX(const Rectangle& graphBounds, const size_t ply, const size_t plyCount) const;
+    int scoreToY(const Rectangle& graphBounds, const int score) const;
+    int getCurrentReviewPly(const std::vector<PlyEvaluation>& evaluations) const; // -1 if off the reviewed line
+};
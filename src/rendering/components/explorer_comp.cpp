@@ -0,0 +1,131 @@
+#include "explorer_comp.h"
+#include "ui_renderer.h"
+#include "../../config/config.h"
+#include "../../profiling/profiler.h"
+
+namespace ExplorerCfg = Config::ExplorerPanel;
+
+namespace {
+    // Column offsets from the left padding
+    constexpr int GAMES_COLUMN = 80;
+    constexpr int RESULTS_COLUMN = 170;
+    constexpr int RESULT_WIDTH = 55;
+    constexpr Color HINT_COLOR = {128, 128, 128, 255};
+    constexpr Color SUMMARY_COLOR = {60, 65, 70, 255};
+    constexpr Color TEXT_COLOR = {40, 45, 55, 255};
+    constexpr Color WHITE_WINS_COLOR = {70, 110, 70, 255};
+    constexpr Color DRAW_COLOR = {100, 105, 115, 255};
+    constexpr Color BLACK_WINS_COLOR = {140, 60, 60, 255};
+}
+
+ExplorerComp::ExplorerComp(const ChessAnalysisProgram& controller) :
+    controller(controller) {}
+
+void ExplorerComp::draw() const {
+    PROFILE_SCOPE("ExplorerComp::draw");
+
+    // Lookups only happen when the position changes, so their version is the layout key
+    const uint64_t layoutKey = controller.getExplorerStats().version;
+    if (!textLayout.isCurrent(layoutKey)) {
+        textLayout.begin(layoutKey);
+        layoutMoves(getDialogBounds());
+    }
+    textLayout.draw();
+}
+
+void ExplorerComp::drawChrome() const {
+    Rectangle panelBounds = getDialogBounds();
+
+    UIRenderer::drawPanelBackground(panelBounds, UIRenderer::PanelStyle::Stats);
+    UIRenderer::drawPanelBorder(panelBounds);
+    UIRenderer::drawPanelShadowRight(panelBounds, 8);
+    drawDialogTitle(panelBounds);
+}
+
+Rectangle ExplorerComp::getDialogBounds() const {
+    // Left column, between EngineComp and ControlsComp
+    float totalPanelHeight = Config::StatsPanel::PANEL_HEIGHT + Config::EngineDialog::DIALOG_HEIGHT + ExplorerCfg::PANEL_HEIGHT + Config::ControlsPanel::PANEL_HEIGHT;
+    float verticalCenterOffset = (Config::Window::HEIGHT - totalPanelHeight) / 2.0f;
+    return Rectangle{
+        0,  // Align to left edge
+        verticalCenterOffset + Config::StatsPanel::PANEL_HEIGHT + Config::EngineDialog::DIALOG_HEIGHT,  // Start below EngineComp
+        ExplorerCfg::PANEL_WIDTH,
+        ExplorerCfg::PANEL_HEIGHT
+    };
+}
+
+void ExplorerComp::drawDialogTitle(const Rectangle& panelBounds) const {
+    UIRenderer::drawPanelTitle(panelBounds, ExplorerCfg::TITLE_TEXT,
+                                ExplorerCfg::TITLE_HEIGHT, ExplorerCfg::PANEL_PADDING);
+}
+
+void ExplorerComp::layoutMoves(const Rectangle& panelBounds) const {
+    const int textX = panelBounds.x + ExplorerCfg::PANEL_PADDING;
+    const int textY = panelBounds.y + ExplorerCfg::TITLE_HEIGHT + 8;
+    if (!controller.hasOpeningExplorer()) {
+        // Two lines: the hint is wider than the left column
+        textLayout.addText("No opening explorer", textX, textY + ExplorerCfg::PANEL_PADDING, ExplorerCfg::FONT_SIZE, HINT_COLOR);
+        textLayout.addText(
+            std::string("(build ") + Config::Database::EXPLORER_PATH + " with --index)",
+            textX,
+            textY + ExplorerCfg::PANEL_PADDING + ExplorerCfg::LINE_HEIGHT,
+            ExplorerCfg::FONT_SIZE,
+            HINT_COLOR);
+        return;
+    }
+
+    const ExplorerStats& explorerStats = controller.getExplorerStats();
+    if (explorerStats.moves.empty()) {
+        textLayout.addText("Position not in the opening tree", textX, textY, ExplorerCfg::FONT_SIZE, SUMMARY_COLOR);
+        textLayout.addText(
+            std::to_string(controller.getOpeningExplorerSize()) + " games aggregated",
+            textX,
+            textY + ExplorerCfg::LINE_HEIGHT,
+            ExplorerCfg::FONT_SIZE,
+            HINT_COLOR);
+        return;
+    }
+
+    // Column headers
+    textLayout.addText("Move", textX, textY, ExplorerCfg::FONT_SIZE, SUMMARY_COLOR);
+    textLayout.addText("Games", textX + GAMES_COLUMN, textY, ExplorerCfg::FONT_SIZE, SUMMARY_COLOR);
+    textLayout.addText("White", textX + RESULTS_COLUMN, textY, ExplorerCfg::FONT_SIZE, SUMMARY_COLOR);
+    textLayout.addText("Draw", textX + RESULTS_COLUMN + RESULT_WIDTH, textY, ExplorerCfg::FONT_SIZE, SUMMARY_COLOR);
+    textLayout.addText("Black", textX + RESULTS_COLUMN + 2 * RESULT_WIDTH, textY, ExplorerCfg::FONT_SIZE, SUMMARY_COLOR);
+    const int ratingWidth = UIRenderer::measureMonospaceText("Elo", ExplorerCfg::FONT_SIZE);
+    const int rowWidth = ExplorerCfg::PANEL_WIDTH - 2 * ExplorerCfg::PANEL_PADDING;
+    textLayout.addText("Elo", textX + rowWidth - ratingWidth, textY, ExplorerCfg::FONT_SIZE, SUMMARY_COLOR);
+
+    for (size_t row = 0; row < explorerStats.moves.size() && row < static_cast<size_t>(ExplorerCfg::MAX_ROWS); row++)
+        layoutMoveRow(panelBounds, explorerStats.moves[row], static_cast<int>(row));
+}
+
+void ExplorerComp::layoutMoveRow(const Rectangle& panelBounds, const ExplorerLine& line, const int row) const {
+    const int rowX = panelBounds.x + ExplorerCfg::PANEL_PADDING;
+    const int rowY = panelBounds.y + ExplorerCfg::TITLE_HEIGHT + 8 + 26 + row * ExplorerCfg::LINE_HEIGHT;
+    const int rowWidth = ExplorerCfg::PANEL_WIDTH - 2 * ExplorerCfg::PANEL_PADDING;
+    const ExplorerMove& stats = line.stats;
+
+    textLayout.addText(line.san, rowX, rowY, ExplorerCfg::FONT_SIZE, TEXT_COLOR);
+    textLayout.addText(std::to_string(stats.games), rowX + GAMES_COLUMN, rowY, ExplorerCfg::FONT_SIZE, TEXT_COLOR);
+
+    // Result shares of the games that have a result
+    const uint32_t decided = stats.whiteWins + stats.draws + stats.blackWins;
+    textLayout.addText(getPercentText(stats.whiteWins, decided), rowX + RESULTS_COLUMN, rowY, ExplorerCfg::FONT_SIZE, WHITE_WINS_COLOR);
+    textLayout.addText(getPercentText(stats.draws, decided), rowX + RESULTS_COLUMN + RESULT_WIDTH, rowY, ExplorerCfg::FONT_SIZE, DRAW_COLOR);
+    textLayout.addText(getPercentText(stats.blackWins, decided), rowX + RESULTS_COLUMN + 2 * RESULT_WIDTH, rowY, ExplorerCfg::FONT_SIZE, BLACK_WINS_COLOR);
+
+    // Average rating of the players who chose the move, right aligned
+    const std::string ratingText =
+        (stats.averageRating > 0) ?
+        std::to_string(stats.averageRating) :
+        "-";
+    const int ratingWidth = UIRenderer::measureMonospaceText(ratingText, ExplorerCfg::FONT_SIZE);
+    textLayout.addText(ratingText, rowX + rowWidth - ratingWidth, rowY, ExplorerCfg::FONT_SIZE, HINT_COLOR);
+}
+
+std::string ExplorerComp::getPercentText(const uint32_t count, const uint32_t total) {
+    if (total == 0)
+        return "-";
+    return std::to_string((static_cast<uint64_t>(count) * 100 + total / 2) / total) + "%";
+}
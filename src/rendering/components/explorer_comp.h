@@ -0,0 +1,31 @@
+#pragma once
+
+#include <raylib.h>
+#include <string>
+#include "../../database/opening_explorer.h"
+#include "../../config/config.h"
+#include "../../application/chess_analysis_program.h"
+#include "text_layout_cache.h"
+
+class ChessAnalysisProgram;
+struct ExplorerLine;
+
+class ExplorerComp {
+public:
+    ExplorerComp(const ChessAnalysisProgram& controller);
+
+    void draw() const;
+    void drawChrome() const; // Static background, border and title (cached by ChessGUI)
+    Rectangle getDialogBounds() const;
+
+private:
+    const ChessAnalysisProgram& controller;
+    mutable TextLayoutCache textLayout; // Rebuilt when a new lookup result arrives
+
+    void drawDialogTitle(const Rectangle& panelBounds) const;
+    void layoutMoves(const Rectangle& panelBounds) const;
+    void layoutMoveRow(const Rectangle& panelBounds, const ExplorerLine& line, const int row) const;
+
+    // Helper functions
+    static std::string getPercentText(const uint32_t count, const uint32_t total); // "38%"
+};
@@ -1,4 +1,5 @@
 #include "game_overlay.h"
+#include "../../profiling/profiler.h"
 
 namespace GOCfg = Config::GameOver;
 
@@ -6,6 +7,7 @@ GameOverlay::GameOverlay(const ChessAnalysisProgram& controller) :
     controller(controller) {}
 
 void GameOverlay::draw() const {
+    PROFILE_SCOPE("GameOverlay::draw");
     // Draw controls
     void drawControls();
 
@@ -0,0 +1,42 @@
+#include "move_hint_renderer.h"
+#include "piece_renderer.h"
+#include "../../application/chess_analysis_program.h"
+#include "../../config/config.h"
+
+namespace BoardCfg = Config::Board;
+namespace PieceCfg = Config::Pieces;
+namespace HintCfg = Config::MoveHints;
+
+MoveHintRenderer::MoveHintRenderer(const ChessAnalysisProgram& controller, const PieceRenderer& pieceRenderer) :
+    controller(controller), pieceRenderer(pieceRenderer) {
+}
+
+void MoveHintRenderer::draw() const {
+    if (!controller.getIsDragging())
+        return;
+
+    // Destinations come from the controller's legal move cache (empty for the opponent's pieces)
+    Bitboard targets = controller.getLegalDestinations(
+        controller.getDraggedPieceRank(),
+        controller.getDraggedPieceFile());
+    while (targets) {
+        const Square square = Bitboards::popLsb(targets);
+        const int rank = rankOf(square);
+        const int file = fileOf(square);
+        const Vector2 pieceScreenPos =
+            pieceRenderer.boardPosToScreenPos({
+                static_cast<float>(file),
+                static_cast<float>(rank)
+            });
+        const Vector2 center = {
+            pieceScreenPos.x + PieceCfg::SIZE / 2.0f,
+            pieceScreenPos.y + PieceCfg::SIZE / 2.0f
+        };
+
+        if (controller.getPieceAt(rank, file) == BoardCfg::EMPTY)
+            DrawCircleV(center, HintCfg::DOT_RADIUS, HintCfg::HINT_COLOR);
+        else
+            DrawRing(center, HintCfg::RING_RADIUS - HintCfg::RING_WIDTH, HintCfg::RING_RADIUS,
+                0.0f, 360.0f, HintCfg::RING_SEGMENTS, HintCfg::HINT_COLOR);
+    }
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <raylib.h>
+
+class ChessAnalysisProgram;
+class PieceRenderer;
+
+/**
+ * Handles rendering the legal destinations of the dragged piece
+ * (dots on empty squares, rings around capturable pieces)
+ */
+class MoveHintRenderer {
+public:
+    MoveHintRenderer(const ChessAnalysisProgram& controller, const PieceRenderer& pieceRenderer);
+
+    void draw() const;
+
+private:
+    const ChessAnalysisProgram& controller;
+    const PieceRenderer& pieceRenderer;
+};
@@ -1,6 +1,8 @@
 #include "moves_comp.h"
 #include "ui_renderer.h"
 #include "../../config/config.h"
+#include "../../profiling/profiler.h"
+#include <utility>
 
 namespace MoveCFG = Config::MovesPanel;
 
@@ -8,20 +10,28 @@ MovesComp::MovesComp(const ChessAnalysisProgram& controller) :
     controller(controller) {}
 
 void MovesComp::draw() const {
+    PROFILE_SCOPE("MovesComp::draw");
     drawDialogWindow();
 }
 
-void MovesComp::drawDialogWindow() const {
+void MovesComp::drawChrome() const {
     Rectangle panelBounds = getDialogBounds();
 
     // Draw panel using UIRenderer
     UIRenderer::drawPanelBackground(panelBounds, UIRenderer::PanelStyle::Moves);
     UIRenderer::drawPanelBorder(panelBounds);
     UIRenderer::drawPanelShadowLeft(panelBounds, 8);
-
-    // Draw content
     drawDialogTitle(panelBounds);
-    drawMoves(panelBounds);
+}
+
+void MovesComp::drawDialogWindow() const {
+    // Re-layout only when the history changed (chrome is cached in the static layer)
+    const uint64_t historyVersion = controller.getHistoryVersion();
+    if (!textLayout.isCurrent(historyVersion)) {
+        textLayout.begin(historyVersion);
+        layoutMoves(getDialogBounds());
+    }
+    textLayout.draw();
 }
 
 void MovesComp::drawDialogTitle(const Rectangle& panelBounds) const {
@@ -29,16 +39,17 @@ void MovesComp::drawDialogTitle(const Rectangle& panelBounds) const {
                                 MoveCFG::TITLE_HEIGHT, MoveCFG::PANEL_PADDING);
 }
 
-void MovesComp::drawMoves(const Rectangle& panelBounds) const {
-    const std::vector<PositionState> positionHistory = controller.getPositionHistory();
-    const std::vector<PositionState> positionRedos = controller.getRedoPositions();
+void MovesComp::layoutMoves(const Rectangle& panelBounds) const {
+    // Node indices into the variation tree (current line only)
+    const std::vector<int32_t>& positionHistory = controller.getHistoryPath();
+    const std::vector<int32_t>& positionRedos = controller.getRedoLine();
     if (positionHistory.size() < 2 && positionRedos.empty()) {
         std::string text = "No moves yet!";
         
         int textX = panelBounds.x + MoveCFG::PANEL_PADDING;
         int textY = panelBounds.y + MoveCFG::TITLE_HEIGHT + 8 + MoveCFG::PANEL_PADDING;
 
-        UIRenderer::drawTextWithShadow(
+        textLayout.addText(
             text, 
             textX, 
             textY, 
@@ -67,7 +78,7 @@ void MovesComp::drawMoves(const Rectangle& panelBounds) const {
             int movesToSkip = totalMoves - MoveCFG::MAX_MOVES_DISPLAYED + 1;
             startIndex = 1 + movesToSkip;
             // Start on black's move (even indices are black moves)
-            if (positionHistory.at(startIndex).movedBy == 'b')
+            if (controller.getPositionNode(positionHistory.at(startIndex)).state.movedBy == 'b')
                 startIndex += 1;
         // If there are redo moves, use pivot logic
         } else if (positionHistory.size() - 1 < MoveCFG::PIVOT_MOVE_INDEX + 2) {
@@ -77,20 +88,20 @@ void MovesComp::drawMoves(const Rectangle& panelBounds) const {
             // Redo fits after pivot, history will overflow
             isEllipsisBefore = true;
             startIndex = (positionHistory.size() - 1) - (MoveCFG::MAX_MOVES_DISPLAYED - positionRedos.size() - 1) + 1;
-            if (positionHistory.at(startIndex).movedBy == 'b')
+            if (controller.getPositionNode(positionHistory.at(startIndex)).state.movedBy == 'b')
                 startIndex += 1;
         } else {
             // Both overflow, center around current position
             isEllipsisBefore = true;
             isEllipsisAfter = true;
             startIndex = positionHistory.size() - MoveCFG::PIVOT_MOVE_INDEX;
-            if (positionHistory.at(startIndex).movedBy == 'b')
+            if (controller.getPositionNode(positionHistory.at(startIndex)).state.movedBy == 'b')
                 startIndex += 1;
         }
     }
     
     if (isEllipsisBefore) {
-        drawEllipsis(panelBounds, movesDrawnCount++);
+        layoutEllipsis(panelBounds, movesDrawnCount++);
     }
 
     // Draw historical moves
@@ -99,9 +110,9 @@ void MovesComp::drawMoves(const Rectangle& panelBounds) const {
         if (isEllipsisAfter && movesDrawnCount >= MoveCFG::MAX_MOVES_DISPLAYED - 1) {
             break;
         }
-        drawHistoricalMove(
+        layoutHistoricalMove(
             panelBounds, 
-            positionHistory.at(i), 
+            controller.getPositionNode(positionHistory.at(i)).state, 
             movesDrawnCount++, i >= positionHistory.size() - 1, i);
     }
     
@@ -114,75 +125,54 @@ void MovesComp::drawMoves(const Rectangle& panelBounds) const {
             else if (movesDrawnCount >= MoveCFG::MAX_MOVES_DISPLAYED)
                 break;
             int index = positionHistory.size() + positionRedos.size() - i - 1;
-            drawRedoMove(panelBounds, positionRedos.at(i), movesDrawnCount++, index);
+            layoutRedoMove(panelBounds, controller.getPositionNode(positionRedos.at(i)).state, movesDrawnCount++, index);
         }
     }
     
     // Draw trailing ellipsis if needed
     if (isEllipsisAfter && movesDrawnCount < MoveCFG::MAX_MOVES_DISPLAYED) {
-        drawEllipsis(panelBounds, movesDrawnCount++);
+        layoutEllipsis(panelBounds, movesDrawnCount++);
     }
 }
 
-void MovesComp::drawHistoricalMove(
+void MovesComp::layoutHistoricalMove(
     const Rectangle& panelBounds, 
     const PositionState& moveData, 
     const int movesCount, 
     const bool isLastMove, 
     const int index) const {
 
-    std::string moveText = getMoveText(moveData, movesCount, index);
-
-    // Calculate x and y positions
-    Vector2 textPosition = calcMoveTextPos(panelBounds, moveText, movesCount, MoveCFG::MOVE_FONT_SIZE);
-
     // Determine color
     Color moveColor =
         isLastMove ?
         Color{0, 0, 139, 255} :
         Color{45, 45, 45, 255};
-    // Draw the text
-    UIRenderer::drawTextWithShadow(
-            moveText, 
-            static_cast<int>(textPosition.x), 
-            static_cast<int>(textPosition.y), 
-            MoveCFG::MOVE_FONT_SIZE, 
-            moveColor);
+    layoutMoveText(panelBounds, getMoveText(moveData, movesCount, index), movesCount, moveColor);
 }
 
-void MovesComp::drawRedoMove(
+void MovesComp::layoutRedoMove(
     const Rectangle& panelBounds, 
     const PositionState& moveData, 
     const int movesCount,
     const int index) const {
 
-    std::string moveText = getMoveText(moveData, movesCount, index);
-
-    // Calculate x and y positions
-    Vector2 textPosition = calcMoveTextPos(panelBounds, moveText, movesCount, MoveCFG::MOVE_FONT_SIZE);
-
-    // Draw the text
-    UIRenderer::drawTextWithShadow(
-        moveText,
-        static_cast<int>(textPosition.x),
-        static_cast<int>(textPosition.y),
-        MoveCFG::MOVE_FONT_SIZE,
-        Color{128, 128, 128, 255});
+    layoutMoveText(panelBounds, getMoveText(moveData, movesCount, index), movesCount, Color{128, 128, 128, 255});
 }
 
-void MovesComp::drawEllipsis(const Rectangle& panelBounds, const int movesCount) const {
-    std::string moveText = MoveCFG::ELLIPSIS;
+void MovesComp::layoutEllipsis(const Rectangle& panelBounds, const int movesCount) const {
+    layoutMoveText(panelBounds, MoveCFG::ELLIPSIS, movesCount, Color{128, 128, 128, 255});
+}
 
-    // Calculate x and y positions
-    Vector2 textPosition = calcMoveTextPos(panelBounds, moveText, movesCount, MoveCFG::MOVE_FONT_SIZE);
+void MovesComp::layoutMoveText(const Rectangle& panelBounds, const std::string& moveText, const int movesCount, const Color& color) const {
+    // Shape once, then center using the measured width
+    UIRenderer::ShapedText shapedText = UIRenderer::shapeText(moveText, MoveCFG::MOVE_FONT_SIZE);
+    Vector2 textPosition = calcMoveTextPos(panelBounds, shapedText.width, movesCount);
 
-    // Draw the text
-    UIRenderer::drawTextWithShadow(
-            moveText, 
-            static_cast<int>(textPosition.x), 
-            static_cast<int>(textPosition.y), 
-            MoveCFG::MOVE_FONT_SIZE, 
-            Color{128, 128, 128, 255});
+    textLayout.add(
+        std::move(shapedText),
+        static_cast<int>(textPosition.x),
+        static_cast<int>(textPosition.y),
+        color);
 }
 
 Rectangle MovesComp::getDialogBounds() const {
@@ -197,7 +187,7 @@ Rectangle MovesComp::getDialogBounds() const {
     };
 }
 
-Vector2 MovesComp::calcMoveTextPos(const Rectangle& panelBounds, const std::string& moveText, const int movesCount, const int fontSize) const {
+Vector2 MovesComp::calcMoveTextPos(const Rectangle& panelBounds, const float textWidth, const int movesCount) const {
     int movePerCol = MoveCFG::MOVES_PER_ROW;
     int gridRows = MoveCFG::GRID_ROWS;
 
@@ -215,9 +205,8 @@ Vector2 MovesComp::calcMoveTextPos(const Rectangle& panelBounds, const std::stri
         return {-1000.0f, -1000.0f};
     }
 
-    // Measure text width and center it within the cell
-    int textWidth = MeasureText(moveText.c_str(), fontSize);
-    int textX = cellX + (cellWidth - textWidth) / 2;  // Center horizontally in cell
+    // Center the measured text within the cell
+    int textX = cellX + (cellWidth - static_cast<int>(textWidth)) / 2;  // Center horizontally in cell
     int textY = cellY; // Keep vertical position at top of cell
 
     return {static_cast<float>(textX), static_cast<float>(textY)};
@@ -230,7 +219,7 @@ std::string MovesComp::getMoveText(const PositionState& moveData, const int move
         "" :
         std::to_string(index / 2 + 1) + ". " ;
     // Get the rest of the move text
-    moveText += moveData.algebraicMove;
+    moveText += moveData.move.toAlgebraicNotation();
 
     return moveText;
 }
\ No newline at end of file
@@ -3,6 +3,7 @@
 #include <raylib.h>
 #include "../../config/config.h"
 #include "../../application/chess_analysis_program.h"
+#include "text_layout_cache.h"
 
 class ChessAnalysisProgram;
 
@@ -11,20 +12,22 @@ public:
     MovesComp(const ChessAnalysisProgram& controller);
 
     void draw() const;
+    void drawChrome() const; // Static background, border and title (cached by ChessGUI)
+    Rectangle getDialogBounds() const;
 
 private:
     const ChessAnalysisProgram& controller;
-
+    mutable TextLayoutCache textLayout; // Rebuilt when the move history version changes
 
     void drawDialogWindow() const;
     void drawDialogTitle(const Rectangle& panelBounds) const;
-    void drawMoves(const Rectangle& panelBounds) const;
-    void drawHistoricalMove(const Rectangle& panelBounds, const PositionState& moveData, const int movesCount, const bool isLastMove, const int index) const;
-    void drawRedoMove(const Rectangle& panelBounds, const PositionState& moveData, const int movesCount, const int index) const;
-    void drawEllipsis(const Rectangle& panelBounds, const int movesCount) const;
+    void layoutMoves(const Rectangle& panelBounds) const;
+    void layoutHistoricalMove(const Rectangle& panelBounds, const PositionState& moveData, const int movesCount, const bool isLastMove, const int index) const;
+    void layoutRedoMove(const Rectangle& panelBounds, const PositionState& moveData, const int movesCount, const int index) const;
+    void layoutEllipsis(const Rectangle& panelBounds, const int movesCount) const;
+    void layoutMoveText(const Rectangle& panelBounds, const std::string& moveText, const int movesCount, const Color& color) const;
 
     // Helper functions
-    Rectangle getDialogBounds() const;
-    Vector2 calcMoveTextPos(const Rectangle& panelBounds, const std::string& moveText, const int movesCount, const int fontSize) const;
+    Vector2 calcMoveTextPos(const Rectangle& panelBounds, const float textWidth, const int movesCount) const;
     std::string getMoveText(const PositionState& moveData, const int movesCount, const int index) const;
 };
\ No newline at end of file
@@ -12,7 +12,6 @@ PieceRenderer::PieceRenderer(const ChessAnalysisProgram& controller, const Textu
 
 void PieceRenderer::draw() const {
     drawPieces();
-    drawDraggedPiece();
 }
 
 Vector2 PieceRenderer::screenPosToBoardPos(const Vector2 pos) const {
@@ -48,7 +47,7 @@ Vector2 PieceRenderer::boardPosToScreenPos(const Vector2 pos) const {
 }
 
 void PieceRenderer::drawPieces() const {
-    // Draw all playable pieces not being dragged
+    // Draw all playable pieces not being dragged (every sprite comes from the atlas, so this batches)
     for (int rank = BoardCfg::MIN_RANK; rank <= BoardCfg::MAX_RANK; rank++) {
         for (int file = BoardCfg::MIN_FILE; file <= BoardCfg::MAX_FILE; file++) {
             // Skip piece if being dragged
@@ -59,14 +58,12 @@ void PieceRenderer::drawPieces() const {
             // Draw playable pieces
             char currentPiece = controller.getPieceAt(rank, file);
             if (currentPiece != BoardCfg::EMPTY) {
-                std::string pieceString = controller.pieceToTextureString(currentPiece);
                 const Vector2 screenPos = 
                     boardPosToScreenPos({
                         static_cast<float>(file), 
                         static_cast<float>(rank)
                     });
-                DrawTextureEx(textureManager.getPieceTexture(pieceString), screenPos, 0.0f, 
-                    PieceCfg::SCALE, WHITE);
+                textureManager.drawPiece(currentPiece, screenPos, PieceCfg::SCALE);
             }
         }
     }
@@ -76,7 +73,6 @@ void PieceRenderer::drawDraggedPiece() const {
     // Draw the dragged piece at mouse position
     if (controller.getIsDragging()) {
         const Vector2 mousePos = GetMousePosition();
-        std::string pieceString = controller.pieceToTextureString(controller.getDraggedPiece());
         Vector2 dragOffset = controller.getDragOffset();
 
         // Calculate draw position
@@ -86,8 +82,7 @@ void PieceRenderer::drawDraggedPiece() const {
         };
 
         // Draw the piece being dragged
-        DrawTextureEx(textureManager.getPieceTexture(pieceString), drawPos, 0.0f,
-            PieceCfg::SCALE, WHITE);
+        textureManager.drawPiece(controller.getDraggedPiece(), drawPos, PieceCfg::SCALE);
     }
 }
 
@@ -14,6 +14,7 @@ public:
     PieceRenderer(const ChessAnalysisProgram& controller, const TextureManager& textureManager);
     
     void draw() const;
+    void drawDraggedPiece() const; // Follows the mouse, so drawn live every frame
     
     // Board utilities
     Vector2 screenPosToBoardPos(const Vector2 pos) const;
@@ -24,5 +25,4 @@ private:
     const TextureManager& textureManager;
     
     void drawPieces() const;
-    void drawDraggedPiece() const;
 };
\ No newline at end of file
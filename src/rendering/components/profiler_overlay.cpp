@@ -0,0 +1,99 @@
+#include "profiler_overlay.h"
+#include "ui_renderer.h"
+#include "../../application/chess_analysis_program.h"
+#include "../../profiling/profiler.h"
+#include <algorithm>
+
+namespace ProfilerCfg = Config::Profiler;
+
+ProfilerOverlay::ProfilerOverlay(const ChessAnalysisProgram& controller) :
+    controller(controller) {}
+
+void ProfilerOverlay::draw() const {
+    if (!controller.getProfilerOverlayVisible())
+        return;
+
+    Rectangle bounds = getOverlayBounds();
+    DrawRectangleRec(bounds, ProfilerCfg::BACKGROUND_COLOR);
+
+    int textX = bounds.x + ProfilerCfg::OVERLAY_PADDING;
+    int currentY = bounds.y + ProfilerCfg::OVERLAY_PADDING;
+
+    if (!Profiler::isCompiledIn()) {
+        UIRenderer::drawTextWithShadow("Profiling disabled", textX, currentY,
+            ProfilerCfg::OVERLAY_FONT_SIZE, ProfilerCfg::TEXT_COLOR);
+        currentY += ProfilerCfg::OVERLAY_LINE_HEIGHT;
+        UIRenderer::drawTextWithShadow("Rebuild with -DCHESS_PROFILING", textX, currentY,
+            ProfilerCfg::OVERLAY_FONT_SIZE, ProfilerCfg::TEXT_COLOR);
+        return;
+    }
+
+    // Frame time summary over the recorded history
+    std::vector<float> history = Profiler::getFrameHistoryMs();
+    float lastMs = history.empty() ? 0.0f : history.back();
+    float maxMs = history.empty() ? 0.0f : *std::max_element(history.begin(), history.end());
+    float avgMs = 0.0f;
+    for (float frameMs : history)
+        avgMs += frameMs;
+    if (!history.empty())
+        avgMs /= history.size();
+
+    UIRenderer::drawTextWithShadow(
+        TextFormat("Frame %.2f ms  avg %.2f  max %.2f", lastMs, avgMs, maxMs),
+        textX, currentY, ProfilerCfg::OVERLAY_FONT_SIZE, ProfilerCfg::TEXT_COLOR);
+    currentY += ProfilerCfg::OVERLAY_LINE_HEIGHT + 4;
+
+    Rectangle graphBounds = {
+        static_cast<float>(textX),
+        static_cast<float>(currentY),
+        bounds.width - 2 * ProfilerCfg::OVERLAY_PADDING,
+        static_cast<float>(ProfilerCfg::GRAPH_HEIGHT)
+    };
+    drawFrameGraph(graphBounds);
+    currentY += ProfilerCfg::GRAPH_HEIGHT + 8;
+
+    drawZoneList(textX, currentY);
+}
+
+void ProfilerOverlay::drawFrameGraph(const Rectangle& graphBounds) const {
+    std::vector<float> history = Profiler::getFrameHistoryMs();
+
+    // Frame budget line for the target frame rate
+    float budgetMs = 1000.0f / Config::Window::TARGET_FPS;
+    float budgetY = graphBounds.y + graphBounds.height * (1.0f - budgetMs / ProfilerCfg::GRAPH_MAX_MS);
+    DrawLine(graphBounds.x, budgetY, graphBounds.x + graphBounds.width, budgetY, ProfilerCfg::BUDGET_COLOR);
+
+    // One bar per frame, newest on the right
+    float barWidth = graphBounds.width / ProfilerCfg::FRAME_HISTORY_SIZE;
+    float startX = graphBounds.x + graphBounds.width - history.size() * barWidth;
+    for (size_t i = 0; i < history.size(); i++) {
+        float ratio = std::min(history[i] / ProfilerCfg::GRAPH_MAX_MS, 1.0f);
+        float barHeight = graphBounds.height * ratio;
+        DrawRectangleRec(
+            { startX + i * barWidth, graphBounds.y + graphBounds.height - barHeight, std::max(barWidth, 1.0f), barHeight },
+            history[i] > budgetMs ? ProfilerCfg::BUDGET_COLOR : ProfilerCfg::GRAPH_COLOR);
+    }
+}
+
+void ProfilerOverlay::drawZoneList(int textX, int& currentY) const {
+    std::vector<ProfileZoneSummary> zones = Profiler::getLastFrameZones();
+
+    int shown = 0;
+    for (const ProfileZoneSummary& zone : zones) {
+        if (shown++ >= ProfilerCfg::MAX_ZONES_SHOWN)
+            break;
+        UIRenderer::drawTextWithShadow(
+            TextFormat("%-28s %7.3f ms x%d", zone.name, zone.totalNs / 1.0e6, zone.calls),
+            textX, currentY, ProfilerCfg::OVERLAY_FONT_SIZE, ProfilerCfg::TEXT_COLOR);
+        currentY += ProfilerCfg::OVERLAY_LINE_HEIGHT;
+    }
+}
+
+Rectangle ProfilerOverlay::getOverlayBounds() const {
+    return Rectangle{
+        ProfilerCfg::OVERLAY_X,
+        ProfilerCfg::OVERLAY_Y,
+        ProfilerCfg::OVERLAY_WIDTH,
+        ProfilerCfg::OVERLAY_HEIGHT
+    };
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <raylib.h>
+#include "../../config/config.h"
+
+class ChessAnalysisProgram;
+
+/**
+ * Debug overlay showing frame-time history and the most expensive zones of the last frame
+ */
+class ProfilerOverlay {
+public:
+    ProfilerOverlay(const ChessAnalysisProgram& controller);
+
+    void draw() const;
+
+private:
+    const ChessAnalysisProgram& controller;
+
+    void drawFrameGraph(const Rectangle& graphBounds) const;
+    void drawZoneList(int textX, int& currentY) const;
+    Rectangle getOverlayBounds() const;
+};
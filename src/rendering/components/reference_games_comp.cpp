@@ -0,0 +1,126 @@
+#include "reference_games_comp.h"
+#include "ui_renderer.h"
+#include "../../config/config.h"
+#include "../../profiling/profiler.h"
+#include <algorithm>
+
+namespace RefGamesCfg = Config::ReferenceGamesPanel;
+
+namespace {
+    constexpr int RESULT_COLUMN_WIDTH = 60;
+    constexpr Color HINT_COLOR = {128, 128, 128, 255};
+    constexpr Color SUMMARY_COLOR = {60, 65, 70, 255};
+    constexpr Color TEXT_COLOR = {40, 45, 55, 255};
+}
+
+ReferenceGamesComp::ReferenceGamesComp(const ChessAnalysisProgram& controller) :
+    controller(controller) {}
+
+void ReferenceGamesComp::draw() const {
+    PROFILE_SCOPE("ReferenceGamesComp::draw");
+
+    // Lookups only happen when the position changes, so their version is the layout key
+    const uint64_t layoutKey = controller.getReferenceGames().version;
+    if (!textLayout.isCurrent(layoutKey)) {
+        textLayout.begin(layoutKey);
+        layoutGames(getDialogBounds());
+    }
+    textLayout.draw();
+}
+
+void ReferenceGamesComp::drawChrome() const {
+    Rectangle panelBounds = getDialogBounds();
+
+    UIRenderer::drawPanelBackground(panelBounds, UIRenderer::PanelStyle::Moves);
+    UIRenderer::drawPanelBorder(panelBounds);
+    UIRenderer::drawPanelShadowLeft(panelBounds, 8);
+    drawDialogTitle(panelBounds);
+}
+
+Rectangle ReferenceGamesComp::getDialogBounds() const {
+    // Right side, directly above the moves panel
+    float movesTop = (Config::Window::HEIGHT - Config::MovesPanel::PANEL_HEIGHT) / 2.0f;
+    return Rectangle{
+        static_cast<float>(Config::Window::WIDTH - RefGamesCfg::PANEL_WIDTH),
+        movesTop - RefGamesCfg::PANEL_MARGIN - RefGamesCfg::PANEL_HEIGHT,
+        RefGamesCfg::PANEL_WIDTH,
+        RefGamesCfg::PANEL_HEIGHT
+    };
+}
+
+void ReferenceGamesComp::drawDialogTitle(const Rectangle& panelBounds) const {
+    UIRenderer::drawPanelTitle(panelBounds, RefGamesCfg::TITLE_TEXT,
+                                RefGamesCfg::TITLE_HEIGHT, RefGamesCfg::PANEL_PADDING);
+}
+
+void ReferenceGamesComp::layoutGames(const Rectangle& panelBounds) const {
+    const int textX = panelBounds.x + RefGamesCfg::PANEL_PADDING;
+    const int textY = panelBounds.y + RefGamesCfg::TITLE_HEIGHT + 8;
+    if (!controller.hasGameDatabase()) {
+        textLayout.addText(
+            std::string("No game database (build ") + Config::Database::INDEX_PATH + " with --index)",
+            textX,
+            textY + RefGamesCfg::PANEL_PADDING,
+            RefGamesCfg::FONT_SIZE,
+            HINT_COLOR);
+        return;
+    }
+
+    const ReferenceGames& referenceGames = controller.getReferenceGames();
+    const std::string summary =
+        (referenceGames.totalGames == 0) ?
+        "Position not found in " + std::to_string(controller.getGameDatabaseSize()) + " games" :
+        std::to_string(referenceGames.totalGames) + " of " + std::to_string(controller.getGameDatabaseSize()) + " games reach this position";
+    textLayout.addText(summary, textX, textY, RefGamesCfg::FONT_SIZE, SUMMARY_COLOR);
+
+    for (size_t row = 0; row < referenceGames.games.size() && row < static_cast<size_t>(RefGamesCfg::MAX_ROWS); row++)
+        layoutGameRow(panelBounds, referenceGames.games[row], static_cast<int>(row));
+}
+
+void ReferenceGamesComp::layoutGameRow(const Rectangle& panelBounds, const ReferenceGame& game, const int row) const {
+    const int rowX = panelBounds.x + RefGamesCfg::PANEL_PADDING;
+    const int rowY = panelBounds.y + RefGamesCfg::TITLE_HEIGHT + 8 + 26 + row * RefGamesCfg::LINE_HEIGHT;
+    const int rowWidth = RefGamesCfg::PANEL_WIDTH - 2 * RefGamesCfg::PANEL_PADDING;
+
+    // Move at which the game reached the position, right aligned
+    const std::string moveText = "move " + std::to_string(game.ply / 2 + 1);
+    const int moveWidth = UIRenderer::measureMonospaceText(moveText, RefGamesCfg::FONT_SIZE);
+    textLayout.addText(moveText, rowX + rowWidth - moveWidth, rowY, RefGamesCfg::FONT_SIZE, HINT_COLOR);
+
+    textLayout.addText(getResultText(game.game.result), rowX, rowY, RefGamesCfg::FONT_SIZE, TEXT_COLOR);
+
+    // "White - Black, Event 2024"
+    std::string description = game.game.white + " - " + game.game.black;
+    const std::string year = game.game.date.substr(0, 4);
+    if (!game.game.event.empty() && game.game.event != "?")
+        description += ", " + game.game.event;
+    if (!year.empty() && year != "????")
+        description += " " + year;
+    const int descriptionWidth = rowWidth - RESULT_COLUMN_WIDTH - moveWidth - 10;
+    textLayout.addText(
+        fitText(description, RefGamesCfg::FONT_SIZE, descriptionWidth),
+        rowX + RESULT_COLUMN_WIDTH,
+        rowY,
+        RefGamesCfg::FONT_SIZE,
+        TEXT_COLOR);
+}
+
+std::string ReferenceGamesComp::getResultText(const GameResult result) {
+    switch (result) {
+        case GameResult::WhiteWins: return "1-0";
+        case GameResult::BlackWins: return "0-1";
+        case GameResult::Draw: return "1/2";
+        default: return "*";
+    }
+}
+
+std::string ReferenceGamesComp::fitText(const std::string& text, const int fontSize, const int maxWidth) {
+    if (UIRenderer::measureMonospaceText(text, fontSize) <= maxWidth)
+        return text;
+
+    // Monospace: every glyph has the same advance
+    const int ellipsisWidth = UIRenderer::measureMonospaceText("...", fontSize);
+    const int glyphWidth = std::max(1, UIRenderer::measureMonospaceText("M", fontSize));
+    const int keptGlyphs = std::max(0, (maxWidth - ellipsisWidth) / glyphWidth);
+    return text.substr(0, keptGlyphs) + "...";
+}
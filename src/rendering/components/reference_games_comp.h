@@ -0,0 +1,32 @@
+#pragma once
+
+#include <raylib.h>
+#include <string>
+#include "../../database/position_index.h"
+#include "../../config/config.h"
+#include "../../application/chess_analysis_program.h"
+#include "text_layout_cache.h"
+
+class ChessAnalysisProgram;
+struct ReferenceGame;
+
+class ReferenceGamesComp {
+public:
+    ReferenceGamesComp(const ChessAnalysisProgram& controller);
+
+    void draw() const;
+    void drawChrome() const; // Static background, border and title (cached by ChessGUI)
+    Rectangle getDialogBounds() const;
+
+private:
+    const ChessAnalysisProgram& controller;
+    mutable TextLayoutCache textLayout; // Rebuilt when a new lookup result arrives
+
+    void drawDialogTitle(const Rectangle& panelBounds) const;
+    void layoutGames(const Rectangle& panelBounds) const;
+    void layoutGameRow(const Rectangle& panelBounds, const ReferenceGame& game, const int row) const;
+
+    // Helper functions
+    static std::string getResultText(const GameResult result);
+    static std::string fitText(const std::string& text, const int fontSize, const int maxWidth); // Cut with "..." if too wide
+};
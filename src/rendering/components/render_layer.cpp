@@ -0,0 +1,90 @@
+#include "render_layer.h"
+#include <rlgl.h>
+#include <algorithm>
+
+RenderLayer::~RenderLayer() {
+    unload();
+}
+
+void RenderLayer::setBounds(const Rectangle& newBounds) {
+    bool sizeChanged =
+        static_cast<int>(newBounds.width) != static_cast<int>(bounds.width) ||
+        static_cast<int>(newBounds.height) != static_cast<int>(bounds.height);
+    bounds = newBounds;
+
+    if (loaded && !sizeChanged)
+        return;
+
+    unload();
+    target = LoadRenderTexture(static_cast<int>(bounds.width), static_cast<int>(bounds.height));
+    loaded = target.id != 0;
+    valid = false;
+}
+
+void RenderLayer::begin(const Color& clearColor) {
+    beginUpdate();
+    ClearBackground(clearColor);
+}
+
+void RenderLayer::beginUpdate() {
+    BeginTextureMode(target);
+
+    // Default blending multiplies alpha into the target, leaving translucent
+    // strokes see-through when the layer is blitted; accumulate alpha "over" instead
+    rlSetBlendFactorsSeparate(RL_SRC_ALPHA, RL_ONE_MINUS_SRC_ALPHA, RL_ONE, RL_ONE_MINUS_SRC_ALPHA,
+        RL_FUNC_ADD, RL_FUNC_ADD);
+    BeginBlendMode(BLEND_CUSTOM_SEPARATE);
+
+    // Shift screen coordinates so callers can draw exactly as they would on screen
+    Camera2D camera = {};
+    camera.offset = { -bounds.x, -bounds.y };
+    camera.target = { 0.0f, 0.0f };
+    camera.rotation = 0.0f;
+    camera.zoom = 1.0f;
+    BeginMode2D(camera);
+}
+
+void RenderLayer::end() {
+    EndMode2D();
+    EndBlendMode();
+    EndTextureMode();
+    valid = true;
+}
+
+void RenderLayer::draw() const {
+    drawRegion(bounds);
+}
+
+void RenderLayer::drawRegion(const Rectangle& region) const {
+    if (!loaded)
+        return;
+
+    // Clip the requested region to the layer
+    float left = std::max(region.x, bounds.x);
+    float top = std::max(region.y, bounds.y);
+    float right = std::min(region.x + region.width, bounds.x + bounds.width);
+    float bottom = std::min(region.y + region.height, bounds.y + bounds.height);
+    if (right <= left || bottom <= top)
+        return;
+
+    // Render textures are stored bottom-up, so flip the source rectangle
+    float localX = left - bounds.x;
+    float localY = top - bounds.y;
+    float width = right - left;
+    float height = bottom - top;
+    Rectangle source = {
+        localX,
+        static_cast<float>(target.texture.height) - localY - height,
+        width,
+        -height
+    };
+    DrawTextureRec(target.texture, source, { left, top }, WHITE);
+}
+
+void RenderLayer::unload() {
+    if (loaded)
+        UnloadRenderTexture(target);
+    target = {};
+    loaded = false;
+    valid = false;
+}
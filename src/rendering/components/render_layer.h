@@ -0,0 +1,49 @@
+#pragma once
+
+#include <raylib.h>
+
+/**
+ * Off-screen render target for content that rarely changes
+ *
+ * Draw into the layer between begin() and end() using normal screen
+ * coordinates; afterwards draw() blits the cached result with a single
+ * textured quad. The layer stays valid until invalidate() is called.
+ */
+class RenderLayer {
+public:
+    RenderLayer() = default;
+    ~RenderLayer();
+
+    // Non-copyable (owns a GPU render target)
+    RenderLayer(const RenderLayer&) = delete;
+    RenderLayer& operator=(const RenderLayer&) = delete;
+
+    /**
+     * Set the screen-space area covered by the layer
+     * Reallocates the render target only when the size changes.
+     */
+    void setBounds(const Rectangle& bounds);
+    const Rectangle& getBounds() const { return bounds; }
+
+    // Cached content state
+    bool isValid() const { return valid; }
+    void invalidate() { valid = false; }
+
+    // Record content in screen coordinates; end() marks the layer valid
+    void begin(const Color& clearColor = BLANK);
+    void beginUpdate(); // Like begin() but keeps existing content for partial redraws
+    void end();
+
+    // Blit the whole layer, or only the part overlapping a screen-space region
+    void draw() const;
+    void drawRegion(const Rectangle& region) const;
+
+    // Release the render target (must happen before the window closes)
+    void unload();
+
+private:
+    RenderTexture2D target = {};
+    Rectangle bounds = {0, 0, 0, 0};
+    bool loaded = false;
+    bool valid = false;
+};
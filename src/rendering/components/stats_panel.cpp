@@ -1,6 +1,7 @@
 #include "stats_panel.h"
 #include "ui_renderer.h"
 #include "../../config/config.h"
+#include "../../profiling/profiler.h"
 
 namespace StatsPanelCfg = Config::StatsPanel;
 
@@ -8,12 +9,30 @@ StatsPanel::StatsPanel(const ChessAnalysisProgram& controller) :
     controller(controller) {}
 
 void StatsPanel::draw() const {
-    drawStatsPanel();
+    PROFILE_SCOPE("StatsPanel::draw");
+
+    // Every stat shown derives from the position history
+    const uint64_t historyVersion = controller.getHistoryVersion();
+    if (!textLayout.isCurrent(historyVersion)) {
+        textLayout.begin(historyVersion);
+        layoutStatsPanel();
+    }
+    textLayout.draw();
+}
+
+void StatsPanel::drawChrome() const {
+    Rectangle panelBounds = getPanelBounds();
+    
+    // Draw panel using UIRenderer
+    UIRenderer::drawPanelBackground(panelBounds, UIRenderer::PanelStyle::Stats);
+    UIRenderer::drawPanelBorder(panelBounds);
+    UIRenderer::drawPanelShadowRight(panelBounds, 6);
+    drawPanelTitle();
 }
 
 Rectangle StatsPanel::getPanelBounds() const {
     // Position at the top of the vertically centered left panel area
-    float totalPanelHeight = StatsPanelCfg::PANEL_HEIGHT + Config::EngineDialog::DIALOG_HEIGHT + Config::ControlsPanel::PANEL_HEIGHT;
+    float totalPanelHeight = StatsPanelCfg::PANEL_HEIGHT + Config::EngineDialog::DIALOG_HEIGHT + Config::ExplorerPanel::PANEL_HEIGHT + Config::ControlsPanel::PANEL_HEIGHT;
     float verticalCenterOffset = (Config::Window::HEIGHT - totalPanelHeight) / 2.0f;
     return Rectangle{
         0,  // Align to left edge
@@ -23,23 +42,15 @@ Rectangle StatsPanel::getPanelBounds() const {
     };
 }
 
-void StatsPanel::drawStatsPanel() const {
+void StatsPanel::layoutStatsPanel() const {
     Rectangle panelBounds = getPanelBounds();
     
-    // Draw panel using UIRenderer
-    UIRenderer::drawPanelBackground(panelBounds, UIRenderer::PanelStyle::Stats);
-    UIRenderer::drawPanelBorder(panelBounds);
-    UIRenderer::drawPanelShadowRight(panelBounds, 6);
-    
-    // Draw content
-    drawPanelTitle();
-    
     // Draw statistics with dynamic positioning
     int currentY = panelBounds.y + StatsPanelCfg::TITLE_HEIGHT + 12 + StatsPanelCfg::PANEL_PADDING;
-    drawCurrentPlayer(currentY);
-    drawHalfMoveClock(currentY);
-    drawGameStatus(currentY);
-    drawCapturedPieces(currentY);
+    layoutCurrentPlayer(currentY);
+    layoutHalfMoveClock(currentY);
+    layoutGameStatus(currentY);
+    layoutCapturedPieces(currentY);
 }
 
 void StatsPanel::drawPanelTitle() const {
@@ -48,7 +59,7 @@ void StatsPanel::drawPanelTitle() const {
                               StatsPanelCfg::TITLE_HEIGHT, StatsPanelCfg::PANEL_PADDING);
 }
 
-void StatsPanel::drawStat(const std::string& label, const std::string& value, int& currentY) const {
+void StatsPanel::layoutStat(const std::string& label, const std::string& value, int& currentY) const {
     Rectangle panelBounds = getPanelBounds();
     
     int labelX = panelBounds.x + StatsPanelCfg::PANEL_PADDING;
@@ -58,15 +69,15 @@ void StatsPanel::drawStat(const std::string& label, const std::string& value, in
     int valueX = panelBounds.x + StatsPanelCfg::PANEL_PADDING + labelWidth + 20; // 20px spacing
     
     // Draw label
-    drawText(label, labelX, currentY, 17, Color{90, 95, 100, 255});
+    addText(label, labelX, currentY, 17, Color{90, 95, 100, 255});
     
     // Draw value
-    drawText(value, valueX, currentY, 17, Color{40, 45, 50, 255});
+    addText(value, valueX, currentY, 17, Color{40, 45, 50, 255});
     
     currentY += StatsPanelCfg::LINE_HEIGHT + 2; // Reduced spacing from 4 to 2
 }
 
-void StatsPanel::drawCurrentPlayer(int& currentY) const {
+void StatsPanel::layoutCurrentPlayer(int& currentY) const {
     char player = controller.getCurrentPlayer();
     std::string playerName = (player == 'w') ? "White" : "Black";
     Color playerColor = (player == 'w') ? Color{100, 100, 100, 255} : Color{60, 60, 60, 255};
@@ -78,18 +89,18 @@ void StatsPanel::drawCurrentPlayer(int& currentY) const {
     int labelWidth = UIRenderer::measureMonospaceText("Captured Pieces:", 17);
     int valueX = panelBounds.x + StatsPanelCfg::PANEL_PADDING + labelWidth + 20; // 20px spacing
     
-    drawText("Current Player:", labelX, currentY, 17, Color{90, 95, 100, 255});
-    drawText(playerName, valueX, currentY, 17, playerColor);
+    addText("Current Player:", labelX, currentY, 17, Color{90, 95, 100, 255});
+    addText(playerName, valueX, currentY, 17, playerColor);
     
     currentY += StatsPanelCfg::LINE_HEIGHT + 2; // Reduced spacing from 4 to 2
 }
 
-void StatsPanel::drawHalfMoveClock(int& currentY) const {
+void StatsPanel::layoutHalfMoveClock(int& currentY) const {
     std::string clockValue = std::to_string(controller.getHalfmoveClock());
-    drawStat("Halfmove Clock:", clockValue, currentY);
+    layoutStat("Halfmove Clock:", clockValue, currentY);
 }
 
-void StatsPanel::drawGameStatus(int& currentY) const {
+void StatsPanel::layoutGameStatus(int& currentY) const {
     std::string status;
     Color statusColor;
     
@@ -108,18 +119,17 @@ void StatsPanel::drawGameStatus(int& currentY) const {
     int labelWidth = UIRenderer::measureMonospaceText("Captured Pieces:", 17);
     int valueX = panelBounds.x + StatsPanelCfg::PANEL_PADDING + labelWidth + 20; // 20px spacing
     
-    drawText("Game Status:", labelX, currentY, 17, Color{90, 95, 100, 255});
-    drawText(status, valueX, currentY, 17, statusColor);
+    addText("Game Status:", labelX, currentY, 17, Color{90, 95, 100, 255});
+    addText(status, valueX, currentY, 17, statusColor);
     
     currentY += StatsPanelCfg::LINE_HEIGHT + 2; // Reduced spacing from 4 to 2
 }
 
-void StatsPanel::drawCapturedPieces(int& currentY) const {
-    std::vector<char> captured = controller.getCapturedPieces();
-    std::string capturedCount = std::to_string(captured.size());
-    drawStat("Captured Pieces:", capturedCount, currentY);
+void StatsPanel::layoutCapturedPieces(int& currentY) const {
+    std::string capturedCount = std::to_string(controller.getCapturedPieceCount());
+    layoutStat("Captured Pieces:", capturedCount, currentY);
 }
 
-void StatsPanel::drawText(const std::string& text, int x, int y, int fontSize, Color textColor) const {
-    UIRenderer::drawTextWithShadow(text, x, y, fontSize, textColor);
+void StatsPanel::addText(const std::string& text, int x, int y, int fontSize, Color textColor) const {
+    textLayout.addText(text, x, y, fontSize, textColor);
 }
@@ -5,6 +5,7 @@
 #include <vector>
 #include "../../config/config.h"
 #include "../../application/chess_analysis_program.h"
+#include "text_layout_cache.h"
 
 class ChessAnalysisProgram;
 
@@ -13,20 +14,22 @@ public:
     StatsPanel(const ChessAnalysisProgram& controller);
     
     void draw() const;
+    void drawChrome() const; // Static background, border and title (cached by ChessGUI)
+    Rectangle getPanelBounds() const;
 
 private:
     const ChessAnalysisProgram& controller;
+    mutable TextLayoutCache textLayout; // Rebuilt when the position history version changes
 
     // Use Config::StatsPanel constants
     
-    void drawStatsPanel() const;
+    void layoutStatsPanel() const;
     void drawPanelTitle() const;
-    void drawStat(const std::string& label, const std::string& value, int& currentY) const;
-    void drawText(const std::string& text, int x, int y, int fontSize, Color textColor) const;
+    void layoutStat(const std::string& label, const std::string& value, int& currentY) const;
+    void addText(const std::string& text, int x, int y, int fontSize, Color textColor) const;
     
-    Rectangle getPanelBounds() const;
-    void drawCurrentPlayer(int& currentY) const;
-    void drawHalfMoveClock(int& currentY) const;
-    void drawGameStatus(int& currentY) const;
-    void drawCapturedPieces(int& currentY) const;
+    void layoutCurrentPlayer(int& currentY) const;
+    void layoutHalfMoveClock(int& currentY) const;
+    void layoutGameStatus(int& currentY) const;
+    void layoutCapturedPieces(int& currentY) const;
 };
\ No newline at end of file
@@ -0,0 +1,28 @@
+#include "text_layout_cache.h"
+#include <utility>
+
+void TextLayoutCache::begin(uint64_t version) {
+    runs.clear();
+    lines.clear();
+    contentVersion = version;
+    valid = true;
+}
+
+void TextLayoutCache::add(UIRenderer::ShapedText text, int x, int y, Color color) {
+    runs.push_back({std::move(text), x, y, color});
+}
+
+void TextLayoutCache::addText(const std::string& text, int x, int y, int fontSize, Color color) {
+    add(UIRenderer::shapeText(text, fontSize), x, y, color);
+}
+
+void TextLayoutCache::addLine(int startX, int startY, int endX, int endY, Color color) {
+    lines.push_back({startX, startY, endX, endY, color});
+}
+
+void TextLayoutCache::draw() const {
+    for (const LineRun& line : lines)
+        DrawLine(line.startX, line.startY, line.endX, line.endY, line.color);
+    for (const TextRun& run : runs)
+        UIRenderer::drawShapedTextWithShadow(run.text, run.x, run.y, run.color);
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <raylib.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "ui_renderer.h"
+
+/**
+ * Laid-out panel text keyed on a content version
+ *
+ * Panels rebuild the layout (string formatting, glyph shaping and width
+ * measurement) only when the version of the data they display changes;
+ * otherwise draw() replays the cached runs directly.
+ */
+class TextLayoutCache {
+public:
+    // Check if the cached layout was built for this content version
+    bool isCurrent(uint64_t version) const { return valid && contentVersion == version; }
+    void invalidate() { valid = false; }
+
+    // Start a new layout for a content version (discards previous runs)
+    void begin(uint64_t version);
+
+    // Append content (positions in screen coordinates)
+    void add(UIRenderer::ShapedText text, int x, int y, Color color);
+    void addText(const std::string& text, int x, int y, int fontSize, Color color);
+    void addLine(int startX, int startY, int endX, int endY, Color color);
+
+    // Replay the cached layout
+    void draw() const;
+
+private:
+    struct TextRun {
+        UIRenderer::ShapedText text;
+        int x;
+        int y;
+        Color color;
+    };
+
+    struct LineRun {
+        int startX;
+        int startY;
+        int endX;
+        int endY;
+        Color color;
+    };
+
+    std::vector<TextRun> runs;
+    std::vector<LineRun> lines;
+    uint64_t contentVersion = 0;
+    bool valid = false;
+};
@@ -1,19 +1,34 @@
 #include "texture_manager.h"
 #include "../../application/chess_analysis_program.h"
 #include "../../config/config.h"
+#include <algorithm>
+#include <string>
 
 namespace BoardCfg = Config::Board;
 namespace PieceCfg = Config::Pieces;
 
+static_assert(BoardCfg::VALID_PIECES.size() == static_cast<size_t>(PieceSprite::Count),
+    "PieceSprite must list every valid piece");
+
+// Piece character -> sprite lookup, built at compile time from VALID_PIECES
+static constexpr std::array<PieceSprite, 128> buildPieceSpriteTable() {
+    std::array<PieceSprite, 128> table = {};
+    for (size_t i = 0; i < table.size(); i++)
+        table[i] = PieceSprite::None;
+    for (size_t i = 0; i < BoardCfg::VALID_PIECES.size(); i++)
+        table[static_cast<unsigned char>(BoardCfg::VALID_PIECES[i])] = static_cast<PieceSprite>(i);
+    return table;
+}
+
+static constexpr std::array<PieceSprite, 128> PIECE_SPRITE_TABLE = buildPieceSpriteTable();
+
 TextureManager::TextureManager(const ChessAnalysisProgram& controller) :
-    controller(controller), texturesLoaded(false) {
+    controller(controller), boardTexture{}, pieceAtlas{}, pieceSources{}, texturesLoaded(false) {
 }
 
 TextureManager::~TextureManager() {
     if (texturesLoaded) {
-        // Unload all the piece textures
-        for (const std::pair<std::string, Texture2D>& pieceTexture : pieceTextures) 
-            UnloadTexture(pieceTexture.second);
+        UnloadTexture(pieceAtlas);
         UnloadTexture(boardTexture);
     }
 }
@@ -24,10 +39,8 @@ void TextureManager::loadTextures() {
     // Load board
     boardTexture = LoadTexture(BoardCfg::TEXTURE_PATH);
     
-    // Load piece textures
-    for (char piece : BoardCfg::VALID_PIECES) {
-        loadPieceTexture(piece);
-    }
+    // Pack piece sprites into one texture
+    loadPieceAtlas();
     
     texturesLoaded = true;
 }
@@ -40,12 +53,64 @@ const Texture2D& TextureManager::getBoardTexture() const {
     return boardTexture;
 }
 
-const Texture2D& TextureManager::getPieceTexture(const std::string& pieceString) const {
-    return pieceTextures.at(pieceString);
+const Texture2D& TextureManager::getPieceAtlas() const {
+    return pieceAtlas;
+}
+
+PieceSprite TextureManager::getPieceSprite(const char piece) {
+    const unsigned char index = static_cast<unsigned char>(piece);
+    return index < PIECE_SPRITE_TABLE.size() ? PIECE_SPRITE_TABLE[index] : PieceSprite::None;
 }
 
-void TextureManager::loadPieceTexture(const char piece) {
-    std::string pieceString = controller.pieceToTextureString(piece);
-    std::string path = PieceCfg::TEXTURE_PATH + pieceString + ".png";
-    pieceTextures[pieceString] = LoadTexture(path.c_str());
-}
\ No newline at end of file
+void TextureManager::drawPiece(const char piece, const Vector2 position, const float scale) const {
+    const PieceSprite sprite = getPieceSprite(piece);
+    if (sprite == PieceSprite::None)
+        return;
+
+    const Rectangle& source = pieceSources[static_cast<size_t>(sprite)];
+    const Rectangle dest = {
+        position.x,
+        position.y,
+        source.width * scale,
+        source.height * scale
+    };
+    DrawTexturePro(pieceAtlas, source, dest, {0.0f, 0.0f}, 0.0f, WHITE);
+}
+
+void TextureManager::loadPieceAtlas() {
+    // Load every sprite on the CPU first to size the atlas cells
+    std::array<Image, static_cast<size_t>(PieceSprite::Count)> images = {};
+    int cellWidth = 0;
+    int cellHeight = 0;
+    for (size_t i = 0; i < BoardCfg::VALID_PIECES.size(); i++) {
+        std::string path = PieceCfg::TEXTURE_PATH + controller.pieceToTextureString(BoardCfg::VALID_PIECES[i]) + ".png";
+        images[i] = LoadImage(path.c_str());
+        ImageFormat(&images[i], PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+        cellWidth = std::max(cellWidth, images[i].width);
+        cellHeight = std::max(cellHeight, images[i].height);
+    }
+
+    // Compose the atlas: white pieces on the first row, black pieces on the second
+    const int rows = (static_cast<int>(images.size()) + ATLAS_COLUMNS - 1) / ATLAS_COLUMNS;
+    Image atlas = GenImageColor(cellWidth * ATLAS_COLUMNS, cellHeight * rows, BLANK);
+    for (size_t i = 0; i < images.size(); i++) {
+        const Rectangle source = {
+            0.0f,
+            0.0f,
+            static_cast<float>(images[i].width),
+            static_cast<float>(images[i].height)
+        };
+        const Rectangle dest = {
+            static_cast<float>((static_cast<int>(i) % ATLAS_COLUMNS) * cellWidth),
+            static_cast<float>((static_cast<int>(i) / ATLAS_COLUMNS) * cellHeight),
+            source.width,
+            source.height
+        };
+        ImageDraw(&atlas, images[i], source, dest, WHITE);
+        pieceSources[i] = dest;
+        UnloadImage(images[i]);
+    }
+
+    pieceAtlas = LoadTextureFromImage(atlas);
+    UnloadImage(atlas);
+}
@@ -1,13 +1,27 @@
 #pragma once
 
 #include <raylib.h>
-#include <map>
-#include <string>
+#include <array>
+#include <cstddef>
+#include <cstdint>
 
 class ChessAnalysisProgram;
 
+/**
+ * Piece sprites in the atlas, in Config::Board::VALID_PIECES order
+ */
+enum class PieceSprite : uint8_t {
+    WhitePawn, WhiteRook, WhiteKnight, WhiteBishop, WhiteQueen, WhiteKing,
+    BlackPawn, BlackRook, BlackKnight, BlackBishop, BlackQueen, BlackKing,
+    Count,
+    None
+};
+
 /**
  * Manages loading and unloading of textures for the chess board and pieces
+ *
+ * All piece sprites are packed into a single atlas texture at load time, so
+ * consecutive piece draws share one texture and batch into one draw call.
  */
 class TextureManager {
 public:
@@ -18,13 +32,27 @@ public:
     bool areTexturesLoaded() const;
     
     const Texture2D& getBoardTexture() const;
-    const Texture2D& getPieceTexture(const std::string& pieceString) const;
+    const Texture2D& getPieceAtlas() const;
+
+    // Map a board piece character to its sprite (PieceSprite::None if invalid)
+    static PieceSprite getPieceSprite(const char piece);
+
+    /**
+     * Draw a piece sprite from the atlas
+     * @param piece Board piece character (e.g. 'K', 'p')
+     * @param position Top-left corner in screen coordinates
+     * @param scale Scale applied to the source sprite
+     */
+    void drawPiece(const char piece, const Vector2 position, const float scale) const;
 
 private:
+    static constexpr int ATLAS_COLUMNS = 6; // One row per color
+
     const ChessAnalysisProgram& controller;
     Texture2D boardTexture;
-    std::map<std::string, Texture2D> pieceTextures;
+    Texture2D pieceAtlas;
+    std::array<Rectangle, static_cast<size_t>(PieceSprite::Count)> pieceSources;
     bool texturesLoaded;
     
-    void loadPieceTexture(const char piece);
-};
\ No newline at end of file
+    void loadPieceAtlas();
+};
@@ -1,36 +1,45 @@
 #include "ui_renderer.h"
 
+namespace FontCfg = Config::Fonts;
+
 // Initialize static members
-Font UIRenderer::monospaceFont = {0};
+std::map<int, UIRenderer::SizedFont> UIRenderer::sizedFonts;
+const char* UIRenderer::monospaceFontPath = nullptr;
 bool UIRenderer::fontsLoaded = false;
 
+// Subtle shadow drawn under all panel text for better readability
+static constexpr Color TEXT_SHADOW_COLOR = {0, 0, 0, 30};
+
 void UIRenderer::initializeFonts() {
     if (fontsLoaded) return;
     
-    // Try to load custom monospace font from config paths
-    monospaceFont = LoadFontEx(Config::Fonts::MONOSPACE_FONT_PATH, Config::Fonts::BASE_FONT_SIZE, 0, 0);
-    
-    // If loading fails, try fallback fonts
-    if (monospaceFont.texture.id == 0) {
-        monospaceFont = LoadFontEx(Config::Fonts::FALLBACK_MONOSPACE_PATH, Config::Fonts::BASE_FONT_SIZE, 0, 0);
-    }
-    
-    if (monospaceFont.texture.id == 0) {
-        monospaceFont = LoadFontEx(Config::Fonts::FALLBACK_MONOSPACE_PATH_2, Config::Fonts::BASE_FONT_SIZE, 0, 0);
-    }
-    
-    // If all fails, use default font
-    if (monospaceFont.texture.id == 0) {
-        monospaceFont = GetFontDefault();
+    // Find the first configured monospace font that loads (probe at the first baked size)
+    const int probeSize = FontCfg::BAKED_SIZES[0];
+    for (const char* path : {FontCfg::MONOSPACE_FONT_PATH, FontCfg::FALLBACK_MONOSPACE_PATH, FontCfg::FALLBACK_MONOSPACE_PATH_2}) {
+        Font font = LoadFontEx(path, probeSize, 0, 0);
+        if (font.texture.id != 0) {
+            UnloadFont(font); // Re-baked below with the glyph tables
+            monospaceFontPath = path;
+            break;
+        }
     }
     
+    // If all fails, getSizedFont falls back to the scaled default font
     fontsLoaded = true;
+    
+    // Bake a glyph atlas for every configured size up front; other sizes are baked lazily
+    for (int fontSize : FontCfg::BAKED_SIZES)
+        getSizedFont(fontSize);
 }
 
 void UIRenderer::cleanupFonts() {
-    if (fontsLoaded && monospaceFont.texture.id != GetFontDefault().texture.id) {
-        UnloadFont(monospaceFont);
+    const unsigned int defaultFontId = GetFontDefault().texture.id;
+    for (const std::pair<const int, SizedFont>& sizedFont : sizedFonts) {
+        if (sizedFont.second.font.texture.id != defaultFontId)
+            UnloadFont(sizedFont.second.font);
     }
+    sizedFonts.clear();
+    monospaceFontPath = nullptr;
     fontsLoaded = false;
 }
 
@@ -38,11 +47,55 @@ bool UIRenderer::areCustomFontsLoaded() {
     return fontsLoaded;
 }
 
-Font UIRenderer::getMonospaceFont() {
+const UIRenderer::SizedFont& UIRenderer::getSizedFont(int fontSize) {
     if (!fontsLoaded) {
         initializeFonts();
     }
-    return monospaceFont;
+
+    auto existing = sizedFonts.find(fontSize);
+    if (existing != sizedFonts.end())
+        return existing->second;
+    return sizedFonts.emplace(fontSize, bakeFont(fontSize)).first->second;
+}
+
+UIRenderer::SizedFont UIRenderer::bakeFont(int fontSize) {
+    SizedFont sizedFont;
+    if (monospaceFontPath)
+        sizedFont.font = LoadFontEx(monospaceFontPath, fontSize, 0, 0);
+    if (sizedFont.font.texture.id == 0)
+        sizedFont.font = GetFontDefault();
+    sizedFont.scale = static_cast<float>(fontSize) / sizedFont.font.baseSize;
+
+    // Resolve ASCII glyph indices once (GetGlyphIndex is a linear search)
+    for (int codepoint = 0; codepoint < static_cast<int>(sizedFont.asciiGlyphIndex.size()); codepoint++)
+        sizedFont.asciiGlyphIndex[codepoint] = GetGlyphIndex(sizedFont.font, codepoint);
+
+    // Monospace check over printable ASCII, so measuring becomes arithmetic
+    sizedFont.isMonospace = true;
+    sizedFont.advance = getGlyphAdvance(sizedFont, sizedFont.asciiGlyphIndex[' ']);
+    for (int codepoint = ' ' + 1; codepoint <= '~'; codepoint++) {
+        if (getGlyphAdvance(sizedFont, sizedFont.asciiGlyphIndex[codepoint]) != sizedFont.advance) {
+            sizedFont.isMonospace = false;
+            break;
+        }
+    }
+
+    return sizedFont;
+}
+
+int UIRenderer::getGlyphIndex(const SizedFont& sizedFont, int codepoint) {
+    return
+        (codepoint >= 0 && codepoint < static_cast<int>(sizedFont.asciiGlyphIndex.size())) ?
+        sizedFont.asciiGlyphIndex[codepoint] :
+        GetGlyphIndex(sizedFont.font, codepoint);
+}
+
+float UIRenderer::getGlyphAdvance(const SizedFont& sizedFont, int index) {
+    const float advance =
+        (sizedFont.font.glyphs[index].advanceX == 0) ?
+        sizedFont.font.recs[index].width :
+        static_cast<float>(sizedFont.font.glyphs[index].advanceX);
+    return advance * sizedFont.scale;
 }
 
 void UIRenderer::drawPanelBackground(const Rectangle& bounds, PanelStyle style) {
@@ -98,29 +151,106 @@ void UIRenderer::drawPanelTitle(const Rectangle& bounds, const std::string& titl
 }
 
 void UIRenderer::drawTextWithShadow(const std::string& text, int x, int y, int fontSize, Color textColor) {
-    Font font = getMonospaceFont();
-    float spacing = Config::Fonts::MONOSPACE_SPACING;
-    DrawTextEx( // Draw text with subtle shadow for better readability
-        font, 
-        text.c_str(), 
-        { static_cast<float>(x + 1), static_cast<float>(y + 1) }, 
-        static_cast<float>(fontSize), 
-        spacing,
-        Color{0, 0, 0, 30});
-    DrawTextEx(
-        font, 
-        text.c_str(), 
-        { static_cast<float>(x), static_cast<float>(y) },
-        static_cast<float>(fontSize), 
-        spacing, 
-        textColor);
+    const SizedFont& sizedFont = getSizedFont(fontSize);
+
+    // Draw text with subtle shadow for better readability (whole shadow first, as DrawTextEx did)
+    drawTextGlyphs(sizedFont, text, static_cast<float>(x + 1), static_cast<float>(y + 1), TEXT_SHADOW_COLOR);
+    drawTextGlyphs(sizedFont, text, static_cast<float>(x), static_cast<float>(y), textColor);
 }
 
 int UIRenderer::measureMonospaceText(const std::string& text, int fontSize) {
-    Font font = getMonospaceFont();
-    float spacing = Config::Fonts::MONOSPACE_SPACING;
-    Vector2 textSize = MeasureTextEx(font, text.c_str(), static_cast<float>(fontSize), spacing);
-    return static_cast<int>(textSize.x);
+    const SizedFont& sizedFont = getSizedFont(fontSize);
+    const float spacing = FontCfg::MONOSPACE_SPACING;
+
+    if (!sizedFont.isMonospace) {
+        Vector2 textSize = MeasureTextEx(sizedFont.font, text.c_str(), static_cast<float>(fontSize), spacing);
+        return static_cast<int>(textSize.x);
+    }
+
+    // Every glyph advances the same distance: count codepoints (skip UTF-8 continuation bytes)
+    int codepointCount = 0;
+    for (char c : text) {
+        if ((static_cast<unsigned char>(c) & 0xC0) != 0x80)
+            codepointCount++;
+    }
+    if (codepointCount == 0)
+        return 0;
+    return static_cast<int>(codepointCount * sizedFont.advance + (codepointCount - 1) * spacing);
+}
+
+UIRenderer::ShapedText UIRenderer::shapeText(const std::string& text, int fontSize) {
+    const SizedFont& sizedFont = getSizedFont(fontSize);
+    const float spacing = FontCfg::MONOSPACE_SPACING;
+
+    ShapedText shaped;
+    shaped.fontSize = fontSize;
+    shaped.glyphs.reserve(text.size());
+
+    // Same pen advance rules as DrawTextEx/MeasureTextEx, resolved once
+    float penX = 0.0f;
+    for (size_t i = 0; i < text.size();) {
+        int codepointSize = 0;
+        const int codepoint = GetCodepointNext(&text[i], &codepointSize);
+        const int index = getGlyphIndex(sizedFont, codepoint);
+        i += codepointSize;
+
+        if (codepoint != ' ' && codepoint != '\t')
+            shaped.glyphs.push_back({index, penX});
+        penX += getGlyphAdvance(sizedFont, index) + spacing;
+    }
+    shaped.width = (penX > 0.0f) ? penX - spacing : 0.0f;
+
+    return shaped;
+}
+
+void UIRenderer::drawShapedTextWithShadow(const ShapedText& text, int x, int y, Color textColor) {
+    const SizedFont& sizedFont = getSizedFont(text.fontSize);
+
+    // Draw text with subtle shadow for better readability
+    for (const ShapedGlyph& glyph : text.glyphs)
+        drawGlyph(sizedFont, glyph.index, x + 1 + glyph.offsetX, static_cast<float>(y + 1), TEXT_SHADOW_COLOR);
+    for (const ShapedGlyph& glyph : text.glyphs)
+        drawGlyph(sizedFont, glyph.index, x + glyph.offsetX, static_cast<float>(y), textColor);
+}
+
+void UIRenderer::drawTextGlyphs(const SizedFont& sizedFont, const std::string& text, float x, float y, Color tint) {
+    const float spacing = FontCfg::MONOSPACE_SPACING;
+
+    // Same pen advance rules as shapeText, without storing the glyphs
+    float penX = x;
+    for (size_t i = 0; i < text.size();) {
+        int codepointSize = 0;
+        const int codepoint = GetCodepointNext(&text[i], &codepointSize);
+        const int index = getGlyphIndex(sizedFont, codepoint);
+        i += codepointSize;
+
+        if (codepoint != ' ' && codepoint != '\t')
+            drawGlyph(sizedFont, index, penX, y, tint);
+        penX += getGlyphAdvance(sizedFont, index) + spacing;
+    }
+}
+
+void UIRenderer::drawGlyph(const SizedFont& sizedFont, int index, float x, float y, Color tint) {
+    // Equivalent to DrawTextCodepoint without the per-glyph index search
+    const Font& font = sizedFont.font;
+    const Rectangle& rec = font.recs[index];
+    const GlyphInfo& info = font.glyphs[index];
+    const float padding = static_cast<float>(font.glyphPadding);
+    const float scale = sizedFont.scale;
+
+    Rectangle source = {
+        rec.x - padding,
+        rec.y - padding,
+        rec.width + 2.0f * padding,
+        rec.height + 2.0f * padding
+    };
+    Rectangle dest = {
+        x + (info.offsetX - padding) * scale,
+        y + (info.offsetY - padding) * scale,
+        source.width * scale,
+        source.height * scale
+    };
+    DrawTexturePro(font.texture, source, dest, {0.0f, 0.0f}, 0.0f, tint);
 }
 
 Color UIRenderer::getPanelBackgroundColor(PanelStyle style) {
@@ -1,7 +1,10 @@
 #pragma once
 
 #include <raylib.h>
+#include <array>
+#include <map>
 #include <string>
+#include <vector>
 #include "../../config/config.h"
 
 class UIRenderer {
@@ -14,6 +17,19 @@ public:
         Moves       // Another light blue-gray background
     };
 
+    // A glyph resolved against the monospace font baked at the text's size (atlas index and pen offset)
+    struct ShapedGlyph {
+        int index;
+        float offsetX;
+    };
+
+    // A single line of text shaped once: glyph lookups and width measured up front
+    struct ShapedText {
+        std::vector<ShapedGlyph> glyphs;
+        int fontSize = 0;
+        float width = 0.0f;
+    };
+
     // Font management
     static void initializeFonts();
     static void cleanupFonts();
@@ -28,8 +44,22 @@ public:
     static void drawTextWithShadow(const std::string& text, int x, int y, int fontSize, Color textColor);
     static int measureMonospaceText(const std::string& text, int fontSize);
 
+    // Shaped text (see TextLayoutCache)
+    static ShapedText shapeText(const std::string& text, int fontSize);
+    static void drawShapedTextWithShadow(const ShapedText& text, int x, int y, Color textColor);
+
 private:
-    static Font monospaceFont;
+    // Monospace font baked at one pixel size
+    struct SizedFont {
+        Font font{};
+        float scale = 1.0f;                         // Only differs from 1 for the default-font fallback
+        float advance = 0.0f;                       // Scaled advance shared by every printable ASCII glyph
+        bool isMonospace = false;                   // All printable ASCII glyphs share one advance
+        std::array<int, 128> asciiGlyphIndex = {};  // ASCII codepoint -> glyph index
+    };
+
+    static std::map<int, SizedFont> sizedFonts;     // Keyed by pixel size
+    static const char* monospaceFontPath;           // First configured font that loaded (nullptr = default font)
     static bool fontsLoaded;
     
     static Color getPanelBackgroundColor(PanelStyle style);
@@ -37,5 +67,11 @@ private:
     static Color getShadowColor(int alpha);
     static Color getTitleBarColor();
     static Color getTitleTextColor();
-    static Font getMonospaceFont();
+    // Font cache
+    static const SizedFont& getSizedFont(int fontSize);
+    static SizedFont bakeFont(int fontSize);
+    static int getGlyphIndex(const SizedFont& sizedFont, int codepoint);
+    static float getGlyphAdvance(const SizedFont& sizedFont, int index);
+    static void drawTextGlyphs(const SizedFont& sizedFont, const std::string& text, float x, float y, Color tint);
+    static void drawGlyph(const SizedFont& sizedFont, int index, float x, float y, Color tint);
 };
\ No newline at end of file
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <cstdint>
+
+/**
+ * Change-tracking bits that drive rendering
+ *
+ * The controller accumulates these as state changes; ChessGUI redraws only
+ * the cached layers affected by a frame's bits, and the main loop skips the
+ * frame entirely (sleeping on events) when no bit is set.
+ */
+namespace DirtyFlags {
+    constexpr uint32_t NONE    = 0;
+    constexpr uint32_t BOARD   = 1u << 0;  // Pieces, captured pieces or drag origin changed
+    constexpr uint32_t HISTORY = 1u << 1;  // Move history or redo list changed
+    constexpr uint32_t ENGINE  = 1u << 2;  // New engine snapshot version or enabled state
+    constexpr uint32_t INPUT   = 1u << 3;  // Input activity needing a new frame (e.g. dragged piece moved)
+    constexpr uint32_t WINDOW  = 1u << 4;  // Resize, focus or restore events
+    constexpr uint32_t OVERLAY = 1u << 5;  // Live overlays (profiler) need a fresh frame
+    constexpr uint32_t ALL     = BOARD | HISTORY | ENGINE | INPUT | WINDOW | OVERLAY;
+}